@@ -0,0 +1,93 @@
+//
+// Copyright (c) 2019
+// The Boost.uBLAS developers
+//
+// This file is part of Boost.uBLAS. It is made available under the
+// Boost Software License, Version 1.0.
+// (Consult LICENSE or http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/numeric/ublas/batched.hpp>
+#include <boost/program_options.hpp>
+#include "benchmark.hpp"
+#include <complex>
+#include <string>
+
+namespace boost { namespace numeric { namespace ublas { namespace benchmark {
+
+// Products of a batch of l 4 x 4 matrices, see reference/batched_prod.cpp
+// for the loop over fixed_matrix products
+template <typename T>
+class batched_prod : public benchmark
+{
+public:
+  batched_prod(std::string const &name) : benchmark(name) {}
+  virtual void setup(long l)
+  {
+    a.resize(l);
+    b.resize(l);
+    c.resize(l);
+    for (std::size_t i = 0; i != a.data().size(); ++i)
+    {
+      a.data()[i] = std::rand() % 200;
+      b.data()[i] = std::rand() % 200;
+    }
+  }
+  virtual void operation(long l)
+  {
+    ublas::batched_prod(a, b, c);
+  }
+private:
+  batched_matrix<T, 4, 4> a;
+  batched_matrix<T, 4, 4> b;
+  batched_matrix<T, 4, 4> c;
+};
+
+}}}}
+
+namespace po = boost::program_options;
+namespace ublas = boost::numeric::ublas;
+namespace bm = boost::numeric::ublas::benchmark;
+
+template <typename T>
+void benchmark(std::string const &type)
+{
+  bm::batched_prod<T> p("batched_prod(batched_matrix<" + type + ", 4, 4>)");
+  p.run(std::vector<long>({1, 4, 16, 64, 256, 1024, 4096, 16384, 65536, 262144}));
+}
+
+int main(int argc, char **argv)
+{
+  po::variables_map vm;
+  try
+  {
+    po::options_description desc("Batched matrix product\n"
+                                 "Allowed options");
+    desc.add_options()("help,h", "produce help message");
+    desc.add_options()("type,t", po::value<std::string>(), "select value-type (float, double, fcomplex, dcomplex)");
+
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.count("help"))
+    {
+      std::cout << desc << std::endl;
+      return 0;
+    }
+  }
+  catch(std::exception &e)
+  {
+    std::cerr << "error: " << e.what() << std::endl;
+    return 1;
+  }
+  std::string type = vm.count("type") ? vm["type"].as<std::string>() : "float";
+  if (type == "float")
+    benchmark<float>("float");
+  else if (type == "double")
+    benchmark<double>("double");
+  else if (type == "fcomplex")
+    benchmark<std::complex<float>>("std::complex<float>");
+  else if (type == "dcomplex")
+    benchmark<std::complex<double>>("std::complex<double>");
+  else
+    std::cerr << "unsupported value-type \"" << vm["type"].as<std::string>() << '\"' << std::endl;
+}
@@ -0,0 +1,96 @@
+//
+// Copyright (c) 2019
+// The Boost.uBLAS developers
+//
+// This file is part of Boost.uBLAS. It is made available under the
+// Boost Software License, Version 1.0.
+// (Consult LICENSE or http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/program_options.hpp>
+#include "../benchmark.hpp"
+#include <complex>
+#include <string>
+
+namespace po = boost::program_options;
+namespace ublas = boost::numeric::ublas;
+namespace boost { namespace numeric { namespace ublas { namespace benchmark {
+
+// One fixed_matrix product after the other, the baseline of batched_prod
+template <typename T>
+class batched_prod : public benchmark
+{
+  using matrix = ublas::fixed_matrix<T, 4, 4>;
+public:
+  batched_prod(std::string const &name) : benchmark(name) {}
+  virtual void setup(long l)
+  {
+    a.resize(l);
+    b.resize(l);
+    c.resize(l);
+    for (long k = 0; k != l; ++k)
+      for (int i = 0; i != 4; ++i)
+        for (int j = 0; j != 4; ++j)
+        {
+          a[k](i, j) = std::rand() % 200;
+          b[k](i, j) = std::rand() % 200;
+        }
+  }
+  virtual void operation(long l)
+  {
+    for (long k = 0; k != l; ++k)
+      c[k] = ublas::prod(a[k], b[k]);
+  }
+private:
+  std::vector<matrix> a;
+  std::vector<matrix> b;
+  std::vector<matrix> c;
+};
+
+}}}}
+
+namespace bm = boost::numeric::ublas::benchmark;
+
+template <typename T>
+void benchmark(std::string const &type)
+{
+  bm::batched_prod<T> p("ref::batched_prod(fixed_matrix<" + type + ", 4, 4>)");
+  p.run(std::vector<long>({1, 4, 16, 64, 256, 1024, 4096, 16384, 65536, 262144}));
+}
+
+int main(int argc, char **argv)
+{
+  po::variables_map vm;
+  try
+  {
+    po::options_description desc("Loop over fixed size matrix products\n"
+                                 "Allowed options");
+    desc.add_options()("help,h", "produce help message");
+    desc.add_options()("type,t", po::value<std::string>(), "select value-type (float, double, fcomplex, dcomplex)");
+
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.count("help"))
+    {
+      std::cout << desc << std::endl;
+      return 0;
+    }
+  }
+  catch(std::exception &e)
+  {
+    std::cerr << "error: " << e.what() << std::endl;
+    return 1;
+  }
+  std::string type = vm.count("type") ? vm["type"].as<std::string>() : "float";
+  if (type == "float")
+    benchmark<float>("float");
+  else if (type == "double")
+    benchmark<double>("double");
+  else if (type == "fcomplex")
+    benchmark<std::complex<float>>("std::complex<float>");
+  else if (type == "dcomplex")
+    benchmark<std::complex<double>>("std::complex<double>");
+  else
+    std::cerr << "unsupported value-type \"" << vm["type"].as<std::string>() << '\"' << std::endl;
+}
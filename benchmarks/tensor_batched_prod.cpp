@@ -0,0 +1,111 @@
+//
+// Copyright (c) 2019
+// The Boost.uBLAS developers
+//
+// This file is part of Boost.uBLAS. It is made available under the
+// Boost Software License, Version 1.0.
+// (Consult LICENSE or http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/numeric/ublas/tensor.hpp>
+#include <boost/program_options.hpp>
+#include "benchmark.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+
+namespace boost { namespace numeric { namespace ublas { namespace benchmark {
+
+// Products of a batch of l n x n matrices stored as n x n x l tensors, with
+// one call to batched_prod or with one call to prod for each slice.
+template <typename T>
+class tensor_batched_prod : public benchmark
+{
+  using tensor_type = tensor<T>;
+public:
+  tensor_batched_prod(std::string const &name, std::string const &method, std::size_t n)
+    : benchmark(name), method_(method), n_(n) {}
+  virtual void setup(long l)
+  {
+    a = tensor_type(shape{n_, n_, std::size_t(l)});
+    b = tensor_type(shape{n_, n_, std::size_t(l)});
+    for (std::size_t i = 0; i != a.size(); ++i)
+    {
+      a[i] = std::rand() % 200;
+      b[i] = std::rand() % 200;
+    }
+  }
+  virtual void operation(long l)
+  {
+    if (method_ == "batched")
+      c = batched_prod(a, b, {2}, {1});
+    else
+    {
+      auto const size = n_ * n_;
+      c = tensor_type(shape{n_, n_, std::size_t(l)});
+      tensor_type ak(shape{n_, n_}), bk(shape{n_, n_});
+      for (std::size_t k = 0; k != std::size_t(l); ++k)
+      {
+        std::copy(a.begin() + k * size, a.begin() + (k + 1) * size, ak.begin());
+        std::copy(b.begin() + k * size, b.begin() + (k + 1) * size, bk.begin());
+        auto const ck = prod(ak, bk, {2}, {1});
+        std::copy(ck.begin(), ck.end(), c.begin() + k * size);
+      }
+    }
+  }
+private:
+  std::string method_;
+  std::size_t n_;
+  tensor_type a, b, c;
+};
+
+}}}}
+
+namespace po = boost::program_options;
+namespace ublas = boost::numeric::ublas;
+namespace bm = boost::numeric::ublas::benchmark;
+
+template <typename T>
+void benchmark(std::string const &type, std::string const &method, std::size_t n)
+{
+  bm::tensor_batched_prod<T> p(method + "(tensor<" + type + ">, " + std::to_string(n) + ")", method, n);
+  p.run(std::vector<long>({1, 4, 16, 64, 256, 1024, 4096, 16384, 65536}));
+}
+
+int main(int argc, char **argv)
+{
+  po::variables_map vm;
+  try
+  {
+    po::options_description desc("Batched tensor contraction\n"
+                                 "Allowed options");
+    desc.add_options()("help,h", "produce help message");
+    desc.add_options()("type,t", po::value<std::string>(), "select value-type (float, double)");
+    desc.add_options()("method,m", po::value<std::string>(), "select batched_prod or a loop over prod (batched, prod)");
+    desc.add_options()("size,n", po::value<std::size_t>(), "select the extent of the matrices (default 4)");
+
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.count("help"))
+    {
+      std::cout << desc << std::endl;
+      return 0;
+    }
+  }
+  catch(std::exception &e)
+  {
+    std::cerr << "error: " << e.what() << std::endl;
+    return 1;
+  }
+  std::string type = vm.count("type") ? vm["type"].as<std::string>() : "float";
+  std::string method = vm.count("method") ? vm["method"].as<std::string>() : "batched";
+  std::size_t n = vm.count("size") ? vm["size"].as<std::size_t>() : 4;
+  if (method != "batched" && method != "prod")
+    std::cerr << "unsupported method \"" << method << '\"' << std::endl;
+  else if (type == "float")
+    benchmark<float>("float", method, n);
+  else if (type == "double")
+    benchmark<double>("double", method, n);
+  else
+    std::cerr << "unsupported value-type \"" << vm["type"].as<std::string>() << '\"' << std::endl;
+}
@@ -0,0 +1,128 @@
+//
+// Copyright (c) 2019
+// The Boost.uBLAS developers
+//
+// This file is part of Boost.uBLAS. It is made available under the
+// Boost Software License, Version 1.0.
+// (Consult LICENSE or http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/numeric/ublas/tensor.hpp>
+#include <boost/program_options.hpp>
+#include "benchmark.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <string>
+
+namespace boost { namespace numeric { namespace ublas { namespace benchmark {
+
+// Time to accuracy of the decompositions of an n x n x n tensor of
+// multilinear rank (r,r,r) and CP rank r with 1% noise. Prints the
+// number of iterations and the fit reached in that time.
+template <typename T>
+class tensor_decomposition : public benchmark
+{
+  using clock = std::chrono::system_clock;
+  using tensor_type = tensor<T>;
+public:
+  tensor_decomposition(std::string const &name, std::string const &method, std::size_t rank)
+    : benchmark(name), name_(name), method_(method), rank_(rank) {}
+  virtual void setup(long l)
+  {
+    auto const n = std::size_t(l);
+    auto c = tensor_type(shape{rank_, rank_, rank_}, T{});
+    for (std::size_t r = 0; r != rank_; ++r)
+      c.at(r, r, r) = T(rank_ - r);
+    a = c;
+    for (std::size_t k = 1; k <= 3; ++k)
+    {
+      matrix<T> u(n, rank_);
+      for (std::size_t i = 0; i != n; ++i)
+        for (std::size_t j = 0; j != rank_; ++j)
+          u(i, j) = T(std::rand() % 200) / 100 - 1;
+      a = prod(a, u, k);
+    }
+    auto const scale = norm(a) / std::sqrt(T(a.size())) / 100;
+    for (auto &x : a)
+      x += scale * (T(std::rand() % 200) / 100 - 1);
+  }
+  virtual void operation(long)
+  {
+    if (method_ == "hosvd")
+      fit = hosvd(a, {rank_, rank_, rank_}).fit;
+    else if (method_ == "hooi")
+      fit = hooi(a, {rank_, rank_, rank_}, 100, T(1e-5)).fit;
+    else
+      fit = cp_als(a, rank_, 500, T(1e-5)).fit;
+  }
+  void run(std::vector<long> const &sizes)
+  {
+    std::cout << "# benchmark : " << name_ << '\n'
+              << "# size \ttime (ms)\titerations\tfit" << std::endl;
+    for (auto s : sizes)
+    {
+      setup(s);
+      auto start = clock::now();
+      operation(s);
+      auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(clock::now() - start);
+      std::cout << s << '\t' << duration.count() << '\t' << fit.size() << '\t' << fit.back() << std::endl;
+    }
+  }
+private:
+  std::string name_;
+  std::string method_;
+  std::size_t rank_;
+  tensor_type a;
+  std::vector<T> fit;
+};
+
+}}}}
+
+namespace po = boost::program_options;
+namespace ublas = boost::numeric::ublas;
+namespace bm = boost::numeric::ublas::benchmark;
+
+template <typename T>
+void benchmark(std::string const &type, std::string const &method, std::size_t rank)
+{
+  bm::tensor_decomposition<T> p(method + "(tensor<" + type + ">, " + std::to_string(rank) + ")", method, rank);
+  p.run(std::vector<long>({16, 32, 64, 128, 256}));
+}
+
+int main(int argc, char **argv)
+{
+  po::variables_map vm;
+  try
+  {
+    po::options_description desc("Tensor decompositions\n"
+                                 "Allowed options");
+    desc.add_options()("help,h", "produce help message");
+    desc.add_options()("type,t", po::value<std::string>(), "select value-type (float, double)");
+    desc.add_options()("method,m", po::value<std::string>(), "select decomposition (hosvd, hooi, cp_als)");
+    desc.add_options()("rank,r", po::value<std::size_t>(), "select rank of the synthetic tensor (default 8)");
+
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.count("help"))
+    {
+      std::cout << desc << std::endl;
+      return 0;
+    }
+  }
+  catch(std::exception &e)
+  {
+    std::cerr << "error: " << e.what() << std::endl;
+    return 1;
+  }
+  std::string type = vm.count("type") ? vm["type"].as<std::string>() : "double";
+  std::string method = vm.count("method") ? vm["method"].as<std::string>() : "hooi";
+  std::size_t rank = vm.count("rank") ? vm["rank"].as<std::size_t>() : 8;
+  if (method != "hosvd" && method != "hooi" && method != "cp_als")
+    std::cerr << "unsupported decomposition \"" << method << '\"' << std::endl;
+  else if (type == "float")
+    benchmark<float>("float", method, rank);
+  else if (type == "double")
+    benchmark<double>("double", method, rank);
+  else
+    std::cerr << "unsupported value-type \"" << vm["type"].as<std::string>() << '\"' << std::endl;
+}
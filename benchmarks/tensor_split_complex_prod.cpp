@@ -0,0 +1,104 @@
+//
+// Copyright (c) 2019
+// The Boost.uBLAS developers
+//
+// This file is part of Boost.uBLAS. It is made available under the
+// Boost Software License, Version 1.0.
+// (Consult LICENSE or http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/numeric/ublas/tensor.hpp>
+#include <boost/program_options.hpp>
+#include "benchmark.hpp"
+#include <complex>
+#include <cstdlib>
+#include <string>
+
+namespace boost { namespace numeric { namespace ublas { namespace benchmark {
+
+// Contraction of the last two modes of an n x n x n complex tensor with the
+// first two modes of another, stored with interleaved complex elements or
+// with split real and imaginary planes.
+template <typename T>
+class tensor_split_complex_prod : public benchmark
+{
+  using value_type = std::complex<T>;
+  using tensor_type = tensor<value_type>;
+  using split_type = split_complex_tensor<T>;
+public:
+  tensor_split_complex_prod(std::string const &name, std::string const &method)
+    : benchmark(name), method_(method) {}
+  virtual void setup(long l)
+  {
+    auto const n = std::size_t(l);
+    a = tensor_type(shape{n, n, n});
+    b = tensor_type(shape{n, n, n});
+    for (std::size_t i = 0; i != a.size(); ++i)
+    {
+      a[i] = value_type(std::rand() % 200, std::rand() % 200);
+      b[i] = value_type(std::rand() % 200, std::rand() % 200);
+    }
+    sa = split_type(a);
+    sb = split_type(b);
+  }
+  virtual void operation(long)
+  {
+    if (method_ == "split")
+      sc = prod(sa, sb, {2, 3}, {1, 2});
+    else
+      c = prod(a, b, {2, 3}, {1, 2});
+  }
+private:
+  std::string method_;
+  tensor_type a, b, c;
+  split_type sa, sb, sc;
+};
+
+}}}}
+
+namespace po = boost::program_options;
+namespace ublas = boost::numeric::ublas;
+namespace bm = boost::numeric::ublas::benchmark;
+
+template <typename T>
+void benchmark(std::string const &type, std::string const &method)
+{
+  bm::tensor_split_complex_prod<T> p(method + "(tensor<complex<" + type + ">>)", method);
+  p.run(std::vector<long>({8, 16, 32, 64, 96, 128}));
+}
+
+int main(int argc, char **argv)
+{
+  po::variables_map vm;
+  try
+  {
+    po::options_description desc("Complex tensor contraction\n"
+                                 "Allowed options");
+    desc.add_options()("help,h", "produce help message");
+    desc.add_options()("type,t", po::value<std::string>(), "select value-type of the real and imaginary parts (float, double)");
+    desc.add_options()("method,m", po::value<std::string>(), "select interleaved or split-complex storage (interleaved, split)");
+
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.count("help"))
+    {
+      std::cout << desc << std::endl;
+      return 0;
+    }
+  }
+  catch(std::exception &e)
+  {
+    std::cerr << "error: " << e.what() << std::endl;
+    return 1;
+  }
+  std::string type = vm.count("type") ? vm["type"].as<std::string>() : "float";
+  std::string method = vm.count("method") ? vm["method"].as<std::string>() : "split";
+  if (method != "interleaved" && method != "split")
+    std::cerr << "unsupported method \"" << method << '\"' << std::endl;
+  else if (type == "float")
+    benchmark<float>("float", method);
+  else if (type == "double")
+    benchmark<double>("double", method);
+  else
+    std::cerr << "unsupported value-type \"" << vm["type"].as<std::string>() << '\"' << std::endl;
+}
@@ -33,7 +33,7 @@ int main()
 		auto B1 = matrix_t(n[1],n[2],2);
 		auto v1 = tensor_t(shape{n[0],1},2);
 		auto v2 = tensor_t(shape{n[1],1},2);
-//		auto v3 = tensor_t(shape{n[2],1},2);
+		auto v3 = tensor_t(shape{n[2],1},2);
 
 		// C1(j,k) = B1(j,k) + A(i,j,k)*v1(i);
 		// tensor_t C1 = B1 + prod(A,vector_t(n[0],1),1);
@@ -43,10 +43,9 @@ int main()
 		//tensor_t C2 = prod(A,vector_t(n[1],1),2) + 4;
 //		tensor_t C2 = A(_,_i,_) * v2(_i,_) + 4;
 
-		// not yet implemented!
-		// C3() = A(i,j,k)*T1(i)*T2(j)*T2(k);		
+		// C3() = A(i,j,k)*v1(i)*v2(j)*v3(k);
 		// tensor_t C3 = prod(prod(prod(A,v1,1),v2,1),v3,1);
-		// tensor_t C3 = A(_i,_j,_k) * v1(_i,_) * v2(_j,_) * v3(_k,_);
+		tensor_t C3 = einsum(A(_i,_j,_k), v1(_i,_), v2(_j,_), v3(_k,_));
 
 		// formatted output
 		std::cout << "% --------------------------- " << std::endl;
@@ -60,6 +59,12 @@ int main()
 		std::cout << "% C2(i,k) = A(i,j,k)*v2(j) + 4;" << std::endl << std::endl;
 //		std::cout << "C2=" << C2 << ";" << std::endl << std::endl;
 
+		// formatted output
+		std::cout << "% --------------------------- " << std::endl;
+		std::cout << "% --------------------------- " << std::endl << std::endl;
+		std::cout << "% C3() = A(i,j,k)*v1(i)*v2(j)*v3(k);" << std::endl << std::endl;
+		std::cout << "C3=" << C3 << ";" << std::endl << std::endl;
+
 	}
 
 
@@ -82,7 +87,10 @@ int main()
 //		tensor_t C2 =  A(_,_j,_) * B2(_,_j) + 4;
 
 		// C3(i,l1,l2) = A(i,j,k)*T1(l1,j)*T2(l2,k);
-		// not yet implemented.
+		// tensor_t C3 = prod(prod(A,T1,2),T2,3);
+		auto T1 = tensor_t(shape{m,n[1]},2);
+		auto T2 = tensor_t(shape{m,n[2]},2);
+		tensor_t C3 = einsum(A(_,_j,_k), T1(_,_j), T2(_,_k));
 
 		// formatted output
 		std::cout << "% --------------------------- " << std::endl;
@@ -96,11 +104,11 @@ int main()
 		std::cout << "% C2(i,l,k) = A(i,j,k)*B2(l,j) + 4;" << std::endl << std::endl;
 //		std::cout << "C2=" << C2 << ";" << std::endl << std::endl;
 
-//		// formatted output
-//		std::cout << "% --------------------------- " << std::endl;
-//		std::cout << "% --------------------------- " << std::endl << std::endl;
-//		std::cout << "% C3(i,l1,l2) = A(i,j,k)*T1(l1,j)*T2(l2,k);" << std::endl << std::endl;
-//		std::cout << "C3=" << C3 << ";" << std::endl << std::endl;
+		// formatted output
+		std::cout << "% --------------------------- " << std::endl;
+		std::cout << "% --------------------------- " << std::endl << std::endl;
+		std::cout << "% C3(i,l1,l2) = A(i,j,k)*T1(l1,j)*T2(l2,k);" << std::endl << std::endl;
+		std::cout << "C3=" << C3 << ";" << std::endl << std::endl;
 	}
 
 
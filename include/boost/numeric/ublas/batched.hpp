@@ -0,0 +1,674 @@
+//
+//  Copyright (c) 2019
+//  The Boost.uBLAS developers
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef _BOOST_UBLAS_BATCHED_
+#define _BOOST_UBLAS_BATCHED_
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/type_traits/remove_const.hpp>
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/exception.hpp>
+#include <boost/numeric/ublas/operation_fixed.hpp>
+
+/** \file batched.hpp
+ *  \brief Batches of many small matrices and vectors of the same shape.
+ *
+ * A \c batched_matrix holds \c batch matrices of size M x N as blocks
+ * of \c batched_block matrices, each block a structure of arrays: element
+ * (i, j) of the matrices of a block is one contiguous array indexed by
+ * the matrix. The kernels below run their innermost loops across the
+ * matrices of a block, where the compiler vectorizes them, instead of
+ * across the few elements of one matrix, and a block is small enough
+ * to stay in cache and read in one stream. The blocks are spread over
+ * OpenMP threads above \c BOOST_UBLAS_PARALLEL_THRESHOLD elements.
+ */
+
+namespace boost { namespace numeric { namespace ublas {
+
+    // Matrices of a block of a batch
+    const std::size_t batched_block = 16;
+
+namespace detail {
+
+    BOOST_UBLAS_INLINE
+    std::size_t batched_blocks (std::size_t batch) {
+        return (batch + batched_block - 1) / batched_block;
+    }
+
+}
+
+    /** \brief A batch of M x N dense matrices stored as blocks of structures of arrays.
+     *
+     * Element (i, j) of matrix \c b is at
+     * <tt>data () [((b / batched_block * M + i) * N + j) * batched_block + b % batched_block]</tt>,
+     * the last block padded to \c batched_block matrices.
+     */
+    template<class T, std::size_t M, std::size_t N, class A = unbounded_array<T> >
+    class batched_matrix {
+    public:
+        typedef typename A::size_type size_type;
+        typedef T value_type;
+        typedef const T &const_reference;
+        typedef T &reference;
+        typedef const T *const_pointer;
+        typedef T *pointer;
+        typedef A array_type;
+
+        // Construction and destruction
+        BOOST_UBLAS_INLINE
+        batched_matrix ():
+            batch_ (0), data_ () {}
+        BOOST_UBLAS_INLINE
+        explicit batched_matrix (size_type batch):
+            batch_ (batch), data_ (M * N * batched_block * detail::batched_blocks (batch)) {}
+        BOOST_UBLAS_INLINE
+        batched_matrix (size_type batch, const value_type &init):
+            batch_ (batch), data_ (M * N * batched_block * detail::batched_blocks (batch), init) {}
+#ifdef BOOST_UBLAS_CPP_GE_2011
+        template<class L, class A2>
+        explicit batched_matrix (const std::vector<fixed_matrix<T, M, N, L, A2> > &ms):
+            batch_ (0), data_ () {
+            assign (ms);
+        }
+#endif
+
+        // Accessors
+        BOOST_UBLAS_INLINE
+        size_type batch () const {
+            return batch_;
+        }
+        BOOST_UBLAS_INLINE
+        BOOST_CONSTEXPR size_type size1 () const {
+            return M;
+        }
+        BOOST_UBLAS_INLINE
+        BOOST_CONSTEXPR size_type size2 () const {
+            return N;
+        }
+
+        // Storage accessors
+        BOOST_UBLAS_INLINE
+        const array_type &data () const {
+            return data_;
+        }
+        BOOST_UBLAS_INLINE
+        array_type &data () {
+            return data_;
+        }
+        // Block h of the batch
+        BOOST_UBLAS_INLINE
+        const_pointer block_data (size_type h) const {
+            return data_.begin () + h * M * N * batched_block;
+        }
+        BOOST_UBLAS_INLINE
+        pointer block_data (size_type h) {
+            return data_.begin () + h * M * N * batched_block;
+        }
+
+        // Resizing, the elements are not preserved
+        BOOST_UBLAS_INLINE
+        void resize (size_type batch) {
+            batch_ = batch;
+            data_.resize (M * N * batched_block * detail::batched_blocks (batch));
+        }
+
+        // Element access
+        BOOST_UBLAS_INLINE
+        const_reference operator () (size_type b, size_type i, size_type j) const {
+            BOOST_UBLAS_CHECK (b < batch_, bad_index ());
+            BOOST_UBLAS_CHECK (i < M, bad_index ());
+            BOOST_UBLAS_CHECK (j < N, bad_index ());
+            return block_data (b / batched_block) [(i * N + j) * batched_block + b % batched_block];
+        }
+        BOOST_UBLAS_INLINE
+        reference operator () (size_type b, size_type i, size_type j) {
+            BOOST_UBLAS_CHECK (b < batch_, bad_index ());
+            BOOST_UBLAS_CHECK (i < M, bad_index ());
+            BOOST_UBLAS_CHECK (j < N, bad_index ());
+            return block_data (b / batched_block) [(i * N + j) * batched_block + b % batched_block];
+        }
+
+        BOOST_UBLAS_INLINE
+        void clear () {
+            std::fill (data_.begin (), data_.end (), value_type/*zero*/());
+        }
+
+#ifdef BOOST_UBLAS_CPP_GE_2011
+        // Conversion from and to one fixed_matrix per element of the batch
+        template<class L, class A2>
+        void assign (const std::vector<fixed_matrix<T, M, N, L, A2> > &ms) {
+            resize (ms.size ());
+            for (size_type b = 0; b < batch_; ++ b)
+                for (size_type i = 0; i < M; ++ i)
+                    for (size_type j = 0; j < N; ++ j)
+                        (*this) (b, i, j) = ms [b] (i, j);
+        }
+        template<class L, class A2>
+        void copy_to (std::vector<fixed_matrix<T, M, N, L, A2> > &ms) const {
+            ms.resize (batch_);
+            for (size_type b = 0; b < batch_; ++ b)
+                for (size_type i = 0; i < M; ++ i)
+                    for (size_type j = 0; j < N; ++ j)
+                        ms [b] (i, j) = (*this) (b, i, j);
+        }
+#endif
+
+    private:
+        size_type batch_;
+        array_type data_;
+    };
+
+    /** \brief A batch of dense vectors of size N stored as blocks of structures of arrays.
+     *
+     * Element i of vector \c b is at
+     * <tt>data () [(b / batched_block * N + i) * batched_block + b % batched_block]</tt>,
+     * the layout of a batch of N x 1 matrices.
+     */
+    template<class T, std::size_t N, class A = unbounded_array<T> >
+    class batched_vector {
+    public:
+        typedef typename A::size_type size_type;
+        typedef T value_type;
+        typedef const T &const_reference;
+        typedef T &reference;
+        typedef const T *const_pointer;
+        typedef T *pointer;
+        typedef A array_type;
+
+        // Construction and destruction
+        BOOST_UBLAS_INLINE
+        batched_vector ():
+            batch_ (0), data_ () {}
+        BOOST_UBLAS_INLINE
+        explicit batched_vector (size_type batch):
+            batch_ (batch), data_ (N * batched_block * detail::batched_blocks (batch)) {}
+        BOOST_UBLAS_INLINE
+        batched_vector (size_type batch, const value_type &init):
+            batch_ (batch), data_ (N * batched_block * detail::batched_blocks (batch), init) {}
+#ifdef BOOST_UBLAS_CPP_GE_2011
+        template<class A2>
+        explicit batched_vector (const std::vector<fixed_vector<T, N, A2> > &vs):
+            batch_ (0), data_ () {
+            assign (vs);
+        }
+#endif
+
+        // Accessors
+        BOOST_UBLAS_INLINE
+        size_type batch () const {
+            return batch_;
+        }
+        BOOST_UBLAS_INLINE
+        BOOST_CONSTEXPR size_type size () const {
+            return N;
+        }
+
+        // Storage accessors
+        BOOST_UBLAS_INLINE
+        const array_type &data () const {
+            return data_;
+        }
+        BOOST_UBLAS_INLINE
+        array_type &data () {
+            return data_;
+        }
+        // Block h of the batch
+        BOOST_UBLAS_INLINE
+        const_pointer block_data (size_type h) const {
+            return data_.begin () + h * N * batched_block;
+        }
+        BOOST_UBLAS_INLINE
+        pointer block_data (size_type h) {
+            return data_.begin () + h * N * batched_block;
+        }
+
+        // Resizing, the elements are not preserved
+        BOOST_UBLAS_INLINE
+        void resize (size_type batch) {
+            batch_ = batch;
+            data_.resize (N * batched_block * detail::batched_blocks (batch));
+        }
+
+        // Element access
+        BOOST_UBLAS_INLINE
+        const_reference operator () (size_type b, size_type i) const {
+            BOOST_UBLAS_CHECK (b < batch_, bad_index ());
+            BOOST_UBLAS_CHECK (i < N, bad_index ());
+            return block_data (b / batched_block) [i * batched_block + b % batched_block];
+        }
+        BOOST_UBLAS_INLINE
+        reference operator () (size_type b, size_type i) {
+            BOOST_UBLAS_CHECK (b < batch_, bad_index ());
+            BOOST_UBLAS_CHECK (i < N, bad_index ());
+            return block_data (b / batched_block) [i * batched_block + b % batched_block];
+        }
+
+        BOOST_UBLAS_INLINE
+        void clear () {
+            std::fill (data_.begin (), data_.end (), value_type/*zero*/());
+        }
+
+#ifdef BOOST_UBLAS_CPP_GE_2011
+        // Conversion from and to one fixed_vector per element of the batch
+        template<class A2>
+        void assign (const std::vector<fixed_vector<T, N, A2> > &vs) {
+            resize (vs.size ());
+            for (size_type b = 0; b < batch_; ++ b)
+                for (size_type i = 0; i < N; ++ i)
+                    (*this) (b, i) = vs [b] (i);
+        }
+        template<class A2>
+        void copy_to (std::vector<fixed_vector<T, N, A2> > &vs) const {
+            vs.resize (batch_);
+            for (size_type b = 0; b < batch_; ++ b)
+                for (size_type i = 0; i < N; ++ i)
+                    vs [b] (i) = (*this) (b, i);
+        }
+#endif
+
+    private:
+        size_type batch_;
+        array_type data_;
+    };
+
+    /** \brief The row interchanges of the LU factorizations of a batch.
+     *
+     * <tt>(b, k)</tt> is the row swapped with row k at step k of the
+     * factorization of matrix \c b, as <tt>pm (k)</tt> of a \c permutation_matrix.
+     * Stored in blocks as a \c batched_vector.
+     */
+    template<std::size_t N, class A = unbounded_array<std::size_t> >
+    class batched_permutation {
+    public:
+        typedef typename A::size_type size_type;
+        typedef A array_type;
+
+        BOOST_UBLAS_INLINE
+        batched_permutation ():
+            batch_ (0), data_ () {}
+        explicit batched_permutation (size_type batch):
+            batch_ (batch), data_ (N * batched_block * detail::batched_blocks (batch)) {
+            for (size_type b = 0; b < batch; ++ b)
+                for (size_type k = 0; k < N; ++ k)
+                    (*this) (b, k) = k;
+        }
+
+        BOOST_UBLAS_INLINE
+        size_type batch () const {
+            return batch_;
+        }
+        BOOST_UBLAS_INLINE
+        BOOST_CONSTEXPR size_type size () const {
+            return N;
+        }
+
+        BOOST_UBLAS_INLINE
+        const size_type *block_data (size_type h) const {
+            return data_.begin () + h * N * batched_block;
+        }
+        BOOST_UBLAS_INLINE
+        size_type *block_data (size_type h) {
+            return data_.begin () + h * N * batched_block;
+        }
+
+        BOOST_UBLAS_INLINE
+        size_type operator () (size_type b, size_type k) const {
+            BOOST_UBLAS_CHECK (b < batch_, bad_index ());
+            BOOST_UBLAS_CHECK (k < N, bad_index ());
+            return block_data (b / batched_block) [k * batched_block + b % batched_block];
+        }
+        BOOST_UBLAS_INLINE
+        size_type &operator () (size_type b, size_type k) {
+            BOOST_UBLAS_CHECK (b < batch_, bad_index ());
+            BOOST_UBLAS_CHECK (k < N, bad_index ());
+            return block_data (b / batched_block) [k * batched_block + b % batched_block];
+        }
+
+    private:
+        size_type batch_;
+        array_type data_;
+    };
+
+namespace detail {
+
+    // The kernels work on the first size matrices of one block. Element
+    // (i, j) of an operand with n columns is the array at (i * n + j) * batched_block.
+
+    // Matrices of the last block of a batch
+    BOOST_UBLAS_INLINE
+    std::size_t batched_block_size (std::size_t batch, std::size_t h) {
+        return (std::min) (batch - h * batched_block, batched_block);
+    }
+
+    // C = A B for M x K and K x N matrices. A row of C is accumulated in
+    // registers across the lanes, each element summed in the order of the
+    // generic evaluation.
+    template<std::size_t M, std::size_t N, std::size_t K, class T>
+    void batched_matrix_prod (T *BOOST_UBLAS_RESTRICT c, const T *BOOST_UBLAS_RESTRICT a, const T *BOOST_UBLAS_RESTRICT b,
+                              std::size_t size) {
+        const std::size_t s = batched_block;
+        for (std::size_t i = 0; i < M; ++ i) {
+            const T *ai = a + i * K * s;
+            T *ci = c + i * N * s;
+            for (std::size_t l = 0; l < size; ++ l) {
+                T t [N];
+                for (std::size_t j = 0; j < N; ++ j)
+                    t [j] = T/*zero*/();
+                for (std::size_t p = 0; p < K; ++ p) {
+                    T aip (ai [p * s + l]);
+                    for (std::size_t j = 0; j < N; ++ j)
+                        t [j] += aip * b [(p * N + j) * s + l];
+                }
+                for (std::size_t j = 0; j < N; ++ j)
+                    ci [j * s + l] = t [j];
+            }
+        }
+    }
+
+    // Partial pivoting on the largest element by norm_inf, the first one
+    // on ties, as lu_factorize. Returns 1 + the first lane of the block
+    // whose matrix is singular, or 0.
+    template<class T>
+    std::size_t batched_lu_factorize (T *a, std::size_t *pm, std::size_t n, std::size_t size) {
+        typedef typename type_traits<T>::real_type real_type;
+        const std::size_t s = batched_block;
+        real_type t_max [batched_block];
+        T m_inv [batched_block];
+        bool singular [batched_block];
+        std::fill (singular, singular + size, false);
+        for (std::size_t k = 0; k < n; ++ k) {
+            std::size_t *pk = pm + k * s;
+            const T *akk = a + (k * n + k) * s;
+            for (std::size_t l = 0; l < size; ++ l) {
+                pk [l] = k;
+                t_max [l] = type_traits<T>::norm_inf (akk [l]);
+            }
+            for (std::size_t i = k + 1; i < n; ++ i) {
+                const T *aik = a + (i * n + k) * s;
+                for (std::size_t l = 0; l < size; ++ l) {
+                    real_type u (type_traits<T>::norm_inf (aik [l]));
+                    if (u > t_max [l]) {
+                        t_max [l] = u;
+                        pk [l] = i;
+                    }
+                }
+            }
+            for (std::size_t i = k + 1; i < n; ++ i)
+                for (std::size_t j = 0; j < n; ++ j) {
+                    T *akj = a + (k * n + j) * s;
+                    T *aij = a + (i * n + j) * s;
+                    for (std::size_t l = 0; l < size; ++ l)
+                        if (pk [l] == i)
+                            std::swap (akj [l], aij [l]);
+                }
+            // A zero pivot leaves its column unscaled
+            for (std::size_t l = 0; l < size; ++ l) {
+                bool zero (akk [l] == T/*zero*/());
+                singular [l] = singular [l] || zero;
+                m_inv [l] = zero ? T (1) : T (1) / akk [l];
+            }
+            for (std::size_t i = k + 1; i < n; ++ i) {
+                T *aik = a + (i * n + k) * s;
+                for (std::size_t l = 0; l < size; ++ l)
+                    aik [l] *= m_inv [l];
+                for (std::size_t j = k + 1; j < n; ++ j) {
+                    T *aij = a + (i * n + j) * s;
+                    const T *akj = a + (k * n + j) * s;
+                    for (std::size_t l = 0; l < size; ++ l)
+                        aij [l] -= aik [l] * akj [l];
+                }
+            }
+        }
+        for (std::size_t l = 0; l < size; ++ l)
+            if (singular [l])
+                return l + 1;
+        return 0;
+    }
+
+    // Solves L U X = P B in place for the n x m right hand sides B,
+    // column by column of L and U
+    template<class T>
+    void batched_lu_substitute (const T *lu, const std::size_t *pm, T *x,
+                                std::size_t n, std::size_t m, std::size_t size) {
+        const std::size_t s = batched_block;
+        for (std::size_t k = 0; k < n; ++ k) {
+            const std::size_t *pk = pm + k * s;
+            for (std::size_t i = k + 1; i < n; ++ i)
+                for (std::size_t j = 0; j < m; ++ j) {
+                    T *xkj = x + (k * m + j) * s;
+                    T *xij = x + (i * m + j) * s;
+                    for (std::size_t l = 0; l < size; ++ l)
+                        if (pk [l] == i)
+                            std::swap (xkj [l], xij [l]);
+                }
+        }
+        for (std::size_t j = 0; j < m; ++ j) {
+            for (std::size_t k = 0; k < n; ++ k) {
+                const T *xk = x + (k * m + j) * s;
+                for (std::size_t i = k + 1; i < n; ++ i) {
+                    const T *lik = lu + (i * n + k) * s;
+                    T *xi = x + (i * m + j) * s;
+                    for (std::size_t l = 0; l < size; ++ l)
+                        xi [l] -= lik [l] * xk [l];
+                }
+            }
+            for (std::size_t k = n; k-- > 0;) {
+                const T *ukk = lu + (k * n + k) * s;
+                T *xk = x + (k * m + j) * s;
+                for (std::size_t l = 0; l < size; ++ l)
+                    xk [l] /= ukk [l];
+                for (std::size_t i = 0; i < k; ++ i) {
+                    const T *uik = lu + (i * n + k) * s;
+                    T *xi = x + (i * m + j) * s;
+                    for (std::size_t l = 0; l < size; ++ l)
+                        xi [l] -= uik [l] * xk [l];
+                }
+            }
+        }
+    }
+
+}
+
+    /** \brief C = A B for every matrix of the batch.
+     *
+     * \c c is resized to the batch and must not be \c a or \c b.
+     */
+    template<class T, std::size_t M, std::size_t K, std::size_t N, class A1, class A2, class A3>
+    batched_matrix<T, M, N, A3> &
+    batched_prod (const batched_matrix<T, M, K, A1> &a, const batched_matrix<T, K, N, A2> &b,
+                  batched_matrix<T, M, N, A3> &c) {
+        BOOST_UBLAS_CHECK (a.batch () == b.batch (), bad_size ());
+        std::size_t batch (a.batch ());
+        c.resize (batch);
+        std::ptrdiff_t blocks (detail::batched_blocks (batch));
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel for schedule (static) if (batch * M * N >= BOOST_UBLAS_PARALLEL_THRESHOLD)
+#endif
+        for (std::ptrdiff_t h = 0; h < blocks; ++ h)
+            detail::batched_matrix_prod<M, N, K> (c.block_data (h), a.block_data (h), b.block_data (h),
+                                                  detail::batched_block_size (batch, h));
+        return c;
+    }
+
+    /** \brief y = A x for every matrix and vector of the batch.
+     *
+     * \c y is resized to the batch and must not be \c x.
+     */
+    template<class T, std::size_t M, std::size_t N, class A1, class A2, class A3>
+    batched_vector<T, M, A3> &
+    batched_prod (const batched_matrix<T, M, N, A1> &a, const batched_vector<T, N, A2> &x,
+                  batched_vector<T, M, A3> &y) {
+        BOOST_UBLAS_CHECK (a.batch () == x.batch (), bad_size ());
+        std::size_t batch (a.batch ());
+        y.resize (batch);
+        std::ptrdiff_t blocks (detail::batched_blocks (batch));
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel for schedule (static) if (batch * M * N >= BOOST_UBLAS_PARALLEL_THRESHOLD)
+#endif
+        for (std::ptrdiff_t h = 0; h < blocks; ++ h)
+            detail::batched_matrix_prod<M, 1, N> (y.block_data (h), a.block_data (h), x.block_data (h),
+                                                  detail::batched_block_size (batch, h));
+        return y;
+    }
+
+    /** \brief LU factorization with partial pivoting of every matrix of the batch.
+     *
+     * Same factors and row interchanges as \c lu_factorize for each
+     * matrix. Returns 1 + the first matrix of the batch that is singular,
+     * or 0 if none is.
+     */
+    template<class T, std::size_t N, class A, class PA>
+    std::size_t batched_lu_factorize (batched_matrix<T, N, N, A> &a, batched_permutation<N, PA> &pm) {
+        BOOST_UBLAS_CHECK (a.batch () == pm.batch (), bad_size ());
+        std::size_t batch (a.batch ());
+        std::ptrdiff_t blocks (detail::batched_blocks (batch));
+        std::vector<std::size_t> singular (blocks);
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel for schedule (static) if (batch * N * N >= BOOST_UBLAS_PARALLEL_THRESHOLD)
+#endif
+        for (std::ptrdiff_t h = 0; h < blocks; ++ h)
+            singular [h] = detail::batched_lu_factorize (a.block_data (h), pm.block_data (h),
+                                                         N, detail::batched_block_size (batch, h));
+        for (std::ptrdiff_t h = 0; h < blocks; ++ h)
+            if (singular [h])
+                return h * batched_block + singular [h];
+        return 0;
+    }
+
+    /** \brief Solves A x = b in place for every matrix of the batch,
+     * given the factorization of \c batched_lu_factorize.
+     */
+    template<class T, std::size_t N, class A, class PA, class A2>
+    void batched_lu_substitute (const batched_matrix<T, N, N, A> &lu, const batched_permutation<N, PA> &pm,
+                                batched_vector<T, N, A2> &x) {
+        BOOST_UBLAS_CHECK (lu.batch () == pm.batch (), bad_size ());
+        BOOST_UBLAS_CHECK (lu.batch () == x.batch (), bad_size ());
+        std::size_t batch (lu.batch ());
+        std::ptrdiff_t blocks (detail::batched_blocks (batch));
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel for schedule (static) if (batch * N * N >= BOOST_UBLAS_PARALLEL_THRESHOLD)
+#endif
+        for (std::ptrdiff_t h = 0; h < blocks; ++ h)
+            detail::batched_lu_substitute (lu.block_data (h), pm.block_data (h), x.block_data (h),
+                                           N, 1, detail::batched_block_size (batch, h));
+    }
+
+    /** \brief Solves A X = B in place for every matrix of the batch,
+     * given the factorization of \c batched_lu_factorize.
+     */
+    template<class T, std::size_t N, std::size_t M, class A, class PA, class A2>
+    void batched_lu_substitute (const batched_matrix<T, N, N, A> &lu, const batched_permutation<N, PA> &pm,
+                                batched_matrix<T, N, M, A2> &x) {
+        BOOST_UBLAS_CHECK (lu.batch () == pm.batch (), bad_size ());
+        BOOST_UBLAS_CHECK (lu.batch () == x.batch (), bad_size ());
+        std::size_t batch (lu.batch ());
+        std::ptrdiff_t blocks (detail::batched_blocks (batch));
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel for schedule (static) if (batch * N * N >= BOOST_UBLAS_PARALLEL_THRESHOLD)
+#endif
+        for (std::ptrdiff_t h = 0; h < blocks; ++ h)
+            detail::batched_lu_substitute (lu.block_data (h), pm.block_data (h), x.block_data (h),
+                                           N, M, detail::batched_block_size (batch, h));
+    }
+
+namespace detail {
+
+#ifdef BOOST_UBLAS_CPP_GE_2011
+    // A matrix of a block, for the cofactors of operation_fixed.hpp
+    template<class T, std::size_t N>
+    struct batched_lane {
+        typedef typename boost::remove_const<T>::type value_type;
+
+        BOOST_UBLAS_INLINE
+        T &operator () (std::size_t i, std::size_t j) const {
+            return data [(i * N + j) * batched_block];
+        }
+
+        T *data;
+    };
+
+    // The adjugate divided by the determinant for sizes 1 to 4. The
+    // determinants are checked after the loop over the lanes, for it to
+    // be vectorized. Returns whether a matrix of the block is singular.
+    template<std::size_t N, class T>
+    bool batched_inverse_cofactors (const T *BOOST_UBLAS_RESTRICT a, T *BOOST_UBLAS_RESTRICT ai, std::size_t size) {
+        T d [batched_block];
+        for (std::size_t l = 0; l < size; ++ l) {
+            const batched_lane<const T, N> al = {a + l};
+            const batched_lane<T, N> ail = {ai + l};
+            d [l] = fixed_cofactors<N>::adjugate (al, ail);
+            T d_inv = T (1) / d [l];
+            for (std::size_t k = 0; k < N * N; ++ k)
+                ai [k * batched_block + l] *= d_inv;
+        }
+        return std::find (d, d + size, T/*zero*/()) != d + size;
+    }
+
+    template<class T, std::size_t N, class A1, class A2>
+    batched_matrix<T, N, N, A2> &
+    batched_inverse (const batched_matrix<T, N, N, A1> &a, batched_matrix<T, N, N, A2> &ai, boost::true_type) {
+        std::size_t batch (a.batch ());
+        ai.resize (batch);
+        std::ptrdiff_t blocks (batched_blocks (batch));
+        bool singular = false;
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel for schedule (static) reduction (|| : singular) if (batch * N * N >= BOOST_UBLAS_PARALLEL_THRESHOLD)
+#endif
+        for (std::ptrdiff_t h = 0; h < blocks; ++ h)
+            singular = batched_inverse_cofactors<N> (a.block_data (h), ai.block_data (h),
+                                                     batched_block_size (batch, h)) || singular;
+        if (singular)
+            ublas::singular ().raise ();
+        return ai;
+    }
+#endif
+
+    template<class T, std::size_t N, class A1, class A2>
+    batched_matrix<T, N, N, A2> &
+    batched_inverse (const batched_matrix<T, N, N, A1> &a, batched_matrix<T, N, N, A2> &ai, boost::false_type) {
+        std::size_t batch (a.batch ());
+        batched_matrix<T, N, N> lu (batch);
+        std::copy (a.data ().begin (), a.data ().end (), lu.data ().begin ());
+        batched_permutation<N> pm (batch);
+        if (batched_lu_factorize (lu, pm) != 0)
+            singular ().raise ();
+        ai.resize (batch);
+        ai.clear ();
+        for (std::size_t b = 0; b < batch; ++ b)
+            for (std::size_t k = 0; k < N; ++ k)
+                ai (b, k, k) = T (1);
+        batched_lu_substitute (lu, pm, ai);
+        return ai;
+    }
+
+}
+
+    /** \brief Inverse of every matrix of the batch.
+     *
+     * In closed form from the cofactors up to size 4 as \c inverse of
+     * operation_fixed.hpp, else solved against the identity with the LU
+     * factorization of a copy of \c a. Throws \c singular if a matrix
+     * of the batch is. \c ai must not be \c a.
+     */
+    template<class T, std::size_t N, class A1, class A2>
+    batched_matrix<T, N, N, A2> &
+    batched_inverse (const batched_matrix<T, N, N, A1> &a, batched_matrix<T, N, N, A2> &ai) {
+#ifdef BOOST_UBLAS_CPP_GE_2011
+        return detail::batched_inverse (a, ai, boost::integral_constant<bool, (N <= 4)> ());
+#else
+        return detail::batched_inverse (a, ai, boost::false_type ());
+#endif
+    }
+
+}}}
+
+#endif
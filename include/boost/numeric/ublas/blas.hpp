@@ -11,6 +11,7 @@
 #define _BOOST_UBLAS_BLAS_
 
 #include <boost/numeric/ublas/traits.hpp>
+#include <boost/numeric/ublas/detail/blas_backend.hpp>
 
 namespace boost { namespace numeric { namespace ublas {
     
@@ -222,6 +223,11 @@ namespace boost { namespace numeric { namespace ublas {
         template<class V1, class T1, class T2, class M, class V2>
         V1 & gmv (V1 &v1, const T1 &t1, const T2 &t2, const M &m, const V2 &v2) 
     {
+#ifdef BOOST_UBLAS_USE_CBLAS
+            typedef typename V1::value_type value_type;
+            if (detail::blas_matrix_vector_prod<V1, M, V2>::apply_checked (v1, m, v2, value_type (t2), value_type (t1), false))
+                return v1;
+#endif
             return v1 = t1 * v1 + t2 * prod (m, v2);
         }
 
@@ -402,6 +408,11 @@ namespace boost { namespace numeric { namespace ublas {
         template<class M1, class T1, class T2, class M2, class M3>
         M1 & gmm (M1 &m1, const T1 &t1, const T2 &t2, const M2 &m2, const M3 &m3) 
     {
+#ifdef BOOST_UBLAS_USE_CBLAS
+            typedef typename M1::value_type value_type;
+            if (detail::blas_matrix_matrix_prod<M1, M2, M3>::apply_checked (m1, m2, m3, value_type (t2), value_type (t1)))
+                return m1;
+#endif
             return m1 = t1 * m1 + t2 * prod (m2, m3);
         }
 
@@ -0,0 +1,550 @@
+//
+//  Copyright (c) 2019
+//  The Boost.uBLAS developers
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef _BOOST_UBLAS_BLAS_BACKEND_
+#define _BOOST_UBLAS_BLAS_BACKEND_
+
+#include <boost/numeric/ublas/detail/config.hpp>
+
+// Dense products and LU factorizations handed to an external CBLAS
+// (BOOST_UBLAS_USE_CBLAS) and LAPACK (BOOST_UBLAS_USE_LAPACK). Operands
+// are seen through the strided views of detail/raw.hpp, transposed and
+// conjugated through trans () and herm (). Each entry point returns false
+// for what the library cannot take, which is then evaluated by uBLAS.
+
+#if defined (BOOST_UBLAS_USE_CBLAS) || defined (BOOST_UBLAS_USE_LAPACK)
+
+#include <complex>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/type_traits/remove_const.hpp>
+#include <boost/numeric/ublas/functional.hpp>
+#include <boost/numeric/ublas/matrix_expression.hpp>
+#include <boost/numeric/ublas/storage.hpp>
+#include <boost/numeric/ublas/temporary_arena.hpp>
+#include <boost/numeric/ublas/detail/raw.hpp>
+#ifdef BOOST_UBLAS_USE_CBLAS
+#include <cblas.h>
+#endif
+
+namespace boost { namespace numeric { namespace ublas {
+namespace detail {
+
+    typedef BOOST_UBLAS_BLAS_INT blas_int;
+
+#ifdef BOOST_UBLAS_USE_LAPACK
+    // The Fortran interface, LAPACKE is not always installed
+    extern "C" {
+        void sgetrf_ (const blas_int *m, const blas_int *n, float *a, const blas_int *lda, blas_int *ipiv, blas_int *info);
+        void dgetrf_ (const blas_int *m, const blas_int *n, double *a, const blas_int *lda, blas_int *ipiv, blas_int *info);
+        void cgetrf_ (const blas_int *m, const blas_int *n, std::complex<float> *a, const blas_int *lda, blas_int *ipiv, blas_int *info);
+        void zgetrf_ (const blas_int *m, const blas_int *n, std::complex<double> *a, const blas_int *lda, blas_int *ipiv, blas_int *info);
+    }
+#endif
+
+    // The element types of the library
+    template<class T>
+    struct blas_types {
+        BOOST_STATIC_CONSTANT (bool, value = false);
+    };
+    template<>
+    struct blas_types<float> {
+        BOOST_STATIC_CONSTANT (bool, value = true);
+        BOOST_STATIC_CONSTANT (bool, complex = false);
+#ifdef BOOST_UBLAS_USE_CBLAS
+        static void gemm (CBLAS_ORDER order, CBLAS_TRANSPOSE ta, CBLAS_TRANSPOSE tb, blas_int m, blas_int n, blas_int k,
+                          float alpha, const float *a, blas_int lda, const float *b, blas_int ldb,
+                          float beta, float *c, blas_int ldc) {
+            cblas_sgemm (order, ta, tb, m, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
+        }
+        static void gemv (CBLAS_ORDER order, CBLAS_TRANSPOSE ta, blas_int m, blas_int n,
+                          float alpha, const float *a, blas_int lda, const float *x, blas_int incx,
+                          float beta, float *y, blas_int incy) {
+            cblas_sgemv (order, ta, m, n, alpha, a, lda, x, incx, beta, y, incy);
+        }
+        static void trsm (CBLAS_ORDER order, CBLAS_UPLO uplo, CBLAS_TRANSPOSE ta, CBLAS_DIAG diag, blas_int m, blas_int n,
+                          const float *a, blas_int lda, float *b, blas_int ldb) {
+            cblas_strsm (order, CblasLeft, uplo, ta, diag, m, n, 1.f, a, lda, b, ldb);
+        }
+        static void trsv (CBLAS_UPLO uplo, CBLAS_TRANSPOSE ta, CBLAS_DIAG diag, blas_int n,
+                          const float *a, blas_int lda, float *x, blas_int incx) {
+            cblas_strsv (CblasRowMajor, uplo, ta, diag, n, a, lda, x, incx);
+        }
+#endif
+#ifdef BOOST_UBLAS_USE_LAPACK
+        static void getrf (blas_int m, blas_int n, float *a, blas_int lda, blas_int *ipiv, blas_int &info) {
+            sgetrf_ (&m, &n, a, &lda, ipiv, &info);
+        }
+#endif
+    };
+    template<>
+    struct blas_types<double> {
+        BOOST_STATIC_CONSTANT (bool, value = true);
+        BOOST_STATIC_CONSTANT (bool, complex = false);
+#ifdef BOOST_UBLAS_USE_CBLAS
+        static void gemm (CBLAS_ORDER order, CBLAS_TRANSPOSE ta, CBLAS_TRANSPOSE tb, blas_int m, blas_int n, blas_int k,
+                          double alpha, const double *a, blas_int lda, const double *b, blas_int ldb,
+                          double beta, double *c, blas_int ldc) {
+            cblas_dgemm (order, ta, tb, m, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
+        }
+        static void gemv (CBLAS_ORDER order, CBLAS_TRANSPOSE ta, blas_int m, blas_int n,
+                          double alpha, const double *a, blas_int lda, const double *x, blas_int incx,
+                          double beta, double *y, blas_int incy) {
+            cblas_dgemv (order, ta, m, n, alpha, a, lda, x, incx, beta, y, incy);
+        }
+        static void trsm (CBLAS_ORDER order, CBLAS_UPLO uplo, CBLAS_TRANSPOSE ta, CBLAS_DIAG diag, blas_int m, blas_int n,
+                          const double *a, blas_int lda, double *b, blas_int ldb) {
+            cblas_dtrsm (order, CblasLeft, uplo, ta, diag, m, n, 1., a, lda, b, ldb);
+        }
+        static void trsv (CBLAS_UPLO uplo, CBLAS_TRANSPOSE ta, CBLAS_DIAG diag, blas_int n,
+                          const double *a, blas_int lda, double *x, blas_int incx) {
+            cblas_dtrsv (CblasRowMajor, uplo, ta, diag, n, a, lda, x, incx);
+        }
+#endif
+#ifdef BOOST_UBLAS_USE_LAPACK
+        static void getrf (blas_int m, blas_int n, double *a, blas_int lda, blas_int *ipiv, blas_int &info) {
+            dgetrf_ (&m, &n, a, &lda, ipiv, &info);
+        }
+#endif
+    };
+    template<>
+    struct blas_types<std::complex<float> > {
+        typedef std::complex<float> value_type;
+
+        BOOST_STATIC_CONSTANT (bool, value = true);
+        BOOST_STATIC_CONSTANT (bool, complex = true);
+#ifdef BOOST_UBLAS_USE_CBLAS
+        static void gemm (CBLAS_ORDER order, CBLAS_TRANSPOSE ta, CBLAS_TRANSPOSE tb, blas_int m, blas_int n, blas_int k,
+                          value_type alpha, const value_type *a, blas_int lda, const value_type *b, blas_int ldb,
+                          value_type beta, value_type *c, blas_int ldc) {
+            cblas_cgemm (order, ta, tb, m, n, k, &alpha, a, lda, b, ldb, &beta, c, ldc);
+        }
+        static void gemv (CBLAS_ORDER order, CBLAS_TRANSPOSE ta, blas_int m, blas_int n,
+                          value_type alpha, const value_type *a, blas_int lda, const value_type *x, blas_int incx,
+                          value_type beta, value_type *y, blas_int incy) {
+            cblas_cgemv (order, ta, m, n, &alpha, a, lda, x, incx, &beta, y, incy);
+        }
+        static void trsm (CBLAS_ORDER order, CBLAS_UPLO uplo, CBLAS_TRANSPOSE ta, CBLAS_DIAG diag, blas_int m, blas_int n,
+                          const value_type *a, blas_int lda, value_type *b, blas_int ldb) {
+            const value_type one (1);
+            cblas_ctrsm (order, CblasLeft, uplo, ta, diag, m, n, &one, a, lda, b, ldb);
+        }
+        static void trsv (CBLAS_UPLO uplo, CBLAS_TRANSPOSE ta, CBLAS_DIAG diag, blas_int n,
+                          const value_type *a, blas_int lda, value_type *x, blas_int incx) {
+            cblas_ctrsv (CblasRowMajor, uplo, ta, diag, n, a, lda, x, incx);
+        }
+#endif
+#ifdef BOOST_UBLAS_USE_LAPACK
+        static void getrf (blas_int m, blas_int n, value_type *a, blas_int lda, blas_int *ipiv, blas_int &info) {
+            cgetrf_ (&m, &n, a, &lda, ipiv, &info);
+        }
+#endif
+    };
+    template<>
+    struct blas_types<std::complex<double> > {
+        typedef std::complex<double> value_type;
+
+        BOOST_STATIC_CONSTANT (bool, value = true);
+        BOOST_STATIC_CONSTANT (bool, complex = true);
+#ifdef BOOST_UBLAS_USE_CBLAS
+        static void gemm (CBLAS_ORDER order, CBLAS_TRANSPOSE ta, CBLAS_TRANSPOSE tb, blas_int m, blas_int n, blas_int k,
+                          value_type alpha, const value_type *a, blas_int lda, const value_type *b, blas_int ldb,
+                          value_type beta, value_type *c, blas_int ldc) {
+            cblas_zgemm (order, ta, tb, m, n, k, &alpha, a, lda, b, ldb, &beta, c, ldc);
+        }
+        static void gemv (CBLAS_ORDER order, CBLAS_TRANSPOSE ta, blas_int m, blas_int n,
+                          value_type alpha, const value_type *a, blas_int lda, const value_type *x, blas_int incx,
+                          value_type beta, value_type *y, blas_int incy) {
+            cblas_zgemv (order, ta, m, n, &alpha, a, lda, x, incx, &beta, y, incy);
+        }
+        static void trsm (CBLAS_ORDER order, CBLAS_UPLO uplo, CBLAS_TRANSPOSE ta, CBLAS_DIAG diag, blas_int m, blas_int n,
+                          const value_type *a, blas_int lda, value_type *b, blas_int ldb) {
+            const value_type one (1);
+            cblas_ztrsm (order, CblasLeft, uplo, ta, diag, m, n, &one, a, lda, b, ldb);
+        }
+        static void trsv (CBLAS_UPLO uplo, CBLAS_TRANSPOSE ta, CBLAS_DIAG diag, blas_int n,
+                          const value_type *a, blas_int lda, value_type *x, blas_int incx) {
+            cblas_ztrsv (CblasRowMajor, uplo, ta, diag, n, a, lda, x, incx);
+        }
+#endif
+#ifdef BOOST_UBLAS_USE_LAPACK
+        static void getrf (blas_int m, blas_int n, value_type *a, blas_int lda, blas_int *ipiv, blas_int &info) {
+            zgetrf_ (&m, &n, a, &lda, ipiv, &info);
+        }
+#endif
+    };
+
+    // Element (i, j) of a matrix operand at data [i * stride1 + j * stride2],
+    // conjugated if conj
+    template<class T>
+    struct blas_matrix_arg {
+        BOOST_UBLAS_INLINE
+        blas_matrix_arg (const T *data, std::ptrdiff_t stride1, std::ptrdiff_t stride2, bool conj):
+            data_ (data), stride1_ (stride1), stride2_ (stride2), conj_ (conj) {}
+
+        const T *data_;
+        std::ptrdiff_t stride1_;
+        std::ptrdiff_t stride2_;
+        bool conj_;
+    };
+
+    // Strided matrices, trans () and herm () of strided matrices
+    template<class E>
+    struct blas_matrix_operand {
+        typedef raw::strided_matrix_traits<E> strided_traits;
+        typedef blas_matrix_arg<typename E::value_type> arg_type;
+
+        BOOST_STATIC_CONSTANT (bool, value = strided_traits::value);
+
+        static BOOST_UBLAS_INLINE
+        arg_type get (const E &e) {
+            return arg_type (strided_traits::data (e), strided_traits::stride1 (e), strided_traits::stride2 (e), false);
+        }
+    };
+    template<class E>
+    struct blas_matrix_operand<const E>:
+        public blas_matrix_operand<E> {};
+    template<class E, class T>
+    struct blas_matrix_operand<matrix_unary2<E, scalar_conj<T> > > {
+        typedef matrix_unary2<E, scalar_conj<T> > expression_type;
+        typedef typename boost::remove_const<typename expression_type::expression_closure_type>::type closure_type;
+        typedef raw::strided_matrix_traits<closure_type> strided_traits;
+        typedef blas_matrix_arg<T> arg_type;
+
+        BOOST_STATIC_CONSTANT (bool, value = strided_traits::value);
+
+        static BOOST_UBLAS_INLINE
+        arg_type get (const expression_type &e) {
+            const closure_type &c (e.expression ());
+            return arg_type (strided_traits::data (c), strided_traits::stride2 (c), strided_traits::stride1 (c),
+                             blas_types<T>::complex);
+        }
+    };
+
+    // Whether an m x n operand of strides s1, s2 is a row major array the
+    // library can index, and its leading dimension
+    inline
+    bool blas_row_major (std::ptrdiff_t s1, std::ptrdiff_t s2, std::size_t m, std::size_t n, blas_int &ld) {
+        const std::size_t int_max ((std::numeric_limits<blas_int>::max) ());
+        if (m > int_max || n > int_max || (n > 1 && s2 != 1))
+            return false;
+        // A single row has any leading dimension
+        std::ptrdiff_t l (m > 1 ? s1 : std::ptrdiff_t (n));
+        if (l < 1 || l < std::ptrdiff_t (n) || std::size_t (l) > int_max)
+            return false;
+        ld = blas_int (l);
+        return true;
+    }
+    // Increment of a vector operand, the library also takes negative ones
+    // but starts them from the other end
+    inline
+    bool blas_increment (std::ptrdiff_t s, std::size_t n, blas_int &inc) {
+        const std::size_t int_max ((std::numeric_limits<blas_int>::max) ());
+        if (n > int_max || (n > 1 && (s < 1 || std::size_t (s) > int_max)))
+            return false;
+        inc = n > 1 ? blas_int (s) : 1;
+        return true;
+    }
+
+    // First and last elements of an m x n strided operand
+    template<class T>
+    void blas_extent (const T *p, std::ptrdiff_t s1, std::ptrdiff_t s2, std::size_t m, std::size_t n,
+                      const T *&first, const T *&last) {
+        std::ptrdiff_t d1 ((std::ptrdiff_t (m) - 1) * s1), d2 ((std::ptrdiff_t (n) - 1) * s2);
+        first = p + (std::min) (d1, std::ptrdiff_t ()) + (std::min) (d2, std::ptrdiff_t ());
+        last = p + (std::max) (d1, std::ptrdiff_t ()) + (std::max) (d2, std::ptrdiff_t ());
+    }
+    // Whether two strided operands may share elements
+    template<class T>
+    bool blas_overlap (const T *p, std::ptrdiff_t p1, std::ptrdiff_t p2, std::size_t pm, std::size_t pn,
+                       const T *q, std::ptrdiff_t q1, std::ptrdiff_t q2, std::size_t qm, std::size_t qn) {
+        if (pm == 0 || pn == 0 || qm == 0 || qn == 0)
+            return false;
+        const T *p_first, *p_last, *q_first, *q_last;
+        blas_extent (p, p1, p2, pm, pn, p_first, p_last);
+        blas_extent (q, q1, q2, qm, qn, q_first, q_last);
+        std::less<const T *> less;
+        return ! (less (p_last, q_first) || less (q_last, p_first));
+    }
+
+#ifdef BOOST_UBLAS_USE_CBLAS
+    // How the library reads an m x n operand in the given order
+    template<class T>
+    bool blas_transpose (CBLAS_ORDER order, const blas_matrix_arg<T> &a, std::size_t m, std::size_t n,
+                         CBLAS_TRANSPOSE &t, blas_int &ld) {
+        bool row (order == CblasRowMajor);
+        if (! a.conj_ && (row ? blas_row_major (a.stride1_, a.stride2_, m, n, ld) :
+                                blas_row_major (a.stride2_, a.stride1_, n, m, ld))) {
+            t = CblasNoTrans;
+            return true;
+        }
+        if (row ? blas_row_major (a.stride2_, a.stride1_, n, m, ld) :
+                  blas_row_major (a.stride1_, a.stride2_, m, n, ld)) {
+            t = a.conj_ ? CblasConjTrans : CblasTrans;
+            return true;
+        }
+        return false;
+    }
+
+    // C = alpha A B + beta C, for A m x k and B k x n
+    template<class T>
+    bool blas_gemm (const raw::strided_matrix_view<T> &c, std::size_t m, std::size_t n, std::size_t k,
+                    const blas_matrix_arg<T> &a, const blas_matrix_arg<T> &b, T alpha, T beta) {
+        CBLAS_ORDER order;
+        CBLAS_TRANSPOSE ta, tb;
+        blas_int lda, ldb, ldc;
+        if (blas_row_major (c.stride1_, c.stride2_, m, n, ldc))
+            order = CblasRowMajor;
+        else if (blas_row_major (c.stride2_, c.stride1_, n, m, ldc))
+            order = CblasColMajor;
+        else
+            return false;
+        if (! blas_transpose (order, a, m, k, ta, lda) || ! blas_transpose (order, b, k, n, tb, ldb))
+            return false;
+        blas_types<T>::gemm (order, ta, tb, blas_int (m), blas_int (n), blas_int (k),
+                             alpha, a.data_, lda, b.data_, ldb, beta, c.data_, ldc);
+        return true;
+    }
+
+    // y = alpha A x + beta y, for A m x n
+    template<class T>
+    bool blas_gemv (const raw::strided_vector_view<T> &y, const blas_matrix_arg<T> &a, std::size_t m, std::size_t n,
+                    const raw::strided_vector_view<const T> &x, T alpha, T beta) {
+        CBLAS_TRANSPOSE ta;
+        blas_int lda, incx, incy;
+        if (! blas_increment (y.stride_, m, incy) || ! blas_increment (x.stride_, n, incx) ||
+            ! blas_transpose (CblasRowMajor, a, m, n, ta, lda))
+            return false;
+        // The stored array is A or the transpose of A
+        if (ta == CblasNoTrans)
+            blas_types<T>::gemv (CblasRowMajor, ta, blas_int (m), blas_int (n), alpha, a.data_, lda, x.data_, incx, beta, y.data_, incy);
+        else
+            blas_types<T>::gemv (CblasRowMajor, ta, blas_int (n), blas_int (m), alpha, a.data_, lda, x.data_, incx, beta, y.data_, incy);
+        return true;
+    }
+
+    // M F= E1 E2 for dense matrices
+    template<class M, class E1, class E2, bool = (blas_types<typename M::value_type>::value &&
+                                                  raw::strided_matrix_traits<M>::value &&
+                                                  blas_matrix_operand<E1>::value &&
+                                                  blas_matrix_operand<E2>::value &&
+                                                  boost::is_same<typename M::value_type, typename E1::value_type>::value &&
+                                                  boost::is_same<typename M::value_type, typename E2::value_type>::value)>
+    struct blas_matrix_matrix_prod {
+        template<class T>
+        static BOOST_UBLAS_INLINE
+        bool apply (M &, const E1 &, const E2 &, const T &, const T &) {
+            return false;
+        }
+    };
+    template<class M, class E1, class E2>
+    struct blas_matrix_matrix_prod<M, E1, E2, true> {
+        typedef typename M::value_type value_type;
+
+        // M = alpha E1 E2 + beta M, M not shared with E1 nor E2
+        static
+        bool apply (M &m, const E1 &e1, const E2 &e2, const value_type &alpha, const value_type &beta) {
+            std::size_t size1 (BOOST_UBLAS_SAME (m.size1 (), e1.size1 ()));
+            std::size_t size2 (BOOST_UBLAS_SAME (m.size2 (), e2.size2 ()));
+            std::size_t size (BOOST_UBLAS_SAME (e1.size2 (), e2.size1 ()));
+            return blas_gemm (raw::strided_matrix (m), size1, size2, size,
+                              blas_matrix_operand<E1>::get (e1), blas_matrix_operand<E2>::get (e2), alpha, beta);
+        }
+        // The same if M does not share elements with E1 nor E2
+        static
+        bool apply_checked (M &m, const E1 &e1, const E2 &e2, const value_type &alpha, const value_type &beta) {
+            raw::strided_matrix_view<value_type> c (raw::strided_matrix (m));
+            blas_matrix_arg<value_type> a (blas_matrix_operand<E1>::get (e1)), b (blas_matrix_operand<E2>::get (e2));
+            if (blas_overlap<value_type> (c.data_, c.stride1_, c.stride2_, m.size1 (), m.size2 (),
+                                          a.data_, a.stride1_, a.stride2_, e1.size1 (), e1.size2 ()) ||
+                blas_overlap<value_type> (c.data_, c.stride1_, c.stride2_, m.size1 (), m.size2 (),
+                                          b.data_, b.stride1_, b.stride2_, e2.size1 (), e2.size2 ()))
+                return false;
+            return apply (m, e1, e2, alpha, beta);
+        }
+    };
+
+    // V F= M E, or V F= E M if transposed, for a dense matrix and vectors
+    template<class V, class M, class E, bool = (blas_types<typename V::value_type>::value &&
+                                                raw::strided_vector_traits<V>::value &&
+                                                blas_matrix_operand<M>::value &&
+                                                raw::strided_vector_traits<E>::value &&
+                                                boost::is_same<typename V::value_type, typename M::value_type>::value &&
+                                                boost::is_same<typename V::value_type, typename E::value_type>::value)>
+    struct blas_matrix_vector_prod {
+        template<class T>
+        static BOOST_UBLAS_INLINE
+        bool apply (V &, const M &, const E &, const T &, const T &, bool) {
+            return false;
+        }
+    };
+    template<class V, class M, class E>
+    struct blas_matrix_vector_prod<V, M, E, true> {
+        typedef typename V::value_type value_type;
+
+        // V = alpha M E + beta V, V not shared with M nor E
+        static
+        bool apply (V &v, const M &m, const E &e, const value_type &alpha, const value_type &beta, bool transposed) {
+            blas_matrix_arg<value_type> a (blas_matrix_operand<M>::get (m));
+            std::size_t size1 (m.size1 ()), size2 (m.size2 ());
+            if (transposed) {
+                std::swap (a.stride1_, a.stride2_);
+                std::swap (size1, size2);
+            }
+            BOOST_UBLAS_CHECK (v.size () == size1, bad_size ());
+            BOOST_UBLAS_CHECK (e.size () == size2, bad_size ());
+            return blas_gemv (raw::strided_vector (v), a, size1, size2, raw::strided_vector (e), alpha, beta);
+        }
+        // The same if V does not share elements with M nor E
+        static
+        bool apply_checked (V &v, const M &m, const E &e, const value_type &alpha, const value_type &beta, bool transposed) {
+            raw::strided_vector_view<value_type> y (raw::strided_vector (v));
+            raw::strided_vector_view<const value_type> x (raw::strided_vector (e));
+            blas_matrix_arg<value_type> a (blas_matrix_operand<M>::get (m));
+            if (blas_overlap<value_type> (y.data_, y.stride_, 0, v.size (), 1,
+                                          a.data_, a.stride1_, a.stride2_, m.size1 (), m.size2 ()) ||
+                blas_overlap<value_type> (y.data_, y.stride_, 0, v.size (), 1,
+                                          x.data_, x.stride_, 0, e.size (), 1))
+                return false;
+            return apply (v, m, e, alpha, beta, transposed);
+        }
+    };
+
+    // Solves L U X = B in place, for the factors of lu_factorize in M
+    template<class M, class E, bool = (blas_types<typename E::value_type>::value &&
+                                       blas_matrix_operand<M>::value &&
+                                       raw::strided_matrix_traits<E>::value &&
+                                       boost::is_same<typename M::value_type, typename E::value_type>::value)>
+    struct blas_lu_substitute {
+        static BOOST_UBLAS_INLINE
+        bool apply (const M &, E &) {
+            return false;
+        }
+    };
+    template<class M, class E>
+    struct blas_lu_substitute<M, E, true> {
+        typedef typename E::value_type value_type;
+
+        static
+        bool apply (const M &m, E &e) {
+            std::size_t size (BOOST_UBLAS_SAME (m.size1 (), m.size2 ()));
+            std::size_t size2 (e.size2 ());
+            BOOST_UBLAS_CHECK (e.size1 () == size, bad_size ());
+            raw::strided_matrix_view<value_type> b (raw::strided_matrix (e));
+            blas_matrix_arg<value_type> a (blas_matrix_operand<M>::get (m));
+            CBLAS_ORDER order;
+            CBLAS_TRANSPOSE ta;
+            blas_int lda, ldb;
+            if (blas_row_major (b.stride1_, b.stride2_, size, size2, ldb))
+                order = CblasRowMajor;
+            else if (blas_row_major (b.stride2_, b.stride1_, size2, size, ldb))
+                order = CblasColMajor;
+            else
+                return false;
+            if (! blas_transpose (order, a, size, size, ta, lda))
+                return false;
+            // The lower triangle of a transposed array is its upper one
+            bool stored (ta == CblasNoTrans);
+            blas_types<value_type>::trsm (order, stored ? CblasLower : CblasUpper, ta, CblasUnit,
+                                          blas_int (size), blas_int (size2), a.data_, lda, b.data_, ldb);
+            blas_types<value_type>::trsm (order, stored ? CblasUpper : CblasLower, ta, CblasNonUnit,
+                                          blas_int (size), blas_int (size2), a.data_, lda, b.data_, ldb);
+            return true;
+        }
+    };
+    template<class M, class E, bool = (blas_types<typename E::value_type>::value &&
+                                       blas_matrix_operand<M>::value &&
+                                       raw::strided_vector_traits<E>::value &&
+                                       boost::is_same<typename M::value_type, typename E::value_type>::value)>
+    struct blas_lu_substitute_vector {
+        static BOOST_UBLAS_INLINE
+        bool apply (const M &, E &) {
+            return false;
+        }
+    };
+    template<class M, class E>
+    struct blas_lu_substitute_vector<M, E, true> {
+        typedef typename E::value_type value_type;
+
+        static
+        bool apply (const M &m, E &e) {
+            std::size_t size (BOOST_UBLAS_SAME (m.size1 (), m.size2 ()));
+            BOOST_UBLAS_CHECK (e.size () == size, bad_size ());
+            raw::strided_vector_view<value_type> x (raw::strided_vector (e));
+            blas_matrix_arg<value_type> a (blas_matrix_operand<M>::get (m));
+            CBLAS_TRANSPOSE ta;
+            blas_int lda, incx;
+            if (! blas_increment (x.stride_, size, incx) || ! blas_transpose (CblasRowMajor, a, size, size, ta, lda))
+                return false;
+            bool stored (ta == CblasNoTrans);
+            blas_types<value_type>::trsv (stored ? CblasLower : CblasUpper, ta, CblasUnit, blas_int (size), a.data_, lda, x.data_, incx);
+            blas_types<value_type>::trsv (stored ? CblasUpper : CblasLower, ta, CblasNonUnit, blas_int (size), a.data_, lda, x.data_, incx);
+            return true;
+        }
+    };
+#endif
+
+#ifdef BOOST_UBLAS_USE_LAPACK
+    // LU factorization with partial pivoting of a dense matrix by ?getrf,
+    // in place if columns are contiguous, else through a column major copy
+    template<class M, bool = (blas_types<typename M::value_type>::value &&
+                              raw::strided_matrix_traits<M>::value)>
+    struct lapack_lu_factorize {
+        template<class PM>
+        static BOOST_UBLAS_INLINE
+        bool apply (M &, PM &, typename M::size_type &) {
+            return false;
+        }
+    };
+    template<class M>
+    struct lapack_lu_factorize<M, true> {
+        typedef typename M::value_type value_type;
+        typedef typename M::size_type size_type;
+
+        template<class PM>
+        static
+        bool apply (M &m, PM &pm, size_type &singular) {
+            size_type size1 (m.size1 ()), size2 (m.size2 ());
+            size_type size ((std::min) (size1, size2));
+            if (size == 0)
+                return false;
+            raw::strided_matrix_view<value_type> a (raw::strided_matrix (m));
+            unbounded_array<blas_int, temporary_allocator<blas_int> > ipiv (size);
+            blas_int lda, info;
+            if (blas_row_major (a.stride2_, a.stride1_, size2, size1, lda)) {
+                blas_types<value_type>::getrf (blas_int (size1), blas_int (size2), a.data_, lda, ipiv.begin (), info);
+            } else {
+                if (! blas_row_major (std::ptrdiff_t (size1), std::ptrdiff_t (1), size2, size1, lda))
+                    return false;
+                unbounded_array<value_type, temporary_allocator<value_type> > t (size1 * size2);
+                for (size_type j = 0; j < size2; ++ j)
+                    for (size_type i = 0; i < size1; ++ i)
+                        t [j * size1 + i] = a (i, j);
+                blas_types<value_type>::getrf (blas_int (size1), blas_int (size2), t.begin (), lda, ipiv.begin (), info);
+                for (size_type i = 0; i < size1; ++ i)
+                    for (size_type j = 0; j < size2; ++ j)
+                        a (i, j) = t [j * size1 + i];
+            }
+            // The interchanges are counted from 1, so is the first zero pivot
+            for (size_type i = 0; i < size; ++ i)
+                pm (i) = size_type (ipiv [i] - 1);
+            singular = info > 0 ? size_type (info) : 0;
+            return true;
+        }
+    };
+#endif
+
+}
+}}}
+
+#endif
+
+#endif
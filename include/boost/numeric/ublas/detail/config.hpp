@@ -290,6 +290,39 @@ bool disable_type_check<Dummy>::value = false;
 #define BOOST_UBLAS_STRICT_HERMITIAN
 #endif
 
+// Run the parallel kernels through OpenMP if the compiler has it enabled
+#if defined (_OPENMP) && ! defined (BOOST_UBLAS_NO_OPENMP)
+#define BOOST_UBLAS_USE_OPENMP
+#endif
+// Minimum amount of work (elements touched) for a kernel to go parallel
+#ifndef BOOST_UBLAS_PARALLEL_THRESHOLD
+#define BOOST_UBLAS_PARALLEL_THRESHOLD 32768
+#endif
+// Summation used by the dense reductions sum, norm_2, norm_2_square and inner_prod
+#ifndef BOOST_UBLAS_DEFAULT_SUMMATION
+#define BOOST_UBLAS_DEFAULT_SUMMATION pairwise_summation_tag
+#endif
+// Temporaries are routed through a temporary_arena, which needs thread local storage
+#ifndef BOOST_UBLAS_NO_TEMPORARY_ARENA
+#if !defined (BOOST_NO_CXX11_THREAD_LOCAL)
+#define BOOST_UBLAS_THREAD_LOCAL thread_local
+#elif defined (__GNUC__)
+#define BOOST_UBLAS_THREAD_LOCAL __thread
+#else
+#define BOOST_UBLAS_NO_TEMPORARY_ARENA
+#endif
+#endif
+// Pointer arguments of kernels that never alias each other
+#ifdef BOOST_RESTRICT
+#define BOOST_UBLAS_RESTRICT BOOST_RESTRICT
+#else
+#define BOOST_UBLAS_RESTRICT
+#endif
+// Integer of the CBLAS and LAPACK interfaces, 64 bits wide for ILP64 builds of them
+#ifndef BOOST_UBLAS_BLAS_INT
+#define BOOST_UBLAS_BLAS_INT int
+#endif
+
 // Define to configure special settings for reference returning members
 // #define BOOST_UBLAS_REFERENCE_CONST_MEMBER
 // #define BOOST_UBLAS_PROXY_CONST_MEMBER
@@ -0,0 +1,344 @@
+//
+//  Copyright (c) 2019
+//  The Boost.uBLAS developers
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef _BOOST_UBLAS_EXPRESSION_ALIAS_
+#define _BOOST_UBLAS_EXPRESSION_ALIAS_
+
+#include <cstddef>
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/numeric/ublas/matrix_expression.hpp>
+#include <boost/numeric/ublas/detail/raw.hpp>
+
+// Run time checks whether an expression may read the storage of the
+// dense container it is assigned to. Without such an alias the container
+// operator = evaluates the expression in place, as noalias () would.
+// Leaves are compared through the strided view protocol (see
+// detail/raw.hpp), anything the checks do not know is taken to alias.
+
+namespace boost { namespace numeric { namespace ublas {
+namespace detail {
+
+    // The addresses [first, last) of the elements an assignment writes,
+    // and the container writing them
+    class alias_region {
+    public:
+        BOOST_UBLAS_INLINE
+        alias_region (const void *object, std::size_t first, std::size_t last):
+            object_ (object), first_ (first), last_ (last) {}
+
+        // The container itself, read at the element it writes
+        BOOST_UBLAS_INLINE
+        bool is (const void *object) const {
+            return object_ != 0 && object == object_;
+        }
+        BOOST_UBLAS_INLINE
+        bool overlaps (std::size_t first, std::size_t last) const {
+            return first < last && first_ < last_ && first < last_ && first_ < last;
+        }
+        BOOST_UBLAS_INLINE
+        bool overlaps (const alias_region &r) const {
+            return overlaps (r.first_, r.last_);
+        }
+        template<class T>
+        BOOST_UBLAS_INLINE
+        bool contains (const T &t) const {
+            std::size_t first (reinterpret_cast<std::size_t> (&t));
+            return overlaps (first, first + sizeof (T));
+        }
+
+    private:
+        const void *object_;
+        std::size_t first_;
+        std::size_t last_;
+    };
+
+    // The addresses spanned by a strided vector or matrix of the given sizes
+    inline
+    void strided_extent (std::ptrdiff_t &lo, std::ptrdiff_t &hi, std::size_t size, std::ptrdiff_t stride) {
+        std::ptrdiff_t offset (std::ptrdiff_t (size - 1) * stride);
+        (offset < 0 ? lo : hi) += offset;
+    }
+    template<class T>
+    BOOST_UBLAS_INLINE
+    alias_region strided_region (const void *object, const T *data, std::ptrdiff_t lo, std::ptrdiff_t hi) {
+        std::size_t address (reinterpret_cast<std::size_t> (data));
+        return alias_region (object, address + std::size_t (lo) * sizeof (T), address + std::size_t (hi + 1) * sizeof (T));
+    }
+    template<class V>
+    alias_region strided_vector_region (const V &v, const void *object) {
+        if (v.size () == 0)
+            return alias_region (object, 0, 0);
+        raw::strided_vector_view<const typename V::value_type> w (raw::strided_vector (v));
+        std::ptrdiff_t lo (0), hi (0);
+        strided_extent (lo, hi, v.size (), w.stride_);
+        return strided_region (object, w.data_, lo, hi);
+    }
+    template<class M>
+    alias_region strided_matrix_region (const M &m, const void *object) {
+        if (m.size1 () == 0 || m.size2 () == 0)
+            return alias_region (object, 0, 0);
+        raw::strided_matrix_view<const typename M::value_type> w (raw::strided_matrix (m));
+        std::ptrdiff_t lo (0), hi (0);
+        strided_extent (lo, hi, m.size1 (), w.stride1_);
+        strided_extent (lo, hi, m.size2 (), w.stride2_);
+        return strided_region (object, w.data_, lo, hi);
+    }
+
+    // Whether E reads the region other than elementwise at the element
+    // written, specialized below for the expression nodes
+    template<class E>
+    struct expression_alias_traits;
+
+    template<class E>
+    BOOST_UBLAS_INLINE
+    bool expression_may_alias (const E &e, const alias_region &r, bool elementwise) {
+        return expression_alias_traits<E>::apply (e, r, elementwise);
+    }
+
+    // Leaves: strided matrices and vectors by their extent, the rest unknown
+    template<class E>
+    BOOST_UBLAS_INLINE
+    bool leaf_may_alias (const E &e, const alias_region &r, boost::true_type, boost::false_type) {
+        return strided_matrix_region (e, 0).overlaps (r);
+    }
+    template<class E>
+    BOOST_UBLAS_INLINE
+    bool leaf_may_alias (const E &e, const alias_region &r, boost::false_type, boost::true_type) {
+        return strided_vector_region (e, 0).overlaps (r);
+    }
+    template<class E, class S>
+    BOOST_UBLAS_INLINE
+    bool leaf_may_alias (const E &, const alias_region &, boost::false_type, S) {
+        return true;
+    }
+
+    template<class E>
+    struct expression_alias_traits {
+        static BOOST_UBLAS_INLINE
+        bool apply (const E &e, const alias_region &r, bool elementwise) {
+            if (elementwise && r.is (&e))
+                return false;
+            return leaf_may_alias (e, r,
+                                   boost::integral_constant<bool, raw::strided_matrix_traits<E>::value> (),
+                                   boost::integral_constant<bool, raw::strided_vector_traits<E>::value> ());
+        }
+    };
+    template<class E>
+    struct expression_alias_traits<const E>:
+        public expression_alias_traits<E> {};
+
+    // Expressions without storage, and sparse containers, which are never
+    // the dense container assigned to
+    template<class E>
+    struct no_alias_traits {
+        static BOOST_UBLAS_INLINE
+        bool apply (const E &, const alias_region &, bool) {
+            return false;
+        }
+    };
+    template<class T, class ALLOC>
+    struct expression_alias_traits<zero_vector<T, ALLOC> >:
+        public no_alias_traits<zero_vector<T, ALLOC> > {};
+    template<class T, class ALLOC>
+    struct expression_alias_traits<unit_vector<T, ALLOC> >:
+        public no_alias_traits<unit_vector<T, ALLOC> > {};
+    template<class T, class ALLOC>
+    struct expression_alias_traits<scalar_vector<T, ALLOC> >:
+        public no_alias_traits<scalar_vector<T, ALLOC> > {};
+    template<class T, class ALLOC>
+    struct expression_alias_traits<zero_matrix<T, ALLOC> >:
+        public no_alias_traits<zero_matrix<T, ALLOC> > {};
+    template<class T, class ALLOC>
+    struct expression_alias_traits<identity_matrix<T, ALLOC> >:
+        public no_alias_traits<identity_matrix<T, ALLOC> > {};
+    template<class T, class ALLOC>
+    struct expression_alias_traits<scalar_matrix<T, ALLOC> >:
+        public no_alias_traits<scalar_matrix<T, ALLOC> > {};
+    template<class T, class A>
+    struct expression_alias_traits<mapped_vector<T, A> >:
+        public no_alias_traits<mapped_vector<T, A> > {};
+    template<class T, std::size_t IB, class IA, class TA>
+    struct expression_alias_traits<compressed_vector<T, IB, IA, TA> >:
+        public no_alias_traits<compressed_vector<T, IB, IA, TA> > {};
+    template<class T, std::size_t IB, class IA, class TA>
+    struct expression_alias_traits<coordinate_vector<T, IB, IA, TA> >:
+        public no_alias_traits<coordinate_vector<T, IB, IA, TA> > {};
+    template<class T, class L, class A>
+    struct expression_alias_traits<mapped_matrix<T, L, A> >:
+        public no_alias_traits<mapped_matrix<T, L, A> > {};
+    template<class T, class L, std::size_t IB, class IA, class TA>
+    struct expression_alias_traits<compressed_matrix<T, L, IB, IA, TA> >:
+        public no_alias_traits<compressed_matrix<T, L, IB, IA, TA> > {};
+    template<class T, class L, std::size_t IB, class IA, class TA>
+    struct expression_alias_traits<coordinate_matrix<T, L, IB, IA, TA> >:
+        public no_alias_traits<coordinate_matrix<T, L, IB, IA, TA> > {};
+
+    // References stand for the container they refer to
+    template<class E>
+    struct expression_alias_traits<vector_reference<E> > {
+        static BOOST_UBLAS_INLINE
+        bool apply (const vector_reference<E> &e, const alias_region &r, bool elementwise) {
+            return expression_may_alias (e.expression (), r, elementwise);
+        }
+    };
+    template<class E>
+    struct expression_alias_traits<matrix_reference<E> > {
+        static BOOST_UBLAS_INLINE
+        bool apply (const matrix_reference<E> &e, const alias_region &r, bool elementwise) {
+            return expression_may_alias (e.expression (), r, elementwise);
+        }
+    };
+
+    // Elementwise nodes read their operands at the element they compute,
+    // scalars are held by reference
+    template<class E, class F>
+    struct expression_alias_traits<vector_unary<E, F> > {
+        static BOOST_UBLAS_INLINE
+        bool apply (const vector_unary<E, F> &e, const alias_region &r, bool elementwise) {
+            return expression_may_alias (e.expression (), r, elementwise);
+        }
+    };
+    template<class E1, class E2, class F>
+    struct expression_alias_traits<vector_binary<E1, E2, F> > {
+        static BOOST_UBLAS_INLINE
+        bool apply (const vector_binary<E1, E2, F> &e, const alias_region &r, bool elementwise) {
+            return expression_may_alias (e.expression1 (), r, elementwise) ||
+                   expression_may_alias (e.expression2 (), r, elementwise);
+        }
+    };
+    template<class E1, class E2, class F>
+    struct expression_alias_traits<vector_binary_scalar1<E1, E2, F> > {
+        static BOOST_UBLAS_INLINE
+        bool apply (const vector_binary_scalar1<E1, E2, F> &e, const alias_region &r, bool elementwise) {
+            return r.contains (e.expression1 ()) ||
+                   expression_may_alias (e.expression2 (), r, elementwise);
+        }
+    };
+    template<class E1, class E2, class F>
+    struct expression_alias_traits<vector_binary_scalar2<E1, E2, F> > {
+        static BOOST_UBLAS_INLINE
+        bool apply (const vector_binary_scalar2<E1, E2, F> &e, const alias_region &r, bool elementwise) {
+            return expression_may_alias (e.expression1 (), r, elementwise) ||
+                   r.contains (e.expression2 ());
+        }
+    };
+    template<class E, class F>
+    struct expression_alias_traits<matrix_unary1<E, F> > {
+        static BOOST_UBLAS_INLINE
+        bool apply (const matrix_unary1<E, F> &e, const alias_region &r, bool elementwise) {
+            return expression_may_alias (e.expression (), r, elementwise);
+        }
+    };
+    template<class E1, class E2, class F>
+    struct expression_alias_traits<matrix_binary<E1, E2, F> > {
+        static BOOST_UBLAS_INLINE
+        bool apply (const matrix_binary<E1, E2, F> &e, const alias_region &r, bool elementwise) {
+            return expression_may_alias (e.expression1 (), r, elementwise) ||
+                   expression_may_alias (e.expression2 (), r, elementwise);
+        }
+    };
+    template<class E1, class E2, class F>
+    struct expression_alias_traits<matrix_binary_scalar1<E1, E2, F> > {
+        static BOOST_UBLAS_INLINE
+        bool apply (const matrix_binary_scalar1<E1, E2, F> &e, const alias_region &r, bool elementwise) {
+            return r.contains (e.expression1 ()) ||
+                   expression_may_alias (e.expression2 (), r, elementwise);
+        }
+    };
+    template<class E1, class E2, class F>
+    struct expression_alias_traits<matrix_binary_scalar2<E1, E2, F> > {
+        static BOOST_UBLAS_INLINE
+        bool apply (const matrix_binary_scalar2<E1, E2, F> &e, const alias_region &r, bool elementwise) {
+            return expression_may_alias (e.expression1 (), r, elementwise) ||
+                   r.contains (e.expression2 ());
+        }
+    };
+
+    // Transposes, outer and inner products read other elements than the
+    // one they compute
+    template<class E, class F>
+    struct expression_alias_traits<matrix_unary2<E, F> > {
+        static BOOST_UBLAS_INLINE
+        bool apply (const matrix_unary2<E, F> &e, const alias_region &r, bool) {
+            return expression_may_alias (e.expression (), r, false);
+        }
+    };
+    template<class E1, class E2, class F>
+    struct expression_alias_traits<vector_matrix_binary<E1, E2, F> > {
+        static BOOST_UBLAS_INLINE
+        bool apply (const vector_matrix_binary<E1, E2, F> &e, const alias_region &r, bool) {
+            return expression_may_alias (e.expression1 (), r, false) ||
+                   expression_may_alias (e.expression2 (), r, false);
+        }
+    };
+    template<class E1, class E2, class F>
+    struct expression_alias_traits<matrix_vector_binary1<E1, E2, F> > {
+        static BOOST_UBLAS_INLINE
+        bool apply (const matrix_vector_binary1<E1, E2, F> &e, const alias_region &r, bool) {
+            return expression_may_alias (e.expression1 (), r, false) ||
+                   expression_may_alias (e.expression2 (), r, false);
+        }
+    };
+    template<class E1, class E2, class F>
+    struct expression_alias_traits<matrix_vector_binary2<E1, E2, F> > {
+        static BOOST_UBLAS_INLINE
+        bool apply (const matrix_vector_binary2<E1, E2, F> &e, const alias_region &r, bool) {
+            return expression_may_alias (e.expression1 (), r, false) ||
+                   expression_may_alias (e.expression2 (), r, false);
+        }
+    };
+    template<class E1, class E2, class F>
+    struct expression_alias_traits<matrix_matrix_binary<E1, E2, F> > {
+        static BOOST_UBLAS_INLINE
+        bool apply (const matrix_matrix_binary<E1, E2, F> &e, const alias_region &r, bool) {
+            return expression_may_alias (e.expression1 (), r, false) ||
+                   expression_may_alias (e.expression2 (), r, false);
+        }
+    };
+
+    // Whether assigning E to the strided container V or M may read elements
+    // already written. A container of other sizes than E is resized first,
+    // it may then not appear in E at all.
+    template<class V, class E>
+    BOOST_UBLAS_INLINE
+    bool vector_may_alias (const V &v, const vector_expression<E> &e, boost::true_type) {
+        const void *object (v.size () == e ().size () ? &v : 0);
+        return expression_may_alias (e (), strided_vector_region (v, object), true);
+    }
+    template<class V, class E>
+    BOOST_UBLAS_INLINE
+    bool vector_may_alias (const V &, const vector_expression<E> &, boost::false_type) {
+        return true;
+    }
+    template<class V, class E>
+    BOOST_UBLAS_INLINE
+    bool vector_may_alias (const V &v, const vector_expression<E> &e) {
+        return vector_may_alias (v, e, boost::integral_constant<bool, raw::strided_vector_traits<V>::value> ());
+    }
+    template<class M, class E>
+    BOOST_UBLAS_INLINE
+    bool matrix_may_alias (const M &m, const matrix_expression<E> &e, boost::true_type) {
+        const void *object (m.size1 () == e ().size1 () && m.size2 () == e ().size2 () ? &m : 0);
+        return expression_may_alias (e (), strided_matrix_region (m, object), true);
+    }
+    template<class M, class E>
+    BOOST_UBLAS_INLINE
+    bool matrix_may_alias (const M &, const matrix_expression<E> &, boost::false_type) {
+        return true;
+    }
+    template<class M, class E>
+    BOOST_UBLAS_INLINE
+    bool matrix_may_alias (const M &m, const matrix_expression<E> &e) {
+        return matrix_may_alias (m, e, boost::integral_constant<bool, raw::strided_matrix_traits<M>::value> ());
+    }
+
+}
+}}}
+
+#endif
@@ -0,0 +1,191 @@
+//
+//  Copyright (c) 2019
+//  The Boost.uBLAS developers
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef _BOOST_UBLAS_FIXED_KERNELS_
+#define _BOOST_UBLAS_FIXED_KERNELS_
+
+#include <cstddef>
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/numeric/ublas/fwd.hpp>
+#include <boost/numeric/ublas/matrix_expression.hpp>
+#include <boost/numeric/ublas/detail/vector_assign.hpp>
+#include <boost/numeric/ublas/detail/matrix_assign.hpp>
+
+#ifdef BOOST_UBLAS_CPP_GE_2011
+
+// Kernels for products and transposes of fixed_vector and fixed_matrix,
+// all loops unrolled at compile time
+
+namespace boost { namespace numeric { namespace ublas {
+namespace detail {
+
+    // f (I), f (I + 1) ... f (N - 1)
+    template<std::size_t I, std::size_t N>
+    struct fixed_unroll {
+        template<class F>
+        static BOOST_UBLAS_INLINE
+        void apply (const F &f) {
+            f (I);
+            fixed_unroll<I + 1, N>::apply (f);
+        }
+    };
+    template<std::size_t N>
+    struct fixed_unroll<N, N> {
+        template<class F>
+        static BOOST_UBLAS_INLINE
+        void apply (const F &) {}
+    };
+
+    // f (0) + f (1) + ... + f (N - 1), added in the order of the generic evaluation
+    template<class T, std::size_t N>
+    struct fixed_sum {
+        template<class F>
+        static BOOST_UBLAS_INLINE
+        T apply (const F &f) {
+            return fixed_sum<T, N - 1>::apply (f) + f (N - 1);
+        }
+    };
+    template<class T>
+    struct fixed_sum<T, 0> {
+        template<class F>
+        static BOOST_UBLAS_INLINE
+        T apply (const F &) {
+            return T ();
+        }
+    };
+
+    // v F= A x for an M x N matrix
+    template<template <class T1, class T2> class F, class T, std::size_t M, std::size_t N, class V, class E1, class E2>
+    BOOST_UBLAS_INLINE
+    void fixed_matrix_vector_prod (V &v, const E1 &e1, const E2 &e2) {
+        typedef F<typename V::reference, T> functor_type;
+        fixed_unroll<0, M>::apply ([&] (std::size_t i) {
+            functor_type::apply (v (i), fixed_sum<T, N>::apply ([&] (std::size_t k) -> T {
+                return e1 (i, k) * e2 (k);
+            }));
+        });
+    }
+
+    // v F= x A for an M x N matrix
+    template<template <class T1, class T2> class F, class T, std::size_t M, std::size_t N, class V, class E1, class E2>
+    BOOST_UBLAS_INLINE
+    void fixed_vector_matrix_prod (V &v, const E1 &e1, const E2 &e2) {
+        typedef F<typename V::reference, T> functor_type;
+        fixed_unroll<0, N>::apply ([&] (std::size_t j) {
+            functor_type::apply (v (j), fixed_sum<T, M>::apply ([&] (std::size_t k) -> T {
+                return e1 (k) * e2 (k, j);
+            }));
+        });
+    }
+
+    // C F= A B for an M x K and a K x N matrix, in the order of the layout of C
+    template<template <class T1, class T2> class F, class T, std::size_t M, std::size_t K, std::size_t N, class C, class E1, class E2>
+    BOOST_UBLAS_INLINE
+    void fixed_matrix_matrix_prod (C &c, const E1 &e1, const E2 &e2, row_major_tag) {
+        typedef F<typename C::reference, T> functor_type;
+        fixed_unroll<0, M>::apply ([&] (std::size_t i) {
+            fixed_unroll<0, N>::apply ([&] (std::size_t j) {
+                functor_type::apply (c (i, j), fixed_sum<T, K>::apply ([&] (std::size_t k) -> T {
+                    return e1 (i, k) * e2 (k, j);
+                }));
+            });
+        });
+    }
+    template<template <class T1, class T2> class F, class T, std::size_t M, std::size_t K, std::size_t N, class C, class E1, class E2>
+    BOOST_UBLAS_INLINE
+    void fixed_matrix_matrix_prod (C &c, const E1 &e1, const E2 &e2, column_major_tag) {
+        typedef F<typename C::reference, T> functor_type;
+        fixed_unroll<0, N>::apply ([&] (std::size_t j) {
+            fixed_unroll<0, M>::apply ([&] (std::size_t i) {
+                functor_type::apply (c (i, j), fixed_sum<T, K>::apply ([&] (std::size_t k) -> T {
+                    return e1 (i, k) * e2 (k, j);
+                }));
+            });
+        });
+    }
+
+    // C F= A^T for an N x M matrix A
+    template<template <class T1, class T2> class F, class T, std::size_t M, std::size_t N, class C, class E>
+    BOOST_UBLAS_INLINE
+    void fixed_matrix_trans (C &c, const E &e) {
+        typedef F<typename C::reference, T> functor_type;
+        fixed_unroll<0, M>::apply ([&] (std::size_t i) {
+            fixed_unroll<0, N>::apply ([&] (std::size_t j) {
+                functor_type::apply (c (i, j), e (j, i));
+            });
+        });
+    }
+
+    template<class T, std::size_t N, class A1, class A2>
+    BOOST_UBLAS_INLINE
+    T fixed_inner_prod (const fixed_vector<T, N, A1> &v1, const fixed_vector<T, N, A2> &v2, boost::true_type) {
+        return fixed_sum<T, N>::apply ([&] (std::size_t i) -> T {
+            return v1 (i) * v2 (i);
+        });
+    }
+    template<class T, std::size_t N, class A1, class A2>
+    BOOST_UBLAS_INLINE
+    T fixed_inner_prod (const fixed_vector<T, N, A1> &v1, const fixed_vector<T, N, A2> &v2, boost::false_type) {
+        return inner_prod (v1, v2, BOOST_UBLAS_DEFAULT_SUMMATION ());
+    }
+
+}
+
+    // Products of fixed size operands of the same value type are assigned
+    // by the unrolled kernels
+    template<template <class T1, class T2> class F, class T, std::size_t M, std::size_t N, class A1, class L, class A2, class A3>
+    BOOST_UBLAS_INLINE
+    void vector_assign (fixed_vector<T, M, A1> &v,
+                        const vector_expression<matrix_vector_binary1<fixed_matrix<T, M, N, L, A2>, fixed_vector<T, N, A3>,
+                                                                      matrix_vector_prod1<fixed_matrix<T, M, N, L, A2>, fixed_vector<T, N, A3>, T> > > &e) {
+        detail::fixed_matrix_vector_prod<F, T, M, N> (v, e ().expression1 (), e ().expression2 ());
+    }
+    template<template <class T1, class T2> class F, class T, std::size_t M, std::size_t N, class A1, class A2, class L, class A3>
+    BOOST_UBLAS_INLINE
+    void vector_assign (fixed_vector<T, N, A1> &v,
+                        const vector_expression<matrix_vector_binary2<fixed_vector<T, M, A2>, fixed_matrix<T, M, N, L, A3>,
+                                                                      matrix_vector_prod2<fixed_vector<T, M, A2>, fixed_matrix<T, M, N, L, A3>, T> > > &e) {
+        detail::fixed_vector_matrix_prod<F, T, M, N> (v, e ().expression1 (), e ().expression2 ());
+    }
+    template<template <class T1, class T2> class F, class T, std::size_t M, std::size_t K, std::size_t N, class L, class A,
+             class L1, class A1, class L2, class A2>
+    BOOST_UBLAS_INLINE
+    void matrix_assign (fixed_matrix<T, M, N, L, A> &m,
+                        const matrix_expression<matrix_matrix_binary<fixed_matrix<T, M, K, L1, A1>, fixed_matrix<T, K, N, L2, A2>,
+                                                                     matrix_matrix_prod<fixed_matrix<T, M, K, L1, A1>, fixed_matrix<T, K, N, L2, A2>, T> > > &e) {
+        detail::fixed_matrix_matrix_prod<F, T, M, K, N> (m, e ().expression1 (), e ().expression2 (), typename L::orientation_category ());
+    }
+    template<template <class T1, class T2> class F, class T, std::size_t M, std::size_t N, class L, class A, class L1, class A1>
+    BOOST_UBLAS_INLINE
+    void matrix_assign (fixed_matrix<T, M, N, L, A> &m,
+                        const matrix_expression<matrix_unary2<const fixed_matrix<T, N, M, L1, A1>, scalar_identity<T> > > &e) {
+        detail::fixed_matrix_trans<F, T, M, N> (m, e ().expression ());
+    }
+    template<template <class T1, class T2> class F, class T, std::size_t M, std::size_t N, class L, class A, class L1, class A1>
+    BOOST_UBLAS_INLINE
+    void matrix_assign (fixed_matrix<T, M, N, L, A> &m,
+                        const matrix_expression<matrix_unary2<fixed_matrix<T, N, M, L1, A1>, scalar_identity<T> > > &e) {
+        detail::fixed_matrix_trans<F, T, M, N> (m, e ().expression ());
+    }
+
+    // Below eight elements the default summation adds the products one
+    // after the other, as the unrolled sum does
+    template<class T, std::size_t N, class A1, class A2>
+    BOOST_UBLAS_INLINE
+    T inner_prod (const fixed_vector<T, N, A1> &v1, const fixed_vector<T, N, A2> &v2) {
+        return detail::fixed_inner_prod (v1, v2, boost::integral_constant<bool, (N < 8 &&
+            ! boost::is_same<BOOST_UBLAS_DEFAULT_SUMMATION, compensated_summation_tag>::value)> ());
+    }
+
+}}}
+
+#endif // BOOST_UBLAS_CPP_GE_2011
+
+#endif
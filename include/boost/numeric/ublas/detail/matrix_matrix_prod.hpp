@@ -0,0 +1,225 @@
+//
+//  Copyright (c) 2019
+//  The Boost.uBLAS developers
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef _BOOST_UBLAS_MATRIX_MATRIX_PROD_
+#define _BOOST_UBLAS_MATRIX_MATRIX_PROD_
+
+#include <algorithm>
+#include <cstddef>
+#include <boost/mpl/if.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/type_traits/is_base_of.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/type_traits/remove_const.hpp>
+#include <boost/numeric/ublas/matrix_expression.hpp>
+#include <boost/numeric/ublas/temporary_arena.hpp>
+#include <boost/numeric/ublas/detail/raw.hpp>
+#include <boost/numeric/ublas/detail/matrix_assign.hpp>
+#include <boost/numeric/ublas/detail/matrix_vector_prod.hpp>
+
+// Packed kernels for assigning prod (matrix, matrix) to a dense matrix,
+// reading strided operands (see detail/raw.hpp) through their pointer.
+// With BOOST_UBLAS_USE_CBLAS the products ?gemm takes go there first.
+
+namespace boost { namespace numeric { namespace ublas {
+namespace detail {
+
+    // Register tiles of mr x nr elements of C, panels of kc x nc elements of B
+    struct matrix_matrix_prod_size {
+        enum { mr = 4, nr = 8, kc = 256, nc = 256, threshold = 32768 };
+    };
+
+    // The assignments of matrix_vector_prod.hpp, y = A x, y += A x and y -= A x
+    template<template <class T1, class T2> class F>
+    struct matrix_matrix_prod_assign_traits:
+        public matrix_vector_prod_assign_traits<F> {};
+
+    // The kernels need dense operands of the product's value type
+    template<template <class T1, class T2> class F, class M, class E1, class E2, class T>
+    struct matrix_matrix_prod_kernel_traits {
+        BOOST_STATIC_CONSTANT (bool, value =
+            (matrix_matrix_prod_assign_traits<F>::supported &&
+             boost::is_base_of<dense_proxy_tag, typename M::storage_category>::value &&
+             boost::is_base_of<dense_proxy_tag, typename E1::storage_category>::value &&
+             boost::is_base_of<dense_proxy_tag, typename E2::storage_category>::value &&
+             boost::is_same<typename M::value_type, T>::value &&
+             boost::is_same<typename E1::value_type, T>::value &&
+             boost::is_same<typename E2::value_type, T>::value));
+    };
+
+    // B (k0 .. k0 + kc, j0 .. j0 + nc) as slivers of nr columns, each
+    // row of a sliver contiguous, padded with zeros to whole slivers
+    template<class T, class E>
+    void matrix_matrix_prod_pack_b (T *bp, const E &b, std::size_t k0, std::size_t kc, std::size_t j0, std::size_t nc) {
+        const std::size_t nr = matrix_matrix_prod_size::nr;
+        for (std::size_t j = 0; j < nc; j += nr) {
+            std::size_t n ((std::min) (nr, nc - j));
+            for (std::size_t k = 0; k < kc; ++ k) {
+                std::size_t q = 0;
+                for (; q < n; ++ q)
+                    bp [k * nr + q] = b (k0 + k, j0 + j + q);
+                for (; q < nr; ++ q)
+                    bp [k * nr + q] = T/*zero*/();
+            }
+            bp += kc * nr;
+        }
+    }
+
+    // A (i0 .. i0 + mr, k0 .. k0 + kc), a column of the tile after the other
+    template<class T, class E>
+    void matrix_matrix_prod_pack_a (T *ap, const E &a, std::size_t i0, std::size_t m, std::size_t k0, std::size_t kc) {
+        const std::size_t mr = matrix_matrix_prod_size::mr;
+        for (std::size_t k = 0; k < kc; ++ k) {
+            std::size_t r = 0;
+            for (; r < m; ++ r)
+                ap [k * mr + r] = a (i0 + r, k0 + k);
+            for (; r < mr; ++ r)
+                ap [k * mr + r] = T/*zero*/();
+        }
+    }
+
+    // The m x n tile at w of A B, kc products more: zero plus the first
+    // ones, or the partial sums already in w plus the next ones. Every
+    // element is summed in the order of the generic evaluation.
+    template<class T>
+    void matrix_matrix_prod_tile (const raw::strided_matrix_view<T> &w, std::size_t m, std::size_t n,
+                                  const T *ap, const T *bp, std::size_t kc, bool first) {
+        const std::size_t mr = matrix_matrix_prod_size::mr;
+        const std::size_t nr = matrix_matrix_prod_size::nr;
+        T c [mr] [nr];
+        for (std::size_t r = 0; r < mr; ++ r)
+            for (std::size_t q = 0; q < nr; ++ q)
+                c [r] [q] = first || r >= m || q >= n ? T/*zero*/() : w (r, q);
+        for (std::size_t k = 0; k < kc; ++ k) {
+            for (std::size_t r = 0; r < mr; ++ r)
+                for (std::size_t q = 0; q < nr; ++ q)
+                    c [r] [q] += ap [r] * bp [q];
+            ap += mr;
+            bp += nr;
+        }
+        for (std::size_t r = 0; r < m; ++ r)
+            for (std::size_t q = 0; q < n; ++ q)
+                w (r, q) = c [r] [q];
+    }
+
+    // W = A B for an m x k and a k x n operand, by panels of B packed once
+    // and tiles of A packed per thread. Threads own disjoint rows of W.
+    template<class T, class A, class B>
+    void matrix_matrix_prod_packed (const raw::strided_matrix_view<T> &w, const A &a, const B &b,
+                                    std::size_t size1, std::size_t size2, std::size_t size) {
+        typedef matrix_matrix_prod_size prod_size;
+        const std::size_t mr = prod_size::mr;
+        const std::size_t kc_max = prod_size::kc;
+        const std::size_t nc_max = prod_size::nc;
+        unbounded_array<T, temporary_allocator<T> > bp (kc_max * nc_max);
+        std::ptrdiff_t tiles ((size1 + mr - 1) / mr);
+        for (std::size_t j0 = 0; j0 < size2; j0 += nc_max) {
+            std::size_t nc ((std::min) (nc_max, size2 - j0));
+            for (std::size_t k0 = 0; k0 < size; k0 += kc_max) {
+                std::size_t kc ((std::min) (kc_max, size - k0));
+                matrix_matrix_prod_pack_b (bp.begin (), b, k0, kc, j0, nc);
+                const T *bpc = bp.begin ();
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel for schedule (static) if (size1 * nc * kc >= BOOST_UBLAS_PARALLEL_THRESHOLD)
+#endif
+                for (std::ptrdiff_t t = 0; t < tiles; ++ t) {
+                    const std::size_t nr = prod_size::nr;
+                    T ap [prod_size::mr * prod_size::kc];
+                    std::size_t i0 (t * mr);
+                    std::size_t m ((std::min) (mr, size1 - i0));
+                    matrix_matrix_prod_pack_a (ap, a, i0, m, k0, kc);
+                    for (std::size_t j = 0; j < nc; j += nr)
+                        matrix_matrix_prod_tile (raw::strided_matrix_view<T> (&w (i0, j0 + j), w.stride1_, w.stride2_),
+                                                 m, (std::min) (nr, nc - j), ap, bpc + j * kc, kc, k0 == 0);
+                }
+            }
+        }
+    }
+
+    // The dispatcher of matrix_assign.hpp, for products the kernels do not handle
+    template<template <class T1, class T2> class F, class M, class E>
+    BOOST_UBLAS_INLINE
+    void element_matrix_assign (M &m, const matrix_expression<E> &e) {
+        typedef typename matrix_assign_traits<typename M::storage_category,
+                                              F<typename M::reference, typename E::value_type>::computed,
+                                              typename E::const_iterator1::iterator_category,
+                                              typename E::const_iterator2::iterator_category>::storage_category storage_category;
+        typedef typename boost::mpl::if_<boost::is_same<typename M::orientation_category, unknown_orientation_tag>,
+                                          typename E::orientation_category ,
+                                          typename M::orientation_category >::type orientation_category;
+        typedef basic_full<typename M::size_type> unrestricted;
+        matrix_assign<F, unrestricted> (m, e, storage_category (), orientation_category ());
+    }
+
+    // C = A B straight into a strided C, else into a temporary then
+    // assigned to C by F, scattered when C is indirect
+    template<template <class T1, class T2> class F, class M, class A, class B>
+    BOOST_UBLAS_INLINE
+    void matrix_matrix_prod_assign (M &m, const A &a, const B &b, std::size_t size, boost::true_type) {
+        matrix_matrix_prod_packed (raw::strided_matrix (m), a, b, m.size1 (), m.size2 (), size);
+    }
+    template<template <class T1, class T2> class F, class M, class A, class B>
+    void matrix_matrix_prod_assign (M &m, const A &a, const B &b, std::size_t size, boost::false_type) {
+        typedef typename M::value_type value_type;
+        typename temporary_matrix<value_type>::type t (m.size1 (), m.size2 ());
+        matrix_matrix_prod_packed (raw::strided_matrix (t), a, b, m.size1 (), m.size2 (), size);
+        typedef typename boost::mpl::if_<boost::is_same<typename M::orientation_category, column_major_tag>,
+                                         column_major_tag, row_major_tag>::type orientation_category;
+        indexing_matrix_assign<F> (m, t, orientation_category ());
+    }
+
+    // C F= A B
+    template<template <class T1, class T2> class F, class M, class E>
+    void matrix_matrix_prod_assign (M &m, const E &e, boost::true_type) {
+        typedef typename boost::remove_const<typename E::expression1_closure_type>::type expression1_type;
+        typedef typename boost::remove_const<typename E::expression2_closure_type>::type expression2_type;
+        const expression1_type &e1 (e.expression1 ());
+        const expression2_type &e2 (e.expression2 ());
+        std::size_t size1 (BOOST_UBLAS_SAME (m.size1 (), e1.size1 ()));
+        std::size_t size2 (BOOST_UBLAS_SAME (m.size2 (), e2.size2 ()));
+        std::size_t size (BOOST_UBLAS_SAME (e1.size2 (), e2.size1 ()));
+        if (size1 * size2 * size < std::size_t (matrix_matrix_prod_size::threshold)) {
+            element_matrix_assign<F> (m, e);
+            return;
+        }
+#ifdef BOOST_UBLAS_USE_CBLAS
+        typedef matrix_matrix_prod_assign_traits<F> assign_traits;
+        typedef typename M::value_type value_type;
+        if (blas_matrix_matrix_prod<M, expression1_type, expression2_type>::apply (m, e1, e2,
+                value_type (assign_traits::negate ? -1 : 1), value_type (assign_traits::clear ? 0 : 1)))
+            return;
+#endif
+        // Strided operands, their trans () and herm () are packed from
+        // their pointer, the others (indirect ones) gathered through operator ()
+        matrix_matrix_prod_assign<F> (m,
+            matrix_operand_traits<expression1_type>::get (e1),
+            matrix_operand_traits<expression2_type>::get (e2),
+            size, boost::integral_constant<bool, (matrix_matrix_prod_assign_traits<F>::clear &&
+                                                  raw::strided_matrix_traits<M>::value)> ());
+    }
+    template<template <class T1, class T2> class F, class M, class E>
+    BOOST_UBLAS_INLINE
+    void matrix_matrix_prod_assign (M &m, const E &e, boost::false_type) {
+        element_matrix_assign<F> (m, e);
+    }
+
+}
+
+    // Dense matrix products are assigned by the packed kernels, everything
+    // else element by element
+    template<template <class T1, class T2> class F, class M, class E1, class E2, class T>
+    BOOST_UBLAS_INLINE
+    void matrix_assign (M &m, const matrix_expression<matrix_matrix_binary<E1, E2, matrix_matrix_prod<E1, E2, T> > > &e) {
+        typedef detail::matrix_matrix_prod_kernel_traits<F, M, E1, E2, T> kernel_traits;
+        detail::matrix_matrix_prod_assign<F> (m, e (), boost::integral_constant<bool, kernel_traits::value> ());
+    }
+
+}}}
+
+#endif
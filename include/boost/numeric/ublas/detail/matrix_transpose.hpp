@@ -0,0 +1,100 @@
+//
+//  Copyright (c) 2019
+//  The Boost.uBLAS developers
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef _BOOST_UBLAS_MATRIX_TRANSPOSE_
+#define _BOOST_UBLAS_MATRIX_TRANSPOSE_
+
+#include <algorithm>
+#include <cstddef>
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/type_traits/is_base_of.hpp>
+#include <boost/type_traits/remove_const.hpp>
+#include <boost/numeric/ublas/matrix_expression.hpp>
+#include <boost/numeric/ublas/detail/raw.hpp>
+#include <boost/numeric/ublas/detail/matrix_matrix_prod.hpp>
+
+// Tiled kernels for assigning trans (matrix) and herm (matrix) to a
+// dense matrix, reading and writing strided matrices (see detail/raw.hpp)
+// through their pointer.
+
+namespace boost { namespace numeric { namespace ublas {
+namespace detail {
+
+    // Tiles of tile x tile elements, a tile of the source and one of the
+    // target stay in cache while one is read across the other
+    struct matrix_transpose_size {
+        enum { tile = 32 };
+    };
+
+    // The kernels need a strided target and a strided matrix transposed
+    template<template <class T1, class T2> class F, class M, class E>
+    struct matrix_transpose_kernel_traits {
+        typedef typename boost::remove_const<typename E::expression_closure_type>::type closure_type;
+
+        BOOST_STATIC_CONSTANT (bool, value =
+            (boost::is_base_of<dense_proxy_tag, typename M::storage_category>::value &&
+             raw::strided_matrix_traits<M>::value &&
+             raw::strided_matrix_traits<closure_type>::value));
+    };
+
+    // W F= G (X) transposed, tile by tile. Threads own disjoint rows of W.
+    template<template <class T1, class T2> class F, class G, class T, class U>
+    void matrix_transpose_tiled (const raw::strided_matrix_view<T> &w, const raw::strided_matrix_view<const U> &x,
+                                 std::size_t size1, std::size_t size2) {
+        typedef F<T &, typename G::result_type> functor_type;
+        const std::size_t tile = matrix_transpose_size::tile;
+        std::ptrdiff_t tiles ((size1 + tile - 1) / tile);
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel for schedule (static) if (size1 * size2 >= BOOST_UBLAS_PARALLEL_THRESHOLD)
+#endif
+        for (std::ptrdiff_t t = 0; t < tiles; ++ t) {
+            std::size_t i0 (t * tile);
+            std::size_t i1 ((std::min) (size1, i0 + tile));
+            for (std::size_t j0 = 0; j0 < size2; j0 += tile) {
+                std::size_t j1 ((std::min) (size2, j0 + tile));
+                for (std::size_t i = i0; i < i1; ++ i)
+                    for (std::size_t j = j0; j < j1; ++ j)
+                        functor_type::apply (w (i, j), G::apply (x (j, i)));
+            }
+        }
+    }
+
+    // W F= trans (X) or herm (X), G the identity or conj
+    template<template <class T1, class T2> class F, class G, class M, class E>
+    void matrix_transpose_assign (M &m, const E &e, boost::true_type) {
+        std::size_t size1 (BOOST_UBLAS_SAME (m.size1 (), e.size1 ()));
+        std::size_t size2 (BOOST_UBLAS_SAME (m.size2 (), e.size2 ()));
+        matrix_transpose_tiled<F, G> (raw::strided_matrix (m), raw::strided_matrix (e.expression ()), size1, size2);
+    }
+    template<template <class T1, class T2> class F, class G, class M, class E>
+    BOOST_UBLAS_INLINE
+    void matrix_transpose_assign (M &m, const E &e, boost::false_type) {
+        element_matrix_assign<F> (m, e);
+    }
+
+}
+
+    // Transposes of dense matrices are assigned by the tiled kernels,
+    // everything else element by element
+    template<template <class T1, class T2> class F, class M, class E, class T>
+    BOOST_UBLAS_INLINE
+    void matrix_assign (M &m, const matrix_expression<matrix_unary2<E, scalar_identity<T> > > &e) {
+        typedef detail::matrix_transpose_kernel_traits<F, M, matrix_unary2<E, scalar_identity<T> > > kernel_traits;
+        detail::matrix_transpose_assign<F, scalar_identity<T> > (m, e (), boost::integral_constant<bool, kernel_traits::value> ());
+    }
+    template<template <class T1, class T2> class F, class M, class E, class T>
+    BOOST_UBLAS_INLINE
+    void matrix_assign (M &m, const matrix_expression<matrix_unary2<E, scalar_conj<T> > > &e) {
+        typedef detail::matrix_transpose_kernel_traits<F, M, matrix_unary2<E, scalar_conj<T> > > kernel_traits;
+        detail::matrix_transpose_assign<F, scalar_conj<T> > (m, e (), boost::integral_constant<bool, kernel_traits::value> ());
+    }
+
+}}}
+
+#endif
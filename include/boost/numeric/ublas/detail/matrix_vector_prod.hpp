@@ -0,0 +1,365 @@
+//
+//  Copyright (c) 2019
+//  The Boost.uBLAS developers
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef _BOOST_UBLAS_MATRIX_VECTOR_PROD_
+#define _BOOST_UBLAS_MATRIX_VECTOR_PROD_
+
+#include <cstddef>
+#include <boost/mpl/if.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/type_traits/is_base_of.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/type_traits/remove_const.hpp>
+#include <boost/numeric/ublas/matrix_expression.hpp>
+#include <boost/numeric/ublas/detail/raw.hpp>
+#include <boost/numeric/ublas/detail/blas_backend.hpp>
+#include <boost/numeric/ublas/detail/vector_assign.hpp>
+
+// Layout aware kernels for assigning prod (matrix, vector) and
+// prod (vector, matrix) to a dense vector, strided operands and their
+// trans () and herm () read through their pointer. With BOOST_UBLAS_USE_CBLAS
+// the products ?gemv takes go there first.
+
+namespace boost { namespace numeric { namespace ublas {
+namespace detail {
+
+    // Assignments the kernels handle, y = A x, y += A x and y -= A x
+    template<template <class T1, class T2> class F>
+    struct matrix_vector_prod_assign_traits {
+        BOOST_STATIC_CONSTANT (bool, supported = false);
+        BOOST_STATIC_CONSTANT (bool, clear = false);
+        BOOST_STATIC_CONSTANT (bool, negate = false);
+    };
+    template<>
+    struct matrix_vector_prod_assign_traits<scalar_assign> {
+        BOOST_STATIC_CONSTANT (bool, supported = true);
+        BOOST_STATIC_CONSTANT (bool, clear = true);
+        BOOST_STATIC_CONSTANT (bool, negate = false);
+    };
+    template<>
+    struct matrix_vector_prod_assign_traits<scalar_plus_assign> {
+        BOOST_STATIC_CONSTANT (bool, supported = true);
+        BOOST_STATIC_CONSTANT (bool, clear = false);
+        BOOST_STATIC_CONSTANT (bool, negate = false);
+    };
+    template<>
+    struct matrix_vector_prod_assign_traits<scalar_minus_assign> {
+        BOOST_STATIC_CONSTANT (bool, supported = true);
+        BOOST_STATIC_CONSTANT (bool, clear = false);
+        BOOST_STATIC_CONSTANT (bool, negate = true);
+    };
+
+    // The kernels need dense operands and a target of the product's value type
+    template<template <class T1, class T2> class F, class V, class M, class E, class T>
+    struct matrix_vector_prod_kernel_traits {
+        BOOST_STATIC_CONSTANT (bool, value =
+            (matrix_vector_prod_assign_traits<F>::supported &&
+             boost::is_base_of<dense_proxy_tag, typename V::storage_category>::value &&
+             boost::is_base_of<dense_proxy_tag, typename M::storage_category>::value &&
+             boost::is_base_of<dense_proxy_tag, typename E::storage_category>::value &&
+             boost::is_same<typename V::value_type, T>::value));
+    };
+
+    // Strided operands (see detail/raw.hpp) are read through their
+    // pointer, the others through their own operator ()
+    template<class V, bool = raw::strided_vector_traits<V>::value>
+    struct vector_operand_traits {
+        typedef const V &type;
+
+        static BOOST_UBLAS_INLINE
+        type get (const V &v) {
+            return v;
+        }
+    };
+    template<class V>
+    struct vector_operand_traits<V, true> {
+        typedef raw::strided_vector_view<const typename V::value_type> type;
+
+        static BOOST_UBLAS_INLINE
+        type get (const V &v) {
+            return raw::strided_vector (v);
+        }
+    };
+    template<class M, bool = raw::strided_matrix_traits<M>::value>
+    struct matrix_operand_traits {
+        typedef const M &type;
+
+        static BOOST_UBLAS_INLINE
+        type get (const M &m) {
+            return m;
+        }
+    };
+    template<class M>
+    struct matrix_operand_traits<M, true> {
+        typedef raw::strided_matrix_view<const typename M::value_type> type;
+
+        static BOOST_UBLAS_INLINE
+        type get (const M &m) {
+            return raw::strided_matrix (m);
+        }
+    };
+
+    // herm (A) of a strided A, read through the pointer of A and conjugated
+    template<class T>
+    struct conj_strided_matrix_view {
+        typedef std::size_t size_type;
+        typedef T value_type;
+
+        BOOST_UBLAS_INLINE
+        explicit conj_strided_matrix_view (const raw::strided_matrix_view<const T> &m):
+            m_ (m) {}
+        BOOST_UBLAS_INLINE
+        value_type operator () (size_type i, size_type j) const {
+            return scalar_conj<T>::apply (m_ (i, j));
+        }
+
+        raw::strided_matrix_view<const T> m_;
+    };
+    template<class M, bool = raw::strided_matrix_traits<typename boost::remove_const<typename M::expression_closure_type>::type>::value>
+    struct conj_matrix_operand_traits:
+        public matrix_operand_traits<M, false> {};
+    template<class M>
+    struct conj_matrix_operand_traits<M, true> {
+        typedef typename M::value_type value_type;
+        typedef conj_strided_matrix_view<value_type> type;
+
+        static BOOST_UBLAS_INLINE
+        type get (const M &m) {
+            raw::strided_matrix_view<const value_type> e (raw::strided_matrix (m.expression ()));
+            return type (raw::strided_matrix_view<const value_type> (e.data_, e.stride2_, e.stride1_));
+        }
+    };
+    template<class E, class T>
+    struct matrix_operand_traits<matrix_unary2<E, scalar_conj<T> >, false>:
+        public conj_matrix_operand_traits<matrix_unary2<E, scalar_conj<T> > > {};
+    template<class E, class T>
+    struct matrix_operand_traits<const matrix_unary2<E, scalar_conj<T> >, false>:
+        public conj_matrix_operand_traits<matrix_unary2<E, scalar_conj<T> > > {};
+
+    // A seen as is for prod (A, x) and transposed for prod (x, A)
+    template<class M>
+    struct matrix_vector_operand {
+        typedef typename M::size_type size_type;
+        typedef typename M::value_type value_type;
+
+        BOOST_UBLAS_INLINE
+        explicit matrix_vector_operand (const M &m):
+            m_ (matrix_operand_traits<M>::get (m)), size1_ (m.size1 ()), size2_ (m.size2 ()) {}
+        BOOST_UBLAS_INLINE
+        size_type size1 () const {
+            return size1_;
+        }
+        BOOST_UBLAS_INLINE
+        size_type size2 () const {
+            return size2_;
+        }
+        BOOST_UBLAS_INLINE
+        value_type operator () (size_type i, size_type j) const {
+            return m_ (i, j);
+        }
+
+        typename matrix_operand_traits<M>::type m_;
+        size_type size1_;
+        size_type size2_;
+    };
+    template<class M>
+    struct transposed_matrix_vector_operand {
+        typedef typename M::size_type size_type;
+        typedef typename M::value_type value_type;
+
+        BOOST_UBLAS_INLINE
+        explicit transposed_matrix_vector_operand (const M &m):
+            m_ (matrix_operand_traits<M>::get (m)), size1_ (m.size2 ()), size2_ (m.size1 ()) {}
+        BOOST_UBLAS_INLINE
+        size_type size1 () const {
+            return size1_;
+        }
+        BOOST_UBLAS_INLINE
+        size_type size2 () const {
+            return size2_;
+        }
+        BOOST_UBLAS_INLINE
+        value_type operator () (size_type i, size_type j) const {
+            return m_ (j, i);
+        }
+
+        typename matrix_operand_traits<M>::type m_;
+        size_type size1_;
+        size_type size2_;
+    };
+
+    // Dot form for rows of A contiguous in memory. Four rows at a time
+    // share the loads of x, each row is summed in the order of the generic
+    // evaluation.
+    template<template <class T1, class T2> class F, class V, class A, class E>
+    void matrix_vector_prod_dot (V &v, const A &a, const E &x) {
+        typedef F<typename V::reference, typename V::value_type> functor_type;
+        typedef typename V::value_type value_type;
+        typedef typename A::size_type size_type;
+        size_type size1 (a.size1 ()), size2 (a.size2 ());
+        std::ptrdiff_t blocks ((size1 + 3) / 4);
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel for schedule (static) if (size1 * size2 >= BOOST_UBLAS_PARALLEL_THRESHOLD)
+#endif
+        for (std::ptrdiff_t b = 0; b < blocks; ++ b) {
+            size_type i (4 * b);
+            if (i + 4 <= size1) {
+                value_type t0 = value_type (), t1 = value_type (), t2 = value_type (), t3 = value_type ();
+                for (size_type j = 0; j < size2; ++ j) {
+                    value_type xj (x (j));
+                    t0 += a (i, j) * xj;
+                    t1 += a (i + 1, j) * xj;
+                    t2 += a (i + 2, j) * xj;
+                    t3 += a (i + 3, j) * xj;
+                }
+                functor_type::apply (v (i), t0);
+                functor_type::apply (v (i + 1), t1);
+                functor_type::apply (v (i + 2), t2);
+                functor_type::apply (v (i + 3), t3);
+            } else {
+                for (; i < size1; ++ i) {
+                    value_type t = value_type ();
+                    for (size_type j = 0; j < size2; ++ j)
+                        t += a (i, j) * x (j);
+                    functor_type::apply (v (i), t);
+                }
+            }
+        }
+    }
+
+    // Axpy form for columns of A contiguous in memory. Four columns at a
+    // time are added to a block of rows of v, so v is loaded and stored
+    // once per four columns. Threads own disjoint blocks of rows.
+    template<template <class T1, class T2> class F, class V, class A, class E>
+    void matrix_vector_prod_axpy (V &v, const A &a, const E &x) {
+        typedef matrix_vector_prod_assign_traits<F> assign_traits;
+        typedef typename V::value_type value_type;
+        typedef typename A::size_type size_type;
+        const size_type rows = 256;
+        size_type size1 (a.size1 ()), size2 (a.size2 ());
+        std::ptrdiff_t blocks ((size1 + rows - 1) / rows);
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel for schedule (static) if (size1 * size2 >= BOOST_UBLAS_PARALLEL_THRESHOLD)
+#endif
+        for (std::ptrdiff_t b = 0; b < blocks; ++ b) {
+            size_type first (rows * b);
+            size_type last ((std::min) (size1, first + rows));
+            if (assign_traits::clear)
+                for (size_type i = first; i < last; ++ i)
+                    v (i) = value_type ();
+            size_type j (0);
+            for (; j + 4 <= size2; j += 4) {
+                value_type x0 (x (j)), x1 (x (j + 1)), x2 (x (j + 2)), x3 (x (j + 3));
+                if (assign_traits::negate)
+                    x0 = - x0, x1 = - x1, x2 = - x2, x3 = - x3;
+                for (size_type i = first; i < last; ++ i)
+                    v (i) = (((v (i) + a (i, j) * x0) + a (i, j + 1) * x1) + a (i, j + 2) * x2) + a (i, j + 3) * x3;
+            }
+            for (; j < size2; ++ j) {
+                value_type xj (x (j));
+                if (assign_traits::negate)
+                    xj = - xj;
+                for (size_type i = first; i < last; ++ i)
+                    v (i) += a (i, j) * xj;
+            }
+        }
+    }
+
+    template<template <class T1, class T2> class F, class V, class A, class E>
+    BOOST_UBLAS_INLINE
+    void matrix_vector_prod (V &v, const A &a, const E &x, row_major_tag) {
+        matrix_vector_prod_dot<F> (v, a, x);
+    }
+    template<template <class T1, class T2> class F, class V, class A, class E>
+    BOOST_UBLAS_INLINE
+    void matrix_vector_prod (V &v, const A &a, const E &x, column_major_tag) {
+        matrix_vector_prod_axpy<F> (v, a, x);
+    }
+
+    // The dispatcher of vector_assign.hpp, for products the kernels do not handle
+    template<template <class T1, class T2> class F, class V, class E>
+    BOOST_UBLAS_INLINE
+    void element_vector_assign (V &v, const vector_expression<E> &e) {
+        typedef typename vector_assign_traits<typename V::storage_category,
+                                              F<typename V::reference, typename E::value_type>::computed,
+                                              typename E::const_iterator::iterator_category>::storage_category storage_category;
+        vector_assign<F> (v, e, storage_category ());
+    }
+
+    // y F= A x
+    template<template <class T1, class T2> class F, class V, class E>
+    void matrix_vector_prod1_assign (V &v, const E &e, boost::true_type) {
+        typedef typename E::expression1_closure_type matrix_type;
+        const matrix_type &m (e.expression1 ());
+        BOOST_UBLAS_CHECK (v.size () == m.size1 (), bad_size ());
+        BOOST_UBLAS_CHECK (m.size2 () == e.expression2 ().size (), bad_size ());
+        typedef typename boost::mpl::if_<boost::is_same<typename matrix_type::orientation_category, column_major_tag>,
+                                         column_major_tag, row_major_tag>::type orientation_category;
+        typedef typename E::expression2_closure_type vector_type;
+#ifdef BOOST_UBLAS_USE_CBLAS
+        typedef matrix_vector_prod_assign_traits<F> assign_traits;
+        typedef typename V::value_type value_type;
+        if (blas_matrix_vector_prod<V, matrix_type, vector_type>::apply (v, m, e.expression2 (),
+                value_type (assign_traits::negate ? -1 : 1), value_type (assign_traits::clear ? 0 : 1), false))
+            return;
+#endif
+        matrix_vector_prod<F> (v, matrix_vector_operand<matrix_type> (m),
+                               vector_operand_traits<vector_type>::get (e.expression2 ()), orientation_category ());
+    }
+    template<template <class T1, class T2> class F, class V, class E>
+    BOOST_UBLAS_INLINE
+    void matrix_vector_prod1_assign (V &v, const E &e, boost::false_type) {
+        element_vector_assign<F> (v, e);
+    }
+    // y F= x A
+    template<template <class T1, class T2> class F, class V, class E>
+    void matrix_vector_prod2_assign (V &v, const E &e, boost::true_type) {
+        typedef typename E::expression2_closure_type matrix_type;
+        const matrix_type &m (e.expression2 ());
+        BOOST_UBLAS_CHECK (v.size () == m.size2 (), bad_size ());
+        BOOST_UBLAS_CHECK (m.size1 () == e.expression1 ().size (), bad_size ());
+        typedef typename boost::mpl::if_<boost::is_same<typename matrix_type::orientation_category, row_major_tag>,
+                                         column_major_tag, row_major_tag>::type orientation_category;
+        typedef typename E::expression1_closure_type vector_type;
+#ifdef BOOST_UBLAS_USE_CBLAS
+        typedef matrix_vector_prod_assign_traits<F> assign_traits;
+        typedef typename V::value_type value_type;
+        if (blas_matrix_vector_prod<V, matrix_type, vector_type>::apply (v, m, e.expression1 (),
+                value_type (assign_traits::negate ? -1 : 1), value_type (assign_traits::clear ? 0 : 1), true))
+            return;
+#endif
+        matrix_vector_prod<F> (v, transposed_matrix_vector_operand<matrix_type> (m),
+                               vector_operand_traits<vector_type>::get (e.expression1 ()), orientation_category ());
+    }
+    template<template <class T1, class T2> class F, class V, class E>
+    BOOST_UBLAS_INLINE
+    void matrix_vector_prod2_assign (V &v, const E &e, boost::false_type) {
+        element_vector_assign<F> (v, e);
+    }
+
+}
+
+    // Dense matrix vector products are assigned by the layout aware kernels,
+    // everything else element by element
+    template<template <class T1, class T2> class F, class V, class E1, class E2, class T>
+    BOOST_UBLAS_INLINE
+    void vector_assign (V &v, const vector_expression<matrix_vector_binary1<E1, E2, matrix_vector_prod1<E1, E2, T> > > &e) {
+        typedef detail::matrix_vector_prod_kernel_traits<F, V, E1, E2, T> kernel_traits;
+        detail::matrix_vector_prod1_assign<F> (v, e (), boost::integral_constant<bool, kernel_traits::value> ());
+    }
+    template<template <class T1, class T2> class F, class V, class E1, class E2, class T>
+    BOOST_UBLAS_INLINE
+    void vector_assign (V &v, const vector_expression<matrix_vector_binary2<E1, E2, matrix_vector_prod2<E1, E2, T> > > &e) {
+        typedef detail::matrix_vector_prod_kernel_traits<F, V, E2, E1, T> kernel_traits;
+        detail::matrix_vector_prod2_assign<F> (v, e (), boost::integral_constant<bool, kernel_traits::value> ());
+    }
+
+}}}
+
+#endif
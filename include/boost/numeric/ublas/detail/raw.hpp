@@ -11,6 +11,24 @@
 #ifndef _BOOST_UBLAS_RAW_
 #define _BOOST_UBLAS_RAW_
 
+#include <cstddef>
+#include <vector>
+#include <boost/type_traits/remove_const.hpp>
+#include <boost/numeric/ublas/detail/config.hpp>
+#include <boost/numeric/ublas/fwd.hpp>
+#ifdef BOOST_UBLAS_CPP_GE_2011
+#include <array>
+#endif
+
+namespace boost { namespace numeric { namespace ublas {
+
+    template<class T>
+    struct scalar_identity;
+    template<class E, class F>
+    class matrix_unary2;
+
+}}}
+
 namespace boost { namespace numeric { namespace ublas { namespace raw {
 
     // We need data_const() mostly due to MSVC 6.0.
@@ -873,6 +891,540 @@ namespace boost { namespace numeric { namespace ublas { namespace raw {
         return m.start1() * stride1( m.data () ) + m.start2() * stride2( m.data () ) ;
     }
 
+    /** \brief Strided views of dense vectors, matrices and tensors.
+     *
+     * strided_vector_traits<V>::value is true when the elements of V lie
+     * in memory at data (v) + i * stride (v), strided_matrix_traits<M>
+     * when they lie at data (m) + i * stride1 (m) + j * stride2 (m), and
+     * strided_tensor_traits<T> when they lie at data (t) plus the sum of
+     * the indices times strides (t). Kernels test value at compile time
+     * and run on the pointer, whatever container or proxy they are given;
+     * value is false for everything else. trans () of a strided matrix
+     * is strided too, herm () is not as its elements are conjugated. Const
+     * types have the traits of the mutable ones, data () then returns a
+     * pointer to const.
+     */
+    template<class A>
+    struct strided_array_traits {
+        BOOST_STATIC_CONSTANT (bool, value = false);
+    };
+    template<class T, class ALLOC>
+    struct strided_array_traits<unbounded_array<T, ALLOC> > {
+        BOOST_STATIC_CONSTANT (bool, value = true);
+
+        static BOOST_UBLAS_INLINE
+        const T *data (const unbounded_array<T, ALLOC> &a) {
+            return a.begin ();
+        }
+        static BOOST_UBLAS_INLINE
+        T *data (unbounded_array<T, ALLOC> &a) {
+            return a.begin ();
+        }
+    };
+    template<class T, std::size_t N, class ALLOC>
+    struct strided_array_traits<bounded_array<T, N, ALLOC> > {
+        BOOST_STATIC_CONSTANT (bool, value = true);
+
+        static BOOST_UBLAS_INLINE
+        const T *data (const bounded_array<T, N, ALLOC> &a) {
+            return a.begin ();
+        }
+        static BOOST_UBLAS_INLINE
+        T *data (bounded_array<T, N, ALLOC> &a) {
+            return a.begin ();
+        }
+    };
+    template<class T, class ALLOC>
+    struct strided_array_traits<std::vector<T, ALLOC> > {
+        BOOST_STATIC_CONSTANT (bool, value = true);
+
+        static BOOST_UBLAS_INLINE
+        const T *data (const std::vector<T, ALLOC> &a) {
+            return a.empty () ? 0 : &a [0];
+        }
+        static BOOST_UBLAS_INLINE
+        T *data (std::vector<T, ALLOC> &a) {
+            return a.empty () ? 0 : &a [0];
+        }
+    };
+    // Packed bits
+    template<class ALLOC>
+    struct strided_array_traits<std::vector<bool, ALLOC> > {
+        BOOST_STATIC_CONSTANT (bool, value = false);
+    };
+#ifdef BOOST_UBLAS_CPP_GE_2011
+    template<class T, std::size_t N>
+    struct strided_array_traits<std::array<T, N> > {
+        BOOST_STATIC_CONSTANT (bool, value = true);
+
+        static BOOST_UBLAS_INLINE
+        const T *data (const std::array<T, N> &a) {
+            return a.data ();
+        }
+        static BOOST_UBLAS_INLINE
+        T *data (std::array<T, N> &a) {
+            return a.data ();
+        }
+    };
+#endif
+
+    template<class V>
+    struct strided_vector_traits {
+        BOOST_STATIC_CONSTANT (bool, value = false);
+    };
+    template<class V>
+    struct strided_vector_traits<const V>:
+        public strided_vector_traits<V> {};
+
+    template<class M>
+    struct strided_matrix_traits {
+        BOOST_STATIC_CONSTANT (bool, value = false);
+    };
+    template<class M>
+    struct strided_matrix_traits<const M>:
+        public strided_matrix_traits<M> {};
+
+    // Specialized in tensor/tensor.hpp, with rank (t), extents (t) and
+    // contiguous (t), true if the elements fill data (t) in the storage order
+    template<class T>
+    struct strided_tensor_traits {
+        BOOST_STATIC_CONSTANT (bool, value = false);
+    };
+    template<class T>
+    struct strided_tensor_traits<const T>:
+        public strided_tensor_traits<T> {};
+
+    // Containers
+    template<class T, class A>
+    struct strided_vector_traits<vector<T, A> > {
+        typedef strided_array_traits<A> array_traits;
+
+        BOOST_STATIC_CONSTANT (bool, value = array_traits::value);
+
+        static BOOST_UBLAS_INLINE
+        const T *data (const vector<T, A> &v) {
+            return array_traits::data (v.data ());
+        }
+        static BOOST_UBLAS_INLINE
+        T *data (vector<T, A> &v) {
+            return array_traits::data (v.data ());
+        }
+        static BOOST_UBLAS_INLINE
+        std::ptrdiff_t stride (const vector<T, A> &) {
+            return 1;
+        }
+    };
+    template<class T, std::size_t N>
+    struct strided_vector_traits<bounded_vector<T, N> >:
+        public strided_vector_traits<vector<T, bounded_array<T, N> > > {};
+#ifdef BOOST_UBLAS_CPP_GE_2011
+    template<class T, std::size_t N, class A>
+    struct strided_vector_traits<fixed_vector<T, N, A> > {
+        typedef strided_array_traits<A> array_traits;
+
+        BOOST_STATIC_CONSTANT (bool, value = array_traits::value);
+
+        static BOOST_UBLAS_INLINE
+        const T *data (const fixed_vector<T, N, A> &v) {
+            return array_traits::data (v.data ());
+        }
+        static BOOST_UBLAS_INLINE
+        T *data (fixed_vector<T, N, A> &v) {
+            return array_traits::data (v.data ());
+        }
+        static BOOST_UBLAS_INLINE
+        std::ptrdiff_t stride (const fixed_vector<T, N, A> &) {
+            return 1;
+        }
+    };
+#endif
+    template<class T, std::size_t N>
+    struct strided_vector_traits<c_vector<T, N> > {
+        BOOST_STATIC_CONSTANT (bool, value = true);
+
+        static BOOST_UBLAS_INLINE
+        const T *data (const c_vector<T, N> &v) {
+            return v.data ();
+        }
+        static BOOST_UBLAS_INLINE
+        T *data (c_vector<T, N> &v) {
+            return v.data ();
+        }
+        static BOOST_UBLAS_INLINE
+        std::ptrdiff_t stride (const c_vector<T, N> &) {
+            return 1;
+        }
+    };
+
+    // Distances between two rows and between two columns of a dense layout
+    template<class O>
+    struct layout_strides;
+    template<>
+    struct layout_strides<row_major_tag> {
+        static BOOST_UBLAS_INLINE
+        std::ptrdiff_t stride1 (std::size_t, std::size_t size2) {
+            return size2;
+        }
+        static BOOST_UBLAS_INLINE
+        std::ptrdiff_t stride2 (std::size_t, std::size_t) {
+            return 1;
+        }
+    };
+    template<>
+    struct layout_strides<column_major_tag> {
+        static BOOST_UBLAS_INLINE
+        std::ptrdiff_t stride1 (std::size_t, std::size_t) {
+            return 1;
+        }
+        static BOOST_UBLAS_INLINE
+        std::ptrdiff_t stride2 (std::size_t size1, std::size_t) {
+            return size1;
+        }
+    };
+
+    template<class T, class L, class A>
+    struct strided_matrix_traits<matrix<T, L, A> > {
+        typedef strided_array_traits<A> array_traits;
+
+        BOOST_STATIC_CONSTANT (bool, value = array_traits::value);
+
+        static BOOST_UBLAS_INLINE
+        const T *data (const matrix<T, L, A> &m) {
+            return array_traits::data (m.data ());
+        }
+        static BOOST_UBLAS_INLINE
+        T *data (matrix<T, L, A> &m) {
+            return array_traits::data (m.data ());
+        }
+        static BOOST_UBLAS_INLINE
+        std::ptrdiff_t stride1 (const matrix<T, L, A> &m) {
+            return layout_strides<typename L::orientation_category>::stride1 (m.size1 (), m.size2 ());
+        }
+        static BOOST_UBLAS_INLINE
+        std::ptrdiff_t stride2 (const matrix<T, L, A> &m) {
+            return layout_strides<typename L::orientation_category>::stride2 (m.size1 (), m.size2 ());
+        }
+    };
+    template<class T, std::size_t M, std::size_t N, class L>
+    struct strided_matrix_traits<bounded_matrix<T, M, N, L> >:
+        public strided_matrix_traits<matrix<T, L, bounded_array<T, M * N> > > {};
+#ifdef BOOST_UBLAS_CPP_GE_2011
+    template<class T, std::size_t M, std::size_t N, class L, class A>
+    struct strided_matrix_traits<fixed_matrix<T, M, N, L, A> > {
+        typedef strided_array_traits<A> array_traits;
+
+        BOOST_STATIC_CONSTANT (bool, value = array_traits::value);
+
+        static BOOST_UBLAS_INLINE
+        const T *data (const fixed_matrix<T, M, N, L, A> &m) {
+            return array_traits::data (m.data ());
+        }
+        static BOOST_UBLAS_INLINE
+        T *data (fixed_matrix<T, M, N, L, A> &m) {
+            return array_traits::data (m.data ());
+        }
+        static BOOST_UBLAS_INLINE
+        std::ptrdiff_t stride1 (const fixed_matrix<T, M, N, L, A> &) {
+            return layout_strides<typename L::orientation_category>::stride1 (M, N);
+        }
+        static BOOST_UBLAS_INLINE
+        std::ptrdiff_t stride2 (const fixed_matrix<T, M, N, L, A> &) {
+            return layout_strides<typename L::orientation_category>::stride2 (M, N);
+        }
+    };
+#endif
+    // Rows of M elements whatever the size
+    template<class T, std::size_t N, std::size_t M>
+    struct strided_matrix_traits<c_matrix<T, N, M> > {
+        BOOST_STATIC_CONSTANT (bool, value = true);
+
+        static BOOST_UBLAS_INLINE
+        const T *data (const c_matrix<T, N, M> &m) {
+            return m.data ();
+        }
+        static BOOST_UBLAS_INLINE
+        T *data (c_matrix<T, N, M> &m) {
+            return m.data ();
+        }
+        static BOOST_UBLAS_INLINE
+        std::ptrdiff_t stride1 (const c_matrix<T, N, M> &) {
+            return M;
+        }
+        static BOOST_UBLAS_INLINE
+        std::ptrdiff_t stride2 (const c_matrix<T, N, M> &) {
+            return 1;
+        }
+    };
+
+    // References
+    template<class V>
+    struct strided_vector_traits<vector_reference<V> > {
+        typedef strided_vector_traits<V> referred_traits;
+
+        BOOST_STATIC_CONSTANT (bool, value = referred_traits::value);
+
+        static BOOST_UBLAS_INLINE
+        const typename V::value_type *data (const vector_reference<V> &v) {
+            return referred_traits::data (v.expression ());
+        }
+        static BOOST_UBLAS_INLINE
+        typename V::value_type *data (vector_reference<V> &v) {
+            return referred_traits::data (v.expression ());
+        }
+        static BOOST_UBLAS_INLINE
+        std::ptrdiff_t stride (const vector_reference<V> &v) {
+            return referred_traits::stride (v.expression ());
+        }
+    };
+    template<class M>
+    struct strided_matrix_traits<matrix_reference<M> > {
+        typedef strided_matrix_traits<M> referred_traits;
+
+        BOOST_STATIC_CONSTANT (bool, value = referred_traits::value);
+
+        static BOOST_UBLAS_INLINE
+        const typename M::value_type *data (const matrix_reference<M> &m) {
+            return referred_traits::data (m.expression ());
+        }
+        static BOOST_UBLAS_INLINE
+        typename M::value_type *data (matrix_reference<M> &m) {
+            return referred_traits::data (m.expression ());
+        }
+        static BOOST_UBLAS_INLINE
+        std::ptrdiff_t stride1 (const matrix_reference<M> &m) {
+            return referred_traits::stride1 (m.expression ());
+        }
+        static BOOST_UBLAS_INLINE
+        std::ptrdiff_t stride2 (const matrix_reference<M> &m) {
+            return referred_traits::stride2 (m.expression ());
+        }
+    };
+
+    // Proxies, strided when what they refer to is
+    template<class V>
+    struct strided_vector_traits<vector_range<V> > {
+        typedef vector_range<V> vector_type;
+        typedef strided_vector_traits<typename boost::remove_const<typename vector_type::vector_closure_type>::type> closure_traits;
+
+        BOOST_STATIC_CONSTANT (bool, value = closure_traits::value);
+
+        static BOOST_UBLAS_INLINE
+        const typename V::value_type *data (const vector_type &v) {
+            return closure_traits::data (v.data ()) + std::ptrdiff_t (v.start ()) * stride (v);
+        }
+        static BOOST_UBLAS_INLINE
+        typename V::value_type *data (vector_type &v) {
+            return closure_traits::data (v.data ()) + std::ptrdiff_t (v.start ()) * stride (v);
+        }
+        static BOOST_UBLAS_INLINE
+        std::ptrdiff_t stride (const vector_type &v) {
+            return closure_traits::stride (v.data ());
+        }
+    };
+    template<class V>
+    struct strided_vector_traits<vector_slice<V> > {
+        typedef vector_slice<V> vector_type;
+        typedef strided_vector_traits<typename boost::remove_const<typename vector_type::vector_closure_type>::type> closure_traits;
+
+        BOOST_STATIC_CONSTANT (bool, value = closure_traits::value);
+
+        static BOOST_UBLAS_INLINE
+        const typename V::value_type *data (const vector_type &v) {
+            return closure_traits::data (v.data ()) + std::ptrdiff_t (v.start ()) * closure_traits::stride (v.data ());
+        }
+        static BOOST_UBLAS_INLINE
+        typename V::value_type *data (vector_type &v) {
+            return closure_traits::data (v.data ()) + std::ptrdiff_t (v.start ()) * closure_traits::stride (v.data ());
+        }
+        static BOOST_UBLAS_INLINE
+        std::ptrdiff_t stride (const vector_type &v) {
+            return std::ptrdiff_t (v.stride ()) * closure_traits::stride (v.data ());
+        }
+    };
+    template<class M>
+    struct strided_vector_traits<matrix_row<M> > {
+        typedef matrix_row<M> vector_type;
+        typedef strided_matrix_traits<typename boost::remove_const<typename vector_type::matrix_closure_type>::type> closure_traits;
+
+        BOOST_STATIC_CONSTANT (bool, value = closure_traits::value);
+
+        static BOOST_UBLAS_INLINE
+        const typename M::value_type *data (const vector_type &v) {
+            return closure_traits::data (v.data ()) + std::ptrdiff_t (v.index ()) * closure_traits::stride1 (v.data ());
+        }
+        static BOOST_UBLAS_INLINE
+        typename M::value_type *data (vector_type &v) {
+            return closure_traits::data (v.data ()) + std::ptrdiff_t (v.index ()) * closure_traits::stride1 (v.data ());
+        }
+        static BOOST_UBLAS_INLINE
+        std::ptrdiff_t stride (const vector_type &v) {
+            return closure_traits::stride2 (v.data ());
+        }
+    };
+    template<class M>
+    struct strided_vector_traits<matrix_column<M> > {
+        typedef matrix_column<M> vector_type;
+        typedef strided_matrix_traits<typename boost::remove_const<typename vector_type::matrix_closure_type>::type> closure_traits;
+
+        BOOST_STATIC_CONSTANT (bool, value = closure_traits::value);
+
+        static BOOST_UBLAS_INLINE
+        const typename M::value_type *data (const vector_type &v) {
+            return closure_traits::data (v.data ()) + std::ptrdiff_t (v.index ()) * closure_traits::stride2 (v.data ());
+        }
+        static BOOST_UBLAS_INLINE
+        typename M::value_type *data (vector_type &v) {
+            return closure_traits::data (v.data ()) + std::ptrdiff_t (v.index ()) * closure_traits::stride2 (v.data ());
+        }
+        static BOOST_UBLAS_INLINE
+        std::ptrdiff_t stride (const vector_type &v) {
+            return closure_traits::stride1 (v.data ());
+        }
+    };
+    template<class M>
+    struct strided_matrix_traits<matrix_range<M> > {
+        typedef matrix_range<M> matrix_type;
+        typedef strided_matrix_traits<typename boost::remove_const<typename matrix_type::matrix_closure_type>::type> closure_traits;
+
+        BOOST_STATIC_CONSTANT (bool, value = closure_traits::value);
+
+        static BOOST_UBLAS_INLINE
+        const typename M::value_type *data (const matrix_type &m) {
+            return closure_traits::data (m.data ()) + offset (m);
+        }
+        static BOOST_UBLAS_INLINE
+        typename M::value_type *data (matrix_type &m) {
+            return closure_traits::data (m.data ()) + offset (m);
+        }
+        static BOOST_UBLAS_INLINE
+        std::ptrdiff_t stride1 (const matrix_type &m) {
+            return closure_traits::stride1 (m.data ());
+        }
+        static BOOST_UBLAS_INLINE
+        std::ptrdiff_t stride2 (const matrix_type &m) {
+            return closure_traits::stride2 (m.data ());
+        }
+        static BOOST_UBLAS_INLINE
+        std::ptrdiff_t offset (const matrix_type &m) {
+            return std::ptrdiff_t (m.start1 ()) * stride1 (m) + std::ptrdiff_t (m.start2 ()) * stride2 (m);
+        }
+    };
+    template<class M>
+    struct strided_matrix_traits<matrix_slice<M> > {
+        typedef matrix_slice<M> matrix_type;
+        typedef strided_matrix_traits<typename boost::remove_const<typename matrix_type::matrix_closure_type>::type> closure_traits;
+
+        BOOST_STATIC_CONSTANT (bool, value = closure_traits::value);
+
+        static BOOST_UBLAS_INLINE
+        const typename M::value_type *data (const matrix_type &m) {
+            return closure_traits::data (m.data ()) + offset (m);
+        }
+        static BOOST_UBLAS_INLINE
+        typename M::value_type *data (matrix_type &m) {
+            return closure_traits::data (m.data ()) + offset (m);
+        }
+        static BOOST_UBLAS_INLINE
+        std::ptrdiff_t stride1 (const matrix_type &m) {
+            return std::ptrdiff_t (m.stride1 ()) * closure_traits::stride1 (m.data ());
+        }
+        static BOOST_UBLAS_INLINE
+        std::ptrdiff_t stride2 (const matrix_type &m) {
+            return std::ptrdiff_t (m.stride2 ()) * closure_traits::stride2 (m.data ());
+        }
+        static BOOST_UBLAS_INLINE
+        std::ptrdiff_t offset (const matrix_type &m) {
+            return std::ptrdiff_t (m.start1 ()) * closure_traits::stride1 (m.data ()) +
+                   std::ptrdiff_t (m.start2 ()) * closure_traits::stride2 (m.data ());
+        }
+    };
+
+    // Transposes, strided with the strides of what they refer to swapped,
+    // read only as matrix_unary2 gives no mutable access to its expression
+    template<class E, class T>
+    struct strided_matrix_traits<matrix_unary2<E, scalar_identity<T> > > {
+        typedef matrix_unary2<E, scalar_identity<T> > matrix_type;
+        typedef typename boost::remove_const<typename matrix_type::expression_closure_type>::type closure_type;
+        typedef strided_matrix_traits<closure_type> closure_traits;
+
+        BOOST_STATIC_CONSTANT (bool, value = closure_traits::value);
+
+        static BOOST_UBLAS_INLINE
+        const T *data (const matrix_type &m) {
+            return closure_traits::data (m.expression ());
+        }
+        static BOOST_UBLAS_INLINE
+        std::ptrdiff_t stride1 (const matrix_type &m) {
+            return closure_traits::stride2 (m.expression ());
+        }
+        static BOOST_UBLAS_INLINE
+        std::ptrdiff_t stride2 (const matrix_type &m) {
+            return closure_traits::stride1 (m.expression ());
+        }
+    };
+
+    // Element i, or (i, j), of a strided operand
+    template<class T>
+    struct strided_vector_view {
+        typedef std::size_t size_type;
+        typedef T value_type;
+        typedef T &reference;
+
+        BOOST_UBLAS_INLINE
+        strided_vector_view (T *data, std::ptrdiff_t stride):
+            data_ (data), stride_ (stride) {}
+        BOOST_UBLAS_INLINE
+        T &operator () (size_type i) const {
+            return data_ [std::ptrdiff_t (i) * stride_];
+        }
+
+        T *data_;
+        std::ptrdiff_t stride_;
+    };
+    template<class T>
+    struct strided_matrix_view {
+        typedef std::size_t size_type;
+        typedef T value_type;
+        typedef T &reference;
+
+        BOOST_UBLAS_INLINE
+        strided_matrix_view (T *data, std::ptrdiff_t stride1, std::ptrdiff_t stride2):
+            data_ (data), stride1_ (stride1), stride2_ (stride2) {}
+        BOOST_UBLAS_INLINE
+        T &operator () (size_type i, size_type j) const {
+            return data_ [std::ptrdiff_t (i) * stride1_ + std::ptrdiff_t (j) * stride2_];
+        }
+
+        T *data_;
+        std::ptrdiff_t stride1_;
+        std::ptrdiff_t stride2_;
+    };
+
+    template<class V>
+    BOOST_UBLAS_INLINE
+    strided_vector_view<const typename V::value_type> strided_vector (const V &v) {
+        typedef strided_vector_traits<V> traits;
+        return strided_vector_view<const typename V::value_type> (traits::data (v), traits::stride (v));
+    }
+    template<class V>
+    BOOST_UBLAS_INLINE
+    strided_vector_view<typename V::value_type> strided_vector (V &v) {
+        typedef strided_vector_traits<V> traits;
+        return strided_vector_view<typename V::value_type> (traits::data (v), traits::stride (v));
+    }
+    template<class M>
+    BOOST_UBLAS_INLINE
+    strided_matrix_view<const typename M::value_type> strided_matrix (const M &m) {
+        typedef strided_matrix_traits<M> traits;
+        return strided_matrix_view<const typename M::value_type> (traits::data (m), traits::stride1 (m), traits::stride2 (m));
+    }
+    template<class M>
+    BOOST_UBLAS_INLINE
+    strided_matrix_view<typename M::value_type> strided_matrix (M &m) {
+        typedef strided_matrix_traits<M> traits;
+        return strided_matrix_view<typename M::value_type> (traits::data (m), traits::stride1 (m), traits::stride2 (m));
+    }
+
 }}}}
 
 #endif
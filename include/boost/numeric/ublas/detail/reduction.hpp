@@ -0,0 +1,440 @@
+//
+//  Copyright (c) 2019
+//  The Boost.uBLAS developers
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef _BOOST_UBLAS_REDUCTION_
+#define _BOOST_UBLAS_REDUCTION_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+#include <boost/type_traits/is_floating_point.hpp>
+#include <boost/numeric/ublas/traits.hpp>
+
+namespace boost { namespace numeric { namespace ublas {
+
+    /** \brief Summations of the dense reductions.
+     *
+     * \c naive_summation_tag adds the elements one after the other,
+     * \c pairwise_summation_tag adds them along a balanced tree with eight
+     * independent lanes at the leaves, and \c compensated_summation_tag
+     * keeps the rounding error of every addition (Kahan-Babuska). The
+     * default is \c BOOST_UBLAS_DEFAULT_SUMMATION.
+     */
+    struct naive_summation_tag {};
+    struct pairwise_summation_tag {};
+    struct compensated_summation_tag {};
+
+namespace detail {
+
+    // The vector is cut into chunks of a fixed size which are reduced
+    // independently and then merged, so the order of the additions only
+    // depends on the size and never on the number of threads.
+    struct reduction_size {
+        enum { chunk = 4096, leaf = 128 };
+    };
+
+    // Accumulators, add () one value, merge () the partial result of a
+    // following chunk
+    template<class T>
+    struct running_sum {
+        typedef T value_type;
+
+        BOOST_UBLAS_INLINE
+        running_sum ():
+            s_ () {}
+        BOOST_UBLAS_INLINE
+        void add (const value_type &t) {
+            s_ += t;
+        }
+        BOOST_UBLAS_INLINE
+        void merge (const running_sum &r) {
+            s_ += r.s_;
+        }
+        BOOST_UBLAS_INLINE
+        value_type result () const {
+            return s_;
+        }
+
+        value_type s_;
+    };
+
+    template<class T>
+    struct compensated_sum {
+        typedef T value_type;
+
+        BOOST_UBLAS_INLINE
+        compensated_sum ():
+            s_ (), c_ () {}
+        BOOST_UBLAS_INLINE
+        void add (const value_type &t) {
+            // Two sum, c_ gets the exact rounding error of s_ + t
+            value_type s (s_ + t);
+            value_type z (s - s_);
+            c_ += (s_ - (s - z)) + (t - z);
+            s_ = s;
+        }
+        BOOST_UBLAS_INLINE
+        void merge (const compensated_sum &r) {
+            add (r.s_);
+            c_ += r.c_;
+        }
+        BOOST_UBLAS_INLINE
+        value_type result () const {
+            return s_ + c_;
+        }
+
+        value_type s_;
+        value_type c_;
+    };
+
+    template<class T>
+    struct running_max {
+        typedef T value_type;
+
+        BOOST_UBLAS_INLINE
+        running_max ():
+            s_ () {}
+        BOOST_UBLAS_INLINE
+        void add (const value_type &t) {
+            if (t > s_)
+                s_ = t;
+        }
+        BOOST_UBLAS_INLINE
+        void merge (const running_max &r) {
+            add (r.s_);
+        }
+        BOOST_UBLAS_INLINE
+        value_type result () const {
+            return s_;
+        }
+
+        value_type s_;
+    };
+
+    // Smallest value if C is std::less, largest if it is std::greater
+    template<class T, class C>
+    struct running_extremum {
+        typedef T value_type;
+
+        BOOST_UBLAS_INLINE
+        running_extremum ():
+            s_ (), empty_ (true) {}
+        BOOST_UBLAS_INLINE
+        void add (const value_type &t) {
+            if (empty_ || C () (t, s_))
+                s_ = t;
+            empty_ = false;
+        }
+        BOOST_UBLAS_INLINE
+        void merge (const running_extremum &r) {
+            if (! r.empty_)
+                add (r.s_);
+        }
+        BOOST_UBLAS_INLINE
+        value_type result () const {
+            return s_;
+        }
+
+        value_type s_;
+        bool empty_;
+    };
+
+    template<class T, class S>
+    struct summation_traits {
+        typedef running_sum<T> accumulator_type;
+    };
+    template<class T>
+    struct summation_traits<T, compensated_summation_tag> {
+        typedef compensated_sum<T> accumulator_type;
+    };
+
+    // Pairwise sum of f (first) ... f (last - 1)
+    template<class T, class F, class D>
+    T pairwise_reduce (const F &f, D first, D last) {
+        const D leaf = reduction_size::leaf;
+        if (last - first > leaf) {
+            D half (((last - first) / 2 + leaf - 1) / leaf * leaf);
+            return pairwise_reduce<T> (f, first, first + half) + pairwise_reduce<T> (f, first + half, last);
+        }
+        // Eight lanes the compiler can keep in vector registers
+        T t0 = T (), t1 = T (), t2 = T (), t3 = T (), t4 = T (), t5 = T (), t6 = T (), t7 = T ();
+        D i (first);
+        for (; i + 8 <= last; i += 8) {
+            t0 += f (i);
+            t1 += f (i + 1);
+            t2 += f (i + 2);
+            t3 += f (i + 3);
+            t4 += f (i + 4);
+            t5 += f (i + 5);
+            t6 += f (i + 6);
+            t7 += f (i + 7);
+        }
+        T t (((t0 + t1) + (t2 + t3)) + ((t4 + t5) + (t6 + t7)));
+        for (; i < last; ++ i)
+            t += f (i);
+        return t;
+    }
+
+    // Reduction of a single chunk
+    template<class A, class F, class D>
+    BOOST_UBLAS_INLINE
+    A reduce_chunk (const F &f, D first, D last, pairwise_summation_tag) {
+        A a;
+        a.add (pairwise_reduce<typename A::value_type> (f, first, last));
+        return a;
+    }
+    template<class A, class F, class D, class S>
+    BOOST_UBLAS_INLINE
+    A reduce_chunk (const F &f, D first, D last, S) {
+        A a;
+        for (D i = first; i < last; ++ i)
+            a.add (f (i));
+        return a;
+    }
+
+    template<class A, class F, class D, class S>
+    struct chunk_reducer {
+        BOOST_UBLAS_INLINE
+        chunk_reducer (const F &f, D size):
+            f_ (f), size_ (size) {}
+        BOOST_UBLAS_INLINE
+        A operator () (D c) const {
+            const D chunk = reduction_size::chunk;
+            return reduce_chunk<A> (f_, c * chunk, (std::min) (size_, (c + 1) * chunk), S ());
+        }
+
+        const F &f_;
+        D size_;
+    };
+
+    template<class A>
+    struct chunk_partials {
+        BOOST_UBLAS_INLINE
+        explicit chunk_partials (const std::vector<A> &partials):
+            partials_ (partials) {}
+        template<class D>
+        BOOST_UBLAS_INLINE
+        const A &operator () (D c) const {
+            return partials_ [c];
+        }
+
+        const std::vector<A> &partials_;
+    };
+
+    // Merges the chunks first ... last - 1, pairwise along a tree or one after the other
+    template<class A, class G, class D>
+    A merge_chunks (const G &g, D first, D last, pairwise_summation_tag) {
+        if (last - first == 1)
+            return g (first);
+        D half (first + (last - first) / 2);
+        A a (merge_chunks<A> (g, first, half, pairwise_summation_tag ()));
+        a.merge (merge_chunks<A> (g, half, last, pairwise_summation_tag ()));
+        return a;
+    }
+    template<class A, class G, class D, class S>
+    A merge_chunks (const G &g, D first, D last, S) {
+        A a (g (first));
+        for (D c = first + 1; c < last; ++ c)
+            a.merge (g (c));
+        return a;
+    }
+
+    /** \brief Reduces f (0) ... f (size - 1) into the accumulator \c A.
+     *
+     * Chunks are reduced in parallel when \c BOOST_UBLAS_USE_OPENMP is
+     * defined and the vector is large enough, with the same result as
+     * the serial reduction.
+     */
+    template<class A, class F, class D, class S>
+    A reduce (const F &f, D size, S) {
+        const D chunk = reduction_size::chunk;
+        chunk_reducer<A, F, D, S> reducer (f, size);
+        if (size <= chunk)
+            return reducer (D (0));
+        D chunks ((size + chunk - 1) / chunk);
+#ifdef BOOST_UBLAS_USE_OPENMP
+        if (size >= D (BOOST_UBLAS_PARALLEL_THRESHOLD)) {
+            std::vector<A> partials (chunks);
+            #pragma omp parallel for schedule (static)
+            for (std::ptrdiff_t c = 0; c < std::ptrdiff_t (chunks); ++ c)
+                partials [c] = reducer (D (c));
+            return merge_chunks<A> (chunk_partials<A> (partials), D (0), chunks, S ());
+        }
+#endif
+        return merge_chunks<A> (reducer, D (0), chunks, S ());
+    }
+
+    template<class T, class S, class F, class D>
+    BOOST_UBLAS_INLINE
+    T reduce_sum (const F &f, D size, S) {
+        return reduce<typename summation_traits<T, S>::accumulator_type> (f, size, S ()).result ();
+    }
+
+    /** \brief True if p (i) holds for all 0 <= i < size.
+     *
+     * Chunks are tested like in reduce (), without branches inside a
+     * chunk. Chunks after a failed one are skipped, in parallel chunks
+     * that have not started yet.
+     */
+    template<class P, class D>
+    bool reduce_all (const P &p, D size) {
+        const D chunk = reduction_size::chunk;
+        D chunks ((size + chunk - 1) / chunk);
+        bool all = true;
+#ifdef BOOST_UBLAS_USE_OPENMP
+        #pragma omp parallel for schedule (static) if (size >= D (BOOST_UBLAS_PARALLEL_THRESHOLD))
+#endif
+        for (std::ptrdiff_t c = 0; c < std::ptrdiff_t (chunks); ++ c) {
+            bool running;
+#ifdef BOOST_UBLAS_USE_OPENMP
+            #pragma omp atomic read
+#endif
+            running = all;
+            if (! running)
+                continue;
+            bool a = true;
+            D last ((std::min) (size, D (c + 1) * chunk));
+            for (D i = D (c) * chunk; i < last; ++ i)
+                a &= bool (p (i));
+            if (! a) {
+#ifdef BOOST_UBLAS_USE_OPENMP
+                #pragma omp atomic write
+#endif
+                all = false;
+            }
+        }
+        return all;
+    }
+
+    // Elements of the reductions
+    template<class E, class T>
+    struct sum_element {
+        BOOST_UBLAS_INLINE
+        explicit sum_element (const E &e):
+            e_ (e) {}
+        template<class D>
+        BOOST_UBLAS_INLINE
+        T operator () (D i) const {
+            return e_ (i);
+        }
+
+        const E &e_;
+    };
+
+    template<class E, class T>
+    struct norm_2_square_element {
+        BOOST_UBLAS_INLINE
+        explicit norm_2_square_element (const E &e):
+            e_ (e) {}
+        template<class D>
+        BOOST_UBLAS_INLINE
+        T operator () (D i) const {
+            T u (type_traits<typename E::value_type>::norm_2 (e_ (i)));
+            return u * u;
+        }
+
+        const E &e_;
+    };
+
+    template<class E, class T>
+    struct norm_2_element {
+        BOOST_UBLAS_INLINE
+        explicit norm_2_element (const E &e):
+            e_ (e) {}
+        template<class D>
+        BOOST_UBLAS_INLINE
+        T operator () (D i) const {
+            return type_traits<typename E::value_type>::norm_2 (e_ (i));
+        }
+
+        const E &e_;
+    };
+
+    // Square of the element times 2^-exponent
+    template<class E, class T>
+    struct scaled_norm_2_square_element {
+        BOOST_UBLAS_INLINE
+        scaled_norm_2_square_element (const E &e, int exponent):
+            e_ (e), exponent_ (exponent) {}
+        template<class D>
+        BOOST_UBLAS_INLINE
+        T operator () (D i) const {
+            T u (std::ldexp (T (type_traits<typename E::value_type>::norm_2 (e_ (i))), - exponent_));
+            return u * u;
+        }
+
+        const E &e_;
+        int exponent_;
+    };
+
+    template<class E1, class E2, class T>
+    struct inner_prod_element {
+        BOOST_UBLAS_INLINE
+        inner_prod_element (const E1 &e1, const E2 &e2):
+            e1_ (e1), e2_ (e2) {}
+        template<class D>
+        BOOST_UBLAS_INLINE
+        T operator () (D i) const {
+            return e1_ (i) * e2_ (i);
+        }
+
+        const E1 &e1_;
+        const E2 &e2_;
+    };
+
+    // Binary floating point, rescale by a power of two if the squares overflowed
+    // or underflowed
+    template<class T, class S, class E>
+    T rescale_norm_2 (const E &e, const T &t, S, boost::true_type) {
+        typedef std::numeric_limits<T> limits;
+        if (t <= (limits::max) () && t >= (limits::min) () / limits::epsilon ())
+            return type_traits<T>::type_sqrt (t);
+        typedef typename E::size_type size_type;
+        size_type size (e.size ());
+        T m (reduce<running_max<T> > (norm_2_element<E, T> (e), size, naive_summation_tag ()).result ());
+        if (m == T ())
+            return m;
+        if (! (m <= (limits::max) ()))
+            return type_traits<T>::type_sqrt (t);
+        int exponent;
+        std::frexp (m, &exponent);
+        T u (reduce_sum<T> (scaled_norm_2_square_element<E, T> (e, exponent), size, S ()));
+        return std::ldexp (type_traits<T>::type_sqrt (u), exponent);
+    }
+    template<class T, class S, class E>
+    BOOST_UBLAS_INLINE
+    T rescale_norm_2 (const E &, const T &t, S, boost::false_type) {
+        return type_traits<T>::type_sqrt (t);
+    }
+
+    template<class T, class S, class E>
+    BOOST_UBLAS_INLINE
+    T reduce_norm_2_square (const E &e, S) {
+        return reduce_sum<T> (norm_2_square_element<E, T> (e), e.size (), S ());
+    }
+
+    /** \brief Euclidean norm summing the plain squares.
+     *
+     * Only when the sum overflows or loses precision to underflow is the
+     * vector summed a second time, scaled by a power of two, which does
+     * not round.
+     */
+    template<class T, class S, class E>
+    BOOST_UBLAS_INLINE
+    T reduce_norm_2 (const E &e, S) {
+        return rescale_norm_2 (e, reduce_norm_2_square<T> (e, S ()), S (), boost::is_floating_point<T> ());
+    }
+
+}
+
+}}}
+
+#endif
@@ -18,6 +18,7 @@
 #include <boost/core/ignore_unused.hpp>
 
 #include <boost/numeric/ublas/traits.hpp>
+#include <boost/numeric/ublas/detail/reduction.hpp>
 #ifdef BOOST_UBLAS_USE_DUFF_DEVICE
 #include <boost/numeric/ublas/detail/duff.hpp>
 #endif
@@ -335,7 +336,8 @@ namespace boost { namespace numeric { namespace ublas {
         typedef typename V::value_type result_type;
     };
 
-    template<class V>
+    // S selects the summation of the dense case, see detail/reduction.hpp
+    template<class V, class S = BOOST_UBLAS_DEFAULT_SUMMATION>
     struct vector_sum: 
         public vector_scalar_unary_functor<V> {
         typedef typename vector_scalar_unary_functor<V>::value_type value_type;
@@ -344,12 +346,7 @@ namespace boost { namespace numeric { namespace ublas {
         template<class E>
         static BOOST_UBLAS_INLINE
         result_type apply (const vector_expression<E> &e) { 
-            result_type t = result_type (0);
-            typedef typename E::size_type vector_size_type;
-            vector_size_type size (e ().size ());
-            for (vector_size_type i = 0; i < size; ++ i)
-                t += e () (i);
-            return t;
+            return detail::reduce_sum<result_type> (detail::sum_element<E, result_type> (e ()), e ().size (), S ());
         }
         // Dense case
         template<class D, class I>
@@ -423,7 +420,7 @@ namespace boost { namespace numeric { namespace ublas {
             return t;
         }
     };
-    template<class V>
+    template<class V, class S = BOOST_UBLAS_DEFAULT_SUMMATION>
     struct vector_norm_2:
         public vector_scalar_real_unary_functor<V> {
         typedef typename vector_scalar_real_unary_functor<V>::value_type value_type;
@@ -433,16 +430,11 @@ namespace boost { namespace numeric { namespace ublas {
         template<class E>
         static BOOST_UBLAS_INLINE
         result_type apply (const vector_expression<E> &e) {
-            typedef typename E::size_type vector_size_type;
-            vector_size_type size (e ().size ());
 #ifndef BOOST_UBLAS_SCALED_NORM
-            real_type t = real_type ();
-            for (vector_size_type i = 0; i < size; ++ i) {
-                real_type u (type_traits<value_type>::norm_2 (e () (i)));
-                t +=  u * u;
-            }
-            return static_cast<result_type>(type_traits<real_type>::type_sqrt (t));
+            return static_cast<result_type>(detail::reduce_norm_2<real_type> (e (), S ()));
 #else
+            typedef typename E::size_type vector_size_type;
+            vector_size_type size (e ().size ());
             real_type scale = real_type ();
             real_type sum_squares (1);
             for (vector_size_type i = 0; i < size; ++ i) {
@@ -522,7 +514,7 @@ namespace boost { namespace numeric { namespace ublas {
         }
     };
 
-    template<class V>
+    template<class V, class S = BOOST_UBLAS_DEFAULT_SUMMATION>
     struct vector_norm_2_square :
         public vector_scalar_real_unary_functor<V> {
         typedef typename vector_scalar_real_unary_functor<V>::value_type value_type;
@@ -532,14 +524,7 @@ namespace boost { namespace numeric { namespace ublas {
         template<class E>
         static BOOST_UBLAS_INLINE
         result_type apply (const vector_expression<E> &e) {
-            real_type t = real_type ();
-            typedef typename E::size_type vector_size_type;
-            vector_size_type size (e ().size ());
-            for (vector_size_type i = 0; i < size; ++ i) {
-                real_type u (type_traits<value_type>::norm_2 (e () (i)));
-                t +=  u * u;
-            }
-            return t;
+            return detail::reduce_norm_2_square<real_type> (e (), S ());
         }
         // Dense case
         template<class D, class I>
@@ -690,7 +675,7 @@ namespace boost { namespace numeric { namespace ublas {
         typedef TV result_type;
     };
 
-    template<class V1, class V2, class TV>
+    template<class V1, class V2, class TV, class S = BOOST_UBLAS_DEFAULT_SUMMATION>
     struct vector_inner_prod:
         public vector_scalar_binary_functor<V1, V2, TV> {
         typedef typename vector_scalar_binary_functor<V1, V2, TV>::value_type value_type;
@@ -735,15 +720,14 @@ namespace boost { namespace numeric { namespace ublas {
                            const vector_expression<E2> &e2) {
             typedef typename E1::size_type vector_size_type;
             vector_size_type size (BOOST_UBLAS_SAME (e1 ().size (), e2 ().size ()));
-            result_type t = result_type (0);
 #ifndef BOOST_UBLAS_USE_DUFF_DEVICE
-            for (vector_size_type i = 0; i < size; ++ i)
-                t += e1 () (i) * e2 () (i);
+            return detail::reduce_sum<result_type> (detail::inner_prod_element<E1, E2, result_type> (e1 (), e2 ()), size, S ());
 #else
+            result_type t = result_type (0);
             vector_size_type i (0);
             DD (size, 4, r, (t += e1 () (i) * e2 () (i), ++ i));
-#endif
             return t;
+#endif
         }
         // Dense case
         template<class D, class I1, class I2>
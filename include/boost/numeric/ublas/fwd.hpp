@@ -16,6 +16,12 @@
 #define BOOST_UBLAS_FWD_H
 
 #include <memory>
+#include <boost/config.hpp>
+
+// The C++11 test of detail/config.hpp, for this header included first
+#if !defined(BOOST_UBLAS_CPP_GE_2011) && ((defined(__cplusplus) && __cplusplus >= 201103L) || BOOST_MSVC >= 1800)
+#define BOOST_UBLAS_CPP_GE_2011
+#endif
 
 #ifdef BOOST_UBLAS_CPP_GE_2011
 #include <array>
@@ -44,6 +50,12 @@ namespace boost { namespace numeric { namespace ublas {
     template<class I, class T, class ALLOC = std::allocator<std::pair<I, T> > >
     class map_array;
 
+    // Initialisation of newly allocated dense storage, elements of trivial
+    // types left as they are, or value initialised in parallel so the pages
+    // land with the threads of the parallel kernels
+    struct uninitialized_tag {};
+    struct first_touch_tag {};
+
     // Expression types
     struct scalar_tag {};
     
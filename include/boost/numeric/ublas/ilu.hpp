@@ -0,0 +1,424 @@
+//
+//  Copyright (c) 2019
+//  The Boost.uBLAS developers
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef _BOOST_UBLAS_ILU_
+#define _BOOST_UBLAS_ILU_
+
+#include <boost/numeric/ublas/matrix_sparse.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+/** \file ilu.hpp
+ *  \brief Incomplete LU factorizations of row major compressed matrices.
+ *
+ * The factors are stored like the result of \c lu_factorize: the
+ * strictly lower part holds \c L with an implicit unit diagonal and the
+ * upper part, diagonal included, holds \c U. \c ilu_substitute solves
+ * with both factors following a level schedule, all rows of one level
+ * are independent and solved in parallel when BOOST_UBLAS_USE_OPENMP
+ * is defined.
+ */
+
+namespace boost { namespace numeric { namespace ublas {
+
+namespace detail {
+
+    // Position of the diagonal element of every row, returns the index of
+    // the first row missing it plus one or zero.
+    template<class M>
+    typename M::size_type
+    find_diagonal (const M &m, std::vector<typename M::array_size_type> &diagonal) {
+        typedef typename M::size_type size_type;
+        typedef typename M::array_size_type array_size_type;
+
+        size_type size = m.size1 ();
+        diagonal.resize (size);
+        for (size_type i = 0; i < size; ++ i) {
+            array_size_type k = m.index1_data () [i];
+            array_size_type k_end = m.index1_data () [i + 1];
+            while (k < k_end && m.index2_data () [k] < i)
+                ++ k;
+            if (k == k_end || m.index2_data () [k] != i)
+                return i + 1;
+            diagonal [i] = k;
+        }
+        return 0;
+    }
+
+    template<class T>
+    struct ilut_greater_magnitude {
+        typedef typename type_traits<T>::real_type real_type;
+
+        BOOST_UBLAS_INLINE
+        explicit ilut_greater_magnitude (const std::vector<T> &w):
+            w_ (w) {}
+        template<class I>
+        BOOST_UBLAS_INLINE
+        bool operator () (I a, I b) const {
+            return type_traits<T>::norm_2 (w_ [a]) > type_traits<T>::norm_2 (w_ [b]);
+        }
+
+        const std::vector<T> &w_;
+    };
+
+}
+
+    /** \brief In place ILU(0) factorization.
+     *
+     * The factors keep the sparsity pattern of \c m, every row has to
+     * contain its diagonal element.
+     *
+     * \return zero on success, otherwise the index plus one of the first
+     *  row with a missing or zero pivot
+     */
+    template<class T, class IA, class TA>
+    typename compressed_matrix<T, row_major, 0, IA, TA>::size_type
+    ilu0_factorize (compressed_matrix<T, row_major, 0, IA, TA> &m) {
+        typedef compressed_matrix<T, row_major, 0, IA, TA> matrix_type;
+        typedef typename matrix_type::size_type size_type;
+        typedef typename matrix_type::array_size_type array_size_type;
+        typedef T value_type;
+
+        BOOST_UBLAS_CHECK (m.size1 () == m.size2 (), bad_size ());
+        m.complete_index1_data ();
+        std::vector<array_size_type> diagonal;
+        size_type singular = detail::find_diagonal (m, diagonal);
+        if (singular != 0)
+            return singular;
+
+        size_type size = m.size1 ();
+        const array_size_type *row = &m.index1_data () [0];
+        const size_type *col = &m.index2_data () [0];
+        value_type *val = &m.value_data () [0];
+        // IKJ variant restricted to the pattern of the matrix, position
+        // maps a column of the current row to its storage
+        std::vector<array_size_type> position (size, array_size_type (-1));
+        for (size_type i = 0; i < size; ++ i) {
+            for (array_size_type k = row [i]; k < row [i + 1]; ++ k)
+                position [col [k]] = k;
+            for (array_size_type k = row [i]; k < diagonal [i]; ++ k) {
+                size_type j = col [k];
+                value_type lij (val [k] / val [diagonal [j]]);
+                val [k] = lij;
+                for (array_size_type l = diagonal [j] + 1; l < row [j + 1]; ++ l) {
+                    array_size_type p = position [col [l]];
+                    if (p != array_size_type (-1))
+                        val [p] -= lij * val [l];
+                }
+            }
+            for (array_size_type k = row [i]; k < row [i + 1]; ++ k)
+                position [col [k]] = array_size_type (-1);
+            if (val [diagonal [i]] == value_type/*zero*/())
+                return i + 1;
+        }
+        return 0;
+    }
+
+    /** \brief In place ILUT(p, tau) factorization with threshold dropping.
+     *
+     * While eliminating row \c i every entry smaller than
+     * <tt>drop_tolerance * |a_i|_2</tt> is dropped, afterwards only the
+     * \c fill largest entries of both the \c L and \c U part of the row
+     * are kept. The diagonal is never dropped. The pattern of \c m is
+     * replaced by the pattern of the factors.
+     *
+     * \return zero on success, otherwise the index plus one of the first
+     *  row with a zero pivot
+     */
+    template<class T, class IA, class TA>
+    typename compressed_matrix<T, row_major, 0, IA, TA>::size_type
+    ilut_factorize (compressed_matrix<T, row_major, 0, IA, TA> &m,
+                    typename type_traits<T>::real_type drop_tolerance,
+                    typename compressed_matrix<T, row_major, 0, IA, TA>::size_type fill) {
+        typedef compressed_matrix<T, row_major, 0, IA, TA> matrix_type;
+        typedef typename matrix_type::size_type size_type;
+        typedef typename matrix_type::array_size_type array_size_type;
+        typedef typename type_traits<T>::real_type real_type;
+        typedef T value_type;
+
+        BOOST_UBLAS_CHECK (m.size1 () == m.size2 (), bad_size ());
+        m.complete_index1_data ();
+        size_type size = m.size1 ();
+        matrix_type lu (size, size, (std::min) (m.nnz () + 2 * fill * size, size * size));
+        std::vector<array_size_type> diagonal (size);
+        // Dense work row, the list of its non zero columns and the
+        // pending lower columns ordered by a min heap
+        std::vector<value_type> w (size);
+        std::vector<bool> used (size, false);
+        std::vector<size_type> nonzeros, lower, upper, pending;
+        size_type singular = 0;
+        for (size_type i = 0; i < size; ++ i) {
+            real_type row_norm = real_type/*zero*/();
+            for (array_size_type k = m.index1_data () [i]; k < m.index1_data () [i + 1]; ++ k) {
+                size_type j = m.index2_data () [k];
+                w [j] = m.value_data () [k];
+                used [j] = true;
+                nonzeros.push_back (j);
+                if (j < i)
+                    pending.push_back (j);
+                real_type a = type_traits<value_type>::norm_2 (w [j]);
+                row_norm += a * a;
+            }
+            real_type tau = drop_tolerance * type_traits<real_type>::type_sqrt (row_norm);
+            std::make_heap (pending.begin (), pending.end (), std::greater<size_type> ());
+            while (! pending.empty ()) {
+                std::pop_heap (pending.begin (), pending.end (), std::greater<size_type> ());
+                size_type k = pending.back ();
+                pending.pop_back ();
+                value_type wk (w [k] / lu.value_data () [diagonal [k]]);
+                if (type_traits<value_type>::norm_2 (wk) <= tau) {
+                    w [k] = value_type/*zero*/();
+                    continue;
+                }
+                w [k] = wk;
+                for (array_size_type l = diagonal [k] + 1; l < lu.index1_data () [k + 1]; ++ l) {
+                    size_type j = lu.index2_data () [l];
+                    if (! used [j]) {
+                        used [j] = true;
+                        nonzeros.push_back (j);
+                        w [j] = value_type/*zero*/();
+                        if (j < i) {
+                            pending.push_back (j);
+                            std::push_heap (pending.begin (), pending.end (), std::greater<size_type> ());
+                        }
+                    }
+                    w [j] -= wk * lu.value_data () [l];
+                }
+            }
+            // Keep the fill largest entries above tau in each part
+            for (typename std::vector<size_type>::const_iterator it = nonzeros.begin (); it != nonzeros.end (); ++ it) {
+                size_type j = *it;
+                if (j != i && type_traits<value_type>::norm_2 (w [j]) > tau)
+                    (j < i ? lower : upper).push_back (j);
+            }
+            detail::ilut_greater_magnitude<value_type> greater (w);
+            if (lower.size () > fill) {
+                std::nth_element (lower.begin (), lower.begin () + fill, lower.end (), greater);
+                lower.resize (fill);
+            }
+            if (upper.size () > fill) {
+                std::nth_element (upper.begin (), upper.begin () + fill, upper.end (), greater);
+                upper.resize (fill);
+            }
+            std::sort (lower.begin (), lower.end ());
+            std::sort (upper.begin (), upper.end ());
+            for (typename std::vector<size_type>::const_iterator it = lower.begin (); it != lower.end (); ++ it)
+                lu.push_back (i, *it, w [*it]);
+            if (! used [i])
+                w [i] = value_type/*zero*/();
+            if (w [i] == value_type/*zero*/() && singular == 0)
+                singular = i + 1;
+            lu.push_back (i, i, w [i]);
+            diagonal [i] = lu.nnz () - 1;
+            for (typename std::vector<size_type>::const_iterator it = upper.begin (); it != upper.end (); ++ it)
+                lu.push_back (i, *it, w [*it]);
+            for (typename std::vector<size_type>::const_iterator it = nonzeros.begin (); it != nonzeros.end (); ++ it)
+                used [*it] = false;
+            used [i] = false;
+            nonzeros.clear ();
+            lower.clear ();
+            upper.clear ();
+            if (singular != 0)
+                break;
+        }
+        lu.complete_index1_data ();
+        m.swap (lu);
+        return singular;
+    }
+
+    /** \brief Dependency levels of the rows of incomplete LU factors.
+     *
+     * Row \c i of the forward substitution depends on the rows \c j
+     * of its \c L part, row \c i of the backward substitution on the
+     * rows of its \c U part. Rows sharing a level are independent. The
+     * schedule is computed once per pattern and reused by every
+     * \c ilu_substitute.
+     */
+    template<class M>
+    class ilu_level_schedule {
+    public:
+        typedef M matrix_type;
+        typedef typename M::size_type size_type;
+        typedef typename M::array_size_type array_size_type;
+        typedef std::vector<size_type> index_array_type;
+        typedef std::vector<array_size_type> position_array_type;
+
+        // Construction and destruction
+        BOOST_UBLAS_INLINE
+        ilu_level_schedule () {}
+        BOOST_UBLAS_INLINE
+        explicit ilu_level_schedule (const matrix_type &lu) {
+            build (lu);
+        }
+
+        void build (const matrix_type &lu) {
+            BOOST_UBLAS_CHECK (lu.filled1 () == lu.size1 () + 1, bad_size ());
+            if (detail::find_diagonal (lu, diagonal_) != 0)
+                singular ().raise ();
+            size_type size = lu.size1 ();
+            const array_size_type *row = size > 0 ? &lu.index1_data () [0] : 0;
+            const size_type *col = lu.nnz () > 0 ? &lu.index2_data () [0] : 0;
+            std::vector<size_type> level (size);
+            // Forward substitution
+            for (size_type i = 0; i < size; ++ i) {
+                size_type l = 0;
+                for (array_size_type k = row [i]; k < diagonal_ [i]; ++ k)
+                    l = (std::max) (l, level [col [k]] + 1);
+                level [i] = l;
+            }
+            sort_levels (lu, level, lower_order_, lower_begin_, lower_parallel_, true);
+            // Backward substitution
+            for (size_type i = size; i-- > 0; ) {
+                size_type l = 0;
+                for (array_size_type k = diagonal_ [i] + 1; k < row [i + 1]; ++ k)
+                    l = (std::max) (l, level [col [k]] + 1);
+                level [i] = l;
+            }
+            sort_levels (lu, level, upper_order_, upper_begin_, upper_parallel_, false);
+        }
+
+        // Accessors
+        BOOST_UBLAS_INLINE
+        size_type lower_levels () const {
+            return lower_begin_.empty () ? 0 : lower_begin_.size () - 1;
+        }
+        BOOST_UBLAS_INLINE
+        size_type upper_levels () const {
+            return upper_begin_.empty () ? 0 : upper_begin_.size () - 1;
+        }
+        // Rows grouped by level, level l is [begin [l], begin [l + 1])
+        BOOST_UBLAS_INLINE
+        const index_array_type &lower_order () const {
+            return lower_order_;
+        }
+        BOOST_UBLAS_INLINE
+        const index_array_type &lower_begin () const {
+            return lower_begin_;
+        }
+        BOOST_UBLAS_INLINE
+        const index_array_type &upper_order () const {
+            return upper_order_;
+        }
+        BOOST_UBLAS_INLINE
+        const index_array_type &upper_begin () const {
+            return upper_begin_;
+        }
+        BOOST_UBLAS_INLINE
+        const position_array_type &diagonal () const {
+            return diagonal_;
+        }
+        // Whether a level carries enough work to be solved in parallel
+        BOOST_UBLAS_INLINE
+        bool lower_parallel (size_type l) const {
+            return lower_parallel_ [l];
+        }
+        BOOST_UBLAS_INLINE
+        bool upper_parallel (size_type l) const {
+            return upper_parallel_ [l];
+        }
+
+    private:
+        void sort_levels (const matrix_type &lu, const std::vector<size_type> &level,
+                          index_array_type &order, index_array_type &begin,
+                          std::vector<bool> &parallel, bool lower) {
+            size_type size = level.size ();
+            size_type levels = size > 0 ? *std::max_element (level.begin (), level.end ()) + 1 : 0;
+            // Counting sort keeps the rows of a level in increasing order
+            begin.assign (levels + 1, 0);
+            for (size_type i = 0; i < size; ++ i)
+                ++ begin [level [i] + 1];
+            for (size_type l = 0; l < levels; ++ l)
+                begin [l + 1] += begin [l];
+            order.resize (size);
+            std::vector<size_type> next (begin.begin (), begin.end () - 1);
+            for (size_type i = 0; i < size; ++ i)
+                order [next [level [i]] ++] = i;
+            parallel.assign (levels, false);
+            for (size_type l = 0; l < levels; ++ l) {
+                size_type work = 0;
+                for (size_type p = begin [l]; p < begin [l + 1]; ++ p) {
+                    size_type i = order [p];
+                    work += lower ? diagonal_ [i] - lu.index1_data () [i] + 1
+                                  : lu.index1_data () [i + 1] - diagonal_ [i];
+                }
+                parallel [l] = work >= BOOST_UBLAS_PARALLEL_THRESHOLD;
+            }
+        }
+
+        position_array_type diagonal_;
+        index_array_type lower_order_, lower_begin_;
+        index_array_type upper_order_, upper_begin_;
+        std::vector<bool> lower_parallel_, upper_parallel_;
+    };
+
+namespace detail {
+
+    template<class M, class V>
+    BOOST_UBLAS_INLINE
+    void ilu_lower_row (const M &lu, const ilu_level_schedule<M> &s, V &v, typename M::size_type i) {
+        typedef typename M::array_size_type array_size_type;
+        typedef typename V::value_type value_type;
+
+        value_type t (v (i));
+        for (array_size_type k = lu.index1_data () [i]; k < s.diagonal () [i]; ++ k)
+            t -= lu.value_data () [k] * v (lu.index2_data () [k]);
+        v (i) = t;
+    }
+
+    template<class M, class V>
+    BOOST_UBLAS_INLINE
+    void ilu_upper_row (const M &lu, const ilu_level_schedule<M> &s, V &v, typename M::size_type i) {
+        typedef typename M::array_size_type array_size_type;
+        typedef typename V::value_type value_type;
+
+        array_size_type d = s.diagonal () [i];
+        value_type t (v (i));
+        for (array_size_type k = d + 1; k < lu.index1_data () [i + 1]; ++ k)
+            t -= lu.value_data () [k] * v (lu.index2_data () [k]);
+        v (i) = t / lu.value_data () [d];
+    }
+
+}
+
+    /** \brief Solves <tt>L U x = v</tt> in place for incomplete LU factors.
+     *
+     * \param lu the factors computed by \c ilu0_factorize or \c ilut_factorize
+     * \param s the level schedule of \c lu
+     * \param v the right hand side on entry, the solution on exit
+     */
+    template<class M, class V>
+    void ilu_substitute (const M &lu, const ilu_level_schedule<M> &s, V &v) {
+        typedef typename M::size_type size_type;
+
+        BOOST_UBLAS_CHECK (v.size () == lu.size1 (), bad_size ());
+        for (size_type l = 0; l < s.lower_levels (); ++ l) {
+            const size_type *order = &s.lower_order () [0];
+            std::ptrdiff_t first = s.lower_begin () [l], last = s.lower_begin () [l + 1];
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel for schedule (static) if (s.lower_parallel (l))
+#endif
+            for (std::ptrdiff_t p = first; p < last; ++ p)
+                detail::ilu_lower_row (lu, s, v, order [p]);
+        }
+        for (size_type l = 0; l < s.upper_levels (); ++ l) {
+            const size_type *order = &s.upper_order () [0];
+            std::ptrdiff_t first = s.upper_begin () [l], last = s.upper_begin () [l + 1];
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel for schedule (static) if (s.upper_parallel (l))
+#endif
+            for (std::ptrdiff_t p = first; p < last; ++ p)
+                detail::ilu_upper_row (lu, s, v, order [p]);
+        }
+    }
+
+}}}
+
+#endif
@@ -0,0 +1,558 @@
+//
+//  Copyright (c) 2019
+//  The Boost.uBLAS developers
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef _BOOST_UBLAS_ITERATIVE_
+#define _BOOST_UBLAS_ITERATIVE_
+
+#include <boost/numeric/ublas/vector.hpp>
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/operation.hpp>
+#include <boost/numeric/ublas/operation_fused.hpp>
+#include <boost/numeric/ublas/preconditioner.hpp>
+#include <boost/type_traits/is_base_of.hpp>
+
+#include <vector>
+
+/** \file iterative.hpp
+ *  \brief Preconditioned Krylov solvers: CG, BiCGStab and restarted GMRES.
+ *
+ * The operator \c A is either a matrix expression, applied with
+ * \c axpy_prod, or any object providing <tt>A.apply (x, y)</tt> which
+ * stores <tt>A x</tt> into \c y. Preconditioners follow the same
+ * convention, see preconditioner.hpp. All work vectors live in a
+ * \c krylov_workspace which may be reused between solves, so no
+ * allocation takes place inside the iteration.
+ */
+
+namespace boost { namespace numeric { namespace ublas {
+
+    /** \brief Stopping criterion and outcome of an iterative solve.
+     *
+     * The iteration stops as soon as
+     * <tt>|r| <= max (relative_tolerance * |b|, absolute_tolerance)</tt>
+     * or after \c max_iterations iterations.
+     *
+     * \tparam R the real type of the residual norm
+     */
+    template<class R = double>
+    class iteration_control {
+    public:
+        typedef R real_type;
+        typedef std::size_t size_type;
+
+        // Construction and destruction
+        BOOST_UBLAS_INLINE
+        explicit iteration_control (size_type max_iterations = 1000,
+                                    real_type relative_tolerance = real_type (1e-8),
+                                    real_type absolute_tolerance = real_type/*zero*/()):
+            max_iterations_ (max_iterations),
+            relative_tolerance_ (relative_tolerance), absolute_tolerance_ (absolute_tolerance),
+            threshold_ (), iterations_ (0), residual_norm_ (), converged_ (false) {}
+
+        // Accessors
+        BOOST_UBLAS_INLINE
+        size_type max_iterations () const {
+            return max_iterations_;
+        }
+        BOOST_UBLAS_INLINE
+        real_type relative_tolerance () const {
+            return relative_tolerance_;
+        }
+        BOOST_UBLAS_INLINE
+        real_type absolute_tolerance () const {
+            return absolute_tolerance_;
+        }
+        BOOST_UBLAS_INLINE
+        size_type iterations () const {
+            return iterations_;
+        }
+        BOOST_UBLAS_INLINE
+        real_type residual_norm () const {
+            return residual_norm_;
+        }
+        BOOST_UBLAS_INLINE
+        bool converged () const {
+            return converged_;
+        }
+
+        // Used by the solvers
+        BOOST_UBLAS_INLINE
+        void start (real_type rhs_norm) {
+            threshold_ = (std::max) (relative_tolerance_ * rhs_norm, absolute_tolerance_);
+            iterations_ = 0;
+            residual_norm_ = real_type/*zero*/();
+            converged_ = false;
+        }
+        BOOST_UBLAS_INLINE
+        bool satisfied (real_type residual_norm) const {
+            return residual_norm <= threshold_;
+        }
+        BOOST_UBLAS_INLINE
+        size_type finish (size_type iterations, real_type residual_norm) {
+            iterations_ = iterations;
+            residual_norm_ = residual_norm;
+            converged_ = satisfied (residual_norm);
+            return iterations;
+        }
+
+    private:
+        size_type max_iterations_;
+        real_type relative_tolerance_;
+        real_type absolute_tolerance_;
+        real_type threshold_;
+        size_type iterations_;
+        real_type residual_norm_;
+        bool converged_;
+    };
+
+    /** \brief Residual callback which does nothing.
+     *
+     * A monitor is called as <tt>monitor (iteration, residual_norm)</tt>
+     * after every iteration.
+     */
+    struct null_monitor {
+        template<class S, class R>
+        BOOST_UBLAS_INLINE
+        void operator () (S, R) const {}
+    };
+
+    /** \brief Work vectors of the Krylov solvers.
+     *
+     * Storage grows on demand and is kept between solves.
+     *
+     * \tparam T the value type of the work vectors
+     */
+    template<class T>
+    class krylov_workspace {
+    public:
+        typedef T value_type;
+        typedef std::size_t size_type;
+        typedef vector<T> vector_type;
+        typedef matrix<T> matrix_type;
+
+        // Construction and destruction
+        BOOST_UBLAS_INLINE
+        krylov_workspace ():
+            vectors_ (), hessenberg_ () {}
+
+        // Make sure count vectors of the given size are available
+        void reserve (size_type size, size_type count) {
+            if (vectors_.size () < count)
+                vectors_.resize (count);
+            for (size_type k = 0; k < count; ++ k) {
+                if (vectors_ [k].size () != size)
+                    vectors_ [k].resize (size, false);
+            }
+        }
+
+        // Element access
+        BOOST_UBLAS_INLINE
+        vector_type &operator [] (size_type k) {
+            BOOST_UBLAS_CHECK (k < vectors_.size (), bad_index ());
+            return vectors_ [k];
+        }
+        BOOST_UBLAS_INLINE
+        matrix_type &hessenberg () {
+            return hessenberg_;
+        }
+
+    private:
+        std::vector<vector_type> vectors_;
+        matrix_type hessenberg_;
+    };
+
+namespace detail {
+
+    template<class A, class V1, class V2>
+    BOOST_UBLAS_INLINE
+    void apply_operator (const A &a, const V1 &x, V2 &y, boost::true_type) {
+        axpy_prod (a, x, y, true);
+    }
+    template<class A, class V1, class V2>
+    BOOST_UBLAS_INLINE
+    void apply_operator (const A &a, const V1 &x, V2 &y, boost::false_type) {
+        a.apply (x, y);
+    }
+    // Dispatcher: y = A x
+    template<class A, class V1, class V2>
+    BOOST_UBLAS_INLINE
+    void apply_operator (const A &a, const V1 &x, V2 &y) {
+        apply_operator (a, x, y, typename boost::is_base_of<matrix_expression<A>, A>::type ());
+    }
+
+    // The fused kernels below perform one streaming pass each.
+
+    // Returns |t|^2 without a square root
+    template<class T>
+    BOOST_UBLAS_INLINE
+    typename type_traits<T>::real_type
+    krylov_abs_square (const T &t) {
+        return type_traits<T>::real (type_traits<T>::conj (t) * t);
+    }
+
+    // Returns <x, y> = sum conj (x_i) y_i
+    template<class V1, class V2>
+    BOOST_UBLAS_INLINE
+    typename V2::value_type
+    krylov_dot (const V1 &x, const V2 &y) {
+        typedef typename V2::value_type value_type;
+        typedef typename V2::size_type size_type;
+
+        value_type t = value_type/*zero*/();
+        size_type size = y.size ();
+        for (size_type i = 0; i < size; ++ i)
+            t += type_traits<value_type>::conj (x (i)) * y (i);
+        return t;
+    }
+
+    // r = b - y, returns |r|^2
+    template<class E, class V1, class V2>
+    BOOST_UBLAS_INLINE
+    typename type_traits<typename V2::value_type>::real_type
+    krylov_residual (const vector_expression<E> &b, const V1 &y, V2 &r) {
+        fused_norm_2_square<typename V2::value_type> rr;
+        return fused_vector_assign<scalar_assign> (r, b - y, rr).result ();
+    }
+
+    // x += alpha p, r -= alpha q, returns |r|^2
+    template<class X, class V, class T>
+    BOOST_UBLAS_INLINE
+    typename type_traits<T>::real_type
+    krylov_update_norm_2_square (X &x, V &r, const V &p, const V &q, const T &alpha) {
+        typedef typename type_traits<T>::real_type real_type;
+        typedef typename V::size_type size_type;
+
+        real_type t = real_type/*zero*/();
+        size_type size = r.size ();
+        for (size_type i = 0; i < size; ++ i) {
+            x (i) += alpha * p (i);
+            T ri = r (i) - alpha * q (i);
+            r (i) = ri;
+            t += detail::krylov_abs_square (ri);
+        }
+        return t;
+    }
+
+}
+
+    /** \brief Preconditioned conjugate gradient method for hermitian
+     *  positive definite systems <tt>A x = b</tt>.
+     *
+     * \param a the operator \c A
+     * \param x the initial guess on entry, the solution on exit
+     * \param b the right hand side
+     * \param p the preconditioner
+     * \param control the stopping criterion, also receives the outcome
+     * \param monitor called with the iteration number and residual norm
+     * \param ws the workspace, 4 vectors
+     * \return the number of iterations
+     */
+    template<class A, class X, class E, class P, class R, class F, class T>
+    std::size_t
+    cg (const A &a, X &x, const vector_expression<E> &b, const P &p,
+        iteration_control<R> &control, F monitor, krylov_workspace<T> &ws) {
+        typedef std::size_t size_type;
+        typedef typename krylov_workspace<T>::vector_type vector_type;
+        typedef typename type_traits<T>::real_type real_type;
+
+        size_type size = b ().size ();
+        BOOST_UBLAS_CHECK (x.size () == size, bad_size ());
+        ws.reserve (size, 4);
+        vector_type &r = ws [0], &z = ws [1], &d = ws [2], &q = ws [3];
+
+        control.start (norm_2 (b));
+        detail::apply_operator (a, x, q);
+        real_type rr = detail::krylov_residual (b, q, r);
+        real_type rnorm = type_traits<real_type>::type_sqrt (rr);
+        if (control.satisfied (rnorm))
+            return control.finish (0, rnorm);
+        p.apply (r, z);
+        noalias (d) = z;
+        T rho = detail::krylov_dot (r, z);
+        for (size_type it = 1; it <= control.max_iterations (); ++ it) {
+            detail::apply_operator (a, d, q);
+            T dq = detail::krylov_dot (d, q);
+            if (dq == T/*zero*/())
+                return control.finish (it, rnorm);
+            T alpha = rho / dq;
+            rr = detail::krylov_update_norm_2_square (x, r, d, q, alpha);
+            rnorm = type_traits<real_type>::type_sqrt (rr);
+            monitor (it, rnorm);
+            if (control.satisfied (rnorm) || it == control.max_iterations ())
+                return control.finish (it, rnorm);
+            p.apply (r, z);
+            T rho_new = detail::krylov_dot (r, z);
+            noalias (d) = z + (rho_new / rho) * d;
+            rho = rho_new;
+        }
+        return control.finish (0, rnorm);
+    }
+    template<class A, class X, class E, class P, class R, class F>
+    BOOST_UBLAS_INLINE
+    std::size_t
+    cg (const A &a, X &x, const vector_expression<E> &b, const P &p,
+        iteration_control<R> &control, F monitor) {
+        krylov_workspace<typename X::value_type> ws;
+        return cg (a, x, b, p, control, monitor, ws);
+    }
+    template<class A, class X, class E, class P, class R>
+    BOOST_UBLAS_INLINE
+    std::size_t
+    cg (const A &a, X &x, const vector_expression<E> &b, const P &p,
+        iteration_control<R> &control) {
+        return cg (a, x, b, p, control, null_monitor ());
+    }
+
+    /** \brief Right preconditioned BiCGStab method for general
+     *  systems <tt>A x = b</tt>.
+     *
+     * \param a the operator \c A
+     * \param x the initial guess on entry, the solution on exit
+     * \param b the right hand side
+     * \param p the preconditioner
+     * \param control the stopping criterion, also receives the outcome
+     * \param monitor called with the iteration number and residual norm
+     * \param ws the workspace, 7 vectors
+     * \return the number of iterations
+     */
+    template<class A, class X, class E, class P, class R, class F, class T>
+    std::size_t
+    bicgstab (const A &a, X &x, const vector_expression<E> &b, const P &p,
+              iteration_control<R> &control, F monitor, krylov_workspace<T> &ws) {
+        typedef std::size_t size_type;
+        typedef typename krylov_workspace<T>::vector_type vector_type;
+        typedef typename type_traits<T>::real_type real_type;
+
+        size_type size = b ().size ();
+        BOOST_UBLAS_CHECK (x.size () == size, bad_size ());
+        ws.reserve (size, 7);
+        vector_type &r = ws [0], &r0 = ws [1], &d = ws [2], &v = ws [3];
+        vector_type &dhat = ws [4], &shat = ws [5], &t = ws [6];
+        // s shares the storage of r
+        vector_type &s = r;
+
+        control.start (norm_2 (b));
+        detail::apply_operator (a, x, v);
+        real_type rr = detail::krylov_residual (b, v, r);
+        real_type rnorm = type_traits<real_type>::type_sqrt (rr);
+        if (control.satisfied (rnorm))
+            return control.finish (0, rnorm);
+        noalias (r0) = r;
+        d.clear ();
+        v.clear ();
+        T rho (1), alpha (1), omega (1);
+        for (size_type it = 1; it <= control.max_iterations (); ++ it) {
+            T rho_new = detail::krylov_dot (r0, r);
+            if (rho_new == T/*zero*/())
+                return control.finish (it, rnorm);
+            T beta = (rho_new / rho) * (alpha / omega);
+            noalias (d) = r + beta * (d - omega * v);
+            p.apply (d, dhat);
+            detail::apply_operator (a, dhat, v);
+            T r0v = detail::krylov_dot (r0, v);
+            if (r0v == T/*zero*/())
+                return control.finish (it, rnorm);
+            alpha = rho_new / r0v;
+            // s = r - alpha v
+            real_type snorm = minus_assign_norm_2 (s, alpha * v);
+            if (control.satisfied (snorm)) {
+                noalias (x) += alpha * dhat;
+                monitor (it, snorm);
+                return control.finish (it, snorm);
+            }
+            p.apply (s, shat);
+            detail::apply_operator (a, shat, t);
+            // <t, s> and <t, t> in one pass
+            T ts = T/*zero*/();
+            real_type tt = real_type/*zero*/();
+            for (size_type i = 0; i < size; ++ i) {
+                ts += type_traits<T>::conj (t (i)) * s (i);
+                tt += detail::krylov_abs_square (t (i));
+            }
+            if (tt == real_type/*zero*/())
+                return control.finish (it, rnorm);
+            omega = ts / T (tt);
+            // x += alpha dhat + omega shat, r = s - omega t
+            rr = real_type/*zero*/();
+            for (size_type i = 0; i < size; ++ i) {
+                x (i) += alpha * dhat (i) + omega * shat (i);
+                T ri = s (i) - omega * t (i);
+                r (i) = ri;
+                rr += detail::krylov_abs_square (ri);
+            }
+            rnorm = type_traits<real_type>::type_sqrt (rr);
+            monitor (it, rnorm);
+            if (control.satisfied (rnorm) || it == control.max_iterations () || omega == T/*zero*/())
+                return control.finish (it, rnorm);
+            rho = rho_new;
+        }
+        return control.finish (0, rnorm);
+    }
+    template<class A, class X, class E, class P, class R, class F>
+    BOOST_UBLAS_INLINE
+    std::size_t
+    bicgstab (const A &a, X &x, const vector_expression<E> &b, const P &p,
+              iteration_control<R> &control, F monitor) {
+        krylov_workspace<typename X::value_type> ws;
+        return bicgstab (a, x, b, p, control, monitor, ws);
+    }
+    template<class A, class X, class E, class P, class R>
+    BOOST_UBLAS_INLINE
+    std::size_t
+    bicgstab (const A &a, X &x, const vector_expression<E> &b, const P &p,
+              iteration_control<R> &control) {
+        return bicgstab (a, x, b, p, control, null_monitor ());
+    }
+
+    /** \brief Right preconditioned GMRES method restarted every
+     *  \c restart iterations for general systems <tt>A x = b</tt>.
+     *
+     * The Arnoldi basis is orthogonalized with modified Gram-Schmidt
+     * and the least squares problem is updated with Givens rotations,
+     * so the residual norm is known in every iteration.
+     *
+     * \param a the operator \c A
+     * \param x the initial guess on entry, the solution on exit
+     * \param b the right hand side
+     * \param p the preconditioner
+     * \param restart the dimension of the Krylov subspace
+     * \param control the stopping criterion, also receives the outcome
+     * \param monitor called with the iteration number and residual norm
+     * \param ws the workspace, <tt>restart + 3</tt> vectors
+     * \return the number of iterations
+     */
+    template<class A, class X, class E, class P, class R, class F, class T>
+    std::size_t
+    gmres (const A &a, X &x, const vector_expression<E> &b, const P &p, std::size_t restart,
+           iteration_control<R> &control, F monitor, krylov_workspace<T> &ws) {
+        typedef std::size_t size_type;
+        typedef typename krylov_workspace<T>::vector_type vector_type;
+        typedef typename krylov_workspace<T>::matrix_type matrix_type;
+        typedef typename type_traits<T>::real_type real_type;
+
+        size_type size = b ().size ();
+        BOOST_UBLAS_CHECK (x.size () == size, bad_size ());
+        BOOST_UBLAS_CHECK (restart > 0, bad_argument ());
+        ws.reserve (size, restart + 3);
+        vector_type &w = ws [restart + 1], &z = ws [restart + 2];
+        // Column restart of the Hessenberg matrix holds the rotated
+        // right hand side, column restart + 1 the rotation cosines
+        // and restart + 2 the sines.
+        matrix_type &h = ws.hessenberg ();
+        if (h.size1 () != restart + 1 || h.size2 () != restart + 3)
+            h.resize (restart + 1, restart + 3, false);
+
+        control.start (norm_2 (b));
+        size_type it = 0;
+        real_type rnorm = real_type/*zero*/();
+        for (;;) {
+            detail::apply_operator (a, x, w);
+            rnorm = type_traits<real_type>::type_sqrt (detail::krylov_residual (b, w, ws [0]));
+            if (control.satisfied (rnorm) || it == control.max_iterations ())
+                return control.finish (it, rnorm);
+            ws [0] *= T (1) / T (rnorm);
+            h.clear ();
+            h (0, restart) = T (rnorm);
+            size_type j = 0;
+            bool breakdown = false, stagnation = false;
+            while (j < restart && it < control.max_iterations () && ! breakdown) {
+                p.apply (ws [j], z);
+                detail::apply_operator (a, z, w);
+                for (size_type i = 0; i < j; ++ i) {
+                    T hij = detail::krylov_dot (ws [i], w);
+                    h (i, j) = hij;
+                    noalias (w) -= hij * ws [i];
+                }
+                // The last projection also yields the norm of w
+                T hj = detail::krylov_dot (ws [j], w);
+                h (j, j) = hj;
+                real_type hnorm = minus_assign_norm_2 (w, hj * ws [j]);
+                h (j + 1, j) = T (hnorm);
+                breakdown = hnorm == real_type/*zero*/();
+                if (! breakdown)
+                    noalias (ws [j + 1]) = w * (T (1) / T (hnorm));
+                // Apply the previous rotations to the new column
+                for (size_type i = 0; i < j; ++ i) {
+                    T c (h (i, restart + 1)), s (h (i, restart + 2));
+                    T hi (h (i, j)), hi1 (h (i + 1, j));
+                    h (i, j) = c * hi + s * hi1;
+                    h (i + 1, j) = - type_traits<T>::conj (s) * hi + c * hi1;
+                }
+                // Compute the rotation which annihilates h (j + 1, j)
+                T hjj (h (j, j));
+                real_type ajj (type_traits<T>::type_abs (hjj));
+                // A zero column, A is singular on the invariant Krylov
+                // subspace and the residual cannot decrease any more
+                if (ajj == real_type/*zero*/() && hnorm == real_type/*zero*/()) {
+                    ++ it;
+                    monitor (it, rnorm);
+                    stagnation = true;
+                    break;
+                }
+                real_type nrm (type_traits<real_type>::type_sqrt (ajj * ajj + hnorm * hnorm));
+                T c (1), s = T/*zero*/();
+                if (ajj == real_type/*zero*/()) {
+                    c = T/*zero*/();
+                    s = T (1);
+                } else if (hnorm != real_type/*zero*/()) {
+                    c = T (ajj / nrm);
+                    s = (hjj / T (ajj)) * T (hnorm / nrm);
+                }
+                h (j, restart + 1) = c;
+                h (j, restart + 2) = s;
+                h (j, j) = c * hjj + s * T (hnorm);
+                h (j + 1, j) = T/*zero*/();
+                T g (h (j, restart));
+                h (j, restart) = c * g;
+                h (j + 1, restart) = - type_traits<T>::conj (s) * g;
+                rnorm = type_traits<T>::type_abs (h (j + 1, restart));
+                ++ j;
+                ++ it;
+                monitor (it, rnorm);
+                if (control.satisfied (rnorm))
+                    break;
+            }
+            // Solve the triangular system H y = g in place of g, the
+            // first j columns have nonzero pivots
+            for (size_type i = j; i-- > 0; ) {
+                T t (h (i, restart));
+                for (size_type k = i + 1; k < j; ++ k)
+                    t -= h (i, k) * h (k, restart);
+                h (i, restart) = t / h (i, i);
+            }
+            // x += M (V y)
+            w.clear ();
+            for (size_type i = 0; i < j; ++ i)
+                noalias (w) += h (i, restart) * ws [i];
+            p.apply (w, z);
+            noalias (x) += z;
+            if (stagnation)
+                return control.finish (it, rnorm);
+            // Restart, the true residual decides about convergence
+        }
+    }
+    template<class A, class X, class E, class P, class R, class F>
+    BOOST_UBLAS_INLINE
+    std::size_t
+    gmres (const A &a, X &x, const vector_expression<E> &b, const P &p, std::size_t restart,
+           iteration_control<R> &control, F monitor) {
+        krylov_workspace<typename X::value_type> ws;
+        return gmres (a, x, b, p, restart, control, monitor, ws);
+    }
+    template<class A, class X, class E, class P, class R>
+    BOOST_UBLAS_INLINE
+    std::size_t
+    gmres (const A &a, X &x, const vector_expression<E> &b, const P &p, std::size_t restart,
+           iteration_control<R> &control) {
+        return gmres (a, x, b, p, restart, control, null_monitor ());
+    }
+
+}}}
+
+#endif
@@ -18,8 +18,11 @@
 #include <boost/numeric/ublas/matrix_proxy.hpp>
 #include <boost/numeric/ublas/vector.hpp>
 #include <boost/numeric/ublas/triangular.hpp>
+#include <boost/numeric/ublas/detail/blas_backend.hpp>
 
-// LU factorizations in the spirit of LAPACK and Golub & van Loan
+// LU factorizations in the spirit of LAPACK and Golub & van Loan. With
+// BOOST_UBLAS_USE_LAPACK and BOOST_UBLAS_USE_CBLAS dense matrices are
+// factorized by ?getrf and substituted by ?trsm and ?trsv.
 
 namespace boost { namespace numeric { namespace ublas {
 
@@ -139,6 +142,11 @@ namespace boost { namespace numeric { namespace ublas {
         size_type size1 = m.size1 ();
         size_type size2 = m.size2 ();
         size_type size = (std::min) (size1, size2);
+#ifdef BOOST_UBLAS_USE_LAPACK
+        // Nothing left to eliminate once factorized by getrf
+        if (detail::lapack_lu_factorize<M>::apply (m, pm, singular))
+            size = 0;
+#endif
         for (size_type i = 0; i < size; ++ i) {
             matrix_column<M> mci (column (m, i));
             matrix_row<M> mri (row (m, i));
@@ -264,6 +272,10 @@ namespace boost { namespace numeric { namespace ublas {
     // LU substitution
     template<class M, class E>
     void lu_substitute (const M &m, vector_expression<E> &e) {
+#if defined (BOOST_UBLAS_USE_CBLAS) && ! defined (BOOST_UBLAS_SINGULAR_CHECK)
+        if (detail::blas_lu_substitute_vector<M, E>::apply (m, e ()))
+            return;
+#endif
 #if BOOST_UBLAS_TYPE_CHECK
         typedef const M const_matrix_type;
         typedef vector<typename E::value_type> vector_type;
@@ -282,6 +294,10 @@ namespace boost { namespace numeric { namespace ublas {
     }
     template<class M, class E>
     void lu_substitute (const M &m, matrix_expression<E> &e) {
+#if defined (BOOST_UBLAS_USE_CBLAS) && ! defined (BOOST_UBLAS_SINGULAR_CHECK)
+        if (detail::blas_lu_substitute<M, E>::apply (m, e ()))
+            return;
+#endif
 #if BOOST_UBLAS_TYPE_CHECK
         typedef const M const_matrix_type;
         typedef matrix<typename E::value_type> matrix_type;
@@ -18,6 +18,10 @@
 #include <boost/numeric/ublas/vector.hpp>
 #include <boost/numeric/ublas/matrix_expression.hpp>
 #include <boost/numeric/ublas/detail/matrix_assign.hpp>
+#include <boost/numeric/ublas/detail/matrix_vector_prod.hpp>
+#include <boost/numeric/ublas/detail/matrix_matrix_prod.hpp>
+#include <boost/numeric/ublas/detail/matrix_transpose.hpp>
+#include <boost/numeric/ublas/detail/expression_alias.hpp>
 #include <boost/serialization/collection_size_type.hpp>
 #include <boost/serialization/array.hpp>
 #include <boost/serialization/nvp.hpp>
@@ -143,6 +147,29 @@ namespace boost { namespace numeric {
 	        size1_ (size1), size2_ (size2), data_ (layout_type::storage_size (size1, size2), init) {
 	    }
 
+	  /** Dense matrix constructor with defined size whose elements of trivial types are not written
+	   * \param size1 number of rows
+	   * \param size2 number of columns
+	   */
+        BOOST_UBLAS_INLINE
+        matrix (size_type size1, size_type size2, uninitialized_tag tag):
+            matrix_container<self_type> (),
+            size1_ (size1), size2_ (size2), data_ () {
+            detail::resize_storage (data_, layout_type::storage_size (size1, size2), tag);
+        }
+
+	  /** Dense matrix constructor with defined size whose elements are value initialised in parallel
+	   * Every element is first written by the thread that works on it in the parallel kernels.
+	   * \param size1 number of rows
+	   * \param size2 number of columns
+	   */
+        BOOST_UBLAS_INLINE
+        matrix (size_type size1, size_type size2, first_touch_tag tag):
+            matrix_container<self_type> (),
+            size1_ (size1), size2_ (size2), data_ () {
+            detail::resize_storage (data_, layout_type::storage_size (size1, size2), tag);
+        }
+
 	  /** Dense matrix constructor with defined size and an initial data array
 	   * \param size1 number of rows
 	   * \param size2 number of columns
@@ -226,6 +253,29 @@ namespace boost { namespace numeric {
             }
         }
 
+	  /** Resize a matrix to new dimensions without preserving the data, elements of trivial types are not written
+	   * \param size1 the new number of rows
+	   * \param size2 the new number of colums
+	   */
+        BOOST_UBLAS_INLINE
+        void resize (size_type size1, size_type size2, uninitialized_tag tag) {
+            detail::resize_storage (data (), layout_type::storage_size (size1, size2), tag);
+            size1_ = size1;
+            size2_ = size2;
+        }
+
+	  /** Resize a matrix to new dimensions without preserving the data, elements are value initialised in parallel
+	   * Every element is first written by the thread that works on it in the parallel kernels.
+	   * \param size1 the new number of rows
+	   * \param size2 the new number of colums
+	   */
+        BOOST_UBLAS_INLINE
+        void resize (size_type size1, size_type size2, first_touch_tag tag) {
+            detail::resize_storage (data (), layout_type::storage_size (size1, size2), tag);
+            size1_ = size1;
+            size2_ = size2;
+        }
+
         // Element access
     
     /** Access a matrix element. Here we return a const reference
@@ -347,9 +397,26 @@ namespace boost { namespace numeric {
             swap (m);
             return *this;
         }
+        // Evaluates into a temporary of the current temporary_arena
+        template<class AE>
+        matrix &assign_arena_temporary (const matrix_expression<AE> &ae) {
+            typename detail::temporary_matrix<value_type, L>::type temporary (ae);
+            resize (temporary.size1 (), temporary.size2 (), false);
+            return assign (temporary);
+        }
         template<class AE>
         BOOST_UBLAS_INLINE
         matrix &operator = (const matrix_expression<AE> &ae) {
+            // In place, unless the expression reads the storage written
+            if (! detail::matrix_may_alias (*this, ae)) {
+                if (size1 () != ae ().size1 () || size2 () != ae ().size2 ())
+                    resize (ae ().size1 (), ae ().size2 (), false);
+                return assign (ae);
+            }
+#ifndef BOOST_UBLAS_NO_TEMPORARY_ARENA
+            if (temporary_arena::current ())
+                return assign_arena_temporary (ae);
+#endif
             self_type temporary (ae);
             return assign_temporary (temporary);
         }
@@ -362,6 +429,12 @@ namespace boost { namespace numeric {
         template<class AE>
         BOOST_UBLAS_INLINE
         matrix& operator += (const matrix_expression<AE> &ae) {
+            if (! detail::matrix_may_alias (*this, ae))
+                return plus_assign (ae);
+#ifndef BOOST_UBLAS_NO_TEMPORARY_ARENA
+            if (temporary_arena::current ())
+                return assign_arena_temporary (*this + ae);
+#endif
             self_type temporary (*this + ae);
             return assign_temporary (temporary);
         }
@@ -380,6 +453,12 @@ namespace boost { namespace numeric {
         template<class AE>
         BOOST_UBLAS_INLINE
         matrix& operator -= (const matrix_expression<AE> &ae) {
+            if (! detail::matrix_may_alias (*this, ae))
+                return minus_assign (ae);
+#ifndef BOOST_UBLAS_NO_TEMPORARY_ARENA
+            if (temporary_arena::current ())
+                return assign_arena_temporary (*this - ae);
+#endif
             self_type temporary (*this - ae);
             return assign_temporary (temporary);
         }
@@ -1435,6 +1514,9 @@ namespace boost { namespace numeric {
         template<class AE>
         BOOST_UBLAS_INLINE
         fixed_matrix &operator = (const matrix_expression<AE> &ae) {
+            // In place, unless the expression reads the storage written
+            if (! detail::matrix_may_alias (*this, ae))
+                return assign (ae);
             self_type temporary (ae);
             return assign_temporary (temporary);
         }
@@ -1447,6 +1529,8 @@ namespace boost { namespace numeric {
         template<class AE>
         BOOST_UBLAS_INLINE
         fixed_matrix& operator += (const matrix_expression<AE> &ae) {
+            if (! detail::matrix_may_alias (*this, ae))
+                return plus_assign (ae);
             self_type temporary (*this + ae);
             return assign_temporary (temporary);
         }
@@ -1465,6 +1549,8 @@ namespace boost { namespace numeric {
         template<class AE>
         BOOST_UBLAS_INLINE
         fixed_matrix& operator -= (const matrix_expression<AE> &ae) {
+            if (! detail::matrix_may_alias (*this, ae))
+                return minus_assign (ae);
             self_type temporary (*this - ae);
             return assign_temporary (temporary);
         }
@@ -5146,6 +5232,12 @@ namespace boost { namespace numeric {
         template<class AE>
         BOOST_UBLAS_INLINE
         c_matrix &operator = (const matrix_expression<AE> &ae) { 
+            // In place, unless the expression reads the storage written
+            if (! detail::matrix_may_alias (*this, ae)) {
+                if (size1 () != ae ().size1 () || size2 () != ae ().size2 ())
+                    resize (ae ().size1 (), ae ().size2 (), false);
+                return assign (ae);
+            }
             self_type temporary (ae);
             return assign_temporary (temporary);
         }
@@ -5158,6 +5250,8 @@ namespace boost { namespace numeric {
         template<class AE>
         BOOST_UBLAS_INLINE
         c_matrix& operator += (const matrix_expression<AE> &ae) {
+            if (! detail::matrix_may_alias (*this, ae))
+                return plus_assign (ae);
             self_type temporary (*this + ae);
             return assign_temporary (temporary);
         }
@@ -5176,6 +5270,8 @@ namespace boost { namespace numeric {
         template<class AE>
         BOOST_UBLAS_INLINE
         c_matrix& operator -= (const matrix_expression<AE> &ae) {
+            if (! detail::matrix_may_alias (*this, ae))
+                return minus_assign (ae);
             self_type temporary (*this - ae);
             return assign_temporary (temporary);
         }
@@ -6010,4 +6106,7 @@ namespace boost { namespace numeric {
 
 }}}
 
+// Needs the declarations of fixed_vector and fixed_matrix
+#include <boost/numeric/ublas/detail/fixed_kernels.hpp>
+
 #endif
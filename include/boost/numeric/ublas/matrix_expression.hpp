@@ -2983,6 +2983,17 @@ public:
 		return e2_.size2 ();
 	}
 
+public:
+	// Expression accessors
+	BOOST_UBLAS_INLINE
+	expression1_closure_type expression1 () const {
+		return e1_;
+	}
+	BOOST_UBLAS_INLINE
+	const expression2_closure_type &expression2 () const {
+		return e2_;
+	}
+
 public:
 	// Element access
 	BOOST_UBLAS_INLINE
@@ -3512,6 +3523,17 @@ public:
 		return e1_.size2 ();
 	}
 
+public:
+	// Expression accessors
+	BOOST_UBLAS_INLINE
+	const expression1_closure_type &expression1 () const {
+		return e1_;
+	}
+	BOOST_UBLAS_INLINE
+	expression2_closure_type expression2 () const {
+		return e2_;
+	}
+
 public:
 	// Element access
 	BOOST_UBLAS_INLINE
@@ -14,6 +14,7 @@
 #define _BOOST_UBLAS_OPERATION_
 
 #include <boost/numeric/ublas/matrix_proxy.hpp>
+#include <boost/numeric/ublas/detail/blas_backend.hpp>
 
 /** \file operation.hpp
  *  \brief This file contains some specialized products.
@@ -224,6 +225,7 @@ namespace boost { namespace numeric { namespace ublas {
 
           Up to now there are some specialisation for compressed
           matrices that give a large speed up compared to prod.
+          With BOOST_UBLAS_USE_CBLAS dense operands are handed to ?gemv.
           
           \ingroup blas2
 
@@ -243,6 +245,10 @@ namespace boost { namespace numeric { namespace ublas {
         typedef typename V::value_type value_type;
         typedef typename E2::const_iterator::iterator_category iterator_category;
 
+#ifdef BOOST_UBLAS_USE_CBLAS
+        if (detail::blas_matrix_vector_prod<V, E1, E2>::apply (v, e1 (), e2 (), value_type (1), value_type (init ? 0 : 1), false))
+            return v;
+#endif
         if (init)
             v.assign (zero_vector<value_type> (e1 ().size1 ()));
 #if BOOST_UBLAS_TYPE_CHECK
@@ -442,6 +448,7 @@ namespace boost { namespace numeric { namespace ublas {
 
           Up to now there are some specialisation for compressed
           matrices that give a large speed up compared to prod.
+          With BOOST_UBLAS_USE_CBLAS dense operands are handed to ?gemv.
           
           \ingroup blas2
 
@@ -461,6 +468,10 @@ namespace boost { namespace numeric { namespace ublas {
         typedef typename V::value_type value_type;
         typedef typename E1::const_iterator::iterator_category iterator_category;
 
+#ifdef BOOST_UBLAS_USE_CBLAS
+        if (detail::blas_matrix_vector_prod<V, E2, E1>::apply (v, e2 (), e1 (), value_type (1), value_type (init ? 0 : 1), true))
+            return v;
+#endif
         if (init)
             v.assign (zero_vector<value_type> (e2 ().size2 ()));
 #if BOOST_UBLAS_TYPE_CHECK
@@ -679,7 +690,8 @@ namespace boost { namespace numeric { namespace ublas {
           <tt>M.clear()</tt> before <tt>axpy_prod</tt>. Currently \a init
           defaults to \c true, but this may change in the future.
 
-          Up to now there are no specialisations.
+          Up to now there are no specialisations. With
+          BOOST_UBLAS_USE_CBLAS dense operands are handed to ?gemm.
           
           \ingroup blas3
 
@@ -700,6 +712,10 @@ namespace boost { namespace numeric { namespace ublas {
         typedef typename M::storage_category storage_category;
         typedef typename M::orientation_category orientation_category;
 
+#ifdef BOOST_UBLAS_USE_CBLAS
+        if (detail::blas_matrix_matrix_prod<M, E1, E2>::apply (m, e1 (), e2 (), value_type (1), value_type (init ? 0 : 1)))
+            return m;
+#endif
         if (init)
             m.assign (zero_matrix<value_type> (e1 ().size1 (), e2 ().size2 ()));
         return axpy_prod (e1, e2, m, full (), storage_category (), orientation_category ());
@@ -16,6 +16,7 @@
 #include <boost/numeric/ublas/traits.hpp>
 #include <boost/numeric/ublas/detail/vector_assign.hpp> // indexing_vector_assign
 #include <boost/numeric/ublas/detail/matrix_assign.hpp> // indexing_matrix_assign
+#include <boost/numeric/ublas/temporary_arena.hpp>
 
 
 namespace boost { namespace numeric { namespace ublas {
@@ -48,7 +49,7 @@ namespace boost { namespace numeric { namespace ublas {
             vector_range<vector_type> v_range (v, range (i_begin, i_end));
 #else
             // vector<value_type, bounded_array<value_type, block_size> > v_range (i_end - i_begin);
-            vector<value_type> v_range (i_end - i_begin);
+            typename detail::temporary_vector<value_type>::type v_range (i_end - i_begin);
 #endif
             v_range.assign (zero_vector<value_type> (i_end - i_begin));
             for (size_type j_begin = 0; j_begin < j_size; j_begin += block_size) {
@@ -60,8 +61,8 @@ namespace boost { namespace numeric { namespace ublas {
 #else
                 // const matrix<value_type, row_major, bounded_array<value_type, block_size * block_size> > e1_range (project (e1 (), range (i_begin, i_end), range (j_begin, j_end)));
                 // const vector<value_type, bounded_array<value_type, block_size> > e2_range (project (e2 (), range (j_begin, j_end)));
-                const matrix<value_type, row_major> e1_range (project (e1 (), range (i_begin, i_end), range (j_begin, j_end)));
-                const vector<value_type> e2_range (project (e2 (), range (j_begin, j_end)));
+                const typename detail::temporary_matrix<value_type, row_major>::type e1_range (project (e1 (), range (i_begin, i_end), range (j_begin, j_end)));
+                const typename detail::temporary_vector<value_type>::type e2_range (project (e2 (), range (j_begin, j_end)));
                 v_range.plus_assign (prod (e1_range, e2_range));
 #endif
             }
@@ -103,7 +104,7 @@ namespace boost { namespace numeric { namespace ublas {
             vector_range<vector_type> v_range (v, range (j_begin, j_end));
 #else
             // vector<value_type, bounded_array<value_type, block_size> > v_range (j_end - j_begin);
-            vector<value_type> v_range (j_end - j_begin);
+            typename detail::temporary_vector<value_type>::type v_range (j_end - j_begin);
 #endif
             v_range.assign (zero_vector<value_type> (j_end - j_begin));
             for (size_type i_begin = 0; i_begin < i_size; i_begin += block_size) {
@@ -114,8 +115,8 @@ namespace boost { namespace numeric { namespace ublas {
 #else
                 // const vector<value_type, bounded_array<value_type, block_size> > e1_range (project (e1 (), range (i_begin, i_end)));
                 // const matrix<value_type, column_major, bounded_array<value_type, block_size * block_size> > e2_range (project (e2 (), range (i_begin, i_end), range (j_begin, j_end)));
-                const vector<value_type> e1_range (project (e1 (), range (i_begin, i_end)));
-                const matrix<value_type, column_major> e2_range (project (e2 (), range (i_begin, i_end), range (j_begin, j_end)));
+                const typename detail::temporary_vector<value_type>::type e1_range (project (e1 (), range (i_begin, i_end)));
+                const typename detail::temporary_matrix<value_type, column_major>::type e2_range (project (e2 (), range (i_begin, i_end), range (j_begin, j_end)));
 #endif
                 v_range.plus_assign (prod (e1_range, e2_range));
             }
@@ -162,7 +163,7 @@ namespace boost { namespace numeric { namespace ublas {
                 matrix_range<matrix_type> m_range (m, range (i_begin, i_end), range (j_begin, j_end));
 #else
                 // matrix<value_type, row_major, bounded_array<value_type, block_size * block_size> > m_range (i_end - i_begin, j_end - j_begin);
-                matrix<value_type, row_major> m_range (i_end - i_begin, j_end - j_begin);
+                typename detail::temporary_matrix<value_type, row_major>::type m_range (i_end - i_begin, j_end - j_begin);
 #endif
                 m_range.assign (zero_matrix<value_type> (i_end - i_begin, j_end - j_begin));
                 for (size_type k_begin = 0; k_begin < k_size; k_begin += block_size) {
@@ -173,8 +174,8 @@ namespace boost { namespace numeric { namespace ublas {
 #else
                     // const matrix<value_type, row_major, bounded_array<value_type, block_size * block_size> > e1_range (project (e1 (), range (i_begin, i_end), range (k_begin, k_end)));
                     // const matrix<value_type, column_major, bounded_array<value_type, block_size * block_size> > e2_range (project (e2 (), range (k_begin, k_end), range (j_begin, j_end)));
-                    const matrix<value_type, row_major> e1_range (project (e1 (), range (i_begin, i_end), range (k_begin, k_end)));
-                    const matrix<value_type, column_major> e2_range (project (e2 (), range (k_begin, k_end), range (j_begin, j_end)));
+                    const typename detail::temporary_matrix<value_type, row_major>::type e1_range (project (e1 (), range (i_begin, i_end), range (k_begin, k_end)));
+                    const typename detail::temporary_matrix<value_type, column_major>::type e2_range (project (e2 (), range (k_begin, k_end), range (j_begin, j_end)));
 #endif
                     m_range.plus_assign (prod (e1_range, e2_range));
                 }
@@ -223,7 +224,7 @@ namespace boost { namespace numeric { namespace ublas {
                 matrix_range<matrix_type> m_range (m, range (i_begin, i_end), range (j_begin, j_end));
 #else
                 // matrix<value_type, column_major, bounded_array<value_type, block_size * block_size> > m_range (i_end - i_begin, j_end - j_begin);
-                matrix<value_type, column_major> m_range (i_end - i_begin, j_end - j_begin);
+                typename detail::temporary_matrix<value_type, column_major>::type m_range (i_end - i_begin, j_end - j_begin);
 #endif
                 m_range.assign (zero_matrix<value_type> (i_end - i_begin, j_end - j_begin));
                 for (size_type k_begin = 0; k_begin < k_size; k_begin += block_size) {
@@ -234,8 +235,8 @@ namespace boost { namespace numeric { namespace ublas {
 #else
                     // const matrix<value_type, row_major, bounded_array<value_type, block_size * block_size> > e1_range (project (e1 (), range (i_begin, i_end), range (k_begin, k_end)));
                     // const matrix<value_type, column_major, bounded_array<value_type, block_size * block_size> > e2_range (project (e2 (), range (k_begin, k_end), range (j_begin, j_end)));
-                    const matrix<value_type, row_major> e1_range (project (e1 (), range (i_begin, i_end), range (k_begin, k_end)));
-                    const matrix<value_type, column_major> e2_range (project (e2 (), range (k_begin, k_end), range (j_begin, j_end)));
+                    const typename detail::temporary_matrix<value_type, row_major>::type e1_range (project (e1 (), range (i_begin, i_end), range (k_begin, k_end)));
+                    const typename detail::temporary_matrix<value_type, column_major>::type e2_range (project (e2 (), range (k_begin, k_end), range (j_begin, j_end)));
 #endif
                     m_range.plus_assign (prod (e1_range, e2_range));
                 }
@@ -0,0 +1,421 @@
+//
+//  Copyright (c) 2019
+//  The Boost.uBLAS developers
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef _BOOST_UBLAS_OPERATION_CHAIN_
+#define _BOOST_UBLAS_OPERATION_CHAIN_
+
+#include <cstddef>
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/matrix_proxy.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+#include <boost/numeric/ublas/temporary_arena.hpp>
+#include <boost/numeric/ublas/detail/raw.hpp>
+#include <boost/numeric/ublas/detail/blas_backend.hpp>
+#include <boost/numeric/ublas/detail/matrix_matrix_prod.hpp>
+#include <boost/numeric/ublas/detail/matrix_vector_prod.hpp>
+
+/** \file operation_chain.hpp
+ *  \brief Products of chains of matrices in the cheapest order.
+ *
+ * <tt>chain_prod (a, b, c)</tt> is <tt>prod (prod (a, b), c)</tt> or
+ * <tt>prod (a, prod (b, c))</tt>, whichever takes fewer multiplications
+ * for the sizes of \c a, \c b and \c c at run time, and likewise for up
+ * to six factors, the last of which may be a vector. The order is found
+ * by dynamic programming over the sizes of the factors. Dense factors of
+ * the result's value type are read in place, the others are evaluated
+ * first. The products go to the packed kernels of \c prod (), those with
+ * a single column to the matrix vector kernels, or to ?gemm and ?gemv
+ * with \c BOOST_UBLAS_USE_CBLAS. Intermediate results are temporaries,
+ * see temporary_arena.hpp.
+ */
+
+namespace boost { namespace numeric { namespace ublas {
+
+namespace detail {
+
+    // A factor of a chain, a strided matrix of the chain's value type
+    template<class T>
+    struct matrix_chain_operand {
+        typedef std::size_t size_type;
+        typedef T value_type;
+
+        BOOST_UBLAS_INLINE
+        matrix_chain_operand ():
+            m_ (0, 0, 0), size1_ (0), size2_ (0) {}
+        BOOST_UBLAS_INLINE
+        matrix_chain_operand (const raw::strided_matrix_view<const T> &m, size_type size1, size_type size2):
+            m_ (m), size1_ (size1), size2_ (size2) {}
+        BOOST_UBLAS_INLINE
+        size_type size1 () const {
+            return size1_;
+        }
+        BOOST_UBLAS_INLINE
+        size_type size2 () const {
+            return size2_;
+        }
+        BOOST_UBLAS_INLINE
+        const T &operator () (size_type i, size_type j) const {
+            return m_ (i, j);
+        }
+
+        raw::strided_matrix_view<const T> m_;
+        size_type size1_;
+        size_type size2_;
+    };
+
+    // The factors of a chain, their order of evaluation and the evaluation
+    template<class T>
+    class matrix_chain {
+    public:
+        typedef std::size_t size_type;
+        typedef T value_type;
+        typedef matrix_chain_operand<T> operand_type;
+        typedef typename temporary_matrix<T>::type temporary_type;
+
+        enum { max_size = 6 };
+
+        BOOST_UBLAS_INLINE
+        matrix_chain ():
+            size_ (0) {}
+
+        // Strided factors of the value type are read in place, the
+        // others evaluated into a temporary first
+        template<class E>
+        BOOST_UBLAS_INLINE
+        void push_back (const matrix_expression<E> &e) {
+            push_back (e (), boost::integral_constant<bool, (raw::strided_matrix_traits<E>::value &&
+                                                             boost::is_same<typename E::value_type, T>::value)> ());
+        }
+        // A vector is the last factor, a single column
+        template<class E>
+        BOOST_UBLAS_INLINE
+        void push_back (const vector_expression<E> &e) {
+            push_back_vector (e (), boost::integral_constant<bool, (raw::strided_vector_traits<E>::value &&
+                                                                    boost::is_same<typename E::value_type, T>::value)> ());
+        }
+
+        BOOST_UBLAS_INLINE
+        size_type size1 () const {
+            return operands_ [0].size1 ();
+        }
+        BOOST_UBLAS_INLINE
+        size_type size2 () const {
+            return operands_ [size_ - 1].size2 ();
+        }
+
+        // Multiplications of the cheapest order, found by order ()
+        BOOST_UBLAS_INLINE
+        double multiplications () const {
+            return cost_ [size_ - 1];
+        }
+
+        // The cheapest order of the products of factors i to j for every
+        // i and j, the longer runs from the shorter ones
+        void order () {
+            BOOST_UBLAS_CHECK (size_ >= 2, bad_size ());
+            for (size_type i = 0; i < size_; ++ i)
+                cost_ [i * size_ + i] = 0;
+            for (size_type length = 2; length <= size_; ++ length)
+                for (size_type i = 0; i + length <= size_; ++ i) {
+                    size_type j (i + length - 1);
+                    double rows (double (operands_ [i].size1 ()));
+                    double columns (double (operands_ [j].size2 ()));
+                    for (size_type k = i; k < j; ++ k) {
+                        double cost (cost_ [i * size_ + k] + cost_ [(k + 1) * size_ + j] +
+                                     rows * double (operands_ [k].size2 ()) * columns);
+                        if (k == i || cost < cost_ [i * size_ + j]) {
+                            cost_ [i * size_ + j] = cost;
+                            split_ [i * size_ + j] = k;
+                        }
+                    }
+                }
+        }
+
+        // W = the product of all factors, in the order of order ()
+        BOOST_UBLAS_INLINE
+        void evaluate (const raw::strided_matrix_view<T> &w) const {
+            evaluate (w, 0, size_ - 1);
+        }
+
+    private:
+        template<class E>
+        BOOST_UBLAS_INLINE
+        void push_back (const E &e, boost::true_type) {
+            check_size (e.size1 ());
+            operands_ [size_ ++] = operand_type (raw::strided_matrix (e), e.size1 (), e.size2 ());
+        }
+        template<class E>
+        void push_back (const E &e, boost::false_type) {
+            check_size (e.size1 ());
+            temporary_type &t (copies_ [size_]);
+            t.resize (e.size1 (), e.size2 (), false);
+            t.assign (e);
+            operands_ [size_ ++] = operand_type (raw::strided_matrix (static_cast<const temporary_type &> (t)), t.size1 (), t.size2 ());
+        }
+        template<class E>
+        BOOST_UBLAS_INLINE
+        void push_back_vector (const E &e, boost::true_type) {
+            check_size (e.size ());
+            raw::strided_vector_view<const T> v (raw::strided_vector (e));
+            operands_ [size_ ++] = operand_type (raw::strided_matrix_view<const T> (v.data_, v.stride_, 1), e.size (), 1);
+        }
+        template<class E>
+        void push_back_vector (const E &e, boost::false_type) {
+            check_size (e.size ());
+            temporary_type &t (copies_ [size_]);
+            t.resize (e.size (), 1, false);
+            column (t, 0).assign (e);
+            operands_ [size_ ++] = operand_type (raw::strided_matrix (static_cast<const temporary_type &> (t)), t.size1 (), 1);
+        }
+        BOOST_UBLAS_INLINE
+        void check_size (size_type size1) const {
+            BOOST_UBLAS_CHECK (size_ < size_type (max_size), bad_index ());
+            BOOST_UBLAS_CHECK (size_ == 0 || operands_ [size_ - 1].size2 () == size1, bad_size ());
+        }
+
+        // W = the product of factors i to j
+        void evaluate (const raw::strided_matrix_view<T> &w, size_type i, size_type j) const {
+            size_type k (split_ [i * size_ + j]);
+            temporary_type t1, t2;
+            operand_type e1 (factor (t1, i, k)), e2 (factor (t2, k + 1, j));
+            product (w, e1, e2);
+        }
+        // Factor i, or the product of factors i to j evaluated into t
+        operand_type factor (temporary_type &t, size_type i, size_type j) const {
+            if (i == j)
+                return operands_ [i];
+            t.resize (operands_ [i].size1 (), operands_ [j].size2 (), false);
+            evaluate (raw::strided_matrix (t), i, j);
+            return operand_type (raw::strided_matrix (static_cast<const temporary_type &> (t)), t.size1 (), t.size2 ());
+        }
+
+        // W = A B, as a matrix vector product when B is a single column
+        static void product (const raw::strided_matrix_view<T> &w, const operand_type &a, const operand_type &b) {
+            size_type size1 (a.size1 ()), size2 (b.size2 ()), size (a.size2 ());
+#ifdef BOOST_UBLAS_USE_CBLAS
+            if (blas_product (w, a, b, boost::integral_constant<bool, blas_types<T>::value> ()))
+                return;
+#endif
+            if (size2 == 1) {
+                raw::strided_vector_view<T> y (w.data_, w.stride1_);
+                raw::strided_vector_view<const T> x (b.m_.data_, b.m_.stride1_);
+                if (a.m_.stride2_ == 1)
+                    matrix_vector_prod<scalar_assign> (y, a, x, row_major_tag ());
+                else
+                    matrix_vector_prod<scalar_assign> (y, a, x, column_major_tag ());
+            } else if (size == 0) {
+                for (size_type i = 0; i < size1; ++ i)
+                    for (size_type j = 0; j < size2; ++ j)
+                        w (i, j) = T/*zero*/();
+            } else
+                matrix_matrix_prod_packed (w, a, b, size1, size2, size);
+        }
+#ifdef BOOST_UBLAS_USE_CBLAS
+        static bool blas_product (const raw::strided_matrix_view<T> &w, const operand_type &a, const operand_type &b, boost::true_type) {
+            blas_matrix_arg<T> aa (a.m_.data_, a.m_.stride1_, a.m_.stride2_, false);
+            if (b.size2 () == 1)
+                return blas_gemv (raw::strided_vector_view<T> (w.data_, w.stride1_), aa, a.size1 (), a.size2 (),
+                                  raw::strided_vector_view<const T> (b.m_.data_, b.m_.stride1_), T (1), T/*zero*/());
+            blas_matrix_arg<T> ba (b.m_.data_, b.m_.stride1_, b.m_.stride2_, false);
+            return blas_gemm (w, a.size1 (), b.size2 (), a.size2 (), aa, ba, T (1), T/*zero*/());
+        }
+        static BOOST_UBLAS_INLINE
+        bool blas_product (const raw::strided_matrix_view<T> &, const operand_type &, const operand_type &, boost::false_type) {
+            return false;
+        }
+#endif
+
+        operand_type operands_ [max_size];
+        temporary_type copies_ [max_size];
+        double cost_ [max_size * max_size];
+        size_type split_ [max_size * max_size];
+        size_type size_;
+    };
+
+}
+
+    // The value type of a chain, promoted over the factors
+    template<class T1, class T2, class T3 = T2, class T4 = T2, class T5 = T2, class T6 = T2>
+    struct chain_prod_traits {
+        typedef typename promote_traits<typename promote_traits<typename promote_traits<
+                    typename promote_traits<typename promote_traits<T1, T2>::promote_type, T3>::promote_type,
+                    T4>::promote_type, T5>::promote_type, T6>::promote_type value_type;
+        typedef matrix<value_type> matrix_type;
+        typedef vector<value_type> vector_type;
+    };
+
+namespace detail {
+
+    template<class M, class T>
+    BOOST_UBLAS_INLINE
+    M chain_prod_evaluate (matrix_chain<T> &c) {
+        c.order ();
+        M m (c.size1 (), c.size2 ());
+        c.evaluate (raw::strided_matrix (m));
+        return m;
+    }
+    template<class V, class T>
+    BOOST_UBLAS_INLINE
+    V chain_prod_evaluate_vector (matrix_chain<T> &c) {
+        c.order ();
+        V v (c.size1 ());
+        raw::strided_vector_view<T> w (raw::strided_vector (v));
+        c.evaluate (raw::strided_matrix_view<T> (w.data_, w.stride_, 1));
+        return v;
+    }
+
+}
+
+    /** \brief Product of three or more matrices in the cheapest order.
+     *
+     * \param e1 ... e6 the factors, each with as many rows as the one
+     * before has columns
+     * \return the product as a \c matrix of the promoted value type
+     */
+    template<class E1, class E2, class E3>
+    typename chain_prod_traits<typename E1::value_type, typename E2::value_type,
+                               typename E3::value_type>::matrix_type
+    chain_prod (const matrix_expression<E1> &e1, const matrix_expression<E2> &e2,
+                const matrix_expression<E3> &e3) {
+        typedef chain_prod_traits<typename E1::value_type, typename E2::value_type,
+                                  typename E3::value_type> traits;
+        detail::matrix_chain<typename traits::value_type> c;
+        c.push_back (e1);
+        c.push_back (e2);
+        c.push_back (e3);
+        return detail::chain_prod_evaluate<typename traits::matrix_type> (c);
+    }
+    template<class E1, class E2, class E3, class E4>
+    typename chain_prod_traits<typename E1::value_type, typename E2::value_type,
+                               typename E3::value_type, typename E4::value_type>::matrix_type
+    chain_prod (const matrix_expression<E1> &e1, const matrix_expression<E2> &e2,
+                const matrix_expression<E3> &e3, const matrix_expression<E4> &e4) {
+        typedef chain_prod_traits<typename E1::value_type, typename E2::value_type,
+                                  typename E3::value_type, typename E4::value_type> traits;
+        detail::matrix_chain<typename traits::value_type> c;
+        c.push_back (e1);
+        c.push_back (e2);
+        c.push_back (e3);
+        c.push_back (e4);
+        return detail::chain_prod_evaluate<typename traits::matrix_type> (c);
+    }
+    template<class E1, class E2, class E3, class E4, class E5>
+    typename chain_prod_traits<typename E1::value_type, typename E2::value_type,
+                               typename E3::value_type, typename E4::value_type,
+                               typename E5::value_type>::matrix_type
+    chain_prod (const matrix_expression<E1> &e1, const matrix_expression<E2> &e2,
+                const matrix_expression<E3> &e3, const matrix_expression<E4> &e4,
+                const matrix_expression<E5> &e5) {
+        typedef chain_prod_traits<typename E1::value_type, typename E2::value_type,
+                                  typename E3::value_type, typename E4::value_type,
+                                  typename E5::value_type> traits;
+        detail::matrix_chain<typename traits::value_type> c;
+        c.push_back (e1);
+        c.push_back (e2);
+        c.push_back (e3);
+        c.push_back (e4);
+        c.push_back (e5);
+        return detail::chain_prod_evaluate<typename traits::matrix_type> (c);
+    }
+    template<class E1, class E2, class E3, class E4, class E5, class E6>
+    typename chain_prod_traits<typename E1::value_type, typename E2::value_type,
+                               typename E3::value_type, typename E4::value_type,
+                               typename E5::value_type, typename E6::value_type>::matrix_type
+    chain_prod (const matrix_expression<E1> &e1, const matrix_expression<E2> &e2,
+                const matrix_expression<E3> &e3, const matrix_expression<E4> &e4,
+                const matrix_expression<E5> &e5, const matrix_expression<E6> &e6) {
+        typedef chain_prod_traits<typename E1::value_type, typename E2::value_type,
+                                  typename E3::value_type, typename E4::value_type,
+                                  typename E5::value_type, typename E6::value_type> traits;
+        detail::matrix_chain<typename traits::value_type> c;
+        c.push_back (e1);
+        c.push_back (e2);
+        c.push_back (e3);
+        c.push_back (e4);
+        c.push_back (e5);
+        c.push_back (e6);
+        return detail::chain_prod_evaluate<typename traits::matrix_type> (c);
+    }
+
+    /** \brief Product of two or more matrices and a vector in the cheapest order.
+     *
+     * Products ending with the vector are matrix vector products.
+     *
+     * \return the product as a \c vector of the promoted value type
+     */
+    template<class E1, class E2, class E3>
+    typename chain_prod_traits<typename E1::value_type, typename E2::value_type,
+                               typename E3::value_type>::vector_type
+    chain_prod (const matrix_expression<E1> &e1, const matrix_expression<E2> &e2,
+                const vector_expression<E3> &e3) {
+        typedef chain_prod_traits<typename E1::value_type, typename E2::value_type,
+                                  typename E3::value_type> traits;
+        detail::matrix_chain<typename traits::value_type> c;
+        c.push_back (e1);
+        c.push_back (e2);
+        c.push_back (e3);
+        return detail::chain_prod_evaluate_vector<typename traits::vector_type> (c);
+    }
+    template<class E1, class E2, class E3, class E4>
+    typename chain_prod_traits<typename E1::value_type, typename E2::value_type,
+                               typename E3::value_type, typename E4::value_type>::vector_type
+    chain_prod (const matrix_expression<E1> &e1, const matrix_expression<E2> &e2,
+                const matrix_expression<E3> &e3, const vector_expression<E4> &e4) {
+        typedef chain_prod_traits<typename E1::value_type, typename E2::value_type,
+                                  typename E3::value_type, typename E4::value_type> traits;
+        detail::matrix_chain<typename traits::value_type> c;
+        c.push_back (e1);
+        c.push_back (e2);
+        c.push_back (e3);
+        c.push_back (e4);
+        return detail::chain_prod_evaluate_vector<typename traits::vector_type> (c);
+    }
+    template<class E1, class E2, class E3, class E4, class E5>
+    typename chain_prod_traits<typename E1::value_type, typename E2::value_type,
+                               typename E3::value_type, typename E4::value_type,
+                               typename E5::value_type>::vector_type
+    chain_prod (const matrix_expression<E1> &e1, const matrix_expression<E2> &e2,
+                const matrix_expression<E3> &e3, const matrix_expression<E4> &e4,
+                const vector_expression<E5> &e5) {
+        typedef chain_prod_traits<typename E1::value_type, typename E2::value_type,
+                                  typename E3::value_type, typename E4::value_type,
+                                  typename E5::value_type> traits;
+        detail::matrix_chain<typename traits::value_type> c;
+        c.push_back (e1);
+        c.push_back (e2);
+        c.push_back (e3);
+        c.push_back (e4);
+        c.push_back (e5);
+        return detail::chain_prod_evaluate_vector<typename traits::vector_type> (c);
+    }
+    template<class E1, class E2, class E3, class E4, class E5, class E6>
+    typename chain_prod_traits<typename E1::value_type, typename E2::value_type,
+                               typename E3::value_type, typename E4::value_type,
+                               typename E5::value_type, typename E6::value_type>::vector_type
+    chain_prod (const matrix_expression<E1> &e1, const matrix_expression<E2> &e2,
+                const matrix_expression<E3> &e3, const matrix_expression<E4> &e4,
+                const matrix_expression<E5> &e5, const vector_expression<E6> &e6) {
+        typedef chain_prod_traits<typename E1::value_type, typename E2::value_type,
+                                  typename E3::value_type, typename E4::value_type,
+                                  typename E5::value_type, typename E6::value_type> traits;
+        detail::matrix_chain<typename traits::value_type> c;
+        c.push_back (e1);
+        c.push_back (e2);
+        c.push_back (e3);
+        c.push_back (e4);
+        c.push_back (e5);
+        c.push_back (e6);
+        return detail::chain_prod_evaluate_vector<typename traits::vector_type> (c);
+    }
+
+}}}
+
+#endif
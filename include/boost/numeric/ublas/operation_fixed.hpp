@@ -0,0 +1,191 @@
+//
+//  Copyright (c) 2019
+//  The Boost.uBLAS developers
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef _BOOST_UBLAS_OPERATION_FIXED_
+#define _BOOST_UBLAS_OPERATION_FIXED_
+
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/exception.hpp>
+
+/** \file operation_fixed.hpp
+ *  \brief Determinant and inverse of small fixed_matrix.
+ *
+ * The sizes are known at compile time, so both are computed in closed
+ * form from cofactors without pivoting, for matrices of size 1 to 4.
+ * Products and transposes of fixed_matrix and fixed_vector are assigned
+ * by unrolled kernels without including this header.
+ */
+
+#ifdef BOOST_UBLAS_CPP_GE_2011
+
+namespace boost { namespace numeric { namespace ublas {
+
+namespace detail {
+
+    // Determinant and adjugate of an N x N matrix, of any type with
+    // value_type and operator () (i, j)
+    template<std::size_t N>
+    struct fixed_cofactors;
+
+    template<>
+    struct fixed_cofactors<1> {
+        template<class M>
+        static BOOST_UBLAS_INLINE
+        typename M::value_type determinant (const M &a) {
+            return a (0, 0);
+        }
+        template<class M, class MI>
+        static BOOST_UBLAS_INLINE
+        typename M::value_type adjugate (const M &a, MI &b) {
+            b (0, 0) = typename M::value_type (1);
+            return a (0, 0);
+        }
+    };
+
+    template<>
+    struct fixed_cofactors<2> {
+        template<class M>
+        static BOOST_UBLAS_INLINE
+        typename M::value_type determinant (const M &a) {
+            return a (0, 0) * a (1, 1) - a (0, 1) * a (1, 0);
+        }
+        template<class M, class MI>
+        static BOOST_UBLAS_INLINE
+        typename M::value_type adjugate (const M &a, MI &b) {
+            b (0, 0) = a (1, 1);
+            b (0, 1) = - a (0, 1);
+            b (1, 0) = - a (1, 0);
+            b (1, 1) = a (0, 0);
+            return determinant (a);
+        }
+    };
+
+    template<>
+    struct fixed_cofactors<3> {
+        template<class M>
+        static BOOST_UBLAS_INLINE
+        typename M::value_type determinant (const M &a) {
+            return a (0, 0) * (a (1, 1) * a (2, 2) - a (1, 2) * a (2, 1)) +
+                   a (0, 1) * (a (1, 2) * a (2, 0) - a (1, 0) * a (2, 2)) +
+                   a (0, 2) * (a (1, 0) * a (2, 1) - a (1, 1) * a (2, 0));
+        }
+        template<class M, class MI>
+        static BOOST_UBLAS_INLINE
+        typename M::value_type adjugate (const M &a, MI &b) {
+            b (0, 0) = a (1, 1) * a (2, 2) - a (1, 2) * a (2, 1);
+            b (0, 1) = a (0, 2) * a (2, 1) - a (0, 1) * a (2, 2);
+            b (0, 2) = a (0, 1) * a (1, 2) - a (0, 2) * a (1, 1);
+            b (1, 0) = a (1, 2) * a (2, 0) - a (1, 0) * a (2, 2);
+            b (1, 1) = a (0, 0) * a (2, 2) - a (0, 2) * a (2, 0);
+            b (1, 2) = a (0, 2) * a (1, 0) - a (0, 0) * a (1, 2);
+            b (2, 0) = a (1, 0) * a (2, 1) - a (1, 1) * a (2, 0);
+            b (2, 1) = a (0, 1) * a (2, 0) - a (0, 0) * a (2, 1);
+            b (2, 2) = a (0, 0) * a (1, 1) - a (0, 1) * a (1, 0);
+            return a (0, 0) * b (0, 0) + a (0, 1) * b (1, 0) + a (0, 2) * b (2, 0);
+        }
+    };
+
+    // Laplace expansion along the 2 x 2 minors of the upper and the lower
+    // two rows. Always inlined, for the loops over the lanes of batched_inverse
+    // to be vectorized.
+    template<>
+    struct fixed_cofactors<4> {
+        template<class M>
+        struct minors {
+            typedef typename M::value_type value_type;
+
+            BOOST_FORCEINLINE
+            explicit minors (const M &a):
+                s0 (a (0, 0) * a (1, 1) - a (1, 0) * a (0, 1)),
+                s1 (a (0, 0) * a (1, 2) - a (1, 0) * a (0, 2)),
+                s2 (a (0, 0) * a (1, 3) - a (1, 0) * a (0, 3)),
+                s3 (a (0, 1) * a (1, 2) - a (1, 1) * a (0, 2)),
+                s4 (a (0, 1) * a (1, 3) - a (1, 1) * a (0, 3)),
+                s5 (a (0, 2) * a (1, 3) - a (1, 2) * a (0, 3)),
+                c0 (a (2, 0) * a (3, 1) - a (3, 0) * a (2, 1)),
+                c1 (a (2, 0) * a (3, 2) - a (3, 0) * a (2, 2)),
+                c2 (a (2, 0) * a (3, 3) - a (3, 0) * a (2, 3)),
+                c3 (a (2, 1) * a (3, 2) - a (3, 1) * a (2, 2)),
+                c4 (a (2, 1) * a (3, 3) - a (3, 1) * a (2, 3)),
+                c5 (a (2, 2) * a (3, 3) - a (3, 2) * a (2, 3)) {}
+            BOOST_FORCEINLINE
+            value_type determinant () const {
+                return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+            }
+
+            value_type s0, s1, s2, s3, s4, s5;
+            value_type c0, c1, c2, c3, c4, c5;
+        };
+
+        template<class M>
+        static BOOST_UBLAS_INLINE
+        typename M::value_type determinant (const M &a) {
+            return minors<M> (a).determinant ();
+        }
+        template<class M, class MI>
+        static BOOST_FORCEINLINE
+        typename M::value_type adjugate (const M &a, MI &b) {
+            const minors<M> m (a);
+            b (0, 0) =   a (1, 1) * m.c5 - a (1, 2) * m.c4 + a (1, 3) * m.c3;
+            b (0, 1) = - a (0, 1) * m.c5 + a (0, 2) * m.c4 - a (0, 3) * m.c3;
+            b (0, 2) =   a (3, 1) * m.s5 - a (3, 2) * m.s4 + a (3, 3) * m.s3;
+            b (0, 3) = - a (2, 1) * m.s5 + a (2, 2) * m.s4 - a (2, 3) * m.s3;
+            b (1, 0) = - a (1, 0) * m.c5 + a (1, 2) * m.c2 - a (1, 3) * m.c1;
+            b (1, 1) =   a (0, 0) * m.c5 - a (0, 2) * m.c2 + a (0, 3) * m.c1;
+            b (1, 2) = - a (3, 0) * m.s5 + a (3, 2) * m.s2 - a (3, 3) * m.s1;
+            b (1, 3) =   a (2, 0) * m.s5 - a (2, 2) * m.s2 + a (2, 3) * m.s1;
+            b (2, 0) =   a (1, 0) * m.c4 - a (1, 1) * m.c2 + a (1, 3) * m.c0;
+            b (2, 1) = - a (0, 0) * m.c4 + a (0, 1) * m.c2 - a (0, 3) * m.c0;
+            b (2, 2) =   a (3, 0) * m.s4 - a (3, 1) * m.s2 + a (3, 3) * m.s0;
+            b (2, 3) = - a (2, 0) * m.s4 + a (2, 1) * m.s2 - a (2, 3) * m.s0;
+            b (3, 0) = - a (1, 0) * m.c3 + a (1, 1) * m.c1 - a (1, 2) * m.c0;
+            b (3, 1) =   a (0, 0) * m.c3 - a (0, 1) * m.c1 + a (0, 2) * m.c0;
+            b (3, 2) = - a (3, 0) * m.s3 + a (3, 1) * m.s1 - a (3, 2) * m.s0;
+            b (3, 3) =   a (2, 0) * m.s3 - a (2, 1) * m.s1 + a (2, 2) * m.s0;
+            return m.determinant ();
+        }
+    };
+
+}
+
+    /** \brief Determinant of a fixed_matrix of size 1 to 4.
+     */
+    template<class T, std::size_t N, class L, class A>
+    BOOST_UBLAS_INLINE
+    T determinant (const fixed_matrix<T, N, N, L, A> &m) {
+        BOOST_STATIC_ASSERT (N >= 1 && N <= 4);
+        return detail::fixed_cofactors<N>::determinant (m);
+    }
+
+    /** \brief Inverse of a fixed_matrix of size 1 to 4.
+     *
+     * The adjugate divided by the determinant. Throws \c singular if
+     * the determinant is zero.
+     */
+    template<class T, std::size_t N, class L, class A>
+    BOOST_UBLAS_INLINE
+    fixed_matrix<T, N, N, L, A> inverse (const fixed_matrix<T, N, N, L, A> &m) {
+        BOOST_STATIC_ASSERT (N >= 1 && N <= 4);
+        typedef fixed_matrix<T, N, N, L, A> matrix_type;
+        matrix_type mi;
+        T d (detail::fixed_cofactors<N>::adjugate (m, mi));
+        if (d == T/*zero*/())
+            singular ().raise ();
+        T d_inv = T (1) / d;
+        detail::fixed_unroll<0, N * N>::apply ([&] (std::size_t k) {
+            mi.data () [k] *= d_inv;
+        });
+        return mi;
+    }
+
+}}}
+
+#endif // BOOST_UBLAS_CPP_GE_2011
+
+#endif
@@ -0,0 +1,273 @@
+//
+//  Copyright (c) 2019
+//  The Boost.uBLAS developers
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef _BOOST_UBLAS_OPERATION_FUSED_
+#define _BOOST_UBLAS_OPERATION_FUSED_
+
+#include <boost/type_traits/is_floating_point.hpp>
+#include <boost/numeric/ublas/vector_expression.hpp>
+#include <boost/numeric/ublas/detail/reduction.hpp>
+#include <boost/numeric/ublas/detail/vector_assign.hpp>
+
+/** \file operation_fused.hpp
+ *  \brief Vector assignments fused with a reduction over the assigned values.
+ *
+ * <tt>r = plus_assign_norm_2 (y, a * x)</tt> computes <tt>y += a * x</tt>
+ * and returns <tt>norm_2 (y)</tt> in a single pass over memory, instead
+ * of one pass for the assignment and another for the reduction. The
+ * right hand side is any vector expression and is evaluated element by
+ * element like after \c noalias, so it may only refer to the target at
+ * the same index. Like \c norm_2 (), the norms sum the plain squares and
+ * only when the sum overflows or loses precision to underflow sum the
+ * assigned vector a second time, scaled by a power of two.
+ */
+
+namespace boost { namespace numeric { namespace ublas {
+
+    /** \brief Accumulators of the fused reductions.
+     *
+     * An accumulator is called as <tt>r (i, t)</tt> for the new value
+     * \c t of every element \c i of the target and returns the
+     * reduction from \c result ().
+     */
+    template<class T>
+    struct fused_sum {
+        typedef T value_type;
+        typedef T result_type;
+
+        BOOST_UBLAS_INLINE
+        fused_sum ():
+            t_ () {}
+        template<class I>
+        BOOST_UBLAS_INLINE
+        void operator () (I, const value_type &t) {
+            t_ += t;
+        }
+        BOOST_UBLAS_INLINE
+        result_type result () const {
+            return t_;
+        }
+
+        result_type t_;
+    };
+
+    template<class T>
+    struct fused_norm_1 {
+        typedef T value_type;
+        typedef typename type_traits<T>::real_type real_type;
+        typedef real_type result_type;
+
+        BOOST_UBLAS_INLINE
+        fused_norm_1 ():
+            t_ () {}
+        template<class I>
+        BOOST_UBLAS_INLINE
+        void operator () (I, const value_type &t) {
+            t_ += type_traits<value_type>::type_abs (t);
+        }
+        BOOST_UBLAS_INLINE
+        result_type result () const {
+            return t_;
+        }
+
+        result_type t_;
+    };
+
+    template<class T>
+    struct fused_norm_2_square {
+        typedef T value_type;
+        typedef typename type_traits<T>::real_type real_type;
+        typedef real_type result_type;
+
+        BOOST_UBLAS_INLINE
+        fused_norm_2_square ():
+            t_ () {}
+        template<class I>
+        BOOST_UBLAS_INLINE
+        void operator () (I, const value_type &t) {
+            real_type u (type_traits<value_type>::norm_2 (t));
+            t_ += u * u;
+        }
+        BOOST_UBLAS_INLINE
+        result_type result () const {
+            return t_;
+        }
+
+        result_type t_;
+    };
+
+    // Sums the plain squares, assign_norm_2 () and the like rescale them
+    template<class T>
+    struct fused_norm_2:
+        public fused_norm_2_square<T> {
+        typedef typename fused_norm_2_square<T>::real_type real_type;
+        typedef real_type result_type;
+
+        BOOST_UBLAS_INLINE
+        result_type result () const {
+            return type_traits<real_type>::type_sqrt (this->t_);
+        }
+    };
+
+    template<class T>
+    struct fused_norm_inf {
+        typedef T value_type;
+        typedef typename type_traits<T>::real_type real_type;
+        typedef real_type result_type;
+
+        BOOST_UBLAS_INLINE
+        fused_norm_inf ():
+            t_ () {}
+        template<class I>
+        BOOST_UBLAS_INLINE
+        void operator () (I, const value_type &t) {
+            real_type u (type_traits<value_type>::norm_inf (t));
+            if (u > t_)
+                t_ = u;
+        }
+        BOOST_UBLAS_INLINE
+        result_type result () const {
+            return t_;
+        }
+
+        result_type t_;
+    };
+
+    // inner_prod (e, v) over the new values of v
+    template<class E, class T = typename E::value_type>
+    struct fused_inner_prod {
+        typedef typename E::const_closure_type expression_closure_type;
+        typedef T value_type;
+        typedef typename promote_traits<typename E::value_type, T>::promote_type result_type;
+
+        BOOST_UBLAS_INLINE
+        explicit fused_inner_prod (const E &e):
+            e_ (e), t_ () {}
+        template<class I>
+        BOOST_UBLAS_INLINE
+        void operator () (I i, const value_type &t) {
+            t_ += e_ (i) * t;
+        }
+        BOOST_UBLAS_INLINE
+        result_type result () const {
+            return t_;
+        }
+
+        expression_closure_type e_;
+        result_type t_;
+    };
+
+    // Dense (proxy) case
+    template<template <class T1, class T2> class F, class V, class E, class R>
+    void fused_vector_assign (V &v, const vector_expression<E> &e, R &r, dense_proxy_tag) {
+        typedef F<typename V::reference, typename E::value_type> functor_type;
+        typedef typename V::size_type size_type;
+        typedef typename V::value_type value_type;
+
+        size_type size (BOOST_UBLAS_SAME (v.size (), e ().size ()));
+        for (size_type i = 0; i < size; ++ i) {
+            typename V::reference t (v (i));
+            functor_type::apply (t, e () (i));
+            r (i, value_type (t));
+        }
+    }
+    // Packed and sparse case, assign first and reduce over the stored elements
+    template<template <class T1, class T2> class F, class V, class E, class R>
+    void fused_vector_assign (V &v, const vector_expression<E> &e, R &r, sparse_proxy_tag) {
+        BOOST_UBLAS_CHECK (v.size () == e ().size (), bad_size ());
+        vector_assign<F> (v, e);
+        typename V::const_iterator it (v.begin ());
+        typename V::const_iterator it_end (v.end ());
+        while (it != it_end) {
+            r (it.index (), *it);
+            ++ it;
+        }
+    }
+
+    /** \brief Applies <tt>F (v (i), e (i))</tt> to every element of \c v
+     *  and feeds the new values into the accumulator \c r.
+     *
+     * \tparam F an assignment functor such as \c scalar_assign,
+     *  \c scalar_plus_assign or \c scalar_minus_assign
+     * \return the accumulator \c r
+     */
+    template<template <class T1, class T2> class F, class V, class E, class R>
+    BOOST_UBLAS_INLINE
+    R &fused_vector_assign (V &v, const vector_expression<E> &e, R &r) {
+        fused_vector_assign<F> (v, e, r, typename V::storage_category ());
+        return r;
+    }
+
+namespace detail {
+
+    // norm_2 (v) from the fused sum t of its squares
+    template<class V, class T>
+    BOOST_UBLAS_INLINE
+    T fused_rescale_norm_2 (const V &v, const T &t) {
+        return rescale_norm_2 (v, t, naive_summation_tag (), boost::is_floating_point<T> ());
+    }
+
+}
+
+    // v = e, returns norm_2 (v)
+    template<class V, class E>
+    BOOST_UBLAS_INLINE
+    typename type_traits<typename V::value_type>::real_type
+    assign_norm_2 (V &v, const vector_expression<E> &e) {
+        fused_norm_2_square<typename V::value_type> r;
+        return detail::fused_rescale_norm_2 (v, fused_vector_assign<scalar_assign> (v, e, r).result ());
+    }
+    // v += e, returns norm_2 (v)
+    template<class V, class E>
+    BOOST_UBLAS_INLINE
+    typename type_traits<typename V::value_type>::real_type
+    plus_assign_norm_2 (V &v, const vector_expression<E> &e) {
+        fused_norm_2_square<typename V::value_type> r;
+        return detail::fused_rescale_norm_2 (v, fused_vector_assign<scalar_plus_assign> (v, e, r).result ());
+    }
+    // v -= e, returns norm_2 (v)
+    template<class V, class E>
+    BOOST_UBLAS_INLINE
+    typename type_traits<typename V::value_type>::real_type
+    minus_assign_norm_2 (V &v, const vector_expression<E> &e) {
+        fused_norm_2_square<typename V::value_type> r;
+        return detail::fused_rescale_norm_2 (v, fused_vector_assign<scalar_minus_assign> (v, e, r).result ());
+    }
+
+    // v = e1, returns inner_prod (e2, v)
+    template<class V, class E1, class E2>
+    BOOST_UBLAS_INLINE
+    typename fused_inner_prod<E2, typename V::value_type>::result_type
+    assign_inner_prod (V &v, const vector_expression<E1> &e1, const vector_expression<E2> &e2) {
+        BOOST_UBLAS_CHECK (v.size () == e2 ().size (), bad_size ());
+        fused_inner_prod<E2, typename V::value_type> r (e2 ());
+        return fused_vector_assign<scalar_assign> (v, e1, r).result ();
+    }
+    // v += e1, returns inner_prod (e2, v)
+    template<class V, class E1, class E2>
+    BOOST_UBLAS_INLINE
+    typename fused_inner_prod<E2, typename V::value_type>::result_type
+    plus_assign_inner_prod (V &v, const vector_expression<E1> &e1, const vector_expression<E2> &e2) {
+        BOOST_UBLAS_CHECK (v.size () == e2 ().size (), bad_size ());
+        fused_inner_prod<E2, typename V::value_type> r (e2 ());
+        return fused_vector_assign<scalar_plus_assign> (v, e1, r).result ();
+    }
+    // v -= e1, returns inner_prod (e2, v)
+    template<class V, class E1, class E2>
+    BOOST_UBLAS_INLINE
+    typename fused_inner_prod<E2, typename V::value_type>::result_type
+    minus_assign_inner_prod (V &v, const vector_expression<E1> &e1, const vector_expression<E2> &e2) {
+        BOOST_UBLAS_CHECK (v.size () == e2 ().size (), bad_size ());
+        fused_inner_prod<E2, typename V::value_type> r (e2 ());
+        return fused_vector_assign<scalar_minus_assign> (v, e1, r).result ();
+    }
+
+}}}
+
+#endif
@@ -0,0 +1,349 @@
+//
+//  Copyright (c) 2019
+//  The Boost.uBLAS developers
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef _BOOST_UBLAS_PRECONDITIONER_
+#define _BOOST_UBLAS_PRECONDITIONER_
+
+#include <boost/numeric/ublas/vector.hpp>
+#include <boost/numeric/ublas/matrix_sparse.hpp>
+#include <boost/numeric/ublas/ilu.hpp>
+
+#include <vector>
+
+/** \file preconditioner.hpp
+ *  \brief Preconditioners for the iterative solvers in iterative.hpp.
+ *
+ * A preconditioner \c P is any object providing
+ * <tt>P.apply (r, z)</tt>, which stores an approximation of
+ * <tt>A^-1 r</tt> into the dense vector \c z. The incomplete
+ * factorizations work on the storage of a row major
+ * \c compressed_matrix with zero index base, see ilu.hpp.
+ */
+
+namespace boost { namespace numeric { namespace ublas {
+
+    /** \brief The trivial preconditioner <tt>z = r</tt>.
+     */
+    class identity_preconditioner {
+    public:
+        template<class V1, class V2>
+        BOOST_UBLAS_INLINE
+        void apply (const V1 &r, V2 &z) const {
+            noalias (z) = r;
+        }
+    };
+
+    /** \brief Jacobi (diagonal) preconditioner <tt>z = D^-1 r</tt>.
+     *
+     * Zero diagonal elements are treated as ones.
+     *
+     * \tparam T the value type of the stored inverse diagonal
+     */
+    template<class T>
+    class jacobi_preconditioner {
+    public:
+        typedef T value_type;
+        typedef std::size_t size_type;
+        typedef vector<T> vector_type;
+
+        // Construction and destruction
+        BOOST_UBLAS_INLINE
+        jacobi_preconditioner ():
+            inverse_diagonal_ () {}
+        template<class E>
+        BOOST_UBLAS_INLINE
+        explicit jacobi_preconditioner (const matrix_expression<E> &e):
+            inverse_diagonal_ () {
+            build (e ());
+        }
+
+        template<class E>
+        void build (const matrix_expression<E> &e) {
+            size_type size = (std::min) (e ().size1 (), e ().size2 ());
+            inverse_diagonal_.resize (size, false);
+            for (size_type i = 0; i < size; ++ i) {
+                value_type d (e () (i, i));
+                inverse_diagonal_ (i) = d != value_type/*zero*/() ? value_type (1) / d : value_type (1);
+            }
+        }
+        template<class T1, class IA1, class TA1>
+        void build (const compressed_matrix<T1, row_major, 0, IA1, TA1> &m) {
+            typedef typename compressed_matrix<T1, row_major, 0, IA1, TA1>::array_size_type array_size_type;
+
+            size_type size = (std::min) (m.size1 (), m.size2 ());
+            inverse_diagonal_.resize (size, false);
+            for (size_type i = 0; i < size; ++ i) {
+                value_type d = value_type/*zero*/();
+                if (i + 1 < m.filled1 ()) {
+                    for (array_size_type k = m.index1_data () [i]; k < m.index1_data () [i + 1]; ++ k) {
+                        if (m.index2_data () [k] == i) {
+                            d = m.value_data () [k];
+                            break;
+                        }
+                    }
+                }
+                inverse_diagonal_ (i) = d != value_type/*zero*/() ? value_type (1) / d : value_type (1);
+            }
+        }
+
+        // Accessors
+        BOOST_UBLAS_INLINE
+        const vector_type &inverse_diagonal () const {
+            return inverse_diagonal_;
+        }
+
+        template<class V1, class V2>
+        BOOST_UBLAS_INLINE
+        void apply (const V1 &r, V2 &z) const {
+            size_type size = inverse_diagonal_.size ();
+            BOOST_UBLAS_CHECK (r.size () == size, bad_size ());
+            BOOST_UBLAS_CHECK (z.size () == size, bad_size ());
+            for (size_type i = 0; i < size; ++ i)
+                z (i) = inverse_diagonal_ (i) * r (i);
+        }
+
+    private:
+        vector_type inverse_diagonal_;
+    };
+
+    /** \brief ILU(0) preconditioner <tt>z = (LU)^-1 r</tt>.
+     *
+     * The incomplete factors share the sparsity pattern of the matrix,
+     * see \c ilu0_factorize. The triangular solves follow a level
+     * schedule computed once on construction.
+     *
+     * \tparam M a row major \c compressed_matrix with zero index base
+     */
+    template<class M>
+    class ilu0_preconditioner {
+    public:
+        typedef M matrix_type;
+        typedef typename M::value_type value_type;
+        typedef typename M::size_type size_type;
+        typedef ilu_level_schedule<M> schedule_type;
+
+        // Construction and destruction
+        BOOST_UBLAS_INLINE
+        ilu0_preconditioner ():
+            lu_ (), schedule_ () {}
+        template<class E>
+        BOOST_UBLAS_INLINE
+        explicit ilu0_preconditioner (const E &e):
+            lu_ (), schedule_ () {
+            build (e);
+        }
+
+        template<class E>
+        void build (const E &e) {
+            lu_ = e;
+            if (ilu0_factorize (lu_) != 0)
+                singular ().raise ();
+            schedule_.build (lu_);
+        }
+
+        // Accessors
+        BOOST_UBLAS_INLINE
+        const matrix_type &factors () const {
+            return lu_;
+        }
+        BOOST_UBLAS_INLINE
+        const schedule_type &schedule () const {
+            return schedule_;
+        }
+
+        template<class V1, class V2>
+        BOOST_UBLAS_INLINE
+        void apply (const V1 &r, V2 &z) const {
+            noalias (z) = r;
+            ilu_substitute (lu_, schedule_, z);
+        }
+
+    private:
+        matrix_type lu_;
+        schedule_type schedule_;
+    };
+
+    /** \brief ILUT preconditioner <tt>z = (LU)^-1 r</tt>.
+     *
+     * The factors are computed by \c ilut_factorize with the given
+     * drop tolerance and fill per row.
+     *
+     * \tparam M a row major \c compressed_matrix with zero index base
+     */
+    template<class M>
+    class ilut_preconditioner {
+    public:
+        typedef M matrix_type;
+        typedef typename M::value_type value_type;
+        typedef typename M::size_type size_type;
+        typedef typename type_traits<value_type>::real_type real_type;
+        typedef ilu_level_schedule<M> schedule_type;
+
+        // Construction and destruction
+        BOOST_UBLAS_INLINE
+        ilut_preconditioner ():
+            lu_ (), schedule_ () {}
+        template<class E>
+        BOOST_UBLAS_INLINE
+        ilut_preconditioner (const E &e, real_type drop_tolerance, size_type fill):
+            lu_ (), schedule_ () {
+            build (e, drop_tolerance, fill);
+        }
+
+        template<class E>
+        void build (const E &e, real_type drop_tolerance, size_type fill) {
+            lu_ = e;
+            if (ilut_factorize (lu_, drop_tolerance, fill) != 0)
+                singular ().raise ();
+            schedule_.build (lu_);
+        }
+
+        // Accessors
+        BOOST_UBLAS_INLINE
+        const matrix_type &factors () const {
+            return lu_;
+        }
+        BOOST_UBLAS_INLINE
+        const schedule_type &schedule () const {
+            return schedule_;
+        }
+
+        template<class V1, class V2>
+        BOOST_UBLAS_INLINE
+        void apply (const V1 &r, V2 &z) const {
+            noalias (z) = r;
+            ilu_substitute (lu_, schedule_, z);
+        }
+
+    private:
+        matrix_type lu_;
+        schedule_type schedule_;
+    };
+
+    /** \brief Incomplete Cholesky IC(0) preconditioner <tt>z = (LL^H)^-1 r</tt>.
+     *
+     * Only the lower triangle of the (hermitian positive definite)
+     * matrix is read. The factor \c L keeps its sparsity pattern.
+     *
+     * \tparam M a row major \c compressed_matrix with zero index base
+     */
+    template<class M>
+    class ichol0_preconditioner {
+    public:
+        typedef M matrix_type;
+        typedef typename M::value_type value_type;
+        typedef typename M::size_type size_type;
+        typedef typename M::array_size_type array_size_type;
+        typedef typename type_traits<value_type>::real_type real_type;
+
+        // Construction and destruction
+        BOOST_UBLAS_INLINE
+        ichol0_preconditioner ():
+            l_ () {}
+        template<class E>
+        BOOST_UBLAS_INLINE
+        explicit ichol0_preconditioner (const E &e):
+            l_ () {
+            build (e);
+        }
+
+        template<class E>
+        void build (const E &e) {
+            BOOST_UBLAS_CHECK (e.size1 () == e.size2 (), bad_size ());
+            size_type size = e.size1 ();
+            l_.resize (size, size, false);
+            l_.reserve (e.nnz () / 2 + size, false);
+            for (size_type i = 0; i < size && i + 1 < e.filled1 (); ++ i) {
+                for (array_size_type k = e.index1_data () [i]; k < e.index1_data () [i + 1]; ++ k) {
+                    size_type j = e.index2_data () [k];
+                    if (j > i)
+                        break;
+                    l_.push_back (i, j, e.value_data () [k]);
+                }
+            }
+            l_.complete_index1_data ();
+            factorize ();
+        }
+
+        // Accessors
+        BOOST_UBLAS_INLINE
+        const matrix_type &factor () const {
+            return l_;
+        }
+
+        template<class V1, class V2>
+        void apply (const V1 &r, V2 &z) const {
+            size_type size = l_.size1 ();
+            BOOST_UBLAS_CHECK (r.size () == size, bad_size ());
+            BOOST_UBLAS_CHECK (z.size () == size, bad_size ());
+            const array_size_type *row = &l_.index1_data () [0];
+            const size_type *col = &l_.index2_data () [0];
+            const value_type *val = &l_.value_data () [0];
+            // L y = r, the diagonal is the last element of every row
+            for (size_type i = 0; i < size; ++ i) {
+                value_type t (r (i));
+                array_size_type d = row [i + 1] - 1;
+                for (array_size_type k = row [i]; k < d; ++ k)
+                    t -= val [k] * z (col [k]);
+                z (i) = t / val [d];
+            }
+            // L^H z = y, column oriented on the rows of L
+            for (size_type i = size; i-- > 0; ) {
+                array_size_type d = row [i + 1] - 1;
+                value_type t (z (i) / type_traits<value_type>::conj (val [d]));
+                z (i) = t;
+                for (array_size_type k = row [i]; k < d; ++ k)
+                    z (col [k]) -= type_traits<value_type>::conj (val [k]) * t;
+            }
+        }
+
+    private:
+        void factorize () {
+            size_type size = l_.size1 ();
+            const array_size_type *row = &l_.index1_data () [0];
+            const size_type *col = &l_.index2_data () [0];
+            value_type *val = &l_.value_data () [0];
+            for (size_type i = 0; i < size; ++ i) {
+                array_size_type d = row [i + 1];
+                if (d == row [i] || col [d - 1] != i)
+                    singular ().raise ();
+                -- d;
+                for (array_size_type k = row [i]; k <= d; ++ k) {
+                    size_type j = col [k];
+                    // Sparse dot product of the leading parts of rows i and j
+                    value_type s (val [k]);
+                    array_size_type p = row [i], q = row [j];
+                    array_size_type q_end = row [j + 1] - 1;
+                    while (p < k && q < q_end) {
+                        if (col [p] == col [q]) {
+                            s -= val [p] * type_traits<value_type>::conj (val [q]);
+                            ++ p; ++ q;
+                        } else if (col [p] < col [q])
+                            ++ p;
+                        else
+                            ++ q;
+                    }
+                    if (k < d) {
+                        val [k] = s / val [q_end];
+                    } else {
+                        real_type pivot (type_traits<value_type>::real (s));
+                        if (! (pivot > real_type/*zero*/()))
+                            singular ().raise ();
+                        val [k] = value_type (type_traits<real_type>::type_sqrt (pivot));
+                    }
+                }
+            }
+        }
+
+        matrix_type l_;
+    };
+
+}}}
+
+#endif
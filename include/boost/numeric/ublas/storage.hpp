@@ -82,6 +82,24 @@ namespace boost { namespace numeric { namespace ublas {
           else
               data_ = 0;
         }
+        // Elements of trivial types are not written
+        BOOST_UBLAS_INLINE
+        unbounded_array (size_type size, uninitialized_tag, const ALLOC &a = ALLOC()):
+            alloc_ (a), size_ (0) {
+            data_ = 0;
+            resize_internal (size, value_type (), false);
+        }
+        // Elements value initialised by the threads that will work on them
+        BOOST_UBLAS_INLINE
+        unbounded_array (size_type size, first_touch_tag, const ALLOC &a = ALLOC()):
+            alloc_ (a), size_ (size) {
+            if (size_) {
+                data_ = alloc_.allocate (size_);
+                first_touch (true);
+            }
+            else
+                data_ = 0;
+        }
         // No value initialised, but still be default constructed
         BOOST_UBLAS_INLINE
         unbounded_array (size_type size, const value_type &init, const ALLOC &a = ALLOC()):
@@ -209,6 +227,38 @@ namespace boost { namespace numeric { namespace ublas {
         void resize (size_type size, value_type init) {
             resize_internal (size, init, true);
         }
+        BOOST_UBLAS_INLINE
+        void resize (size_type size, uninitialized_tag) {
+            resize_internal (size, value_type (), false);
+        }
+        void resize (size_type size, first_touch_tag) {
+            if (size != size_) {
+                resize_internal (0, value_type (), false);
+                if (size) {
+                    data_ = alloc_.allocate (size);
+                    size_ = size;
+                    first_touch (true);
+                }
+            }
+            else
+                first_touch (false);
+        }
+    private:
+        // Same static partitioning as the parallel kernels
+        void first_touch (bool construct) {
+            std::ptrdiff_t size (size_);
+            pointer data (data_);
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel for schedule (static) if (size >= BOOST_UBLAS_PARALLEL_THRESHOLD)
+#endif
+            for (std::ptrdiff_t i = 0; i < size; ++ i) {
+                if (construct)
+                    alloc_.construct (data + i, value_type ());
+                else
+                    data [i] = value_type ();
+            }
+        }
+    public:
                     
         // Random Access Container
         BOOST_UBLAS_INLINE
@@ -353,6 +403,23 @@ namespace boost { namespace numeric { namespace ublas {
         pointer data_;
     };
 
+namespace detail {
+
+    // Resizes to size elements initialised as by Tag, storage without the
+    // tagged resize is resized as usual
+    template<class A, class Tag>
+    BOOST_UBLAS_INLINE
+    void resize_storage (A &a, typename A::size_type size, Tag) {
+        a.resize (size);
+    }
+    template<class T, class ALLOC, class Tag>
+    BOOST_UBLAS_INLINE
+    void resize_storage (unbounded_array<T, ALLOC> &a, typename ALLOC::size_type size, Tag tag) {
+        a.resize (size, tag);
+    }
+
+}
+
     // Bounded array - with allocator for size_type and difference_type
     template<class T, std::size_t N, class ALLOC>
     class bounded_array:
@@ -0,0 +1,297 @@
+//
+//  Copyright (c) 2019
+//  The Boost.uBLAS developers
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef _BOOST_UBLAS_TEMPORARY_ARENA_
+#define _BOOST_UBLAS_TEMPORARY_ARENA_
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <vector>
+#include <boost/noncopyable.hpp>
+#include <boost/numeric/ublas/detail/config.hpp>
+#include <boost/numeric/ublas/fwd.hpp>
+
+namespace boost { namespace numeric { namespace ublas {
+
+    /** \brief Arena for the temporaries of the library.
+     *
+     * Memory is taken from large blocks by bumping an offset and given
+     * back all at once by \c release () or \c reset (), which keep the
+     * blocks for the next use. Only the last allocation can be given back
+     * on its own. While a \c temporary_arena_guard is alive on a thread,
+     * the temporaries the library creates on that thread are allocated
+     * from its arena.
+     */
+    class temporary_arena:
+        private boost::noncopyable {
+    public:
+        typedef std::size_t size_type;
+
+        enum { alignment = 64 };
+
+        // Position of the arena, see release ()
+        struct marker {
+            size_type block;
+            size_type offset;
+        };
+
+        BOOST_UBLAS_INLINE
+        explicit temporary_arena (size_type block_size = size_type (1) << 20):
+            blocks_ (), block_ (0), offset_ (0), block_size_ (block_size) {}
+        BOOST_UBLAS_INLINE
+        ~temporary_arena () {
+            for (size_type b = 0; b < blocks_.size (); ++ b)
+                ::operator delete (blocks_ [b].data);
+        }
+
+        void *allocate (size_type size, size_type align = alignment) {
+            size = padded_size (size);
+            for (;;) {
+                for (; block_ < blocks_.size (); ++ block_, offset_ = 0) {
+                    const block &b = blocks_ [block_];
+                    size_type address (reinterpret_cast<std::size_t> (b.data) + offset_);
+                    size_type padding ((align - address % align) % align);
+                    if (offset_ + padding + size <= b.size) {
+                        void *p = b.data + offset_ + padding;
+                        offset_ += padding + size;
+                        return p;
+                    }
+                }
+                // None of the blocks left has room, add one
+                blocks_.reserve (blocks_.size () + 1);
+                block b;
+                b.size = (std::max) (block_size_, size + align);
+                b.data = static_cast<char *> (::operator new (b.size));
+                blocks_.push_back (b);
+            }
+        }
+        // Gives the memory back if it was the last allocation, else only with release ()
+        BOOST_UBLAS_INLINE
+        void deallocate (void *p, size_type size) {
+            size = padded_size (size);
+            if (block_ < blocks_.size () &&
+                static_cast<char *> (p) + size == blocks_ [block_].data + offset_)
+                offset_ = static_cast<char *> (p) - blocks_ [block_].data;
+        }
+        BOOST_UBLAS_INLINE
+        bool owns (const void *p) const {
+            for (size_type b = 0; b < blocks_.size (); ++ b)
+                if (static_cast<const char *> (p) >= blocks_ [b].data &&
+                    static_cast<const char *> (p) < blocks_ [b].data + blocks_ [b].size)
+                    return true;
+            return false;
+        }
+
+        BOOST_UBLAS_INLINE
+        marker mark () const {
+            marker m;
+            m.block = block_;
+            m.offset = offset_;
+            return m;
+        }
+        // Gives back everything allocated after the mark was taken
+        BOOST_UBLAS_INLINE
+        void release (const marker &m) {
+            block_ = m.block;
+            offset_ = m.offset;
+        }
+        BOOST_UBLAS_INLINE
+        void reset () {
+            block_ = 0;
+            offset_ = 0;
+        }
+
+        // Bytes handed out, including the padding and unused ends of blocks
+        BOOST_UBLAS_INLINE
+        size_type used () const {
+            size_type size (offset_);
+            for (size_type b = 0; b < block_ && b < blocks_.size (); ++ b)
+                size += blocks_ [b].size;
+            return size;
+        }
+        BOOST_UBLAS_INLINE
+        size_type capacity () const {
+            size_type size (0);
+            for (size_type b = 0; b < blocks_.size (); ++ b)
+                size += blocks_ [b].size;
+            return size;
+        }
+
+        // Arena of the innermost guard of this thread, if any
+        BOOST_UBLAS_INLINE
+        static temporary_arena *current () {
+#ifndef BOOST_UBLAS_NO_TEMPORARY_ARENA
+            return current_pointer ();
+#else
+            return 0;
+#endif
+        }
+
+    private:
+        friend class temporary_arena_guard;
+
+#ifndef BOOST_UBLAS_NO_TEMPORARY_ARENA
+        BOOST_UBLAS_INLINE
+        static temporary_arena *&current_pointer () {
+            static BOOST_UBLAS_THREAD_LOCAL temporary_arena *arena = 0;
+            return arena;
+        }
+#endif
+
+        // Sizes are rounded up so the next allocation needs no padding
+        // and the allocations can be given back in reverse order
+        BOOST_UBLAS_INLINE
+        static size_type padded_size (size_type size) {
+            return (size + alignment - 1) / alignment * alignment;
+        }
+
+        struct block {
+            char *data;
+            size_type size;
+        };
+
+        std::vector<block> blocks_;
+        size_type block_;
+        size_type offset_;
+        size_type block_size_;
+    };
+
+    /** \brief Makes an arena the one of the temporaries of this thread.
+     *
+     * On destruction everything allocated from the arena since the
+     * construction is released and the previous arena is restored, so
+     * guards nest. Objects allocated from the arena must not outlive the
+     * guard.
+     */
+    class temporary_arena_guard:
+        private boost::noncopyable {
+    public:
+        BOOST_UBLAS_INLINE
+        explicit temporary_arena_guard (temporary_arena &arena):
+            arena_ (arena), mark_ (arena.mark ()), previous_ (temporary_arena::current ()) {
+#ifndef BOOST_UBLAS_NO_TEMPORARY_ARENA
+            temporary_arena::current_pointer () = &arena;
+#endif
+        }
+        BOOST_UBLAS_INLINE
+        ~temporary_arena_guard () {
+#ifndef BOOST_UBLAS_NO_TEMPORARY_ARENA
+            temporary_arena::current_pointer () = previous_;
+#endif
+            arena_.release (mark_);
+        }
+
+    private:
+        temporary_arena &arena_;
+        temporary_arena::marker mark_;
+        temporary_arena *previous_;
+    };
+
+    /** \brief Allocator of the current temporary arena.
+     *
+     * The arena active when the allocator is constructed is used, or the
+     * free store when there is none.
+     */
+    template<class T>
+    class temporary_allocator {
+    public:
+        typedef T value_type;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef T *pointer;
+        typedef const T *const_pointer;
+        typedef T &reference;
+        typedef const T &const_reference;
+
+        template<class U>
+        struct rebind {
+            typedef temporary_allocator<U> other;
+        };
+
+        BOOST_UBLAS_INLINE
+        temporary_allocator ():
+            arena_ (temporary_arena::current ()) {}
+        template<class U>
+        BOOST_UBLAS_INLINE
+        temporary_allocator (const temporary_allocator<U> &a):
+            arena_ (a.arena ()) {}
+
+        BOOST_UBLAS_INLINE
+        pointer allocate (size_type n, const void * = 0) {
+            if (arena_)
+                return static_cast<pointer> (arena_->allocate (n * sizeof (T)));
+            return static_cast<pointer> (::operator new (n * sizeof (T)));
+        }
+        BOOST_UBLAS_INLINE
+        void deallocate (pointer p, size_type n) {
+            if (arena_ && arena_->owns (p))
+                arena_->deallocate (p, n * sizeof (T));
+            else
+                ::operator delete (p);
+        }
+        BOOST_UBLAS_INLINE
+        size_type max_size () const {
+            return size_type (-1) / sizeof (T);
+        }
+
+        BOOST_UBLAS_INLINE
+        void construct (pointer p, const T &t) {
+            new (p) T (t);
+        }
+        BOOST_UBLAS_INLINE
+        void destroy (pointer p) {
+            p->~T ();
+        }
+        BOOST_UBLAS_INLINE
+        pointer address (reference r) const {
+            return &r;
+        }
+        BOOST_UBLAS_INLINE
+        const_pointer address (const_reference r) const {
+            return &r;
+        }
+
+        BOOST_UBLAS_INLINE
+        temporary_arena *arena () const {
+            return arena_;
+        }
+
+    private:
+        temporary_arena *arena_;
+    };
+
+    template<class T1, class T2>
+    BOOST_UBLAS_INLINE
+    bool operator == (const temporary_allocator<T1> &a1, const temporary_allocator<T2> &a2) {
+        return a1.arena () == a2.arena ();
+    }
+    template<class T1, class T2>
+    BOOST_UBLAS_INLINE
+    bool operator != (const temporary_allocator<T1> &a1, const temporary_allocator<T2> &a2) {
+        return a1.arena () != a2.arena ();
+    }
+
+namespace detail {
+
+    // Dense containers of the temporaries the library creates
+    template<class T>
+    struct temporary_vector {
+        typedef vector<T, unbounded_array<T, temporary_allocator<T> > > type;
+    };
+    template<class T, class L = row_major>
+    struct temporary_matrix {
+        typedef matrix<T, L, unbounded_array<T, temporary_allocator<T> > > type;
+    };
+
+}
+
+}}}
+
+#endif
@@ -18,9 +18,15 @@
 #include "tensor/functions.hpp"
 #include "tensor/operators_arithmetic.hpp"
 #include "tensor/operators_comparison.hpp"
+#include "tensor/multi_index_product.hpp"
 #include "tensor/extents.hpp"
 #include "tensor/strides.hpp"
 #include "tensor/ostream.hpp"
 #include "tensor/tensor.hpp"
+#include "tensor/tensor_view.hpp"
+#include "tensor/sparse_tensor.hpp"
+#include "tensor/sparse_multiplication.hpp"
+#include "tensor/split_complex_tensor.hpp"
+#include "tensor/decomposition.hpp"
 
 #endif // BOOST_NUMERIC_UBLAS_TENSOR_HPP
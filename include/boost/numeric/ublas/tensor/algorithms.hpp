@@ -17,6 +17,13 @@
 #include <stdexcept>
 #include <complex>
 #include <functional>
+#include <type_traits>
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <vector>
+
+#include <boost/numeric/ublas/detail/config.hpp>
 
 namespace boost {
 namespace numeric {
@@ -336,6 +343,307 @@ void trans( SizeType const p,
 }
 
 
+namespace detail {
+namespace recursive {
+
+/** @brief Copies a tensor, loop r unrolled at compile time, see copy */
+template <std::size_t r, class PointerOut, class PointerIn, class SizeType>
+void copy(SizeType const*const n,
+          PointerOut c, SizeType const*const wc,
+          PointerIn a,  SizeType const*const wa)
+{
+	for(auto d = 0u; d < n[r]; c += wc[r], a += wa[r], ++d)
+		if constexpr (r > 0)
+			copy<r-1>(n, c, wc, a, wa);
+		else
+			*c = *a;
+}
+
+/** @brief Copies a tensor applying a unary operation, loop r unrolled at compile time, see transform */
+template <std::size_t r, class PointerOut, class PointerIn, class SizeType, class UnaryOp>
+void transform(SizeType const*const n,
+               PointerOut c, SizeType const*const wc,
+               PointerIn a,  SizeType const*const wa,
+               UnaryOp op)
+{
+	for(auto d = 0u; d < n[r]; c += wc[r], a += wa[r], ++d)
+		if constexpr (r > 0)
+			transform<r-1>(n, c, wc, a, wa, op);
+		else
+			*c = op(*a);
+}
+
+/** @brief Reduces a tensor with a binary operation, loop r unrolled at compile time, see accumulate */
+template <std::size_t r, class PointerIn, class ValueType, class SizeType, class BinaryOp>
+ValueType accumulate(SizeType const*const n,
+                     PointerIn a, SizeType const*const w,
+                     ValueType k, BinaryOp op)
+{
+	for(auto d = 0u; d < n[r]; a += w[r], ++d)
+		if constexpr (r > 0)
+			k = accumulate<r-1>(n, a, w, k, op);
+		else
+			k = op ( k, *a );
+	return k;
+}
+
+/** @brief Transposes a tensor, loop r unrolled at compile time, see trans */
+template <std::size_t r, class PointerOut, class PointerIn, class SizeType>
+void trans(SizeType const*const na, SizeType const*const pi,
+           PointerOut c,            SizeType const*const wc,
+           PointerIn a,             SizeType const*const wa)
+{
+	for(auto d = 0u; d < na[r]; c += wc[pi[r]-1], a += wa[r], ++d)
+		if constexpr (r > 0)
+			trans<r-1>(na, pi, c, wc, a, wa);
+		else
+			*c = *a;
+}
+
+} // namespace recursive
+} // namespace detail
+
+
+
+/** @brief Copies a tensor of a rank p known at compile time to another tensor with different layouts
+ *
+ * Implements C[i1,i2,...,ip] = A[i1,i2,...,ip] with p nested loops
+ * instantiated at compile time, e.g. for tensors with static_extents or fixed_rank_extents.
+ *
+ * @code copy(std::integral_constant<std::size_t,3>{}, n, c, wc, a, wa); @endcode
+ *
+ * @param[in]  n pointer to the extents of input or output tensor of length p
+ * @param[out] c pointer to the output tensor
+ * @param[in] wc pointer to the strides of output tensor c
+ * @param[in]  a pointer to the input tensor
+ * @param[in] wa pointer to the strides of input tensor a
+*/
+template <std::size_t p, class PointerOut, class PointerIn, class SizeType>
+void copy(std::integral_constant<std::size_t,p>, SizeType const*const n,
+          PointerOut c, SizeType const*const wc,
+          PointerIn a,  SizeType const*const wa)
+{
+	static_assert( std::is_pointer<PointerOut>::value & std::is_pointer<PointerIn>::value,
+	               "Static error in boost::numeric::ublas::copy: Argument types for pointers are not pointer types.");
+	if constexpr ( p == 0 )
+		return;
+	else {
+		if(c == nullptr || a == nullptr || wc == nullptr || wa == nullptr || n == nullptr)
+			throw std::length_error("Error in boost::numeric::ublas::copy: Pointers shall not be null pointers.");
+
+		detail::recursive::copy<p-1>(n, c, wc, a, wa);
+	}
+}
+
+/** @brief Copies a tensor of a rank p known at compile time applying a unary operation
+ *
+ * Implements C[i1,i2,...,ip] = op ( A[i1,i2,...,ip] ), see copy for compile-time ranks
+*/
+template <std::size_t p, class PointerOut, class PointerIn, class SizeType, class UnaryOp>
+void transform(std::integral_constant<std::size_t,p>, SizeType const*const n,
+               PointerOut c, SizeType const*const wc,
+               PointerIn a,  SizeType const*const wa,
+               UnaryOp op)
+{
+	static_assert( std::is_pointer<PointerOut>::value & std::is_pointer<PointerIn>::value,
+	               "Static error in boost::numeric::ublas::transform: Argument types for pointers are not pointer types.");
+	if constexpr ( p == 0 )
+		return;
+	else {
+		if(c == nullptr || a == nullptr || wc == nullptr || wa == nullptr || n == nullptr)
+			throw std::length_error("Error in boost::numeric::ublas::transform: Pointers shall not be null pointers.");
+
+		detail::recursive::transform<p-1>(n, c, wc, a, wa, op);
+	}
+}
+
+/** @brief Performs a reduce operation with all elements of a tensor of a rank p known at compile time
+ *
+ * Implements k = op ( k , A[i1,i2,...,ip] ), for all ir, see copy for compile-time ranks
+*/
+template <std::size_t p, class PointerIn, class ValueType, class SizeType, class BinaryOp>
+ValueType accumulate(std::integral_constant<std::size_t,p>, SizeType const*const n,
+                     PointerIn a, SizeType const*const w,
+                     ValueType k, BinaryOp op)
+{
+	static_assert(std::is_pointer<PointerIn>::value,
+	              "Static error in boost::numeric::ublas::accumulate: Argument types for pointers are not pointer types.");
+	if constexpr ( p == 0 )
+		return k;
+	else {
+		if(a == nullptr || w == nullptr || n == nullptr)
+			throw std::length_error("Error in boost::numeric::ublas::accumulate: Pointers shall not be null pointers.");
+
+		return detail::recursive::accumulate<p-1>(n, a, w, k, op);
+	}
+}
+
+/** @brief Performs a sum with all elements of a tensor of a rank p known at compile time and an initial value
+ *
+ * Implements k = sum_{i1,..,ip} A[i1,i2,...,ip], see copy for compile-time ranks
+*/
+template <std::size_t p, class PointerIn, class ValueType, class SizeType>
+ValueType accumulate(std::integral_constant<std::size_t,p> rank, SizeType const*const n,
+                     PointerIn a, SizeType const*const w,
+                     ValueType k)
+{
+	return accumulate(rank, n, a, w, k, [](auto const& l, auto const& r){ return l + r; });
+}
+
+/** @brief Transposes a tensor of a rank p known at compile time
+ *
+ * Implements C[tau[i1],tau[i2],...,tau[ip]] = A[i1,i2,...,ip], see copy for compile-time ranks
+*/
+template <std::size_t p, class PointerOut, class PointerIn, class SizeType>
+void trans( std::integral_constant<std::size_t,p>, SizeType const*const na, SizeType const*const pi,
+            PointerOut c, SizeType const*const wc,
+            PointerIn a,  SizeType const*const wa)
+{
+	static_assert( std::is_pointer<PointerOut>::value & std::is_pointer<PointerIn>::value,
+	               "Static error in boost::numeric::ublas::trans: Argument types for pointers are not pointer types.");
+	if constexpr ( p < 2 )
+		return;
+	else {
+		if(c == nullptr || a == nullptr || wc == nullptr || wa == nullptr || na == nullptr || pi == nullptr)
+			throw std::length_error("Error in boost::numeric::ublas::trans: Pointers shall not be null pointers.");
+
+		detail::recursive::trans<p-1>(na, pi, c, wc, a, wa);
+	}
+}
+
+
+
+
+namespace detail {
+
+/** @brief Traverses the elements of two tensors with different strides in tiles
+ *
+ * The fastest modes of C and A span tiles of tile x tile elements, all other modes span the grid of tiles.
+ * Within a tile, C and A are both read or written in whole cache lines, even if the fastest mode of one
+ * tensor is the slowest mode of the other, e.g. when one is stored in the first- and the other in the last-order format.
+ *
+ * @code auto tiles = tiled_traversal<std::size_t>(p, n, wc, wa); tiles(t, [c,a](auto ic, auto ia){ c[ic] = a[ia]; }); @endcode
+*/
+template <class SizeType>
+class tiled_traversal
+{
+public:
+	static constexpr SizeType tile = 32;
+
+	/** @param p rank of both tensors, @param n extents, @param wc strides of C, @param wa strides of A */
+	tiled_traversal(SizeType const p, SizeType const*const n, SizeType const*const wc, SizeType const*const wa)
+		: wc_(wc), wa_(wa)
+	{
+		auto const fastest = [p,n](SizeType const*const w, SizeType const skip) {
+			auto f = p;
+			for(auto k = SizeType(0); k < p; ++k)
+				if(n[k] > 1 && k != skip && (f == p || w[k] < w[f]))
+					f = k;
+			return f;
+		};
+
+		if(p == 0 || std::find(n, n+p, SizeType(0)) != n+p){
+			tiles_ = 0;
+			return;
+		}
+
+		r_ = fastest(wc, p);
+		s_ = fastest(wa, p);
+		if(s_ == r_)
+			s_ = fastest(wa, r_);
+
+		for(auto k = SizeType(0); k < p; ++k)
+			if(n[k] > 1 && k != r_ && k != s_)
+				modes_.push_back(k);
+		std::sort(modes_.begin(), modes_.end(), [wc](auto i, auto j){ return wc[i] < wc[j]; });
+		for(auto k : modes_)
+			n_.push_back(n[k]);
+
+		nr_ = r_ < p ? n[r_] : 1;
+		ns_ = s_ < p ? n[s_] : 1;
+		tiles_ = (nr_+tile-1)/tile * ((ns_+tile-1)/tile) * std::accumulate(n_.begin(), n_.end(), SizeType(1), std::multiplies<SizeType>());
+	}
+
+	/** @brief Returns the number of tiles */
+	SizeType size() const { return tiles_; }
+
+	/** @brief Calls fn(ic,ia) with the offsets of C and A for all elements of the t-th tile */
+	template<class Fn>
+	void operator()(SizeType t, Fn&& fn) const
+	{
+		auto const tr = (nr_+tile-1)/tile;
+		auto const ts = (ns_+tile-1)/tile;
+		auto const r0 = (t % tr) * tile;  t /= tr;
+		auto const s0 = (t % ts) * tile;  t /= ts;
+
+		auto oc = SizeType(0), oa = SizeType(0);
+		for(auto k = 0u; k < modes_.size(); ++k){
+			auto const i = t % n_[k];
+			t /= n_[k];
+			oc += i * wc_[modes_[k]];
+			oa += i * wa_[modes_[k]];
+		}
+
+		auto const wcr = nr_ > 1 ? wc_[r_] : 0, war = nr_ > 1 ? wa_[r_] : 0;
+		auto const wcs = ns_ > 1 ? wc_[s_] : 0, was = ns_ > 1 ? wa_[s_] : 0;
+		auto const r1 = std::min(nr_, r0+tile);
+		auto const s1 = std::min(ns_, s0+tile);
+		for(auto js = s0; js < s1; ++js)
+			for(auto jr = r0; jr < r1; ++jr)
+				fn(oc + js*wcs + jr*wcr, oa + js*was + jr*war);
+	}
+
+private:
+	SizeType const* wc_;
+	SizeType const* wa_;
+	SizeType r_ = 0, s_ = 0, nr_ = 1, ns_ = 1, tiles_ = 1;
+	std::vector<SizeType> modes_, n_;
+};
+
+/** @brief Calls fn(ic,ia) with the offsets of C and A for all elements, tile by tile and in parallel, see tiled_traversal */
+template <class SizeType, class Fn>
+void for_each_tiled(SizeType const p, SizeType const*const n, SizeType const*const wc, SizeType const*const wa, Fn fn)
+{
+	auto const tiles = tiled_traversal<SizeType>(p, n, wc, wa);
+	auto const count = std::ptrdiff_t(tiles.size());
+#ifdef BOOST_UBLAS_USE_OPENMP
+	auto const size = std::accumulate(n, n+p, SizeType(1), std::multiplies<SizeType>());
+#pragma omp parallel for schedule (static) if (size >= BOOST_UBLAS_PARALLEL_THRESHOLD)
+#endif
+	for(std::ptrdiff_t t = 0; t < count; ++t)
+		tiles(SizeType(t), fn);
+}
+
+} // namespace detail
+
+
+/** @brief Copies a tensor to another tensor with different layouts in tiles
+ *
+ * Implements C[i1,i2,...,ip] = A[i1,i2,...,ip] like copy, but reads and writes both tensors in cache lines
+ * if their fastest modes differ, e.g. when converting from the first- to the last-order format.
+ *
+ * @param[in]  p rank of input and output tensor
+ * @param[in]  n pointer to the extents of input or output tensor of length p
+ * @param[out] c pointer to the output tensor
+ * @param[in] wc pointer to the strides of output tensor c
+ * @param[in]  a pointer to the input tensor
+ * @param[in] wa pointer to the strides of input tensor a
+*/
+template <class PointerOut, class PointerIn, class SizeType>
+void copy_tiled(SizeType const p, SizeType const*const n,
+                PointerOut c, SizeType const*const wc,
+                PointerIn a,  SizeType const*const wa)
+{
+	static_assert( std::is_pointer<PointerOut>::value & std::is_pointer<PointerIn>::value,
+	               "Static error in boost::numeric::ublas::copy_tiled: Argument types for pointers are not pointer types.");
+	if( p == 0 )
+		return;
+
+	if(c == nullptr || a == nullptr || wc == nullptr || wa == nullptr || n == nullptr)
+		throw std::length_error("Error in boost::numeric::ublas::copy_tiled: Pointers shall not be null pointers.");
+
+	detail::for_each_tiled(p, n, wc, wa, [c,a](auto ic, auto ia){ c[ic] = a[ia]; });
+}
 
 
 }
@@ -0,0 +1,795 @@
+//
+//  Copyright (c) 2019
+//  The Boost.uBLAS developers
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file decomposition.hpp Tucker and CP decompositions of dense tensors
+
+
+#ifndef BOOST_UBLAS_TENSOR_DECOMPOSITION_HPP
+#define BOOST_UBLAS_TENSOR_DECOMPOSITION_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "extents.hpp"
+#include "strides.hpp"
+#include "multiplication.hpp"
+#include "tensor.hpp"
+#include "../detail/config.hpp"
+#include "../matrix.hpp"
+
+namespace boost { namespace numeric { namespace ublas {
+
+/** @brief Tucker decomposition of a tensor, a core tensor multiplied with a factor matrix in every mode
+ *
+ * X = core x1 factors[0] x2 factors[1] ... xp factors[p-1] with orthonormal columns of the factors.
+ *
+ * @tparam V type of the elements
+ * @tparam F storage format of the core tensor and the factor matrices
+*/
+template<class V, class F = first_order>
+struct tucker_decomposition
+{
+	tensor<V,F> core;
+	std::vector<matrix<V,F>> factors;
+	/// fit 1 - ||A-X|| / ||A|| after each iteration
+	std::vector<V> fit;
+};
+
+/** @brief CP decomposition of a tensor, a sum of R weighted outer products of vectors
+ *
+ * X = sum_r lambda[r] * factors[0](:,r) o factors[1](:,r) o ... o factors[p-1](:,r) with columns of unit norm.
+ *
+ * @tparam V type of the elements
+ * @tparam F storage format of the factor matrices
+*/
+template<class V, class F = first_order>
+struct cp_decomposition
+{
+	std::vector<V> lambda;
+	std::vector<matrix<V,F>> factors;
+	/// fit 1 - ||A-X|| / ||A|| after each iteration
+	std::vector<V> fit;
+};
+
+
+namespace detail { namespace decomposition {
+
+/** @brief Computes the Gram matrix g = A(m) * A(m)^T of a contiguous tensor without unfolding it
+ *
+ * A is flattened to an n0 x nm x n1 tensor in the first-order format, g is an nm x nm row-major
+ * matrix. A is traversed in blocks of slabs or fibers that stay in cache while all rows of g are
+ * updated. Threads own rows of g.
+*/
+template<class V, class SizeType>
+void gram(SizeType const n0, SizeType const nm, SizeType const n1, V const* a, V* g)
+{
+	auto const block = SizeType(1) << 15;
+	auto const kb = std::max(SizeType(1), std::min(n0, block / nm));
+	auto const bb = kb < n0 ? SizeType(1) : std::max(SizeType(1), block / (n0*nm));
+	auto const ni = std::ptrdiff_t(nm);
+
+	std::fill(g, g + nm*nm, V{});
+	for(auto b0 = SizeType(0); b0 < n1; b0 += bb){
+		auto const b1 = std::min(n1, b0+bb);
+		for(auto k0 = SizeType(0); k0 < n0; k0 += kb){
+			auto const k1 = std::min(n0, k0+kb);
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel for schedule (dynamic) if (n0*nm*n1*nm >= BOOST_UBLAS_PARALLEL_THRESHOLD)
+#endif
+			for(std::ptrdiff_t ii = 0; ii < ni; ++ii){
+				auto const i = SizeType(ii);
+				auto gi = g + i*nm;
+				for(auto b = b0; b < b1; ++b){
+					auto ai = a + n0*(i + nm*b);
+					// short fibers are accumulated along the row of g
+					if(k1-k0 < SizeType(16)){
+						for(auto k = k0; k < k1; ++k){
+							auto const v = ai[k];
+							auto ak = a + n0*nm*b + k;
+							for(auto j = i; j < nm; ++j)
+								gi[j] += v * ak[j*n0];
+						}
+						continue;
+					}
+					for(auto j = i; j < nm; ++j){
+						auto aj = a + n0*(j + nm*b);
+						auto s = V{};
+						for(auto k = k0; k < k1; ++k)
+							s += ai[k] * aj[k];
+						gi[j] += s;
+					}
+				}
+			}
+		}
+	}
+	for(auto i = SizeType(0); i < nm; ++i)
+		for(auto j = SizeType(0); j < i; ++j)
+			g[i*nm+j] = g[j*nm+i];
+}
+
+/** @brief Computes C = A(m) * (U_p kr ... kr U_m+1 kr U_m-1 kr ... kr U_1) of a contiguous tensor without unfolding it
+ *
+ * Implements C[im,r] = sum(A[i1,...,ip] * U_1[i1,r] * ... * U_m-1[im-1,r] * U_m+1[im+1,r] * ... * U_p[ip,r]).
+ * The Khatri-Rao products of the factors of the modes stored before and after mode m are formed once,
+ * each element of A is then read once. Threads own rows of C.
+ *
+ * @param f row-major factor matrices with R columns, f[m-1] is not used
+ * @param c row-major na[m-1] x R output matrix
+*/
+template<class V, class SizeType>
+void mttkrp(SizeType const p, SizeType const*const n, bool reversed, V const* a, SizeType const m,
+            std::vector<V const*> const& f, SizeType const R, V* c)
+{
+	auto const n01 = flat::flatten(m, p, n, reversed);
+	auto const n0 = n01.first, n1 = n01.second, nm = n[m-1];
+
+	// distance of the modes in the flattened tensor
+	auto d = std::vector<SizeType>(p);
+	for(auto k = SizeType(0), s = SizeType(1); k < p; ++k){
+		auto const r = reversed ? p-1-k : k;
+		d[r] = s;
+		s *= n[r];
+	}
+
+	auto const khatri_rao = [&](SizeType count, SizeType scale, bool before){
+		auto h = std::vector<V>(count*R, V(1));
+		for(auto k = SizeType(0); k < p; ++k){
+			if(k == m-1 || (reversed ? k > m-1 : k < m-1) != before)
+				continue;
+			for(auto x = SizeType(0); x < count; ++x){
+				auto const fk = f[k] + ((x*scale / d[k]) % n[k])*R;
+				for(auto r = SizeType(0); r < R; ++r)
+					h[x*R+r] *= fk[r];
+			}
+		}
+		return h;
+	};
+	auto const h0 = khatri_rao(n0, SizeType(1), true);
+	auto const h1 = khatri_rao(n1, n0*nm, false);
+
+	// rows are processed in blocks such that short fibers of neighbouring rows share cache lines
+	auto const ib = n0 < SizeType(8) ? SizeType(16) : SizeType(1);
+	auto const ni = std::ptrdiff_t((nm + ib - 1) / ib);
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel for schedule (static) if (n0*nm*n1*R >= BOOST_UBLAS_PARALLEL_THRESHOLD)
+#endif
+	for(std::ptrdiff_t ii = 0; ii < ni; ++ii){
+		auto const i0 = SizeType(ii)*ib, i1 = std::min(nm, i0+ib);
+		auto t = std::vector<V>(R);
+		std::fill(c + i0*R, c + i1*R, V{});
+		for(auto b = SizeType(0); b < n1; ++b){
+			auto const hb = h1.data() + b*R;
+			for(auto i = i0; i < i1; ++i){
+				auto ab = a + n0*(i + nm*b);
+				auto ci = c + i*R;
+				// mode m is stored first, its fibers are single elements
+				if(n0 == SizeType(1)){
+					auto const v = ab[0];
+					for(auto r = SizeType(0); r < R; ++r)
+						ci[r] += v * hb[r];
+					continue;
+				}
+				std::fill(t.begin(), t.end(), V{});
+				for(auto x = SizeType(0); x < n0; ++x){
+					auto const v = ab[x];
+					auto const hx = h0.data() + x*R;
+					for(auto r = SizeType(0); r < R; ++r)
+						t[r] += v * hx[r];
+				}
+				for(auto r = SizeType(0); r < R; ++r)
+					ci[r] += t[r] * hb[r];
+			}
+		}
+	}
+}
+
+/** @brief Computes the eigenvalues and eigenvectors of a symmetric n x n matrix
+ *
+ * Reduces g to tridiagonal form with Householder reflections and diagonalizes it with the implicit
+ * QL method, following tred2 and tql2 of EISPACK. The eigenvectors are rotated as rows of q to keep
+ * the updates contiguous.
+ *
+ * @param g row-major matrix, overwritten
+ * @param q row-major matrix with the eigenvectors as columns
+ * @returns eigenvalues in descending order, columns of q in the same order
+*/
+template<class V>
+std::vector<V> eigh(std::size_t const n, std::vector<V>& g, std::vector<V>& q)
+{
+	auto d = std::vector<V>(n), e = std::vector<V>(n);
+	auto const v = [&g,n](std::size_t i, std::size_t j) -> V& { return g[i*n+j]; };
+
+	// Householder reduction to a tridiagonal matrix with diagonal d and subdiagonal e
+	for(auto j = std::size_t(0); j < n; ++j)
+		d[j] = v(n-1,j);
+	for(auto i = n-1; i > 0; --i){
+		auto scale = V{}, h = V{};
+		for(auto k = std::size_t(0); k < i; ++k)
+			scale += std::abs(d[k]);
+		if(scale == V{}){
+			e[i] = d[i-1];
+			for(auto j = std::size_t(0); j < i; ++j){
+				d[j] = v(i-1,j);
+				v(i,j) = V{};
+				v(j,i) = V{};
+			}
+		}
+		else{
+			for(auto k = std::size_t(0); k < i; ++k){
+				d[k] /= scale;
+				h += d[k] * d[k];
+			}
+			auto f = d[i-1];
+			auto s = std::sqrt(h);
+			if(f > V{})
+				s = -s;
+			e[i] = scale * s;
+			h -= f * s;
+			d[i-1] = f - s;
+			std::fill(e.begin(), e.begin()+i, V{});
+			for(auto j = std::size_t(0); j < i; ++j){
+				f = d[j];
+				v(j,i) = f;
+				s = e[j] + v(j,j) * f;
+				for(auto k = j+1; k < i; ++k){
+					s += v(k,j) * d[k];
+					e[k] += v(k,j) * f;
+				}
+				e[j] = s;
+			}
+			f = V{};
+			for(auto j = std::size_t(0); j < i; ++j){
+				e[j] /= h;
+				f += e[j] * d[j];
+			}
+			auto const hh = f / (h + h);
+			for(auto j = std::size_t(0); j < i; ++j)
+				e[j] -= hh * d[j];
+			for(auto j = std::size_t(0); j < i; ++j){
+				f = d[j];
+				s = e[j];
+				for(auto k = j; k < i; ++k)
+					v(k,j) -= f * e[k] + s * d[k];
+				d[j] = v(i-1,j);
+				v(i,j) = V{};
+			}
+		}
+		d[i] = h;
+	}
+
+	// accumulation of the transformations
+	for(auto i = std::size_t(0); i+1 < n; ++i){
+		v(n-1,i) = v(i,i);
+		v(i,i) = V(1);
+		auto const h = d[i+1];
+		if(h != V{}){
+			for(auto k = std::size_t(0); k <= i; ++k)
+				d[k] = v(k,i+1) / h;
+			for(auto j = std::size_t(0); j <= i; ++j){
+				auto s = V{};
+				for(auto k = std::size_t(0); k <= i; ++k)
+					s += v(k,i+1) * v(k,j);
+				for(auto k = std::size_t(0); k <= i; ++k)
+					v(k,j) -= s * d[k];
+			}
+		}
+		for(auto k = std::size_t(0); k <= i; ++k)
+			v(k,i+1) = V{};
+	}
+	for(auto j = std::size_t(0); j < n; ++j){
+		d[j] = v(n-1,j);
+		v(n-1,j) = V{};
+	}
+	v(n-1,n-1) = V(1);
+
+	// transformations as rows
+	q.resize(n*n);
+	for(auto i = std::size_t(0); i < n; ++i)
+		for(auto j = std::size_t(0); j < n; ++j)
+			q[j*n+i] = v(i,j);
+
+	// implicit QL iterations on the tridiagonal matrix
+	for(auto i = std::size_t(1); i < n; ++i)
+		e[i-1] = e[i];
+	e[n-1] = V{};
+
+	auto const eps = std::numeric_limits<V>::epsilon();
+	auto f = V{}, tst1 = V{};
+	for(auto l = std::size_t(0); l < n; ++l){
+		tst1 = std::max(tst1, std::abs(d[l]) + std::abs(e[l]));
+		auto m = l;
+		while(m+1 < n && std::abs(e[m]) > eps*tst1)
+			++m;
+
+		for(auto iter = 0u; m > l && iter < 64u && std::abs(e[l]) > eps*tst1; ++iter){
+			auto s = d[l];
+			auto p = (d[l+1] - s) / (2 * e[l]);
+			auto r = std::hypot(p, V(1));
+			if(p < V{})
+				r = -r;
+			d[l] = e[l] / (p + r);
+			d[l+1] = e[l] * (p + r);
+			auto const dl1 = d[l+1];
+			auto h = s - d[l];
+			for(auto i = l+2; i < n; ++i)
+				d[i] -= h;
+			f += h;
+
+			p = d[m];
+			auto c = V(1), c2 = c, c3 = c;
+			auto const el1 = e[l+1];
+			auto sn = V{}, s2 = V{};
+			for(auto i = m; i-- > l;){
+				c3 = c2;
+				c2 = c;
+				s2 = sn;
+				s = c * e[i];
+				h = c * p;
+				r = std::hypot(p, e[i]);
+				e[i+1] = sn * r;
+				sn = e[i] / r;
+				c = p / r;
+				p = c * d[i] - sn * s;
+				d[i+1] = h + sn * (c * s + sn * d[i]);
+				auto qi = q.data() + i*n, qj = q.data() + (i+1)*n;
+				for(auto k = std::size_t(0); k < n; ++k){
+					auto const t = qj[k];
+					qj[k] = sn * qi[k] + c * t;
+					qi[k] = c * qi[k] - sn * t;
+				}
+			}
+			p = -sn * s2 * c3 * el1 * e[l] / dl1;
+			e[l] = sn * p;
+			d[l] = c * p;
+		}
+		d[l] += f;
+		e[l] = V{};
+	}
+
+	auto order = std::vector<std::size_t>(n);
+	std::iota(order.begin(), order.end(), std::size_t(0));
+	std::stable_sort(order.begin(), order.end(), [&d](auto i, auto j){ return d[i] > d[j]; });
+
+	auto values = std::vector<V>(n);
+	for(auto j = std::size_t(0); j < n; ++j){
+		values[j] = d[order[j]];
+		for(auto i = std::size_t(0); i < n; ++i)
+			g[i*n+j] = q[order[j]*n+i];
+	}
+	q.swap(g);
+	return values;
+}
+
+/** @brief Returns the n x r row-major matrix of the eigenvectors of the r largest eigenvalues of g
+ *
+ * Signs are chosen such that the component with the largest magnitude of each vector is positive.
+*/
+template<class V>
+std::vector<V> leading_eigenvectors(std::size_t const n, std::vector<V> g, std::size_t const r)
+{
+	auto q = std::vector<V>{};
+	eigh(n, g, q);
+	auto u = std::vector<V>(n*r);
+	for(auto j = std::size_t(0); j < r; ++j){
+		auto imax = std::size_t(0);
+		for(auto i = std::size_t(0); i < n; ++i)
+			if(std::abs(q[i*n+j]) > std::abs(q[imax*n+j]))
+				imax = i;
+		auto const s = q[imax*n+j] < 0 ? V(-1) : V(1);
+		for(auto i = std::size_t(0); i < n; ++i)
+			u[i*r+j] = s * q[i*n+j];
+	}
+	return u;
+}
+
+/** @brief Returns the pseudo-inverse of a symmetric positive semi-definite n x n row-major matrix */
+template<class V>
+std::vector<V> pinv(std::size_t const n, std::vector<V> g)
+{
+	auto q = std::vector<V>{};
+	auto const values = eigh(n, g, q);
+	auto const cutoff = V(n) * std::numeric_limits<V>::epsilon() * std::abs(values.front());
+	auto h = std::vector<V>(n*n);
+	for(auto k = std::size_t(0); k < n; ++k){
+		if(values[k] <= cutoff)
+			continue;
+		for(auto i = std::size_t(0); i < n; ++i)
+			for(auto j = std::size_t(0); j < n; ++j)
+				h[i*n+j] += q[i*n+k] * q[j*n+k] / values[k];
+	}
+	return h;
+}
+
+/** @brief Computes Y = A x_k U_k^T for the given one-based modes k with row-major factors U_k of r[k-1] columns
+ *
+ * The products are computed with ttm into two buffers, reused across calls.
+ *
+ * @param n extents of A, replaced by the extents of Y
+ * @returns pointer to Y in one of the buffers
+*/
+template<class F, class V>
+V const* multiply_transposed(V const* a, std::vector<std::size_t>& n, std::vector<std::vector<V>> const& u,
+                             std::vector<std::size_t> const& r, std::vector<std::size_t> modes, std::vector<V> (&buffer)[2])
+{
+	using strides_type = basic_strides<std::size_t,F>;
+
+	// modes with the largest reduction first keep the intermediates small
+	std::stable_sort(modes.begin(), modes.end(), [&n,&r](auto k, auto l){ return n[k-1]*r[l-1] > n[l-1]*r[k-1]; });
+
+	auto const p = n.size();
+	for(auto k : modes){
+		auto nc = n;
+		nc[k-1] = r[k-1];
+		auto const wa = strides_type(shape(n));
+		auto const wc = strides_type(shape(nc));
+		auto const nb = std::vector<std::size_t>{r[k-1], n[k-1]};
+		auto const wb = std::vector<std::size_t>{1u, r[k-1]};
+
+		auto& c = buffer[0].data() == a ? buffer[1] : buffer[0];
+		c.assign(std::accumulate(nc.begin(), nc.end(), std::size_t(1), std::multiplies<>{}), V{});
+		ttm(k, p, c.data(), nc.data(), wc.data(), a, n.data(), wa.data(), u[k-1].data(), nb.data(), wb.data());
+		a = c.data();
+		n = nc;
+	}
+	return a;
+}
+
+template<class F, class V>
+std::vector<V> gram(V const* a, std::vector<std::size_t> const& n, std::size_t const m)
+{
+	auto const n01 = flat::flatten(m, n.size(), n.data(), std::is_same<F,last_order>::value);
+	auto g = std::vector<V>(n[m-1]*n[m-1]);
+	gram(n01.first, n[m-1], n01.second, a, g.data());
+	return g;
+}
+
+template<class V, class F>
+matrix<V,F> to_matrix(std::vector<V> const& u, std::size_t const rows, std::size_t const cols)
+{
+	auto m = matrix<V,F>(rows, cols);
+	for(auto i = std::size_t(0); i < rows; ++i)
+		for(auto j = std::size_t(0); j < cols; ++j)
+			m(i,j) = u[i*cols+j];
+	return m;
+}
+
+template<class V, class M>
+std::vector<V> to_rows(M const& m)
+{
+	auto u = std::vector<V>(m.size1()*m.size2());
+	for(auto i = std::size_t(0); i < m.size1(); ++i)
+		for(auto j = std::size_t(0); j < m.size2(); ++j)
+			u[i*m.size2()+j] = m(i,j);
+	return u;
+}
+
+template<class V>
+V fit(V const norm2, V const residual2)
+{
+	return norm2 > V{} ? 1 - std::sqrt(std::max(residual2, V{}) / norm2) : V(1);
+}
+
+template<class V, class F, class A, class E>
+std::vector<std::size_t> check_ranks(tensor<V,F,A,E> const& a, std::vector<std::size_t> const& ranks, char const* name)
+{
+	static_assert(std::is_floating_point<V>::value, "Static error in boost::numeric::ublas: decompositions require real floating-point tensors.");
+	if(a.empty())
+		throw std::length_error(std::string("error in boost::numeric::ublas::") + name + ": tensor should not be empty.");
+	if(ranks.size() != a.rank())
+		throw std::length_error(std::string("error in boost::numeric::ublas::") + name + ": number of ranks must equal the rank of the tensor.");
+	for(auto k = 0u; k < ranks.size(); ++k)
+		if(ranks[k] == 0u || ranks[k] > a.extents()[k])
+			throw std::length_error(std::string("error in boost::numeric::ublas::") + name + ": ranks must be between one and the extents.");
+	return std::vector<std::size_t>(a.extents().begin(), a.extents().end());
+}
+
+}} // namespace detail::decomposition
+
+
+
+/** @brief Computes the matricized-tensor-times-Khatri-Rao product of a dense tensor
+ *
+ * Implements C[im,r] = sum(A[i1,i2,...,ip] * U1[i1,r] * ... * Um-1[im-1,r] * Um+1[im+1,r] * ... * Up[ip,r])
+ * without unfolding A, in parallel over the rows of C.
+ *
+ * @param[in] a tensor A with order p
+ * @param[in] u p factor matrices of size na[r] x R, u[m-1] is not used
+ * @param[in] m mode with 1 <= m <= p
+ *
+ * @returns dense na[m-1] x R matrix C
+*/
+template<class V, class F, class A, class E, class M>
+auto mttkrp(tensor<V,F,A,E> const& a, std::vector<M> const& u, const std::size_t m)
+{
+	auto const p = a.rank();
+
+	if( m == 0 || p < m )
+		throw std::length_error("error in boost::numeric::ublas::mttkrp: mode must be between one and the rank.");
+	if( u.size() != p )
+		throw std::length_error("error in boost::numeric::ublas::mttkrp: number of factor matrices must equal the rank.");
+
+	auto const R = u[m == 1 ? 1 : 0].size2();
+	for(auto r = 0u; r < p; ++r)
+		if( r != m-1 && (u[r].size1() != a.extents()[r] || u[r].size2() != R) )
+			throw std::length_error("error in boost::numeric::ublas::mttkrp: factor matrices must have na[r] rows and the same number of columns.");
+
+	auto f = std::vector<std::vector<V>>(p);
+	auto fp = std::vector<V const*>(p);
+	for(auto r = 0u; r < p; ++r)
+		if(r != m-1)
+			f[r] = detail::decomposition::to_rows<V>(u[r]), fp[r] = f[r].data();
+
+	auto const n = std::vector<std::size_t>(a.extents().begin(), a.extents().end());
+	auto c = std::vector<V>(n[m-1]*R);
+	detail::decomposition::mttkrp(p, n.data(), std::is_same<F,last_order>::value, a.data(), m, fp, R, c.data());
+
+	auto cm = matrix<V>(n[m-1], R);
+	std::copy(c.begin(), c.end(), cm.data().begin());
+	return cm;
+}
+
+
+/** @brief Computes the truncated higher-order singular value decomposition of a tensor
+ *
+ * The factor of mode k holds the leading ranks[k-1] eigenvectors of the Gram matrix A(k) * A(k)^T,
+ * computed without unfolding A. The core is A x1 U1^T x2 U2^T ... xp Up^T.
+ *
+ * @code auto t = hosvd(a, {10,10,5}); @endcode
+ *
+ * @param[in] a     tensor A with order p
+ * @param[in] ranks p ranks with 1 <= ranks[k-1] <= na[k-1]
+ * @returns Tucker decomposition with one fit
+*/
+template<class V, class F, class A, class E>
+auto hosvd(tensor<V,F,A,E> const& a, std::vector<std::size_t> const& ranks)
+{
+	namespace dd = detail::decomposition;
+
+	auto const n = dd::check_ranks(a, ranks, "hosvd");
+	auto const p = n.size();
+
+	auto u = std::vector<std::vector<V>>(p);
+	for(auto k = 1u; k <= p; ++k)
+		u[k-1] = dd::leading_eigenvectors(n[k-1], dd::gram<F>(a.data(), n, k), ranks[k-1]);
+
+	auto modes = std::vector<std::size_t>(p);
+	std::iota(modes.begin(), modes.end(), std::size_t(1));
+	std::vector<V> buffer[2];
+	auto nc = n;
+	auto const g = dd::multiply_transposed<F>(a.data(), nc, u, ranks, modes, buffer);
+
+	auto d = tucker_decomposition<V,F>{};
+	d.core = tensor<V,F>(shape(nc));
+	std::copy(g, g + d.core.size(), d.core.begin());
+	for(auto k = 0u; k < p; ++k)
+		d.factors.push_back(dd::to_matrix<V,F>(u[k], n[k], ranks[k]));
+
+	auto const norm2 = std::inner_product(a.begin(), a.end(), a.begin(), V{});
+	d.fit.push_back(dd::fit(norm2, norm2 - std::inner_product(d.core.begin(), d.core.end(), d.core.begin(), V{})));
+	return d;
+}
+
+
+/** @brief Computes a Tucker decomposition of a tensor with the higher-order orthogonal iteration (HOOI)
+ *
+ * Starts with the factors of hosvd. In every iteration, the factor of each mode k is replaced by the
+ * leading eigenvectors of the Gram matrix of A x_j Uj^T for all modes j but k. Intermediates are held
+ * in buffers reused across iterations. Stops if the fit improves by less than tolerance.
+ *
+ * @code auto t = hooi(a, {10,10,5}); auto x = reconstruct(t); @endcode
+ *
+ * @param[in] a              tensor A with order p
+ * @param[in] ranks          p ranks with 1 <= ranks[k-1] <= na[k-1]
+ * @param[in] max_iterations maximum number of iterations, at least one is run
+ * @param[in] tolerance      minimum improvement of the fit
+ * @returns Tucker decomposition with the fit of each iteration
+*/
+template<class V, class F, class A, class E>
+auto hooi(tensor<V,F,A,E> const& a, std::vector<std::size_t> const& ranks,
+          std::size_t const max_iterations = 50u, V const tolerance = V(1e-6))
+{
+	namespace dd = detail::decomposition;
+
+	auto const n = dd::check_ranks(a, ranks, "hooi");
+	auto const p = n.size();
+	auto const norm2 = std::inner_product(a.begin(), a.end(), a.begin(), V{});
+
+	auto u = std::vector<std::vector<V>>(p);
+	for(auto k = 1u; k <= p; ++k)
+		u[k-1] = dd::leading_eigenvectors(n[k-1], dd::gram<F>(a.data(), n, k), ranks[k-1]);
+
+	auto d = tucker_decomposition<V,F>{};
+	std::vector<V> buffer[2];
+	auto core = std::vector<V>{};
+	auto nc = n;
+
+	for(auto it = 0u; it < std::max(max_iterations, std::size_t(1)); ++it){
+		for(auto k = 1u; k <= p; ++k){
+			auto modes = std::vector<std::size_t>{};
+			for(auto j = 1u; j <= p; ++j)
+				if(j != k)
+					modes.push_back(j);
+			auto ny = n;
+			auto const y = dd::multiply_transposed<F>(a.data(), ny, u, ranks, modes, buffer);
+			u[k-1] = dd::leading_eigenvectors(n[k-1], dd::gram<F>(y, ny, k), ranks[k-1]);
+
+			if(k == p){
+				nc = ny;
+				auto const g = dd::multiply_transposed<F>(y, nc, u, ranks, {k}, buffer);
+				core.assign(g, g + std::accumulate(nc.begin(), nc.end(), std::size_t(1), std::multiplies<>{}));
+			}
+		}
+
+		d.fit.push_back(dd::fit(norm2, norm2 - std::inner_product(core.begin(), core.end(), core.begin(), V{})));
+		if(it > 0u && std::abs(d.fit[it] - d.fit[it-1]) < tolerance)
+			break;
+	}
+
+	d.core = tensor<V,F>(shape(nc));
+	std::copy(core.begin(), core.end(), d.core.begin());
+	for(auto k = 0u; k < p; ++k)
+		d.factors.push_back(dd::to_matrix<V,F>(u[k], n[k], ranks[k]));
+	return d;
+}
+
+
+/** @brief Computes a CP decomposition of a tensor with alternating least squares (CP-ALS)
+ *
+ * Starts with the leading eigenvectors of the Gram matrices A(k) * A(k)^T. In every iteration, the factor
+ * of each mode k is replaced by mttkrp(A,U,k) times the pseudo-inverse of the Hadamard product of all
+ * Uj^T * Uj but k, and its columns are normalized. Products with A are computed without unfolding it.
+ * Stops if the fit improves by less than tolerance.
+ *
+ * @code auto c = cp_als(a, 10); auto x = reconstruct(c); @endcode
+ *
+ * @param[in] a              tensor A with order p
+ * @param[in] R              number of components
+ * @param[in] max_iterations maximum number of iterations, at least one is run
+ * @param[in] tolerance      minimum improvement of the fit
+ * @returns CP decomposition with the fit of each iteration
+*/
+template<class V, class F, class A, class E>
+auto cp_als(tensor<V,F,A,E> const& a, std::size_t const R,
+            std::size_t const max_iterations = 100u, V const tolerance = V(1e-6))
+{
+	namespace dd = detail::decomposition;
+
+	if(R == 0u)
+		throw std::length_error("error in boost::numeric::ublas::cp_als: number of components must be greater than zero.");
+	auto const n = dd::check_ranks(a, std::vector<std::size_t>(a.rank(), 1u), "cp_als");
+	auto const p = n.size();
+	auto const reversed = std::is_same<F,last_order>::value;
+	auto const norm2 = std::inner_product(a.begin(), a.end(), a.begin(), V{});
+
+	// leading eigenvectors, further columns of mixed signs
+	auto u = std::vector<std::vector<V>>(p);
+	auto fp = std::vector<V const*>(p);
+	for(auto k = 1u; k <= p; ++k){
+		auto const r = std::min(R, n[k-1]);
+		auto const q = dd::leading_eigenvectors(n[k-1], dd::gram<F>(a.data(), n, k), r);
+		u[k-1].resize(n[k-1]*R);
+		for(auto i = 0u; i < n[k-1]; ++i)
+			for(auto j = 0u; j < R; ++j)
+				u[k-1][i*R+j] = j < r ? q[i*r+j] : V(std::cos(V(i*R+j+1)));
+		fp[k-1] = u[k-1].data();
+	}
+
+	auto const cross = [R](std::vector<V> const& uk, std::size_t rows){
+		auto g = std::vector<V>(R*R);
+		for(auto i = 0u; i < rows; ++i)
+			for(auto r = 0u; r < R; ++r)
+				for(auto s = 0u; s < R; ++s)
+					g[r*R+s] += uk[i*R+r] * uk[i*R+s];
+		return g;
+	};
+	auto utu = std::vector<std::vector<V>>(p);
+	for(auto k = 0u; k < p; ++k)
+		utu[k] = cross(u[k], n[k]);
+
+	auto d = cp_decomposition<V,F>{};
+	d.lambda.assign(R, V(1));
+	auto m = std::vector<V>(*std::max_element(n.begin(), n.end()) * R);
+
+	for(auto it = 0u; it < std::max(max_iterations, std::size_t(1)); ++it){
+		for(auto k = 1u; k <= p; ++k){
+			auto const nk = n[k-1];
+			dd::mttkrp(p, n.data(), reversed, a.data(), std::size_t(k), fp, R, m.data());
+
+			auto h = std::vector<V>(R*R, V(1));
+			for(auto j = 0u; j < p; ++j)
+				if(j != k-1)
+					for(auto x = 0u; x < R*R; ++x)
+						h[x] *= utu[j][x];
+			auto const hinv = dd::pinv(R, std::move(h));
+
+			auto& uk = u[k-1];
+			std::fill(uk.begin(), uk.end(), V{});
+			for(auto i = 0u; i < nk; ++i)
+				for(auto s = 0u; s < R; ++s){
+					auto const mis = m[i*R+s];
+					for(auto r = 0u; r < R; ++r)
+						uk[i*R+r] += mis * hinv[s*R+r];
+				}
+
+			for(auto r = 0u; r < R; ++r){
+				auto l = V{};
+				for(auto i = 0u; i < nk; ++i)
+					l += uk[i*R+r] * uk[i*R+r];
+				l = std::sqrt(l);
+				d.lambda[r] = l > V{} ? l : V(1);
+				for(auto i = 0u; i < nk; ++i)
+					uk[i*R+r] /= d.lambda[r];
+			}
+			utu[k-1] = cross(uk, nk);
+		}
+
+		// ||X||^2 from the Gram matrices, <A,X> from the last mttkrp
+		auto x2 = V{}, ax = V{};
+		for(auto r = 0u; r < R; ++r){
+			for(auto s = 0u; s < R; ++s){
+				auto h = d.lambda[r] * d.lambda[s];
+				for(auto j = 0u; j < p; ++j)
+					h *= utu[j][r*R+s];
+				x2 += h;
+			}
+			auto t = V{};
+			for(auto i = 0u; i < n[p-1]; ++i)
+				t += m[i*R+r] * u[p-1][i*R+r];
+			ax += d.lambda[r] * t;
+		}
+
+		d.fit.push_back(dd::fit(norm2, norm2 + x2 - 2*ax));
+		if(it > 0u && std::abs(d.fit[it] - d.fit[it-1]) < tolerance)
+			break;
+	}
+
+	for(auto k = 0u; k < p; ++k)
+		d.factors.push_back(dd::to_matrix<V,F>(u[k], n[k], R));
+	return d;
+}
+
+
+/** @brief Returns the tensor of a Tucker decomposition, core x1 U1 x2 U2 ... xp Up */
+template<class V, class F>
+auto reconstruct(tucker_decomposition<V,F> const& d)
+{
+	auto x = d.core;
+	for(auto k = 0u; k < d.factors.size(); ++k)
+		x = prod(x, d.factors[k], k+1);
+	return x;
+}
+
+/** @brief Returns the tensor of a CP decomposition, the sum of the weighted outer products of the columns */
+template<class V, class F>
+auto reconstruct(cp_decomposition<V,F> const& d)
+{
+	auto const p = d.factors.size();
+	auto const R = d.lambda.size();
+
+	// superdiagonal core with the weights
+	auto x = tensor<V,F>(shape(std::vector<std::size_t>(p, R)), V{});
+	auto const& w = x.strides();
+	for(auto r = 0u; r < R; ++r)
+		x[r * std::accumulate(w.begin(), w.end(), std::size_t(0))] = d.lambda[r];
+	for(auto k = 0u; k < p; ++k)
+		x = prod(x, d.factors[k], k+1);
+	return x;
+}
+
+}}} // namespaces
+
+#endif
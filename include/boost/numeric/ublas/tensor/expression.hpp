@@ -13,6 +13,8 @@
 #define BOOST_UBLAS_TENSOR_EXPRESSIONS_HPP
 
 #include <cstddef>
+#include <type_traits>
+#include <vector>
 #include <boost/numeric/ublas/expression_types.hpp>
 
 
@@ -21,7 +23,7 @@ namespace numeric {
 namespace ublas   {
 
 
-template<class element_type, class storage_format, class storage_type>
+template<class element_type, class storage_format, class storage_type, class extents_type>
 class tensor;
 
 template<class size_type>
@@ -128,6 +130,80 @@ auto make_binary_tensor_expression( tensor_expression<T,EL> const& el, vector_ex
 
 
 
+/** @brief Binary expression of two operands stored in different layouts
+ *
+ * Elements are indexed in the layout of T, the right operand of type TR is read at the linear index
+ * of the same element in its layout. Evaluating the expression into a tensor traverses the operands
+ * in tiles, see detail::eval, without converting the right operand into a temporary tensor.
+ *
+ * \tparam T  type of the tensor and of the left operand
+ * \tparam TR type of the tensor of the right operand with another layout
+ */
+template<class T, class TR, class EL, class ER, class OP>
+struct mixed_binary_tensor_expression
+    : public tensor_expression <T, mixed_binary_tensor_expression<T,TR,EL,ER,OP>>
+{
+	using self_type = mixed_binary_tensor_expression<T,TR,EL,ER,OP>;
+	using tensor_type  = T;
+	using tensor_type_right = TR;
+	using binary_operation = OP;
+	using expression_type_left  = EL;
+	using expression_type_right = ER;
+	using derived_type =  tensor_expression <tensor_type,self_type>;
+
+	using size_type = typename tensor_type::size_type;
+
+	/** @param extents extents of both operands */
+	template<class extents_type>
+	explicit mixed_binary_tensor_expression(expression_type_left const& l, expression_type_right const& r, binary_operation o, extents_type const& extents)
+	  : el(l) , er(r) , op(o), n(extents.size()), wl(extents.size()), wr(extents.size())
+	{
+		auto const p = n.size();
+		auto const first = std::is_same<typename tensor_type::layout_type, column_major>::value;
+		auto const first_right = std::is_same<typename tensor_type_right::layout_type, column_major>::value;
+
+		// modes sorted from the fastest to the slowest one in the layout of T
+		auto w = std::vector<size_type>(p);
+		for(auto k = size_type(0), s = size_type(1); k < p; ++k){
+			auto const m = first_right ? k : p-1-k;
+			w[m] = s;
+			s *= extents[m];
+		}
+		for(auto k = size_type(0), s = size_type(1); k < p; ++k){
+			auto const m = first ? k : p-1-k;
+			n[k]  = extents[m];
+			wl[k] = s;
+			wr[k] = w[m];
+			s *= n[k];
+		}
+	}
+	mixed_binary_tensor_expression() = delete;
+	mixed_binary_tensor_expression(const mixed_binary_tensor_expression& l) = delete;
+	mixed_binary_tensor_expression(mixed_binary_tensor_expression&& l)
+	  : el(l.el), er(l.er), op(l.op), n(std::move(l.n)), wl(std::move(l.wl)), wr(std::move(l.wr)) {}
+
+	/** @brief Returns the i-th element in the layout of T */
+	BOOST_UBLAS_INLINE
+	decltype(auto)  operator()(size_type i) const { return op(el(i), er(right_index(i))); }
+
+	/** @brief Returns the linear index in the layout of TR of the i-th element in the layout of T */
+	size_type right_index(size_type i) const
+	{
+		auto j = size_type(0);
+		for(auto k = 0u; k < n.size(); ++k){
+			j += (i % n[k]) * wr[k];
+			i /= n[k];
+		}
+		return j;
+	}
+
+	expression_type_left const& el;
+	expression_type_right const& er;
+	binary_operation op;
+	std::vector<size_type> n, wl, wr; // extents and linear strides of both layouts, fastest mode of T first
+};
+
+
 template<class T, class E, class OP>
 struct unary_tensor_expression
     : public tensor_expression <T, unary_tensor_expression<T,E,OP>>
@@ -14,11 +14,13 @@
 
 #include <type_traits>
 #include <stdexcept>
+#include <string>
 
+#include "algorithms.hpp"
 
 namespace boost::numeric::ublas {
 
-template<class element_type, class storage_format, class storage_type>
+template<class element_type, class storage_format, class storage_type, class extents_type>
 class tensor;
 
 template<class size_type>
@@ -37,6 +39,9 @@ struct binary_tensor_expression;
 template<class T, class E, class OP>
 struct unary_tensor_expression;
 
+template<class T, class TR, class EL, class ER, class OP>
+struct mixed_binary_tensor_expression;
+
 }
 
 namespace boost::numeric::ublas::detail {
@@ -62,6 +67,10 @@ template<class T, class E, class OP>
 struct has_tensor_types<T, unary_tensor_expression<T,E,OP>>
 { static constexpr bool value = std::is_same<T,E>::value || has_tensor_types<T,E>::value; };
 
+template<class T, class TR, class EL, class ER, class OP>
+struct has_tensor_types<T, mixed_binary_tensor_expression<T,TR,EL,ER,OP>>
+{ static constexpr bool value = std::is_same<T,EL>::value || has_tensor_types<T,EL>::value || std::is_same<TR,ER>::value || has_tensor_types<TR,ER>::value; };
+
 } // namespace boost::numeric::ublas::detail
 
 
@@ -74,8 +83,8 @@ namespace boost::numeric::ublas::detail {
 /** @brief Retrieves extents of the tensor
  *
 */
-template<class T, class F, class A>
-auto retrieve_extents(tensor<T,F,A> const& t)
+template<class T, class F, class A, class E>
+auto retrieve_extents(tensor<T,F,A,E> const& t)
 {
 	return t.extents();
 }
@@ -145,6 +154,29 @@ auto retrieve_extents(unary_tensor_expression<T,E,OP> const& expr)
 	    return retrieve_extents(expr.e);
 }
 
+/** @brief Retrieves extents of the binary tensor expression with operands in different layouts
+ *
+ * @returns extents of the left child expression if it contains tensors, else those of the right child expression.
+*/
+template<class T, class TR, class EL, class ER, class OP>
+auto retrieve_extents(mixed_binary_tensor_expression<T,TR,EL,ER,OP> const& expr)
+{
+	static_assert(detail::has_tensor_types<T,mixed_binary_tensor_expression<T,TR,EL,ER,OP>>::value,
+	              "Error in boost::numeric::ublas::detail::retrieve_extents: Expression to evaluate should contain tensors.");
+
+	if constexpr ( std::is_same<T,EL>::value )
+	    return expr.el.extents();
+
+	else if constexpr ( detail::has_tensor_types<T,EL>::value )
+	    return retrieve_extents(expr.el);
+
+	else if constexpr ( std::is_same<TR,ER>::value )
+	    return expr.er.extents();
+
+	else
+	    return retrieve_extents(expr.er);
+}
+
 } // namespace boost::numeric::ublas::detail
 
 
@@ -152,14 +184,14 @@ auto retrieve_extents(unary_tensor_expression<T,E,OP> const& expr)
 
 namespace boost::numeric::ublas::detail {
 
-template<class T, class F, class A, class S>
-auto all_extents_equal(tensor<T,F,A> const& t, basic_extents<S> const& extents)
+template<class T, class F, class A, class E, class S>
+auto all_extents_equal(tensor<T,F,A,E> const& t, S const& extents)
 {
 	return extents == t.extents();
 }
 
 template<class T, class D, class S>
-auto all_extents_equal(tensor_expression<T,D> const& expr, basic_extents<S> const& extents)
+auto all_extents_equal(tensor_expression<T,D> const& expr, S const& extents)
 {
 	static_assert(detail::has_tensor_types<T,tensor_expression<T,D>>::value,
 	              "Error in boost::numeric::ublas::detail::all_extents_equal: Expression to evaluate should contain tensors.");
@@ -179,7 +211,7 @@ auto all_extents_equal(tensor_expression<T,D> const& expr, basic_extents<S> cons
 }
 
 template<class T, class EL, class ER, class OP, class S>
-auto all_extents_equal(binary_tensor_expression<T,EL,ER,OP> const& expr, basic_extents<S> const& extents)
+auto all_extents_equal(binary_tensor_expression<T,EL,ER,OP> const& expr, S const& extents)
 {
 	static_assert(detail::has_tensor_types<T,binary_tensor_expression<T,EL,ER,OP>>::value,
 	              "Error in boost::numeric::ublas::detail::all_extents_equal: Expression to evaluate should contain tensors.");
@@ -205,7 +237,7 @@ auto all_extents_equal(binary_tensor_expression<T,EL,ER,OP> const& expr, basic_e
 
 
 template<class T, class E, class OP, class S>
-auto all_extents_equal(unary_tensor_expression<T,E,OP> const& expr, basic_extents<S> const& extents)
+auto all_extents_equal(unary_tensor_expression<T,E,OP> const& expr, S const& extents)
 {
 
 	static_assert(detail::has_tensor_types<T,unary_tensor_expression<T,E,OP>>::value,
@@ -222,6 +254,65 @@ auto all_extents_equal(unary_tensor_expression<T,E,OP> const& expr, basic_extent
 	return true;
 }
 
+template<class T, class TR, class EL, class ER, class OP, class S>
+auto all_extents_equal(mixed_binary_tensor_expression<T,TR,EL,ER,OP> const& expr, S const& extents)
+{
+	static_assert(detail::has_tensor_types<T,mixed_binary_tensor_expression<T,TR,EL,ER,OP>>::value,
+	              "Error in boost::numeric::ublas::detail::all_extents_equal: Expression to evaluate should contain tensors.");
+
+	if constexpr ( std::is_same<T,EL>::value )
+	    if(extents !=  expr.el.extents())
+	    return false;
+
+	if constexpr ( std::is_same<TR,ER>::value )
+	    if(extents != expr.er.extents())
+	    return false;
+
+	if constexpr ( detail::has_tensor_types<T,EL>::value )
+	    if(!all_extents_equal(expr.el, extents))
+	    return false;
+
+	if constexpr ( detail::has_tensor_types<TR,ER>::value )
+	    if(!all_extents_equal(expr.er, extents))
+	    return false;
+
+	return true;
+}
+
+
+/** @brief Returns the number of elements of a tensor expression
+ *
+ * @note throws if the tensors within the expression have different shapes.
+*/
+template<class T, class D>
+auto expression_size(tensor_expression<T,D> const& expr, char const* name)
+{
+	auto const extents = retrieve_extents(expr);
+	if(!all_extents_equal(expr, extents))
+		throw std::runtime_error(std::string("Error in boost::numeric::ublas::") + name + ": expression contains tensors with different shapes.");
+	return typename T::size_type(extents.product());
+}
+
+/** @brief Elements of a tensor expression with linear indices in the storage format, evaluated on access
+ *
+ * Models the vector interface the reductions of detail/reduction.hpp expect, no temporary tensor is created.
+*/
+template<class T, class D>
+struct expression_elements
+{
+	using value_type = typename T::value_type;
+	using size_type  = typename T::size_type;
+
+	expression_elements(tensor_expression<T,D> const& expr, size_type size)
+	  : e(expr()), n(size) {}
+
+	size_type size() const { return n; }
+	value_type operator()(size_type i) const { return value_type(e(i)); }
+
+	D const& e;
+	size_type n;
+};
+
 } // namespace boost::numeric::ublas::detail
 
 
@@ -246,6 +337,24 @@ void eval(tensor_type& lhs, tensor_expression<tensor_type, derived_type> const&
 		lhs(i) = expr()(i);
 }
 
+/** @brief Evaluates a binary expression with operands in different layouts for a tensor
+ *
+ * Traverses the tensor and both operands in tiles, see detail::tiled_traversal, so that the right operand
+ * is read in cache lines although its fastest mode is the slowest one of the tensor.
+ *
+ * \note Checks if shape of the tensor matches those of all tensors within the expression.
+*/
+template<class tensor_type, class TR, class EL, class ER, class OP>
+void eval(tensor_type& lhs, tensor_expression<tensor_type, mixed_binary_tensor_expression<tensor_type,TR,EL,ER,OP>> const& expr)
+{
+	if(!detail::all_extents_equal(expr(), lhs.extents() ))
+		throw std::runtime_error("Error in boost::numeric::ublas::tensor: expression contains tensors with different shapes.");
+
+	auto const& e = expr();
+	for_each_tiled(e.n.size(), e.n.data(), e.wl.data(), e.wr.data(),
+	               [&lhs,&e](auto i, auto j){ lhs(i) = e.op(e.el(i), e.er(j)); });
+}
+
 /** @brief Evaluates expression for a tensor
  *
  * Applies a unary function to the results of the expressions before the assignment.
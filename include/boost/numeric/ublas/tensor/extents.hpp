@@ -18,6 +18,7 @@
 #include <limits>
 #include <numeric>
 #include <stdexcept>
+#include <type_traits>
 #include <vector>
 
 #include <cassert>
@@ -26,6 +27,17 @@ namespace boost {
 namespace numeric {
 namespace ublas {
 
+namespace detail {
+
+/** @brief True for the extents types a tensor can be shaped with
+ *
+ * Specialized for basic_extents here and for the compile-time extents in static_extents.hpp
+ */
+template<class E>
+struct is_extents : std::false_type {};
+
+}
+
 
 /** @brief Template class for storing tensor extents with runtime variable size.
  *
@@ -116,6 +128,19 @@ public:
 	{
 	}
 
+	/** @brief Constructs basic_extents from extents of another type
+	 *
+	 * @code auto ex = basic_extents<std::size_t>( static_extents<3,2,4>{} ); @endcode
+	 *
+	 * @param e extents such as static_extents or fixed_rank_extents
+	 */
+	template<class other_extents,
+	         std::enable_if_t<detail::is_extents<other_extents>::value && !std::is_same<other_extents,basic_extents>::value,int> = 0>
+	explicit basic_extents(other_extents const& e)
+	  : basic_extents ( base_type( e.begin(), e.end() ) )
+	{
+	}
+
 	/** @brief Copy constructs basic_extents */
 	basic_extents(basic_extents const& l )
 	  : _base(l._base)
@@ -306,6 +331,21 @@ public:
 		return !( _base == b._base );
 	}
 
+	/** @brief Returns true if extents of another type have the same rank and elements */
+	template<class other_extents,
+	         std::enable_if_t<detail::is_extents<other_extents>::value,int> = 0>
+	bool operator == (other_extents const& b) const
+	{
+		return this->size() == b.size() && std::equal(_base.begin(), _base.end(), b.begin());
+	}
+
+	template<class other_extents,
+	         std::enable_if_t<detail::is_extents<other_extents>::value,int> = 0>
+	bool operator != (other_extents const& b) const
+	{
+		return !( *this == b );
+	}
+
 	const_iterator
 	begin() const
 	{
@@ -328,6 +368,13 @@ private:
 
 using shape = basic_extents<std::size_t>;
 
+namespace detail {
+
+template<class int_type>
+struct is_extents<basic_extents<int_type>> : std::true_type {};
+
+}
+
 } // namespace ublas
 } // namespace numeric
 } // namespace boost
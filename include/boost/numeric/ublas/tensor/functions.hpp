@@ -17,20 +17,25 @@
 #include <stdexcept>
 #include <vector>
 #include <algorithm>
+#include <functional>
 #include <numeric>
+#include <tuple>
 
 
 #include "multiplication.hpp"
 #include "algorithms.hpp"
 #include "expression.hpp"
 #include "expression_evaluation.hpp"
+#include "static_extents.hpp"
 #include "storage_traits.hpp"
+#include "../detail/raw.hpp"
+#include "../detail/reduction.hpp"
 
 namespace boost {
 namespace numeric {
 namespace ublas {
 
-template<class Value, class Format, class Allocator>
+template<class Value, class Format, class Allocator, class Extents>
 class tensor;
 
 template<class Value, class Format, class Allocator>
@@ -39,6 +44,30 @@ class matrix;
 template<class Value, class Allocator>
 class vector;
 
+namespace detail {
+
+/** @brief Type of the tensors returned by functions of tensors or tensor views T */
+template<class T>
+struct result_tensor;
+
+template<class V, class F, class A, class E>
+struct result_tensor<tensor<V,F,A,E>> { using type = tensor<V,F,A,shape>; };
+
+template<class T>
+using result_tensor_t = typename result_tensor<T>::type;
+
+/** @brief True if TA and TB are strided tensors (see detail/raw.hpp) with the same value type, possibly in different storage formats */
+template<class TA, class TB, class = void>
+struct is_strided_tensor_pair : std::false_type {};
+
+template<class TA, class TB>
+struct is_strided_tensor_pair<TA,TB,std::enable_if_t<raw::strided_tensor_traits<TA>::value && raw::strided_tensor_traits<TB>::value>>
+	: std::is_same<typename TA::value_type,typename TB::value_type> {};
+
+template<class TA, class TB>
+constexpr bool is_strided_tensor_pair_v = is_strided_tensor_pair<TA,TB>::value;
+
+} // namespace detail
 
 
 
@@ -49,16 +78,20 @@ class vector;
  * @note calls ublas::ttv
  *
  * @param[in] m contraction dimension with 1 <= m <= p
- * @param[in] a tensor object A with order p
- * @param[in] b vector object B
+ * @param[in] a tensor object or tensor view A with order p
+ * @param[in] b vector object B, any strided vector (see detail/raw.hpp) of the same value type
  *
  * @returns tensor object C with order p-1, the same storage format and allocator type as A
 */
-template<class V, class F, class A1, class A2>
-auto prod(tensor<V,F,A1> const& a, vector<V,A2> const& b, const std::size_t m)
+template<class TA, class E,
+         std::enable_if_t<raw::strided_tensor_traits<TA>::value && raw::strided_vector_traits<E>::value &&
+                          std::is_same<typename E::value_type,typename TA::value_type>::value,int> = 0>
+auto prod(TA const& a, vector_expression<E> const& be, const std::size_t m)
 {
+	using traits = raw::strided_vector_traits<E>;
+	E const& b = be();
 
-	using tensor_type  = tensor<V,F,A1>;
+	using tensor_type  = detail::result_tensor_t<TA>;
 	using extents_type = typename tensor_type::extents_type;
 	using ebase_type   = typename extents_type::base_type;
 	using value_type   = typename tensor_type::value_type;
@@ -85,6 +118,15 @@ auto prod(tensor<V,F,A1> const& a, vector<V,A2> const& b, const std::size_t m)
 	auto nc = ebase_type(std::max(p-1, size_type(2)) , size_type(1));
 	auto nb = ebase_type{b.size(),1};
 
+	// b is read in place, copied first only for a negative stride
+	auto const sb = traits::stride(b);
+	auto bv = std::vector<value_type>{};
+	if(sb < 0)
+		for(auto i = 0u; i < b.size(); ++i)
+			bv.push_back(b(i));
+	auto const bb = sb < 0 ? bv.data() : traits::data(b);
+	auto wb = ebase_type(2, sb < 0 ? size_type(1) : size_type(sb));
+
 
 	for(auto i = 0u, j = 0u; i < p; ++i)
 		if(i != m-1)
@@ -92,12 +134,10 @@ auto prod(tensor<V,F,A1> const& a, vector<V,A2> const& b, const std::size_t m)
 
 	auto c = tensor_type(extents_type(nc),value_type{});
 
-	auto bb = &(b(0));
-
 	ttv(m, p,
 	    c.data(), c.extents().data(), c.strides().data(),
 	    a.data(), a.extents().data(), a.strides().data(),
-	    bb, nb.data(), nb.data());
+	    bb, nb.data(), wb.data());
 
 
 	return c;
@@ -111,17 +151,21 @@ auto prod(tensor<V,F,A1> const& a, vector<V,A2> const& b, const std::size_t m)
  *
  * @note calls ublas::ttm
  *
- * @param[in] a tensor object A with order p
- * @param[in] b vector object B
+ * @param[in] a tensor object or tensor view A with order p
+ * @param[in] b matrix object B, any strided matrix (see detail/raw.hpp) of the same value type
  * @param[in] m contraction dimension with 1 <= m <= p
  *
  * @returns tensor object C with order p, the same storage format and allocator type as A
 */
-template<class V, class F, class A1, class A2>
-auto prod(tensor<V,F,A1> const& a, matrix<V,F,A2> const& b, const std::size_t m)
+template<class TA, class E,
+         std::enable_if_t<raw::strided_tensor_traits<TA>::value && raw::strided_matrix_traits<E>::value &&
+                          std::is_same<typename E::value_type,typename TA::value_type>::value,int> = 0>
+auto prod(TA const& a, matrix_expression<E> const& be, const std::size_t m)
 {
+	using traits = raw::strided_matrix_traits<E>;
+	E const& b = be();
 
-	using tensor_type  = tensor<V,F,A1>;
+	using tensor_type  = detail::result_tensor_t<TA>;
 	using extents_type = typename tensor_type::extents_type;
 	using strides_type = typename tensor_type::strides_type;
 	using value_type   = typename tensor_type::value_type;
@@ -145,15 +189,29 @@ auto prod(tensor<V,F,A1> const& a, matrix<V,F,A2> const& b, const std::size_t m)
 		throw std::length_error("error in boost::numeric::ublas::prod(ttm): second argument matrix should not be empty.");
 
 
-	auto nc = a.extents().base();
+	auto nc = typename extents_type::base_type(a.extents().begin(), a.extents().end());
 	auto nb = extents_type {b.size1(),b.size2()};
-	auto wb = strides_type (nb);
 
 	nc[m-1] = nb[0];
 
 	auto c = tensor_type(extents_type(nc),value_type{});
 
-	auto bb = &(b(0,0));
+	// B is read in place whatever its layout, copied first only for negative strides
+	auto const sb1 = traits::stride1(b);
+	auto const sb2 = traits::stride2(b);
+	auto bv = std::vector<value_type>{};
+	auto wb = nb.base();
+	if(sb1 < 0 || sb2 < 0){
+		auto const wf = strides_type (nb);
+		bv.resize(nb.product());
+		for(auto i = 0u; i < nb[0]; ++i)
+			for(auto j = 0u; j < nb[1]; ++j)
+				bv[i*wf[0] + j*wf[1]] = b(i,j);
+		wb = {wf[0], wf[1]};
+	}
+	else
+		wb = {std::size_t(sb1), std::size_t(sb2)};
+	auto const bb = bv.empty() ? traits::data(b) : bv.data();
 
 	ttm(m, p,
 	    c.data(), c.extents().data(), c.strides().data(),
@@ -181,12 +239,12 @@ auto prod(tensor<V,F,A1> const& a, matrix<V,F,A2> const& b, const std::size_t m)
  * @param[in]  b  right-hand side tensor with order s+q
  * @result     tensor with order r+s
 */
-template<class V, class F, class A1, class A2>
-auto prod(tensor<V,F,A1> const& a, tensor<V,F,A2> const& b,
+template<class TA, class TB, std::enable_if_t<detail::is_strided_tensor_pair_v<TA,TB>,int> = 0>
+auto prod(TA const& a, TB const& b,
           std::vector<std::size_t> const& phia, std::vector<std::size_t> const& phib)
 {
 
-	using tensor_type  = tensor<V,F,A1>;
+	using tensor_type  = detail::result_tensor_t<TA>;
 	using extents_type = typename tensor_type::extents_type;
 	using value_type   = typename tensor_type::value_type;
 	using size_type = typename extents_type::value_type;
@@ -285,29 +343,160 @@ auto prod(tensor<V,F,A1> const& a, tensor<V,F,A2> const& b,
  * @param[in]  b  right-hand side tensor with order s+q
  * @result     tensor with order r+s
 */
-template<class V, class F, class A1, class A2>
-auto prod(tensor<V,F,A1> const& a, tensor<V,F,A2> const& b,
+template<class TA, class TB, std::enable_if_t<detail::is_strided_tensor_pair_v<TA,TB>,int> = 0>
+auto prod(TA const& a, TB const& b,
           std::vector<std::size_t> const& phi)
 {
 	return prod(a, b, phi, phi);
 }
 
 
+/** @brief Computes the q-mode tensor-times-tensor products of all slices along a batch mode
+ *
+ * Implements C[i1,...,ir,j1,...,js,k] = sum( A[i1,...,ir+q,k] * B[j1,...,js+q,k] ) for all k, i.e. prod(A_k, B_k, phia, phib)
+ * for every slice k, in a single call that allocates C once. The batch mode k is the slowest mode in the storage format
+ * of A, i.e. the last mode of A, B and C in the first-order and their first mode in the last-order format.
+ *
+ * @code auto c = batched_prod(a, b, {2}, {1}); // c_k = a_k * b_k for the matrices of a batch @endcode
+ *
+ * @note calls detail::batched::ttt
+ *
+ * na[phia[x]] = nb[phib[x]] for 1 <= x <= q, where na and nb are the extents of the slices
+ *
+ * @param[in]	 phia one-based permutation tuple of length q for the slices of the first input tensor a
+ * @param[in]	 phib one-based permutation tuple of length q for the slices of the second input tensor b
+ * @param[in]  a  left-hand side tensor with order r+q+1
+ * @param[in]  b  right-hand side tensor with order s+q+1
+ * @result     tensor with order max(r+s,1)+1
+*/
+template<class TA, class TB, std::enable_if_t<detail::is_strided_tensor_pair_v<TA,TB>,int> = 0>
+auto batched_prod(TA const& a, TB const& b,
+                  std::vector<std::size_t> const& phia, std::vector<std::size_t> const& phib)
+{
+	using tensor_type  = detail::result_tensor_t<TA>;
+	using extents_type = typename tensor_type::extents_type;
+	using value_type   = typename tensor_type::value_type;
+
+	auto const pa = std::size_t(a.rank());
+	auto const pb = std::size_t(b.rank());
+	auto const q  = phia.size();
+
+	if(pa < 2ul)
+		throw std::runtime_error("error in ublas::batched_prod: order of left-hand side tensor must be greater than 1.");
+	if(pb < 2ul)
+		throw std::runtime_error("error in ublas::batched_prod: order of right-hand side tensor must be greater than 1.");
+	if(q != phib.size())
+		throw std::runtime_error("error in ublas::batched_prod: permutation tuples must have the same length.");
+	if(pa-1 < q || pb-1 < q)
+		throw std::runtime_error("error in ublas::batched_prod: number of contraction dimensions cannot be greater than the order of the slices.");
+
+	// slices without the batch mode
+	auto const slice = [](auto const& t, bool first){
+		auto const p = std::size_t(t.rank());
+		auto const k = first ? p-1 : 0ul;
+		auto n = std::vector<std::size_t>{}, w = std::vector<std::size_t>{};
+		for(auto r = 0ul; r < p; ++r)
+			if(r != k){
+				n.push_back(t.extents().at(r));
+				w.push_back(t.strides().at(r));
+			}
+		return std::make_tuple(n, w, std::size_t(t.extents().at(k)), std::size_t(t.strides().at(k)));
+	};
+	auto const first_c = std::is_same<typename tensor_type::layout_type,column_major>::value;
+	auto const [na, wa, batch, wka] = slice(a, first_c);
+	auto const [nb, wb, batchb, wkb] = slice(b, first_c);
+
+	if(batch != batchb)
+		throw std::runtime_error("error in ublas::batched_prod: batch modes must have the same extent.");
+
+	auto phia1 = std::vector<std::size_t>(pa-1), phib1 = std::vector<std::size_t>(pb-1);
+	std::iota(phia1.begin(), phia1.end(), 1ul);
+	std::iota(phib1.begin(), phib1.end(), 1ul);
+
+	for(auto x = 0ul; x < q; ++x){
+		if(phia.at(x) < 1ul || phia.at(x) > pa-1 || phib.at(x) < 1ul || phib.at(x) > pb-1)
+			throw std::runtime_error("error in ublas::batched_prod: permutation tuples must contain modes of the slices.");
+		if(na.at(phia.at(x)-1) != nb.at(phib.at(x)-1))
+			throw std::runtime_error("error in ublas::batched_prod: permutations of the extents are not correct.");
+		* std::remove(phia1.begin(), phia1.end(), phia.at(x)) = phia.at(x);
+		* std::remove(phib1.begin(), phib1.end(), phib.at(x)) = phib.at(x);
+	}
+
+	auto const r = pa-1 - q;
+	auto const s = pb-1 - q;
+
+	// free modes of A and B, the batch mode and contraction modes
+	auto nai = std::vector<std::size_t>{}, wai = std::vector<std::size_t>{}, nbj = std::vector<std::size_t>{}, wbj = std::vector<std::size_t>{};
+	auto nl = std::vector<std::size_t>{}, wal = std::vector<std::size_t>{}, wbl = std::vector<std::size_t>{};
+	for(auto x = 0ul; x < r; ++x){
+		nai.push_back(na[phia1[x]-1]);
+		wai.push_back(wa[phia1[x]-1]);
+	}
+	for(auto x = 0ul; x < s; ++x){
+		nbj.push_back(nb[phib1[x]-1]);
+		wbj.push_back(wb[phib1[x]-1]);
+	}
+	for(auto x = 0ul; x < q; ++x){
+		nl.push_back(na[phia[x]-1]);
+		wal.push_back(wa[phia[x]-1]);
+		wbl.push_back(wb[phib[x]-1]);
+	}
+
+	auto nc = nai;
+	nc.insert(nc.end(), nbj.begin(), nbj.end());
+	if(nc.empty())
+		nc.push_back(1ul);
+	nc.insert(first_c ? nc.end() : nc.begin(), batch);
+
+	auto c = tensor_type(extents_type(nc), value_type{});
+
+	auto const [ncs, wc, batchc, wkc] = slice(c, first_c);
+	auto const wci = std::vector<std::size_t>(wc.begin(), wc.begin()+r);
+	auto const wcj = std::vector<std::size_t>(wc.begin()+r, wc.begin()+r+s);
+
+	detail::batched::ttt(batch,
+	                     detail::batched::offsets(nai, wci), detail::batched::offsets(nbj, wcj),
+	                     detail::batched::offsets(nai, wai), detail::batched::offsets(nl, wal),
+	                     detail::batched::offsets(nl, wbl),  detail::batched::offsets(nbj, wbj),
+	                     c.data(), wkc, a.data(), wka, b.data(), wkb);
+
+	return c;
+}
+
+/** @brief Computes the q-mode tensor-times-tensor products of all slices along a batch mode
+ *
+ * Implements C[i1,...,ir,j1,...,js,k] = sum( A[i1,...,ir+q,k] * B[j1,...,js+q,k] ) for all k, see batched_prod
+ *
+ * na[phi[x]] = nb[phi[x]] for 1 <= x <= q
+ *
+ * @param[in]	 phi one-based permutation tuple of length q for the slices of both input tensors
+ * @param[in]  a  left-hand side tensor with order r+q+1
+ * @param[in]  b  right-hand side tensor with order s+q+1
+ * @result     tensor with order max(r+s,1)+1
+*/
+template<class TA, class TB, std::enable_if_t<detail::is_strided_tensor_pair_v<TA,TB>,int> = 0>
+auto batched_prod(TA const& a, TB const& b,
+                  std::vector<std::size_t> const& phi)
+{
+	return batched_prod(a, b, phi, phi);
+}
+
+
 /** @brief Computes the inner product of two tensors
  *
  * Implements c = sum(A[i1,i2,...,ip] * B[i1,i2,...,jp])
  *
  * @note calls inner function
  *
- * @param[in] a tensor object A
- * @param[in] b tensor object B
+ * @param[in] a tensor object or tensor view A
+ * @param[in] b tensor object or tensor view B
  *
  * @returns a value type.
 */
-template<class V, class F, class A1, class A2>
-auto inner_prod(tensor<V,F,A1> const& a, tensor<V,F,A2> const& b)
+template<class TA, class TB, std::enable_if_t<detail::is_strided_tensor_pair_v<TA,TB>,int> = 0>
+auto inner_prod(TA const& a, TB const& b)
 {
-	using value_type   = typename tensor<V,F,A1>::value_type;
+	using value_type   = typename TA::value_type;
 
 	if( a.rank() != b.rank() )
 		throw std::length_error("error in boost::numeric::ublas::inner_prod: Rank of both tensors must be the same.");
@@ -318,26 +507,81 @@ auto inner_prod(tensor<V,F,A1> const& a, tensor<V,F,A2> const& b)
 	if( a.extents() != b.extents())
 		throw std::length_error("error in boost::numeric::ublas::inner_prod: Tensor extents should be the same.");
 
+	auto const pa = a.data();
+	auto const pb = b.data();
+
+	// contiguous tensors in the same format are reduced in chunks, in parallel
+	if constexpr (std::is_same<typename TA::layout_type,typename TB::layout_type>::value){
+		if( raw::strided_tensor_traits<TA>::contiguous(a) && raw::strided_tensor_traits<TB>::contiguous(b) )
+			return detail::reduce_sum<value_type>( [pa,pb](auto i){ return value_type(pa[i] * pb[i]); },
+			                                       a.extents().product(), BOOST_UBLAS_DEFAULT_SUMMATION() );
+	}
+	// tensors in different formats are reduced tile by tile, see detail::tiled_traversal
+	else {
+		auto const tiles = detail::tiled_traversal<std::size_t>( a.rank(), a.extents().data(), a.strides().data(), b.strides().data() );
+		return detail::reduce_sum<value_type>( [&tiles,pa,pb](auto t){
+			auto k = value_type{0};
+			tiles( t, [&k,pa,pb](auto ia, auto ib){ k += pa[ia] * pb[ib]; } );
+			return k; }, tiles.size(), BOOST_UBLAS_DEFAULT_SUMMATION() );
+	}
+
 	return inner(a.rank(), a.extents().data(),
 	             a.data(), a.strides().data(),
 	             b.data(), b.strides().data(), value_type{0});
 }
 
+/** @brief Computes the inner product of two tensor expressions without evaluating them into tensors
+ *
+ * Implements c = sum(A[i1,i2,...,ip] * B[i1,i2,...,jp]) in a single pass over the tensors of A and B
+ *
+ * @code auto r = inner_prod(a - b, a - b); @endcode
+ *
+ * @param[in] a tensor expression A
+ * @param[in] b tensor expression B
+ *
+ * @returns a value type.
+*/
+template<class T, class L, class R>
+auto inner_prod(detail::tensor_expression<T,L> const& a, detail::tensor_expression<T,R> const& b)
+{
+	using value_type = typename T::value_type;
+
+	auto const na = detail::retrieve_extents(a);
+	auto const nb = detail::retrieve_extents(b);
+
+	if( na.size() != nb.size() )
+		throw std::length_error("error in boost::numeric::ublas::inner_prod: Rank of both tensors must be the same.");
+
+	if( na.empty() || nb.empty() )
+		throw std::length_error("error in boost::numeric::ublas::inner_prod: Tensors should not be empty.");
+
+	if( na != nb )
+		throw std::length_error("error in boost::numeric::ublas::inner_prod: Tensor extents should be the same.");
+
+	auto const size = detail::expression_size(a, "inner_prod");
+	detail::expression_size(b, "inner_prod");
+
+	auto const& ea = a();
+	auto const& eb = b();
+	return detail::reduce_sum<value_type>( [&ea,&eb](auto i){ return value_type(ea(i) * eb(i)); },
+	                                       size, BOOST_UBLAS_DEFAULT_SUMMATION() );
+}
+
 /** @brief Computes the outer product of two tensors
  *
  * Implements C[i1,...,ip,j1,...,jq] = A[i1,i2,...,ip] * B[j1,j2,...,jq]
  *
  * @note calls outer function
  *
- * @param[in] a tensor object A
- * @param[in] b tensor object B
+ * @param[in] a tensor object or tensor view A
+ * @param[in] b tensor object or tensor view B
  *
  * @returns tensor object C with the same storage format F and allocator type A1
 */
-template<class V, class F, class A1, class A2>
-auto outer_prod(tensor<V,F,A1> const& a, tensor<V,F,A2> const& b)
+template<class TA, class TB, std::enable_if_t<detail::is_strided_tensor_pair_v<TA,TB>,int> = 0>
+auto outer_prod(TA const& a, TB const& b)
 {
-	using tensor_type  = tensor<V,F,A1>;
+	using tensor_type  = detail::result_tensor_t<TA>;
 	using extents_type = typename tensor_type::extents_type;
 
 	if( a.empty() || b.empty() )
@@ -367,19 +611,20 @@ auto outer_prod(tensor<V,F,A1> const& a, tensor<V,F,A2> const& b)
  *
  * @note calls trans function
  *
- * @param[in] a    tensor object of rank p
+ * @param[in] a    tensor object or tensor view of rank p
  * @param[in] tau  one-based permutation tuple of length p
  * @returns        a transposed tensor object with the same storage format F and allocator type A
 */
-template<class V, class F, class A>
-auto trans(tensor<V,F,A> const& a, std::vector<std::size_t> const& tau)
+template<class TA, std::enable_if_t<raw::strided_tensor_traits<TA>::value,int> = 0>
+auto trans(TA const& a, std::vector<std::size_t> const& tau)
 {
-	using tensor_type  = tensor<V,F,A>;
+	using tensor_type  = detail::result_tensor_t<TA>;
+	using E            = typename TA::extents_type;
 	using extents_type = typename tensor_type::extents_type;
 	//	using strides_type = typename tensor_type::strides_type;
 
 	if( a.empty() )
-		return tensor<V,F,A>{};
+		return tensor_type{};
 
 	auto const   p = a.rank();
 	auto const& na = a.extents();
@@ -393,9 +638,14 @@ auto trans(tensor<V,F,A> const& a, std::vector<std::size_t> const& tau)
 	auto c = tensor_type(extents_type(nc));
 
 
-	trans( a.rank(), a.extents().data(), tau.data(),
-	       c.data(), c.strides().data(),
-	       a.data(), a.strides().data());
+	if constexpr (detail::is_static_rank<E>::value)
+		trans( std::integral_constant<std::size_t,E::size()>{}, a.extents().data(), tau.data(),
+		       c.data(), c.strides().data(),
+		       a.data(), a.strides().data());
+	else
+		trans( a.rank(), a.extents().data(), tau.data(),
+		       c.data(), c.strides().data(),
+		       a.data(), a.strides().data());
 
 	//	auto wc_pi = typename strides_type::base_type (p);
 	//	for(auto i = 0u; i < p; ++i)
@@ -412,31 +662,88 @@ auto trans(tensor<V,F,A> const& a, std::vector<std::size_t> const& tau)
 
 /** @brief Computes the frobenius norm of a tensor expression
  *
- * @note evaluates the tensor expression and calls the accumulate function
- *
+ * @note evaluates the elements of the expression while reducing them, in chunks and in parallel.
+ * No temporary tensor is created, norm(a - b) reads a and b once.
  *
  * Implements the two-norm with
  * k = sqrt( sum_(i1,...,ip) A(i1,...,ip)^2 )
  *
- * @param[in] a    tensor object of rank p
+ * Floating-point sums that overflow or underflow are summed a second time, scaled by a power of two.
+ *
+ * @param[in] expr tensor expression of rank p
  * @returns        the frobenius norm of the tensor
 */
-//template<class V, class F, class A>
-//auto norm(tensor<V,F,A> const& a)
 template<class T, class D>
 auto norm(detail::tensor_expression<T,D> const& expr)
 {
+	using value_type = typename T::value_type;
+	using summation  = BOOST_UBLAS_DEFAULT_SUMMATION;
 
-	using tensor_type = typename detail::tensor_expression<T,D>::tensor_type;
-	using value_type = typename tensor_type::value_type;
-
-	auto a = tensor_type( expr );
+	auto const size = detail::expression_size(expr, "norm");
 
-	if( a.empty() )
+	if( size == 0u )
 		throw std::runtime_error("error in boost::numeric::ublas::norm: tensors should not be empty.");
 
-	return std::sqrt( accumulate( a.order(), a.extents().data(), a.data(), a.strides().data(), value_type{},
-	                              [](auto const& l, auto const& r){ return l + r*r; }  ) ) ;
+	auto const elements = detail::expression_elements<T,D>( expr, size );
+
+	if constexpr (std::is_floating_point<value_type>::value)
+		return detail::reduce_norm_2<value_type>( elements, summation() );
+	else
+		return std::sqrt( detail::reduce_sum<value_type>( [&elements](auto i){ auto const x = elements(i); return x*x; }, size, summation() ) );
+}
+
+/** @brief Computes the sum of all elements of a tensor expression
+ *
+ * @note evaluates the elements of the expression while reducing them, in chunks and in parallel.
+ *
+ * @param[in] expr tensor expression
+ * @returns        the sum, zero for empty tensors
+*/
+template<class T, class D>
+auto sum(detail::tensor_expression<T,D> const& expr)
+{
+	using value_type = typename T::value_type;
+
+	auto const elements = detail::expression_elements<T,D>( expr, detail::expression_size(expr, "sum") );
+	return detail::reduce_sum<value_type>( elements, elements.size(), BOOST_UBLAS_DEFAULT_SUMMATION() );
+}
+
+/** @brief Returns the largest element of a tensor expression
+ *
+ * @note evaluates the elements of the expression while reducing them, in chunks and in parallel.
+ *
+ * @param[in] expr non-empty tensor expression with ordered elements
+*/
+template<class T, class D>
+auto (max)(detail::tensor_expression<T,D> const& expr)
+{
+	using value_type = typename T::value_type;
+
+	auto const elements = detail::expression_elements<T,D>( expr, detail::expression_size(expr, "max") );
+	if( elements.size() == 0u )
+		throw std::runtime_error("error in boost::numeric::ublas::max: tensors should not be empty.");
+
+	using accumulator = detail::running_extremum<value_type,std::greater<value_type>>;
+	return detail::reduce<accumulator>( elements, elements.size(), naive_summation_tag() ).result();
+}
+
+/** @brief Returns the smallest element of a tensor expression
+ *
+ * @note evaluates the elements of the expression while reducing them, in chunks and in parallel.
+ *
+ * @param[in] expr non-empty tensor expression with ordered elements
+*/
+template<class T, class D>
+auto (min)(detail::tensor_expression<T,D> const& expr)
+{
+	using value_type = typename T::value_type;
+
+	auto const elements = detail::expression_elements<T,D>( expr, detail::expression_size(expr, "min") );
+	if( elements.size() == 0u )
+		throw std::runtime_error("error in boost::numeric::ublas::min: tensors should not be empty.");
+
+	using accumulator = detail::running_extremum<value_type,std::less<value_type>>;
+	return detail::reduce<accumulator>( elements, elements.size(), naive_summation_tag() ).result();
 }
 
 
@@ -456,11 +763,11 @@ auto real(detail::tensor_expression<T,D> const& expr) {
  * @param[in] lhs tensor expression
  * @returns   unary tensor expression
 */
-template<class V, class F, class A, class D>
-auto real(detail::tensor_expression<tensor<std::complex<V>,F,A>,D> const& expr)
+template<class V, class F, class A, class E, class D>
+auto real(detail::tensor_expression<tensor<std::complex<V>,F,A,E>,D> const& expr)
 {
-	using tensor_complex_type = tensor<std::complex<V>,F,A>;
-	using tensor_type = tensor<V,F,typename storage_traits<A>::template rebind<V>>;
+	using tensor_complex_type = tensor<std::complex<V>,F,A,E>;
+	using tensor_type = tensor<V,F,typename storage_traits<A>::template rebind<V>,E>;
 
 	if( detail::retrieve_extents( expr  ).empty() )
 		throw std::runtime_error("error in boost::numeric::ublas::real: tensors should not be empty.");
@@ -490,11 +797,11 @@ auto imag(detail::tensor_expression<T,D> const& lhs) {
  * @param[in] lhs tensor expression
  * @returns   unary tensor expression
 */
-template<class V, class A, class F, class D>
-auto imag(detail::tensor_expression<tensor<std::complex<V>,F,A>,D> const& expr)
+template<class V, class A, class F, class E, class D>
+auto imag(detail::tensor_expression<tensor<std::complex<V>,F,A,E>,D> const& expr)
 {
-	using tensor_complex_type = tensor<std::complex<V>,F,A>;
-	using tensor_type = tensor<V,F,typename storage_traits<A>::template rebind<V>>;
+	using tensor_complex_type = tensor<std::complex<V>,F,A,E>;
+	using tensor_type = tensor<V,F,typename storage_traits<A>::template rebind<V>,E>;
 
 	if( detail::retrieve_extents( expr  ).empty() )
 		throw std::runtime_error("error in boost::numeric::ublas::real: tensors should not be empty.");
@@ -523,7 +830,7 @@ auto conj(detail::tensor_expression<T,D> const& expr)
 	using new_value_type = std::complex<value_type>;
 	using new_array_type = typename storage_traits<array_type>::template rebind<new_value_type>;
 
-	using tensor_complex_type = tensor<new_value_type,layout_type, new_array_type>;
+	using tensor_complex_type = tensor<new_value_type,layout_type, new_array_type, typename tensor_type::extents_type>;
 
 	if( detail::retrieve_extents( expr  ).empty() )
 		throw std::runtime_error("error in boost::numeric::ublas::conj: tensors should not be empty.");
@@ -542,10 +849,10 @@ auto conj(detail::tensor_expression<T,D> const& expr)
  * @param[in] lhs tensor expression
  * @returns   unary tensor expression
 */
-template<class V, class A, class F, class D>
-auto conj(detail::tensor_expression<tensor<std::complex<V>,F,A>,D> const& expr)
+template<class V, class A, class F, class E, class D>
+auto conj(detail::tensor_expression<tensor<std::complex<V>,F,A,E>,D> const& expr)
 {
-	return detail::make_unary_tensor_expression<tensor<std::complex<V>,F,A>> (expr(), [] (auto const& l) { return std::conj( l ); } );
+	return detail::make_unary_tensor_expression<tensor<std::complex<V>,F,A,E>> (expr(), [] (auto const& l) { return std::conj( l ); } );
 }
 
 
@@ -0,0 +1,439 @@
+//
+//  Copyright (c) 2019
+//  The Boost.uBLAS developers
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file multi_index_product.hpp Contractions of two or more tensors in Einstein notation
+
+
+#ifndef BOOST_UBLAS_TENSOR_MULTI_INDEX_PRODUCT_HPP
+#define BOOST_UBLAS_TENSOR_MULTI_INDEX_PRODUCT_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "algorithms.hpp"
+#include "extents.hpp"
+#include "multiplication.hpp"
+#include "tensor.hpp"
+
+namespace boost {
+namespace numeric {
+namespace ublas {
+namespace detail {
+
+/** @brief One pairwise contraction of a contraction path
+ *
+ * Operands are numbered 0,...,n-1, the intermediate of step k is numbered n+k.
+*/
+struct contraction_step
+{
+	std::size_t left;
+	std::size_t right;
+};
+
+/** @brief Number of operands up to which contraction_path searches all pairwise orders */
+static constexpr std::size_t contraction_path_exhaustive = 10u;
+
+/** @brief Computes a pairwise order for contracting a chain of tensors
+ *
+ * A label occurring in two operands is contracted, a label occurring in one operand is free.
+ * The order minimizes the number of multiply-adds, summed over all pairwise contractions.
+ * Up to contraction_path_exhaustive operands, all orders are searched by dynamic programming
+ * over subsets of operands, beyond, the pair with the least multiply-adds is contracted first.
+ *
+ * @code auto path = contraction_path( {{0,1,2},{0},{1},{2}}, {3,4,2} ); @endcode
+ *
+ * @param labels  zero-based labels of the modes for each operand
+ * @param extents extent of each label
+ * @returns n-1 steps where the last one yields the result
+*/
+inline std::vector<contraction_step>
+contraction_path(std::vector<std::vector<std::size_t>> const& labels, std::vector<std::size_t> const& extents)
+{
+	auto const n = labels.size();
+	auto const m = extents.size();
+	auto path = std::vector<contraction_step>{};
+
+	if(n < 2)
+		return path;
+
+	// modes of the intermediate of a set of operands are the labels occurring once within it
+	auto multiply_adds = [&](std::vector<unsigned char> const& occ_left, std::vector<unsigned char> const& occ_right){
+		auto f = 1.0;
+		for(auto l = 0u; l < m; ++l)
+			if(occ_left[l] == 1 || occ_right[l] == 1)
+				f *= double(extents[l]);
+		return f;
+	};
+
+	auto occurrences = [&](std::size_t i){
+		auto occ = std::vector<unsigned char>(m,0);
+		for(auto l : labels[i])
+			++occ[l];
+		return occ;
+	};
+
+	if(n <= contraction_path_exhaustive)
+	{
+		auto const sets = std::size_t(1) << n;
+		auto occ    = std::vector<std::vector<unsigned char>>(sets, std::vector<unsigned char>(m,0));
+		auto cost   = std::vector<double>(sets, std::numeric_limits<double>::infinity());
+		auto split  = std::vector<std::size_t>(sets, 0u);
+
+		for(auto s = std::size_t(1); s < sets; ++s)
+			for(auto i = 0u; i < n; ++i)
+				if(s & (std::size_t(1) << i))
+					for(auto l : labels[i])
+						++occ[s][l];
+
+		for(auto i = 0u; i < n; ++i)
+			cost[std::size_t(1) << i] = 0.0;
+
+		for(auto s = std::size_t(1); s < sets; ++s){
+			if((s & (s-1)) == 0)
+				continue;
+			// each split {sl, s^sl} once, sl holding the lowest operand of s
+			auto const low = s & (~s + 1);
+			for(auto sl = (s-1) & s; sl > 0; sl = (sl-1) & s){
+				if(!(sl & low))
+					continue;
+				auto const sr = s ^ sl;
+				auto const c = cost[sl] + cost[sr] + multiply_adds(occ[sl], occ[sr]);
+				if(c < cost[s]){
+					cost[s] = c;
+					split[s] = sl;
+				}
+			}
+		}
+
+		auto id = n;
+		auto build = [&](auto& self, std::size_t s) -> std::size_t {
+			if((s & (s-1)) == 0){
+				auto i = 0u;
+				while(!(s & (std::size_t(1) << i))) ++i;
+				return i;
+			}
+			auto const l = self(self, split[s]);
+			auto const r = self(self, s ^ split[s]);
+			path.push_back( {l, r} );
+			return id++;
+		};
+		build(build, sets-1);
+		return path;
+	}
+
+	auto ids = std::vector<std::size_t>(n);
+	auto occ = std::vector<std::vector<unsigned char>>(n);
+	for(auto i = 0u; i < n; ++i)
+		ids[i] = i, occ[i] = occurrences(i);
+
+	for(auto id = n; ids.size() > 1; ++id){
+		auto bi = 0u, bj = 1u;
+		auto best = std::numeric_limits<double>::infinity();
+		for(auto i = 0u; i < ids.size(); ++i)
+			for(auto j = i+1; j < ids.size(); ++j){
+				auto const c = multiply_adds(occ[i], occ[j]);
+				if(c < best)
+					best = c, bi = i, bj = j;
+			}
+		path.push_back( {ids[bi], ids[bj]} );
+		for(auto l = 0u; l < m; ++l)
+			occ[bi][l] += occ[bj][l];
+		ids[bi] = id;
+		ids.erase(ids.begin()+bj);
+		occ.erase(occ.begin()+bj);
+	}
+	return path;
+}
+
+
+
+/** @brief Operand of a contraction in Einstein notation with the labels of its modes */
+template<class V>
+struct multi_index_operand
+{
+	V const* data = nullptr;
+	std::vector<std::size_t> extents;
+	std::vector<std::size_t> strides;
+	std::vector<std::size_t> labels;
+};
+
+
+/** @brief Returns an operand A(_i,...) of a contraction with the labels of its indices
+ *
+ * Every _ is a free mode of its own and is given a new label, counting down from free_label.
+*/
+template<class V, class tensor_type, class tuple_type>
+multi_index_operand<V> make_multi_index_operand(std::pair<tensor_type const&, tuple_type> const& p, std::size_t& free_label)
+{
+	static_assert(std::is_same<typename tensor_type::value_type, V>::value,
+	              "Static error in boost::numeric::ublas::einsum: tensors must have the same value type.");
+
+	auto const& t = p.first;
+	auto o = multi_index_operand<V>{};
+	o.data = t.data();
+	o.extents.assign(t.extents().begin(), t.extents().end());
+	o.strides.assign(t.strides().begin(), t.strides().end());
+	o.labels = std::apply([](auto ... is){ return std::vector<std::size_t>{ is()... }; }, p.second);
+
+	for(auto& l : o.labels)
+		if(l == 0u)
+			l = free_label--;
+	return o;
+}
+
+
+/** @brief Contracts two or more tensors with labeled modes
+ *
+ * A label occurring twice is contracted. Pairs of operands are contracted in the order with the
+ * least multiply-adds (see contraction_path) with intermediates held in reused buffers.
+ * The free modes of the result are those of the operands from left to right, padded to rank two.
+ *
+ * @note is used in function einsum
+ *
+ * @tparam T type of the resulting tensor
+ * @param operands operands with the labels of their modes
+*/
+template<class T>
+T contract(std::vector<multi_index_operand<typename T::value_type>> const& operands)
+{
+	using tensor_type  = T;
+	using value_type   = typename tensor_type::value_type;
+	using extents_type = typename tensor_type::extents_type;
+
+	auto const n = operands.size();
+
+	// labels numbered 0,...,m-1 with their extents and number of occurrences
+	auto names = std::vector<std::size_t>{};
+	auto extents = std::vector<std::size_t>{};
+	auto count = std::vector<std::size_t>{};
+	auto labels = std::vector<std::vector<std::size_t>>(n);
+
+	for(auto i = 0u; i < n; ++i){
+		auto const& o = operands[i];
+		for(auto r = 0u; r < o.labels.size(); ++r){
+			auto const pos = std::size_t(std::find(names.begin(), names.end(), o.labels[r]) - names.begin());
+			if(pos == names.size()){
+				names.push_back(o.labels[r]);
+				extents.push_back(o.extents[r]);
+				count.push_back(0u);
+			}
+			if(extents[pos] != o.extents[r])
+				throw std::runtime_error("error in ublas::einsum: extents of equal indices are not equal.");
+			if(std::find(labels[i].begin(), labels[i].end(), pos) != labels[i].end())
+				throw std::runtime_error("error in ublas::einsum: index occurs twice in a multi-index.");
+			if(++count[pos] > 2u)
+				throw std::runtime_error("error in ublas::einsum: index occurs in more than two multi-indices.");
+			labels[i].push_back(pos);
+		}
+	}
+
+	// free labels from left to right
+	auto free = std::vector<std::size_t>{};
+	for(auto i = 0u; i < n; ++i)
+		for(auto l : labels[i])
+			if(count[l] == 1u)
+				free.push_back(l);
+
+	auto nc = typename extents_type::base_type( std::max(free.size(), std::size_t(2)), std::size_t(1) );
+	for(auto r = 0u; r < free.size(); ++r)
+		nc[r] = extents[free[r]];
+
+	auto c = tensor_type(extents_type(nc), value_type{});
+
+	// strides of the result for each label
+	auto wc = std::vector<std::size_t>(extents.size(), 0u);
+	for(auto r = 0u; r < free.size(); ++r)
+		wc[free[r]] = c.strides()[r];
+
+	struct item
+	{
+		value_type const* data;
+		std::vector<std::size_t> extents, strides, labels;
+		std::size_t buffer;
+	};
+
+	auto constexpr none = std::numeric_limits<std::size_t>::max();
+	auto const path = contraction_path(labels, extents);
+
+	auto items = std::vector<item>{};
+	items.reserve(n + path.size());
+	for(auto i = 0u; i < n; ++i)
+		items.push_back( item{operands[i].data, operands[i].extents, operands[i].strides, labels[i], none} );
+
+	auto buffers = std::vector<std::vector<value_type>>{};
+	auto unused  = std::vector<std::size_t>{};
+	auto scale   = value_type{1};
+	auto written = false;
+
+	auto release = [&](item const& x){
+		if(x.buffer != none)
+			unused.push_back(x.buffer);
+	};
+
+	// the unused buffer with the least sufficient capacity, else any unused buffer, else a new one
+	auto acquire = [&](std::size_t size){
+		auto best = unused.end();
+		for(auto it = unused.begin(); it != unused.end(); ++it)
+			if(buffers[*it].capacity() >= size && (best == unused.end() || buffers[*it].capacity() < buffers[*best].capacity()))
+				best = it;
+		if(best == unused.end() && !unused.empty())
+			best = unused.begin();
+		auto b = std::size_t{};
+		if(best == unused.end())
+			b = buffers.size(), buffers.emplace_back();
+		else
+			b = *best, unused.erase(best);
+		buffers[b].assign(size, value_type{});
+		return b;
+	};
+
+	for(auto k = 0u; k < path.size(); ++k){
+
+		auto const& x = items[path[k].left];
+		auto const& y = items[path[k].right];
+
+		// a scalar scales the other operand
+		if(x.labels.empty() || y.labels.empty()){
+			auto const& s = x.labels.empty() ? x : y;
+			auto const& t = x.labels.empty() ? y : x;
+			scale *= *s.data;
+			release(s);
+			items.push_back(t);
+			continue;
+		}
+
+		auto const last = k+1 == path.size();
+
+		// free modes in the order of decreasing strides, contracted modes of y in the order of x
+		auto phia = std::vector<std::size_t>{}, phib = std::vector<std::size_t>{};
+		auto contracted = std::vector<std::size_t>{};
+
+		auto by_stride = [](item const& z){
+			auto p = std::vector<std::size_t>(z.labels.size());
+			for(auto r = 0u; r < p.size(); ++r) p[r] = r;
+			std::stable_sort(p.begin(), p.end(), [&z](auto i, auto j){ return z.strides[i] > z.strides[j]; });
+			return p;
+		};
+
+		for(auto r : by_stride(x))
+			if(std::find(y.labels.begin(), y.labels.end(), x.labels[r]) == y.labels.end())
+				phia.push_back(r+1);
+			else
+				contracted.push_back(r);
+		for(auto r : by_stride(y))
+			if(std::find(x.labels.begin(), x.labels.end(), y.labels[r]) == x.labels.end())
+				phib.push_back(r+1);
+
+		auto z = item{nullptr, {}, {}, {}, none};
+		for(auto r : phia) z.labels.push_back(x.labels[r-1]), z.extents.push_back(x.extents[r-1]);
+		for(auto r : phib) z.labels.push_back(y.labels[r-1]), z.extents.push_back(y.extents[r-1]);
+
+		for(auto r : contracted){
+			phia.push_back(r+1);
+			phib.push_back(std::size_t(std::find(y.labels.begin(), y.labels.end(), x.labels[r]) - y.labels.begin()) + 1);
+		}
+
+		value_type* out = nullptr;
+		if(last){
+			out = c.data();
+			for(auto l : z.labels)
+				z.strides.push_back(wc[l]);
+			written = true;
+		}
+		else{
+			// last free mode of the loop nest contiguous
+			z.strides.assign(z.labels.size(), 1u);
+			for(auto r = z.labels.size(); r > 1u; --r)
+				z.strides[r-2] = z.strides[r-1] * z.extents[r-1];
+			auto size = std::size_t(1);
+			for(auto e : z.extents)
+				size *= e;
+			z.buffer = acquire(size);
+			out = buffers[z.buffer].data();
+		}
+
+		auto const one = std::size_t(1);
+		ttt(x.labels.size(), y.labels.size(), contracted.size(),
+		    phia.data(), phib.data(),
+		    out, z.extents.empty() ? &one : z.extents.data(), z.strides.empty() ? &one : z.strides.data(),
+		    x.data, x.extents.data(), x.strides.data(),
+		    y.data, y.extents.data(), y.strides.data());
+
+		z.data = out;
+		release(x);
+		release(y);
+		items.push_back(std::move(z));
+	}
+
+	if(!written){
+		auto const& z = items.back();
+		if(z.labels.empty())
+			c(0) = *z.data;
+		else {
+			auto w = std::vector<std::size_t>{};
+			for(auto l : z.labels)
+				w.push_back(wc[l]);
+			copy(z.labels.size(), z.extents.data(), c.data(), w.data(), z.data, z.strides.data());
+		}
+	}
+
+	if(scale != value_type{1})
+		for(auto& v : c)
+			v *= scale;
+
+	return c;
+}
+
+} // namespace detail
+
+
+/** @brief Contracts two or more tensors in Einstein notation at once
+ *
+ * @code auto C = einsum( A(_i,_j,_k), v1(_i,_), v2(_j,_), v3(_k,_) ); @endcode
+ *
+ * Unlike a chain of operator*, which contracts pairs from left to right, the tensors are contracted
+ * in the pairwise order with the least multiply-adds. An index occurring in two multi-indices
+ * is contracted. The free indices of the result are those of the operands from left to right,
+ * padded to rank two, as with prod(a,b,phia,phib) for two operands.
+ *
+ * @note throws std::runtime_error if the extents of equal indices differ, an index occurs twice
+ * in a multi-index or in more than two multi-indices
+ *
+ * @param lhs first tensor with its multi-index, e.g. A(_i,_j)
+ * @param rhs further tensors with their multi-indices
+ * @returns tensor with the storage format and the array type of the first tensor
+*/
+template<class tensor_type_left, class tuple_type_left, class ... tensor_types_right, class ... tuple_types_right>
+auto einsum(std::pair<tensor_type_left const&, tuple_type_left> const& lhs,
+            std::pair<tensor_types_right const&, tuple_types_right> const& ... rhs)
+{
+	static_assert(sizeof...(rhs) > 0, "Static error in boost::numeric::ublas::einsum: at least two tensors must be contracted.");
+
+	using value_type  = typename tensor_type_left::value_type;
+	using tensor_type = tensor<value_type, typename tensor_type_left::layout_type, typename tensor_type_left::array_type, shape>;
+
+	auto free_label = std::numeric_limits<std::size_t>::max();
+	auto operands = std::vector<detail::multi_index_operand<value_type>>{};
+	operands.reserve(1 + sizeof...(rhs));
+	operands.push_back( detail::make_multi_index_operand<value_type>(lhs, free_label) );
+	( operands.push_back( detail::make_multi_index_operand<value_type>(rhs, free_label) ), ... );
+
+	return detail::contract<tensor_type>(operands);
+}
+
+} // namespace ublas
+} // namespace numeric
+} // namespace boost
+
+#endif
@@ -13,7 +13,16 @@
 #ifndef BOOST_UBLAS_TENSOR_MULTIPLICATION
 #define BOOST_UBLAS_TENSOR_MULTIPLICATION
 
+#include <algorithm>
 #include <cassert>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <boost/numeric/ublas/detail/config.hpp>
+#include <boost/numeric/ublas/detail/blas_backend.hpp>
 
 namespace boost {
 namespace numeric {
@@ -265,28 +274,29 @@ void ttm0( SizeType const r,
  * @param na pointer to the extents of input tensor a
  * @param wa pointer to the strides of input tensor a
  * @param b  pointer to the second input tensor
+ * @param wb stride of the input vector b
 */
 
 template <class PointerOut, class PointerIn1, class PointerIn2, class SizeType>
 void ttv( SizeType const m, SizeType const r, SizeType const q,
           PointerOut c, SizeType const*const nc, SizeType const*const wc,
           PointerIn1 a, SizeType const*const na, SizeType const*const wa,
-          PointerIn2 b)
+          PointerIn2 b, SizeType const wb = 1)
 {
 
 	if(r == m) {
-		ttv(m, r-1, q, c, nc, wc,    a, na, wa,    b);
+		ttv(m, r-1, q, c, nc, wc,    a, na, wa,    b, wb);
 	}
 	else if(r == 0){
 		for(auto i0 = 0u; i0 < na[0]; c += wc[0], a += wa[0], ++i0) {
 			auto c1 = c; auto a1 = a; auto b1 = b;
-			for(auto im = 0u; im < na[m]; a1 += wa[m], ++b1, ++im)
+			for(auto im = 0u; im < na[m]; a1 += wa[m], b1 += wb, ++im)
 				*c1 += *a1 * *b1;
 		}
 	}
 	else{
 		for(auto i = 0u; i < na[r]; c += wc[q], a += wa[r], ++i)
-			ttv(m, r-1, q-1, c, nc, wc,    a, na, wa,    b);
+			ttv(m, r-1, q-1, c, nc, wc,    a, na, wa,    b, wb);
 	}
 }
 
@@ -306,23 +316,24 @@ void ttv( SizeType const m, SizeType const r, SizeType const q,
  * @param na pointer to the extents of input tensor a
  * @param wa pointer to the strides of input tensor a
  * @param b  pointer to the second input tensor
+ * @param wb stride of the input vector b
 */
 template <class PointerOut, class PointerIn1, class PointerIn2, class SizeType>
 void ttv0(SizeType const r,
           PointerOut c, SizeType const*const nc, SizeType const*const wc,
           PointerIn1 a, SizeType const*const na, SizeType const*const wa,
-          PointerIn2 b)
+          PointerIn2 b, SizeType const wb = 1)
 {
 
 	if(r > 1){
 		for(auto i = 0u; i < na[r]; c += wc[r-1], a += wa[r], ++i)
-			ttv0(r-1, c, nc, wc,    a, na, wa,    b);
+			ttv0(r-1, c, nc, wc,    a, na, wa,    b, wb);
 	}
 	else{
 		for(auto i1 = 0u; i1 < na[1]; c += wc[0], a += wa[1], ++i1)
 		{
 			auto c1 = c; auto a1 = a; auto b1 = b;
-			for(auto i0 = 0u; i0 < na[0]; a1 += wa[0], ++b1, ++i0)
+			for(auto i0 = 0u; i0 < na[0]; a1 += wa[0], b1 += wb, ++i0)
 				*c1 += *a1 * *b1;
 		}
 	}
@@ -343,19 +354,20 @@ void ttv0(SizeType const r,
  * @param[in]  na pointer to the extents of input tensor A
  * @param[in]  wa pointer to the strides of input tensor A
  * @param[in]  b  pointer to the second input tensor B
+ * @param[in]  wb stride of the input vector b
 */
 template <class PointerOut, class PointerIn1, class PointerIn2, class SizeType>
 void mtv(SizeType const m,
          PointerOut c, SizeType const*const   , SizeType const*const wc,
          PointerIn1 a, SizeType const*const na, SizeType const*const wa,
-         PointerIn2 b)
+         PointerIn2 b, SizeType const wb = 1)
 {
 	// decides whether matrix multiplied with vector or vector multiplied with matrix
 	const auto o = (m == 0) ? 1 : 0;
 
 	for(auto io = 0u; io < na[o]; c += wc[o], a += wa[o], ++io) {
 		auto c1 = c; auto a1 = a; auto b1 = b;
-		for(auto im = 0u; im < na[m]; a1 += wa[m], ++b1, ++im)
+		for(auto im = 0u; im < na[m]; a1 += wa[m], b1 += wb, ++im)
 			*c1 += *a1 * *b1;
 	}
 }
@@ -582,6 +594,455 @@ void outer(SizeType const k,
 //////////////////////////////////////////////////////////////////////////////////////////
 
 
+namespace boost {
+namespace numeric {
+namespace ublas {
+namespace detail {
+namespace flat {
+
+/** @brief Checks if a tensor is stored contiguously in the first-order or, reversed, in the last-order format
+ *
+ * Strides of modes with extent one are not checked.
+ *
+ * @param p        number of modes
+ * @param n        pointer to the extents
+ * @param w        pointer to the strides
+ * @param reversed checks for the last-order format if true
+*/
+template <class SizeType>
+bool is_contiguous(SizeType const p, SizeType const*const n, SizeType const*const w, bool reversed)
+{
+	auto s = SizeType(1);
+	for(auto k = SizeType(0); k < p; ++k){
+		auto const r = reversed ? p-1-k : k;
+		if(n[r] != 1 && w[r] != s)
+			return false;
+		s *= n[r];
+	}
+	return true;
+}
+
+/** @brief Flattens the modes of a contiguous tensor before and after the contraction mode m
+ *
+ * @returns the pair (n0,n1) of the sizes of the modes stored before and after mode m in memory
+*/
+template <class SizeType>
+auto flatten(SizeType const m, SizeType const p, SizeType const*const n, bool reversed)
+{
+	auto n0 = SizeType(1), n1 = SizeType(1);
+	for(auto r = SizeType(0); r < m-1; ++r) n0 *= n[r];
+	for(auto r = m; r < p; ++r) n1 *= n[r];
+	if(reversed)
+		std::swap(n0,n1);
+	return std::make_pair(n0,n1);
+}
+
+
+#ifdef BOOST_UBLAS_USE_CBLAS
+template <class SizeType>
+bool fits_blas_int(SizeType const n)
+{
+	return n <= SizeType(std::numeric_limits<blas_int>::max());
+}
+
+/** @brief Computes c[i,j] += sum(a[i,k,j] * b[k]) with ?gemv, see ttv */
+template <class T, class SizeType>
+bool blas_ttv(SizeType const n0, SizeType const nm, SizeType const n1,
+              T* c, T const* a, T const* b, SizeType const wb)
+{
+	if constexpr (blas_types<T>::value) {
+		if(!fits_blas_int(n0*nm) || !fits_blas_int(n1) || !fits_blas_int(wb))
+			return false;
+		auto const one = T(1);
+		if(n0 == 1)
+			blas_types<T>::gemv(CblasColMajor, CblasTrans, blas_int(nm), blas_int(n1),
+			                    one, a, blas_int(nm), b, blas_int(wb), one, c, 1);
+		else
+			for(auto j = SizeType(0); j < n1; ++j)
+				blas_types<T>::gemv(CblasColMajor, CblasNoTrans, blas_int(n0), blas_int(nm),
+				                    one, a+j*n0*nm, blas_int(n0), b, blas_int(wb), one, c+j*n0, 1);
+		return true;
+	}
+	else
+		return false;
+}
+
+/** @brief Computes c[i,l,j] += sum(a[i,k,j] * b[l,k]) with ?gemm, see ttm */
+template <class T, class SizeType>
+bool blas_ttm(SizeType const n0, SizeType const nm, SizeType const n1, SizeType const nl,
+              T* c, T const* a, T const* b, SizeType const wb0, SizeType const wb1)
+{
+	if constexpr (blas_types<T>::value) {
+		if(!fits_blas_int(n0*nm) || !fits_blas_int(n0*nl) || !fits_blas_int(n1) || !fits_blas_int(nm*nl) || !fits_blas_int(wb0*wb1))
+			return false;
+
+		// b as a column-major matrix b or its transpose, any stride for extents one
+		auto const colmajor = wb0 == 1 || nl == 1;
+		auto const rowmajor = wb1 == 1 || nm == 1;
+		auto const ldb = colmajor ? (nm > 1 ? wb1 : nl) : (nl > 1 ? wb0 : nm);
+		if((!colmajor && !rowmajor) || ldb < (colmajor ? nl : nm))
+			return false;
+
+		auto const one = T(1);
+		if(n0 == 1)
+			// c = b * a with a as nm x n1 and c as nl x n1 matrix
+			blas_types<T>::gemm(CblasColMajor, colmajor ? CblasNoTrans : CblasTrans, CblasNoTrans,
+			                    blas_int(nl), blas_int(n1), blas_int(nm),
+			                    one, b, blas_int(ldb), a, blas_int(nm), one, c, blas_int(nl));
+		else
+			// c_j = a_j * b' for each slice j
+			for(auto j = SizeType(0); j < n1; ++j)
+				blas_types<T>::gemm(CblasColMajor, CblasNoTrans, colmajor ? CblasTrans : CblasNoTrans,
+				                    blas_int(n0), blas_int(nl), blas_int(nm),
+				                    one, a+j*n0*nm, blas_int(n0), b, blas_int(ldb), one, c+j*n0*nl, blas_int(n0));
+		return true;
+	}
+	else
+		return false;
+}
+#endif
+
+
+/** @brief Computes the tensor-times-vector product of a contiguous tensor
+ *
+ * Implements c[i,j] += sum(a[i,k,j] * b[k]) where a is flattened to an n0 x nm x n1 and c to an n0 x n1
+ * tensor in the first-order format. Contracting the first mode (n0 = 1) computes one dot product for
+ * each slice j. Otherwise slices are computed in the axpy form, the last mode (n1 = 1) in blocks of i.
+ *
+ * @note is used in function ttv, calls ?gemv with BOOST_UBLAS_USE_CBLAS
+ *
+ * @param n0 size of the modes before the contraction mode
+ * @param nm extent of the contraction mode
+ * @param n1 size of the modes after the contraction mode
+ * @param c  pointer to the output tensor
+ * @param a  pointer to the input tensor
+ * @param b  pointer to the input vector
+ * @param wb stride of the input vector
+*/
+template <class PointerOut, class PointerIn1, class PointerIn2, class SizeType>
+void ttv(SizeType const n0, SizeType const nm, SizeType const n1,
+         PointerOut c, PointerIn1 a, PointerIn2 b, SizeType const wb)
+{
+	using value_type = std::remove_cv_t<std::remove_pointer_t<PointerOut>>;
+
+#ifdef BOOST_UBLAS_USE_CBLAS
+	if constexpr (std::is_same<value_type, std::remove_cv_t<std::remove_pointer_t<PointerIn1>>>::value &&
+	              std::is_same<value_type, std::remove_cv_t<std::remove_pointer_t<PointerIn2>>>::value)
+		if(blas_ttv<value_type>(n0, nm, n1, c, a, b, wb))
+			return;
+#endif
+
+	if(n0 == 1){
+		auto const nj = std::ptrdiff_t(n1);
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel for schedule (static) if (n0*nm*n1 >= BOOST_UBLAS_PARALLEL_THRESHOLD)
+#endif
+		for(std::ptrdiff_t j = 0; j < nj; ++j){
+			auto aj = a + j*nm;
+			auto t = value_type{};
+			for(auto k = SizeType(0); k < nm; ++k)
+				t += aj[k] * b[k*wb];
+			c[j] += t;
+		}
+	}
+	else{
+		// threads own slices j or, for one slice, blocks of i
+		auto const block = n1 == 1 ? SizeType(512) : n0;
+		auto const ni = (n0 + block - 1) / block;
+		auto const nj = std::ptrdiff_t(ni*n1);
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel for schedule (static) if (n0*nm*n1 >= BOOST_UBLAS_PARALLEL_THRESHOLD)
+#endif
+		for(std::ptrdiff_t ij = 0; ij < nj; ++ij){
+			auto const j  = SizeType(ij) / ni;
+			auto const i0 = (SizeType(ij) % ni) * block;
+			auto const i1 = std::min(i0 + block, n0);
+			auto cj = c + j*n0;
+			auto aj = a + j*n0*nm;
+			for(auto k = SizeType(0); k < nm; ++k){
+				auto const bk = b[k*wb];
+				auto ak = aj + k*n0;
+				for(auto i = i0; i < i1; ++i)
+					cj[i] += ak[i] * bk;
+			}
+		}
+	}
+}
+
+
+/** @brief Computes the tensor-times-matrix product of a contiguous tensor
+ *
+ * Implements c[i,l,j] += sum(a[i,k,j] * b[l,k]) where a is flattened to an n0 x nm x n1 and c to an
+ * n0 x nl x n1 tensor in the first-order format. Contracting the first mode (n0 = 1) is the matrix
+ * product b * a. Otherwise each slice j is the product a_j * b', computed column by column of c_j.
+ *
+ * @note is used in function ttm, calls ?gemm with BOOST_UBLAS_USE_CBLAS
+ *
+ * @param n0  size of the modes before the contraction mode
+ * @param nm  extent of the contraction mode
+ * @param n1  size of the modes after the contraction mode
+ * @param nl  number of rows of the input matrix
+ * @param c   pointer to the output tensor
+ * @param a   pointer to the input tensor
+ * @param b   pointer to the input matrix
+ * @param wb0 row stride of the input matrix
+ * @param wb1 column stride of the input matrix
+*/
+template <class PointerOut, class PointerIn1, class PointerIn2, class SizeType>
+void ttm(SizeType const n0, SizeType const nm, SizeType const n1, SizeType const nl,
+         PointerOut c, PointerIn1 a, PointerIn2 b, SizeType const wb0, SizeType const wb1)
+{
+#ifdef BOOST_UBLAS_USE_CBLAS
+	using value_type = std::remove_cv_t<std::remove_pointer_t<PointerOut>>;
+	if constexpr (std::is_same<value_type, std::remove_cv_t<std::remove_pointer_t<PointerIn1>>>::value &&
+	              std::is_same<value_type, std::remove_cv_t<std::remove_pointer_t<PointerIn2>>>::value)
+		if(blas_ttm<value_type>(n0, nm, n1, nl, c, a, b, wb0, wb1))
+			return;
+#endif
+
+	if(n0 == 1){
+		// b is packed column by column unless its columns are contiguous
+		using value_type = std::remove_cv_t<std::remove_pointer_t<PointerIn2>>;
+		auto packed = std::vector<value_type>{};
+		if(wb0 != 1 && nl > 1){
+			packed.resize(nl*nm);
+			for(auto k = SizeType(0); k < nm; ++k)
+				for(auto l = SizeType(0); l < nl; ++l)
+					packed[k*nl+l] = b[l*wb0 + k*wb1];
+		}
+		auto const bp  = packed.empty() ? b : packed.data();
+		auto const wbk = packed.empty() ? wb1 : nl;
+
+		auto const nj = std::ptrdiff_t(n1);
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel for schedule (static) if (n0*nm*n1*nl >= BOOST_UBLAS_PARALLEL_THRESHOLD)
+#endif
+		for(std::ptrdiff_t j = 0; j < nj; ++j){
+			auto cj = c + j*nl;
+			auto aj = a + j*nm;
+			for(auto k = SizeType(0); k < nm; ++k){
+				auto const ak = aj[k];
+				auto bk = bp + k*wbk;
+				for(auto l = SizeType(0); l < nl; ++l)
+					cj[l] += bk[l] * ak;
+			}
+		}
+	}
+	else{
+		// threads own blocks of four columns l of slices j, which share the loads of a
+		auto const nlb = (nl + 3) / 4;
+		auto const njl = std::ptrdiff_t(n1*nlb);
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel for schedule (static) if (n0*nm*n1*nl >= BOOST_UBLAS_PARALLEL_THRESHOLD)
+#endif
+		for(std::ptrdiff_t jl = 0; jl < njl; ++jl){
+			auto const j = SizeType(jl) / nlb;
+			auto l = SizeType(jl) % nlb * 4;
+			auto cjl = c + (j*nl + l)*n0;
+			auto aj  = a + j*n0*nm;
+			auto bl  = b + l*wb0;
+			if(l + 4 <= nl){
+				for(auto k = SizeType(0); k < nm; ++k){
+					auto const b0 = bl[k*wb1], b1 = bl[wb0+k*wb1], b2 = bl[2*wb0+k*wb1], b3 = bl[3*wb0+k*wb1];
+					auto ak = aj + k*n0;
+					for(auto i = SizeType(0); i < n0; ++i){
+						auto const aik = ak[i];
+						cjl[i]      += aik * b0;
+						cjl[i+n0]   += aik * b1;
+						cjl[i+2*n0] += aik * b2;
+						cjl[i+3*n0] += aik * b3;
+					}
+				}
+			}
+			else{
+				for(; l < nl; ++l, cjl += n0, bl += wb0)
+					for(auto k = SizeType(0); k < nm; ++k){
+						auto const blk = bl[k*wb1];
+						auto ak = aj + k*n0;
+						for(auto i = SizeType(0); i < n0; ++i)
+							cjl[i] += ak[i] * blk;
+					}
+			}
+		}
+	}
+}
+
+} // namespace flat
+
+namespace batched {
+
+/** @brief Returns the offsets of all multi-indices of the extents n for the strides w, the first index running fastest */
+template <class SizeType>
+std::vector<SizeType> offsets(std::vector<SizeType> const& n, std::vector<SizeType> const& w)
+{
+	auto o = std::vector<SizeType>{SizeType(0)};
+	for(auto k = 0u; k < n.size(); ++k){
+		auto const size = o.size();
+		o.resize(size*n[k]);
+		for(auto i = SizeType(1); i < n[k]; ++i)
+			for(auto j = SizeType(0); j < size; ++j)
+				o[i*size+j] = o[j] + i*w[k];
+	}
+	return o;
+}
+
+/** @brief Returns the distance between consecutive offsets if they are equidistant and start at zero, else zero */
+template <class SizeType>
+SizeType stride(std::vector<SizeType> const& o)
+{
+	auto const w = o.size() > 1 ? o[1] : SizeType(1);
+	for(auto i = SizeType(0); i < o.size(); ++i)
+		if(o[i] != i*w)
+			return SizeType(0);
+	return w;
+}
+
+/** @brief Computes the tensor-times-tensor products of all slices k of a batch
+ *
+ * Implements C_k[i,j] += sum(A_k[i,l] * B_k[l,j]) for 0 <= k < batch, where i, j and l are the flattened
+ * free modes of A, the free modes of B and the contraction modes, given by the offsets of their multi-indices
+ * within a slice. The offsets are computed once for the whole batch. Slices are small and computed in the
+ * axpy form by one thread each, with the offsets of j replaced by strides if they are equidistant. The roles
+ * of A and B are swapped if i instead of j is contiguous in C.
+ *
+ * @note is used in function batched_prod
+ *
+ * @param batch number of slices
+ * @param ci offsets of the multi-indices i in C_k
+ * @param cj offsets of the multi-indices j in C_k
+ * @param ai offsets of the multi-indices i in A_k
+ * @param al offsets of the multi-indices l in A_k
+ * @param bl offsets of the multi-indices l in B_k
+ * @param bj offsets of the multi-indices j in B_k
+ * @param c  pointer to the output tensor
+ * @param wc stride between the slices of C
+ * @param a  pointer to the first input tensor
+ * @param wa stride between the slices of A
+ * @param b  pointer to the second input tensor
+ * @param wb stride between the slices of B
+*/
+template <class PointerOut, class PointerIn1, class PointerIn2, class SizeType>
+void ttt(SizeType const batch,
+         std::vector<SizeType> const& ci, std::vector<SizeType> const& cj,
+         std::vector<SizeType> const& ai, std::vector<SizeType> const& al,
+         std::vector<SizeType> const& bl, std::vector<SizeType> const& bj,
+         PointerOut c, SizeType const wc,
+         PointerIn1 a, SizeType const wa,
+         PointerIn2 b, SizeType const wb)
+{
+	// the inner loop runs over the multi-indices that are contiguous in C, C_k^T = B_k^T * A_k^T
+	if(stride(ci) == 1 && stride(cj) != 1)
+		return ttt(batch, cj, ci, bj, bl, al, ai, c, wc, b, wb, a, wa);
+
+	auto const ni = ai.size(), nj = bj.size(), nl = al.size();
+	auto const wcj = stride(cj), wbj = stride(bj);
+	auto const strided = wcj != 0 && wbj != 0;
+	auto const contiguous = wcj == 1 && wbj == 1;
+
+	auto const nk = std::ptrdiff_t(batch);
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel for schedule (static) if (batch*ni*nj*nl >= BOOST_UBLAS_PARALLEL_THRESHOLD)
+#endif
+	for(std::ptrdiff_t k = 0; k < nk; ++k){
+		auto const ck = c + k*wc;
+		auto const ak = a + k*wa;
+		auto const bk = b + k*wb;
+		for(auto i = SizeType(0); i < ni; ++i){
+			auto const cki = ck + ci[i];
+			auto const aki = ak + ai[i];
+			for(auto l = SizeType(0); l < nl; ++l){
+				auto const v = aki[al[l]];
+				auto const bkl = bk + bl[l];
+				if(contiguous)
+					for(auto j = SizeType(0); j < nj; ++j)
+						cki[j] += v * bkl[j];
+				else if(strided)
+					for(auto j = SizeType(0); j < nj; ++j)
+						cki[j*wcj] += v * bkl[j*wbj];
+				else
+					for(auto j = SizeType(0); j < nj; ++j)
+						cki[cj[j]] += v * bkl[bj[j]];
+			}
+		}
+	}
+}
+
+} // namespace batched
+
+
+namespace split_complex {
+
+/** @brief Computes the tensor-times-tensor product of split-complex tensors
+ *
+ * Implements C[i,j] += sum(A[i,l] * B[l,j]) for complex elements whose real and imaginary parts are stored in
+ * separate planes with the same strides, where i, j and l are the flattened free modes of A, the free modes of B
+ * and the contraction modes, given by the offsets of their multi-indices, see batched::ttt. The inner loop runs
+ * over j and computes real(C) += real(A)*real(B) - imag(A)*imag(B) and imag(C) += real(A)*imag(B) + imag(A)*real(B)
+ * with real arithmetic on the planes, which compilers vectorize for contiguous j. Rows i are computed in parallel.
+ *
+ * @note is used in function prod of split_complex_tensor
+ *
+ * @param ci offsets of the multi-indices i in C
+ * @param cj offsets of the multi-indices j in C
+ * @param ai offsets of the multi-indices i in A
+ * @param al offsets of the multi-indices l in A
+ * @param bl offsets of the multi-indices l in B
+ * @param bj offsets of the multi-indices j in B
+ * @param cr pointer to the real plane of the output tensor
+ * @param cm pointer to the imaginary plane of the output tensor
+ * @param ar pointer to the real plane of the first input tensor
+ * @param am pointer to the imaginary plane of the first input tensor
+ * @param br pointer to the real plane of the second input tensor
+ * @param bm pointer to the imaginary plane of the second input tensor
+*/
+template <class PointerOut, class PointerIn1, class PointerIn2, class SizeType>
+void ttt(std::vector<SizeType> const& ci, std::vector<SizeType> const& cj,
+         std::vector<SizeType> const& ai, std::vector<SizeType> const& al,
+         std::vector<SizeType> const& bl, std::vector<SizeType> const& bj,
+         PointerOut cr, PointerOut cm,
+         PointerIn1 ar, PointerIn1 am,
+         PointerIn2 br, PointerIn2 bm)
+{
+	// the inner loop runs over the multi-indices that are contiguous in C, C^T = B^T * A^T
+	if(batched::stride(ci) == 1 && batched::stride(cj) != 1)
+		return ttt(cj, ci, bj, bl, al, ai, cr, cm, br, bm, ar, am);
+
+	auto const ni = ai.size(), nj = bj.size(), nl = al.size();
+	auto const wcj = batched::stride(cj), wbj = batched::stride(bj);
+	auto const contiguous = wcj == 1 && wbj == 1;
+
+	auto const n = std::ptrdiff_t(ni);
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel for schedule (static) if (ni*nj*nl >= BOOST_UBLAS_PARALLEL_THRESHOLD)
+#endif
+	for(std::ptrdiff_t i = 0; i < n; ++i){
+		auto const cri = cr + ci[i], cmi = cm + ci[i];
+		auto const ari = ar + ai[i], ami = am + ai[i];
+		for(auto l = SizeType(0); l < nl; ++l){
+			auto const vr = ari[al[l]], vm = ami[al[l]];
+			auto const brl = br + bl[l], bml = bm + bl[l];
+			if(contiguous)
+				for(auto j = SizeType(0); j < nj; ++j){
+					cri[j] += vr * brl[j] - vm * bml[j];
+					cmi[j] += vr * bml[j] + vm * brl[j];
+				}
+			else
+				for(auto j = SizeType(0); j < nj; ++j){
+					cri[cj[j]] += vr * brl[bj[j]] - vm * bml[bj[j]];
+					cmi[cj[j]] += vr * bml[bj[j]] + vm * brl[bj[j]];
+				}
+		}
+	}
+}
+
+} // namespace split_complex
+} // namespace detail
+} // namespace ublas
+} // namespace numeric
+} // namespace boost
+
+
+
 #include <stdexcept>
 
 namespace boost {
@@ -594,7 +1055,7 @@ namespace ublas {
  *   C[i1,i2,...,im-1,im+1,...,ip] = sum(A[i1,i2,...,im,...,ip] * b[im]) for m>1 and
  *   C[i2,...,ip]                  = sum(A[i1,...,ip]           * b[i1]) for m=1
  *
- * @note calls detail::ttv, detail::ttv0 or detail::mtv
+ * @note calls detail::flat::ttv for contiguous tensors, else detail::ttv, detail::ttv0 or detail::mtv
  *
  * @param[in]  m  contraction mode with 0 < m <= p
  * @param[in]  p  number of dimensions (rank) of the first input tensor with p > 0
@@ -642,12 +1103,24 @@ void ttv(SizeType const m, SizeType const p,
 		throw std::length_error("Error in boost::numeric::ublas::ttv: Extent of dimension mode of A and b must be equal.");
 
 
+	// b is an nb[0] x nb[1] tensor with one extent equal to 1
+	const auto sb = nb[0] == max ? wb[0] : wb[1];
+
+	// contiguous tensors are flattened to a matrix or a sequence of matrices
+	if(p > 1)
+		for(auto reversed : {false, true})
+			if(detail::flat::is_contiguous(p, na, wa, reversed) && detail::flat::is_contiguous(p-1, nc, wc, reversed)){
+				auto const n = detail::flat::flatten(m, p, na, reversed);
+				detail::flat::ttv(n.first, na[m-1], n.second, c, a, b, sb);
+				return;
+			}
+
 	if((m != 1) && (p > 2))
-		detail::recursive::ttv(m-1, p-1, p-2, c, nc, wc,    a, na, wa,   b);
+		detail::recursive::ttv(m-1, p-1, p-2, c, nc, wc,    a, na, wa,   b, sb);
 	else if ((m == 1) && (p > 2))
-		detail::recursive::ttv0(p-1, c, nc, wc,  a, na, wa,   b);
+		detail::recursive::ttv0(p-1, c, nc, wc,  a, na, wa,   b, sb);
 	else if( p == 2 )
-		detail::recursive::mtv(m-1, c, nc, wc,  a, na, wa,   b);
+		detail::recursive::mtv(m-1, c, nc, wc,  a, na, wa,   b, sb);
 	else /*if( p == 1 )*/{
 		auto v = std::remove_pointer_t<std::remove_cv_t<PointerOut>>{};
 		*c = detail::recursive::inner(SizeType(0), na, a, wa, b, wb, v);
@@ -663,7 +1136,7 @@ void ttv(SizeType const m, SizeType const p,
  *   C[i1,i2,...,im-1,j,im+1,...,ip] = sum(A[i1,i2,...,im,...,ip] * B[j,im]) for m>1 and
  *   C[j,i2,...,ip]                  = sum(A[i1,i2,...,ip]        * B[j,i1]) for m=1
  *
- * @note calls detail::ttm or detail::ttm0
+ * @note calls detail::flat::ttm for contiguous tensors, else detail::ttm or detail::ttm0
  *
  * @param[in]  m  contraction mode with 0 < m <= p
  * @param[in]  p  number of dimensions (rank) of the first input tensor with p > 0
@@ -714,6 +1187,14 @@ void ttm(SizeType const m, SizeType const p,
 	if(nc[m-1] != nb[0])
 		throw std::length_error("Error in boost::numeric::ublas::ttm: 1nd Extent of B and M-th Extent of C must be the equal.");
 
+	// contiguous tensors are flattened to a matrix or a sequence of matrices
+	for(auto reversed : {false, true})
+		if(detail::flat::is_contiguous(p, na, wa, reversed) && detail::flat::is_contiguous(p, nc, wc, reversed)){
+			auto const n = detail::flat::flatten(m, p, na, reversed);
+			detail::flat::ttm(n.first, na[m-1], n.second, nb[0], c, a, b, wb[0], wb[1]);
+			return;
+		}
+
 	if ( m != 1 )
 		detail::recursive::ttm (m-1, p-1, c, nc, wc,    a, na, wa,   b, nb, wb);
 	else /*if (m == 1 && p >  2)*/
@@ -26,7 +26,7 @@ namespace numeric{
 namespace ublas {
 
 
-template<class element_type, class storage_format, class storage_type>
+template<class element_type, class storage_format, class storage_type, class extents_type>
 class tensor;
 
 template<class E>
@@ -97,6 +97,48 @@ auto operator/( boost::numeric::ublas::detail::tensor_expression<T,L> const& lhs
 }
 
 
+namespace boost::numeric::ublas::detail {
+
+/** @brief True if T1 and T2 are tensor types with the same value type in different layouts */
+template<class T1, class T2>
+struct is_mixed_layout_pair : std::false_type {};
+
+template<class V, class F1, class A1, class E1, class F2, class A2, class E2>
+struct is_mixed_layout_pair<tensor<V,F1,A1,E1>, tensor<V,F2,A2,E2>>
+	: std::integral_constant<bool, !std::is_same<F1,F2>::value> {};
+
+template<class T1, class T2>
+using enable_if_mixed_layout_pair_t = std::enable_if_t<is_mixed_layout_pair<T1,T2>::value,int>;
+
+/// @brief helper function to simply instantiation of lambda proxy class with operands in different layouts
+template<class T, class TR, class EL, class ER, class OP>
+auto make_mixed_binary_tensor_expression( tensor_expression<T,EL> const& el, tensor_expression<TR,ER> const& er, OP op)
+{
+	return mixed_binary_tensor_expression<T,TR,EL,ER,OP>( el(), er(), op, retrieve_extents(er) ) ;
+}
+
+} // namespace boost::numeric::ublas::detail
+
+
+// Overloaded Arithmetic Operators for operands in different layouts, the result has the layout of the left-hand side
+template<class T1, class T2, class L, class R, boost::numeric::ublas::detail::enable_if_mixed_layout_pair_t<T1,T2> = 0>
+auto operator+( boost::numeric::ublas::detail::tensor_expression<T1,L> const& lhs, boost::numeric::ublas::detail::tensor_expression<T2,R> const& rhs) {
+	return boost::numeric::ublas::detail::make_mixed_binary_tensor_expression (lhs, rhs, [](auto const& l, auto const& r){ return l + r; });
+}
+template<class T1, class T2, class L, class R, boost::numeric::ublas::detail::enable_if_mixed_layout_pair_t<T1,T2> = 0>
+auto operator-( boost::numeric::ublas::detail::tensor_expression<T1,L> const& lhs, boost::numeric::ublas::detail::tensor_expression<T2,R> const& rhs) {
+	return boost::numeric::ublas::detail::make_mixed_binary_tensor_expression (lhs, rhs, [](auto const& l, auto const& r){ return l - r; });
+}
+template<class T1, class T2, class L, class R, boost::numeric::ublas::detail::enable_if_mixed_layout_pair_t<T1,T2> = 0>
+auto operator*( boost::numeric::ublas::detail::tensor_expression<T1,L> const& lhs, boost::numeric::ublas::detail::tensor_expression<T2,R> const& rhs) {
+	return boost::numeric::ublas::detail::make_mixed_binary_tensor_expression (lhs, rhs, [](auto const& l, auto const& r){ return l * r; });
+}
+template<class T1, class T2, class L, class R, boost::numeric::ublas::detail::enable_if_mixed_layout_pair_t<T1,T2> = 0>
+auto operator/( boost::numeric::ublas::detail::tensor_expression<T1,L> const& lhs, boost::numeric::ublas::detail::tensor_expression<T2,R> const& rhs) {
+	return boost::numeric::ublas::detail::make_mixed_binary_tensor_expression (lhs, rhs, [](auto const& l, auto const& r){ return l / r; });
+}
+
+
 // Overloaded Arithmetic Operators with Scalars
 template<class T, class R>
 auto operator+(typename T::const_reference lhs, boost::numeric::ublas::detail::tensor_expression<T,R> const& rhs) {
@@ -161,28 +203,49 @@ auto& operator /= (T& lhs, const boost::numeric::ublas::detail::tensor_expressio
 }
 
 
+template<class T, class T2, class D, boost::numeric::ublas::detail::enable_if_mixed_layout_pair_t<T,T2> = 0>
+auto& operator += (T& lhs, const boost::numeric::ublas::detail::tensor_expression<T2,D> &expr) {
+	return lhs = lhs + expr;
+}
+
+template<class T, class T2, class D, boost::numeric::ublas::detail::enable_if_mixed_layout_pair_t<T,T2> = 0>
+auto& operator -= (T& lhs, const boost::numeric::ublas::detail::tensor_expression<T2,D> &expr) {
+	return lhs = lhs - expr;
+}
+
+template<class T, class T2, class D, boost::numeric::ublas::detail::enable_if_mixed_layout_pair_t<T,T2> = 0>
+auto& operator *= (T& lhs, const boost::numeric::ublas::detail::tensor_expression<T2,D> &expr) {
+	return lhs = lhs * expr;
+}
+
+template<class T, class T2, class D, boost::numeric::ublas::detail::enable_if_mixed_layout_pair_t<T,T2> = 0>
+auto& operator /= (T& lhs, const boost::numeric::ublas::detail::tensor_expression<T2,D> &expr) {
+	return lhs = lhs / expr;
+}
+
+
 
 
-template<class E, class F, class A>
-auto& operator += (boost::numeric::ublas::tensor<E,F,A>& lhs, typename boost::numeric::ublas::tensor<E,F,A>::const_reference r) {
+template<class E, class F, class A, class S>
+auto& operator += (boost::numeric::ublas::tensor<E,F,A,S>& lhs, typename boost::numeric::ublas::tensor<E,F,A,S>::const_reference r) {
 	boost::numeric::ublas::detail::eval(lhs, [r](auto& l) { l+=r; } );
 	return lhs;
 }
 
-template<class E, class F, class A>
-auto& operator -= (boost::numeric::ublas::tensor<E,F,A>& lhs, typename boost::numeric::ublas::tensor<E,F,A>::const_reference r) {
+template<class E, class F, class A, class S>
+auto& operator -= (boost::numeric::ublas::tensor<E,F,A,S>& lhs, typename boost::numeric::ublas::tensor<E,F,A,S>::const_reference r) {
 	boost::numeric::ublas::detail::eval(lhs, [r](auto& l) { l-=r; } );
 	return lhs;
 }
 
-template<class E, class F, class A>
-auto& operator *= (boost::numeric::ublas::tensor<E,F,A>& lhs, typename boost::numeric::ublas::tensor<E,F,A>::const_reference r) {
+template<class E, class F, class A, class S>
+auto& operator *= (boost::numeric::ublas::tensor<E,F,A,S>& lhs, typename boost::numeric::ublas::tensor<E,F,A,S>::const_reference r) {
 	boost::numeric::ublas::detail::eval(lhs, [r](auto& l) { l*=r; } );
 	return lhs;
 }
 
-template<class E, class F, class A>
-auto& operator /= (boost::numeric::ublas::tensor<E,F,A>& lhs, typename boost::numeric::ublas::tensor<E,F,A>::const_reference r) {
+template<class E, class F, class A, class S>
+auto& operator /= (boost::numeric::ublas::tensor<E,F,A,S>& lhs, typename boost::numeric::ublas::tensor<E,F,A,S>::const_reference r) {
 	boost::numeric::ublas::detail::eval(lhs, [r](auto& l) { l/=r; } );
 	return lhs;
 }
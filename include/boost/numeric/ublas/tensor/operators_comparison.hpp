@@ -14,71 +14,49 @@
 
 #include <boost/numeric/ublas/tensor/expression.hpp>
 #include <boost/numeric/ublas/tensor/expression_evaluation.hpp>
+#include <boost/numeric/ublas/detail/reduction.hpp>
 #include <type_traits>
 #include <functional>
 
 namespace boost::numeric::ublas {
-template<class element_type, class storage_format, class storage_type>
+template<class element_type, class storage_format, class storage_type, class extents_type>
 class tensor;
 }
 
 namespace boost::numeric::ublas::detail {
 
-template<class T, class F, class A, class BinaryPred>
-bool compare(tensor<T,F,A> const& lhs, tensor<T,F,A> const& rhs, BinaryPred pred)
+/** @brief Compares two tensor expressions elementwise without evaluating them into tensors
+ *
+ * Elements are evaluated and compared in chunks, in parallel, until a chunk fails.
+*/
+template<class T, class L, class R, class BinaryPred>
+bool compare(tensor_expression<T,L> const& lhs, tensor_expression<T,R> const& rhs, BinaryPred pred)
 {
-
-	if(lhs.extents() != rhs.extents()){
+	if(retrieve_extents(lhs) != retrieve_extents(rhs)){
 		if constexpr(!std::is_same<BinaryPred,std::equal_to<>>::value && !std::is_same<BinaryPred,std::not_equal_to<>>::value)
 			throw std::runtime_error("Error in boost::numeric::ublas::detail::compare: cannot compare tensors with different shapes.");
 		else
 			return false;
 	}
 
-	if constexpr(std::is_same<BinaryPred,std::greater<>>::value || std::is_same<BinaryPred,std::less<>>::value)
-		if(lhs.empty())
-			return false;
+	auto const size = expression_size(lhs, "detail::compare");
+	expression_size(rhs, "detail::compare");
 
-	for(auto i = 0u; i < lhs.size(); ++i)
-		if(!pred(lhs(i), rhs(i)))
-			return false;
-	return true;
-}
-
-template<class T, class F, class A, class UnaryPred>
-bool compare(tensor<T,F,A> const& rhs, UnaryPred pred)
-{
-	for(auto i = 0u; i < rhs.size(); ++i)
-		if(!pred(rhs(i)))
+	if constexpr(std::is_same<BinaryPred,std::greater<>>::value || std::is_same<BinaryPred,std::less<>>::value)
+		if(size == 0u)
 			return false;
-	return true;
-}
-
-
-template<class T, class L, class R, class BinaryPred>
-bool compare(tensor_expression<T,L> const& lhs, tensor_expression<T,R> const& rhs, BinaryPred pred)
-{
-	constexpr bool lhs_is_tensor = std::is_same<T,L>::value;
-	constexpr bool rhs_is_tensor = std::is_same<T,R>::value;
-
-	if constexpr (lhs_is_tensor && rhs_is_tensor)
-		return compare(static_cast<T const&>( lhs ), static_cast<T const&>( rhs ), pred);
-	else if constexpr (lhs_is_tensor && !rhs_is_tensor)
-		return compare(static_cast<T const&>( lhs ), T( rhs ), pred);
-	else if constexpr (!lhs_is_tensor && rhs_is_tensor)
-		return compare(T( lhs ), static_cast<T const&>( rhs ), pred);
-	else
-		return compare(T( lhs ), T( rhs ), pred);
 
+	auto const& l = lhs();
+	auto const& r = rhs();
+	return reduce_all( [&l,&r,&pred](auto i){ return pred(l(i), r(i)); }, size );
 }
 
+/** @brief Tests all elements of a tensor expression without evaluating it into a tensor */
 template<class T, class D, class UnaryPred>
 bool compare(tensor_expression<T,D> const& expr, UnaryPred pred)
 {
-	if constexpr (std::is_same<T,D>::value)
-		return compare(static_cast<T const&>( expr ), pred);
-	else
-		return compare(T( expr ), pred);
+	auto const& e = expr();
+	return reduce_all( [&e,&pred](auto i){ return pred(e(i)); }, expression_size(expr, "detail::compare") );
 }
 
 }
@@ -79,7 +79,7 @@ namespace boost {
 namespace numeric {
 namespace ublas {
 
-template<class T, class F, class A>
+template<class T, class F, class A, class E>
 class tensor;
 
 template<class T, class F, class A>
@@ -93,8 +93,8 @@ class vector;
 }
 
 
-template <class V, class F, class A>
-std::ostream& operator << (std::ostream& out, boost::numeric::ublas::tensor<V,F,A> const& t)
+template <class V, class F, class A, class E>
+std::ostream& operator << (std::ostream& out, boost::numeric::ublas::tensor<V,F,A,E> const& t)
 {
 
 	if(t.extents().is_scalar()){
@@ -0,0 +1,374 @@
+//
+//  Copyright (c) 2019
+//  The Boost.uBLAS developers
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file sparse_multiplication.hpp Products of compressed sparse tensors with vectors and matrices
+
+
+#ifndef BOOST_UBLAS_TENSOR_SPARSE_MULTIPLICATION_HPP
+#define BOOST_UBLAS_TENSOR_SPARSE_MULTIPLICATION_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "sparse_tensor.hpp"
+#include "../detail/config.hpp"
+#include "../expression_types.hpp"
+#include "../matrix.hpp"
+
+namespace boost { namespace numeric { namespace ublas {
+namespace detail { namespace sparse {
+
+/** @brief Returns a, or a copy compressed with mode m at the last level */
+template<class T, class I>
+compressed_tensor<T,I> const& with_last_mode(compressed_tensor<T,I> const& a, std::size_t m, compressed_tensor<T,I>& buffer)
+{
+	if(a.modes().back() == m)
+		return a;
+	auto modes = a.modes();
+	modes.erase(std::find(modes.begin(), modes.end(), m));
+	modes.push_back(m);
+	buffer = compressed_tensor<T,I>(coordinate_tensor<T,I>(a), modes);
+	return buffer;
+}
+
+/** @brief Calls fn(k) for the nodes k of level l, in parallel over the top-level fibers */
+template<class T, class I, class unary_fn>
+void for_each_node(compressed_tensor<T,I> const& a, std::size_t l, unary_fn fn)
+{
+	auto const nr = std::ptrdiff_t(a.fibers(0));
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel for schedule (dynamic, 16) if (a.nnz() >= BOOST_UBLAS_PARALLEL_THRESHOLD)
+#endif
+	for(std::ptrdiff_t r = 0; r < nr; ++r){
+		auto k0 = std::size_t(r), k1 = std::size_t(r)+1;
+		for(auto q = std::size_t(0); q < l; ++q)
+			k0 = a.pointer_data(q)[k0], k1 = a.pointer_data(q)[k1];
+		for(auto k = k0; k < k1; ++k)
+			fn(k);
+	}
+}
+
+/** @brief Spin locks guarding rows updated by several threads, row i by lock i modulo their number */
+using row_locks = std::vector<std::atomic<int>>;
+
+/** @brief Sums the elements below node k of level l times the factor rows of the levels l,...,p-1 but level ll
+ *
+ * @param f     row-major factor matrices of the modes with R columns
+ * @param out   R results
+ * @param work  (p-l)*R temporaries
+*/
+template<class T, class I>
+void mttkrp_sum(compressed_tensor<T,I> const& a, std::vector<std::vector<T>> const& f, std::size_t R, std::size_t ll,
+                std::size_t l, std::size_t k, T* out, T* work)
+{
+	auto const p = a.rank();
+	auto const& val = a.value_data();
+
+	if(l+1 == p){
+		auto const v = val[k];
+		if(l == ll)
+			std::fill(out, out+R, v);
+		else
+			for(auto r = std::size_t(0), i = std::size_t(a.index_data(l)[k])*R; r < R; ++r)
+				out[r] = v * f[a.modes()[l]-1][i+r];
+		return;
+	}
+
+	std::fill(out, out+R, T{});
+	auto const c0 = a.pointer_data(l)[k];
+	auto const c1 = a.pointer_data(l)[k+1];
+	if(l+2 == p && l+1 != ll){
+		// children are elements, summed in the axpy form
+		auto const& idx = a.index_data(l+1);
+		auto const g = f[a.modes()[l+1]-1].data();
+		for(auto c = c0; c < c1; ++c){
+			auto const v = val[c];
+			auto const gc = g + std::size_t(idx[c])*R;
+			for(auto r = std::size_t(0); r < R; ++r)
+				out[r] += v * gc[r];
+		}
+	}
+	else{
+		for(auto c = c0; c < c1; ++c){
+			mttkrp_sum(a, f, R, ll, l+1, c, work, work+R);
+			for(auto r = std::size_t(0); r < R; ++r)
+				out[r] += work[r];
+		}
+	}
+
+	if(l != ll){
+		auto const g = f[a.modes()[l]-1].data() + std::size_t(a.index_data(l)[k])*R;
+		for(auto r = std::size_t(0); r < R; ++r)
+			out[r] *= g[r];
+	}
+}
+
+/** @brief Adds the contributions of node k of level l to the rows of the result c
+ *
+ * @param pre   product of the factor rows of the levels 0,...,l-1, nullptr for l = 0
+ * @param work  (p+1-l)*R temporaries
+ * @param locks locks of the rows of c if they are updated by several threads, else nullptr
+*/
+template<class T, class I>
+void mttkrp_node(compressed_tensor<T,I> const& a, std::vector<std::vector<T>> const& f, std::size_t R, std::size_t ll,
+                 std::size_t l, std::size_t k, T const* pre, T* work, T* c, row_locks* locks)
+{
+	auto const i = std::size_t(a.index_data(l)[k]);
+
+	if(l == ll){
+		mttkrp_sum(a, f, R, ll, l, k, work, work+R);
+		auto ci = c + i*R;
+		auto lock = locks ? &(*locks)[i % locks->size()] : nullptr;
+		if(lock)
+			while(lock->exchange(1, std::memory_order_acquire) != 0)
+				;
+		for(auto r = std::size_t(0); r < R; ++r)
+			ci[r] += pre ? pre[r]*work[r] : work[r];
+		if(lock)
+			lock->store(0, std::memory_order_release);
+		return;
+	}
+
+	auto const g = f[a.modes()[l]-1].data() + i*R;
+	for(auto r = std::size_t(0); r < R; ++r)
+		work[r] = pre ? pre[r]*g[r] : g[r];
+	for(auto c0 = a.pointer_data(l)[k]; c0 < a.pointer_data(l)[k+1]; ++c0)
+		mttkrp_node(a, f, R, ll, l+1, c0, work, work+R, c, locks);
+}
+
+}} // namespace detail::sparse
+
+
+/** @brief Computes the m-mode product of a compressed sparse tensor and a vector
+ *
+ * Implements C[i1,...,im-1,im+1,...,ip] = sum(A[i1,i2,...,ip] * b[im]) for the stored elements of A.
+ * The fibers of mode m are summed in parallel over the top-level fibers, A is compressed with mode m
+ * at its last level first if necessary. C keeps a stored element for every fiber of A.
+ *
+ * @param[in] a compressed sparse tensor A with order p
+ * @param[in] b vector of size na[m-1]
+ * @param[in] m contraction mode with 1 <= m <= p
+ *
+ * @returns compressed sparse tensor with order p-1, padded with a mode of extent one to order two
+*/
+template<class T, class I, class E>
+auto prod(compressed_tensor<T,I> const& a, vector_expression<E> const& be, const std::size_t m)
+{
+	using tensor_type = compressed_tensor<T,I>;
+	using size_type   = typename tensor_type::size_type;
+	E const& b = be();
+
+	auto const p = a.rank();
+
+	if( m == 0)
+		throw std::length_error("error in boost::numeric::ublas::prod(ttv): contraction mode must be greater than zero.");
+	if( p < m )
+		throw std::length_error("error in boost::numeric::ublas::prod(ttv): rank of tensor must be greater than or equal to the modus.");
+	if( b.size() != a.extents()[m-1] )
+		throw std::length_error("error in boost::numeric::ublas::prod(ttv): size of the vector must equal the extent of the contraction mode.");
+
+	auto buffer = tensor_type{};
+	auto const& s = detail::sparse::with_last_mode(a, m, buffer);
+
+	auto bv = std::vector<T>(b.size());
+	for(auto i = size_type(0); i < b.size(); ++i)
+		bv[i] = b(i);
+
+	auto const l = p-2;
+	auto const& ptr = s.pointer_data(l);
+	auto const& idx = s.index_data(p-1);
+	auto const& val = s.value_data();
+	auto c = std::vector<T>(s.fibers(l));
+	if(s.nnz() > 0u)
+		detail::sparse::for_each_node(s, l, [&](size_type k){
+			auto t = T{};
+			for(auto j = ptr[k]; j < ptr[k+1]; ++j)
+				t += val[j] * bv[idx[j]];
+			c[k] = t;
+		});
+
+	auto nc = std::vector<size_type>{};
+	auto modes = std::vector<size_type>{};
+	auto index = std::vector<typename tensor_type::index_array_type>{};
+	auto pointer = std::vector<typename tensor_type::pointer_array_type>{};
+	for(auto r = size_type(0); r < p; ++r)
+		if(r != m-1)
+			nc.push_back(a.extents()[r]);
+	for(auto q = size_type(0); q+1 < p; ++q){
+		modes.push_back(s.modes()[q] > m ? s.modes()[q]-1 : s.modes()[q]);
+		index.push_back(s.index_data(q));
+		if(q+2 < p)
+			pointer.push_back(s.pointer_data(q));
+	}
+
+	// tensors have at least two modes
+	if(p == 2u){
+		nc.push_back(1u);
+		modes.push_back(2u);
+		pointer.emplace_back(s.fibers(0)+1);
+		std::iota(pointer.back().begin(), pointer.back().end(), size_type(0));
+		index.emplace_back(s.fibers(0), 0u);
+	}
+
+	return tensor_type(shape(nc), modes, std::move(index), std::move(pointer), std::move(c));
+}
+
+
+/** @brief Computes the m-mode product of a compressed sparse tensor and a matrix
+ *
+ * Implements C[i1,...,im-1,j,im+1,...,ip] = sum(A[i1,i2,...,ip] * B[j,im]) for the stored elements of A.
+ * The fibers of mode m are multiplied in parallel over the top-level fibers, A is compressed with mode m
+ * at its last level first if necessary. Each fiber of A yields a dense fiber of C.
+ *
+ * @param[in] a compressed sparse tensor A with order p
+ * @param[in] b matrix with na[m-1] columns
+ * @param[in] m contraction mode with 1 <= m <= p
+ *
+ * @returns compressed sparse tensor with order p
+*/
+template<class T, class I, class E>
+auto prod(compressed_tensor<T,I> const& a, matrix_expression<E> const& be, const std::size_t m)
+{
+	using tensor_type = compressed_tensor<T,I>;
+	using size_type   = typename tensor_type::size_type;
+	E const& b = be();
+
+	auto const p = a.rank();
+
+	if( m == 0)
+		throw std::length_error("error in boost::numeric::ublas::prod(ttm): contraction mode must be greater than zero.");
+	if( p < m )
+		throw std::length_error("error in boost::numeric::ublas::prod(ttm): rank of the tensor must be greater equal the modus.");
+	if( b.size2() != a.extents()[m-1] || b.size1() == 0u )
+		throw std::length_error("error in boost::numeric::ublas::prod(ttm): number of columns of the matrix must equal the extent of the contraction mode.");
+
+	auto buffer = tensor_type{};
+	auto const& s = detail::sparse::with_last_mode(a, m, buffer);
+
+	// B transposed, row k holds the column k of B
+	auto const nj = b.size1();
+	auto bt = std::vector<T>(nj*b.size2());
+	for(auto k = size_type(0); k < b.size2(); ++k)
+		for(auto j = size_type(0); j < nj; ++j)
+			bt[k*nj+j] = b(j,k);
+
+	auto const l = p-2;
+	auto const& ptr = s.pointer_data(l);
+	auto const& idx = s.index_data(p-1);
+	auto const& val = s.value_data();
+	auto c = std::vector<T>(s.fibers(l)*nj);
+	if(s.nnz() > 0u)
+		detail::sparse::for_each_node(s, l, [&](size_type k){
+			auto ck = c.data() + k*nj;
+			for(auto i = ptr[k]; i < ptr[k+1]; ++i){
+				auto const v = val[i];
+				auto const bk = bt.data() + std::size_t(idx[i])*nj;
+				for(auto j = size_type(0); j < nj; ++j)
+					ck[j] += v * bk[j];
+			}
+		});
+
+	auto nc = std::vector<size_type>(a.extents().begin(), a.extents().end());
+	nc[m-1] = nj;
+	auto index = std::vector<typename tensor_type::index_array_type>{};
+	auto pointer = std::vector<typename tensor_type::pointer_array_type>{};
+	for(auto q = size_type(0); q+1 < p; ++q){
+		index.push_back(s.index_data(q));
+		if(q+2 < p)
+			pointer.push_back(s.pointer_data(q));
+	}
+	pointer.emplace_back(s.fibers(l)+1);
+	for(auto k = size_type(0); k <= s.fibers(l); ++k)
+		pointer.back()[k] = k*nj;
+	index.emplace_back(s.fibers(l)*nj);
+	for(auto k = size_type(0); k < index.back().size(); ++k)
+		index.back()[k] = typename tensor_type::index_type(k % nj);
+
+	return tensor_type(shape(nc), s.modes(), std::move(index), std::move(pointer), std::move(c));
+}
+
+
+/** @brief Computes the matricized-tensor-times-Khatri-Rao product of a compressed sparse tensor
+ *
+ * Implements C[im,r] = sum(A[i1,i2,...,ip] * U1[i1,r] * ... * Um-1[im-1,r] * Um+1[im+1,r] * ... * Up[ip,r])
+ * for the stored elements of A, the product in every iteration of the CP decomposition with alternating
+ * least squares. The tree of A is traversed in parallel over the top-level fibers. Compress A with
+ * mode m at the first level to let each thread own its rows of C, otherwise threads lock the rows they add to.
+ *
+ * @param[in] a compressed sparse tensor A with order p
+ * @param[in] u p factor matrices of size na[r] x R, u[m-1] is not used
+ * @param[in] m mode with 1 <= m <= p
+ *
+ * @returns dense na[m-1] x R matrix C
+*/
+template<class T, class I, class M>
+auto mttkrp(compressed_tensor<T,I> const& a, std::vector<M> const& u, const std::size_t m)
+{
+	using size_type = typename compressed_tensor<T,I>::size_type;
+
+	auto const p = a.rank();
+
+	if( m == 0 || p < m )
+		throw std::length_error("error in boost::numeric::ublas::mttkrp: mode must be between one and the rank.");
+	if( u.size() != p )
+		throw std::length_error("error in boost::numeric::ublas::mttkrp: number of factor matrices must equal the rank.");
+
+	auto const R = u[m == 1 ? 1 : 0].size2();
+	for(auto r = size_type(0); r < p; ++r)
+		if( r != m-1 && (u[r].size1() != a.extents()[r] || u[r].size2() != R) )
+			throw std::length_error("error in boost::numeric::ublas::mttkrp: factor matrices must have na[r] rows and the same number of columns.");
+
+	// factors are read as contiguous rows
+	auto f = std::vector<std::vector<T>>(p);
+	for(auto r = size_type(0); r < p; ++r){
+		if(r == m-1)
+			continue;
+		f[r].resize(u[r].size1()*R);
+		for(auto i = size_type(0); i < u[r].size1(); ++i)
+			for(auto j = size_type(0); j < R; ++j)
+				f[r][i*R+j] = u[r](i,j);
+	}
+
+	auto const ll = size_type(std::find(a.modes().begin(), a.modes().end(), m) - a.modes().begin());
+	auto c = std::vector<T>(a.extents()[m-1]*R);
+
+	auto const nr = std::ptrdiff_t(a.nnz() > 0u ? a.fibers(0) : 0u);
+
+	auto locks = detail::sparse::row_locks{};
+#ifdef BOOST_UBLAS_USE_OPENMP
+	auto const size = a.nnz()*R;
+	if(ll != 0u && size >= BOOST_UBLAS_PARALLEL_THRESHOLD)
+		locks = detail::sparse::row_locks(1024u);
+#endif
+
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel if (size >= BOOST_UBLAS_PARALLEL_THRESHOLD)
+#endif
+	{
+		auto work = std::vector<T>((p+1)*R);
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp for schedule (dynamic, 16)
+#endif
+		for(std::ptrdiff_t k = 0; k < nr; ++k)
+			detail::sparse::mttkrp_node(a, f, R, ll, size_type(0), size_type(k), static_cast<T const*>(nullptr), work.data(), c.data(), locks.empty() ? nullptr : &locks);
+	}
+
+	auto cm = matrix<T>(a.extents()[m-1], R);
+	std::copy(c.begin(), c.end(), cm.data().begin());
+	return cm;
+}
+
+}}} // namespaces
+
+#endif
@@ -0,0 +1,386 @@
+//
+//  Copyright (c) 2019
+//  The Boost.uBLAS developers
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file sparse_tensor.hpp Definition of the sparse tensor classes coordinate_tensor and compressed_tensor
+
+
+#ifndef BOOST_UBLAS_SPARSE_TENSOR_HPP
+#define BOOST_UBLAS_SPARSE_TENSOR_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "extents.hpp"
+#include "tensor.hpp"
+
+namespace boost { namespace numeric { namespace ublas {
+
+template<class T, class I>
+class compressed_tensor;
+
+
+/** @brief A sparse tensor in the coordinate (COO) format
+ *
+ * Stores the index of each mode and the value of every nonzero element in separate arrays.
+ * Elements are appended in any order, sort() orders them and sums duplicates. A coordinate tensor
+ * is meant for assembling a sparse tensor which is then compressed, see compressed_tensor.
+ *
+ * @code auto a = coordinate_tensor<float>{shape{1000,100,10}}; a.append_element({3,2,1}, 4.f); @endcode
+ *
+ * @tparam T type of the elements
+ * @tparam I type of the indices, a narrower type than std::size_t saves memory for large tensors
+*/
+template<class T, class I = std::size_t>
+class coordinate_tensor
+{
+public:
+	using value_type       = T;
+	using index_type       = I;
+	using size_type        = std::size_t;
+	using const_reference  = value_type const&;
+	using extents_type     = shape;
+	using index_array_type = std::vector<index_type>;
+	using value_array_type = std::vector<value_type>;
+
+	coordinate_tensor() = default;
+
+	/** @brief Constructs an empty sparse tensor with extents e */
+	explicit coordinate_tensor(extents_type const& e, size_type capacity = 0u)
+		: extents_(e)
+		, index_data_(e.size())
+		, value_data_()
+		, sorted_(true)
+	{
+		this->reserve(capacity);
+	}
+
+	/** @brief Constructs a sparse tensor from the nonzero elements of a dense tensor */
+	template<class F, class A, class E>
+	explicit coordinate_tensor(tensor<T,F,A,E> const& t)
+		: coordinate_tensor(shape(t.extents()))
+	{
+		auto const p = t.rank();
+		auto const& n = t.extents();
+		auto const& w = t.strides();
+		auto idx = std::vector<size_type>(p);
+		for(auto i = size_type(0); i < t.size(); ++i){
+			if(t[i] == value_type{})
+				continue;
+			for(auto r = size_type(0); r < p; ++r)
+				idx[r] = (i / w[r]) % n[r];
+			this->append_element(idx, t[i]);
+		}
+		this->sorted_ = std::is_same<F,last_order>::value;
+	}
+
+	/** @brief Constructs a sparse tensor from the elements of a compressed sparse tensor */
+	explicit coordinate_tensor(compressed_tensor<T,I> const& t)
+		: coordinate_tensor(t.extents(), t.nnz())
+	{
+		t.for_each([this](auto const& idx, const_reference v){ this->append_element(idx, v); });
+		this->sorted_ = false;
+	}
+
+
+	size_type rank () const { return this->extents_.size(); }
+	size_type order() const { return this->extents_.size(); }
+	extents_type const& extents() const { return this->extents_; }
+
+	/** @brief Returns the number of stored elements, duplicates are counted until sort() */
+	size_type nnz() const { return this->value_data_.size(); }
+
+	/** @brief Returns the indices of mode r of the stored elements */
+	index_array_type const& index_data(size_type r) const { return this->index_data_.at(r); }
+
+	/** @brief Returns the values of the stored elements */
+	value_array_type const& value_data() const { return this->value_data_; }
+
+	void reserve(size_type capacity)
+	{
+		for(auto& i : this->index_data_)
+			i.reserve(capacity);
+		this->value_data_.reserve(capacity);
+	}
+
+	/** @brief Appends an element, adding it to an element with the same index on sort()
+	 *
+	 * @param idx zero-based index of each mode
+	 * @param v value of the element
+	 */
+	void append_element(std::vector<size_type> const& idx, const_reference v)
+	{
+		if(idx.size() != this->rank())
+			throw std::length_error("error in boost::numeric::ublas::coordinate_tensor::append_element: number of indices must equal the rank.");
+		for(auto r = size_type(0); r < idx.size(); ++r)
+			if(idx[r] >= this->extents_[r])
+				throw std::out_of_range("error in boost::numeric::ublas::coordinate_tensor::append_element: index exceeds the extent.");
+
+		for(auto r = size_type(0); r < idx.size(); ++r)
+			this->index_data_[r].push_back(index_type(idx[r]));
+		this->value_data_.push_back(v);
+		this->sorted_ = false;
+	}
+
+	/** @brief Sorts the elements lexicographically by their indices and sums duplicates
+	 *
+	 * @param modes one-based permutation of the modes in the order of comparison, by default 1,...,p
+	 */
+	void sort(std::vector<size_type> const& modes = {})
+	{
+		auto const p = this->rank();
+		auto const pi = modes.empty() ? identity(p) : modes;
+		if(!is_permutation(pi, p))
+			throw std::runtime_error("error in boost::numeric::ublas::coordinate_tensor::sort: modes must be a permutation of 1,...,p.");
+
+		if(this->sorted_ && pi == identity(p))
+			return;
+
+		auto const n = this->nnz();
+		auto perm = std::vector<size_type>(n);
+		std::iota(perm.begin(), perm.end(), size_type(0));
+		auto const less = [this,&pi](size_type k, size_type l){
+			for(auto m : pi){
+				auto const& i = this->index_data_[m-1];
+				if(i[k] != i[l])
+					return i[k] < i[l];
+			}
+			return false;
+		};
+		std::stable_sort(perm.begin(), perm.end(), less);
+
+		// sum duplicates and apply the permutation
+		auto filled = size_type(0);
+		auto values = value_array_type{};
+		values.reserve(n);
+		for(auto k = size_type(0); k < n; ++k){
+			if(k > 0 && !less(perm[k-1], perm[k]))
+				values.back() += this->value_data_[perm[k]];
+			else
+				values.push_back(this->value_data_[perm[k]]), perm[filled++] = perm[k];
+		}
+		perm.resize(filled);
+
+		for(auto& i : this->index_data_){
+			auto sorted = index_array_type(filled);
+			for(auto k = size_type(0); k < filled; ++k)
+				sorted[k] = i[perm[k]];
+			i.swap(sorted);
+		}
+		this->value_data_.swap(values);
+		this->sorted_ = pi == identity(p);
+	}
+
+	/** @brief Returns the dense tensor with the stored elements */
+	template<class F = first_order>
+	tensor<value_type,F> dense() const
+	{
+		auto t = tensor<value_type,F>(this->extents_, value_type{});
+		auto const& w = t.strides();
+		for(auto k = size_type(0); k < this->nnz(); ++k){
+			auto j = size_type(0);
+			for(auto r = size_type(0); r < this->rank(); ++r)
+				j += this->index_data_[r][k] * w[r];
+			t[j] += this->value_data_[k];
+		}
+		return t;
+	}
+
+private:
+
+	static std::vector<size_type> identity(size_type p)
+	{
+		auto pi = std::vector<size_type>(p);
+		std::iota(pi.begin(), pi.end(), size_type(1));
+		return pi;
+	}
+
+	static bool is_permutation(std::vector<size_type> const& pi, size_type p)
+	{
+		auto const id = identity(p);
+		return pi.size() == p && std::is_permutation(pi.begin(), pi.end(), id.begin());
+	}
+
+	template<class, class>
+	friend class compressed_tensor;
+
+	extents_type extents_;
+	std::vector<index_array_type> index_data_;
+	value_array_type value_data_;
+	bool sorted_ = true;
+};
+
+
+
+/** @brief A sparse tensor in the compressed sparse fiber (CSF) format
+ *
+ * Stores the nonzero elements as a forest with one level for each mode, in the order given by modes().
+ * The nodes of level l are the fibers of the modes modes()[0],...,modes()[l] with nonzero elements,
+ * each with the index of mode modes()[l]. The children of node k of level l are the nodes
+ * pointer_data(l)[k],...,pointer_data(l)[k+1]-1 of level l+1. The nodes of the last level are the
+ * nonzero elements. Kernels are parallelized over the nodes of the first level, the top-level fibers.
+ *
+ * @code auto b = compressed_tensor<float>(a, {3,1,2}); @endcode
+ *
+ * @tparam T type of the elements
+ * @tparam I type of the indices, a narrower type than std::size_t saves memory for large tensors
+*/
+template<class T, class I = std::size_t>
+class compressed_tensor
+{
+public:
+	using value_type         = T;
+	using index_type         = I;
+	using size_type          = std::size_t;
+	using const_reference    = value_type const&;
+	using extents_type       = shape;
+	using index_array_type   = std::vector<index_type>;
+	using pointer_array_type = std::vector<size_type>;
+	using value_array_type   = std::vector<value_type>;
+
+	compressed_tensor() = default;
+
+	/** @brief Compresses a sparse tensor in the coordinate format
+	 *
+	 * @param a sparse tensor, duplicates are summed
+	 * @param modes one-based permutation of the modes from the first to the last level, by default 1,...,p
+	 */
+	explicit compressed_tensor(coordinate_tensor<T,I> a, std::vector<size_type> const& modes = {})
+		: extents_(a.extents())
+		, modes_(modes.empty() ? coordinate_tensor<T,I>::identity(a.rank()) : modes)
+		, index_data_(a.rank())
+		, pointer_data_(std::max(a.rank(),size_type(1))-1)
+		, value_data_()
+	{
+		a.sort(this->modes_);
+
+		auto const p = this->rank();
+		auto const n = a.nnz();
+		for(auto k = size_type(0); k < n; ++k){
+			// the first level whose index differs from the previous element starts new nodes
+			auto d = size_type(0);
+			if(k > 0)
+				while(d < p-1 && a.index_data_[this->modes_[d]-1][k] == a.index_data_[this->modes_[d]-1][k-1])
+					++d;
+			for(auto l = d; l < p; ++l){
+				if(l < p-1)
+					this->pointer_data_[l].push_back(this->index_data_[l+1].size());
+				this->index_data_[l].push_back(a.index_data_[this->modes_[l]-1][k]);
+			}
+			this->value_data_.push_back(a.value_data_[k]);
+		}
+		for(auto l = size_type(0); l+1 < p; ++l)
+			this->pointer_data_[l].push_back(this->index_data_[l+1].size());
+	}
+
+	/** @brief Compresses the nonzero elements of a dense tensor */
+	template<class F, class A, class E>
+	explicit compressed_tensor(tensor<T,F,A,E> const& t, std::vector<size_type> const& modes = {})
+		: compressed_tensor(coordinate_tensor<T,I>(t), modes)
+	{
+	}
+
+	/** @brief Constructs a compressed sparse tensor from its arrays
+	 *
+	 * @param e extents
+	 * @param modes one-based permutation of the modes from the first to the last level
+	 * @param index indices of the nodes of each level
+	 * @param pointer pointers to the first children of the nodes of each level but the last
+	 * @param value values of the nodes of the last level
+	 */
+	compressed_tensor(extents_type const& e, std::vector<size_type> const& modes,
+	                  std::vector<index_array_type> index, std::vector<pointer_array_type> pointer, value_array_type value)
+		: extents_(e)
+		, modes_(modes)
+		, index_data_(std::move(index))
+		, pointer_data_(std::move(pointer))
+		, value_data_(std::move(value))
+	{
+		auto const p = this->rank();
+		if(!coordinate_tensor<T,I>::is_permutation(this->modes_, p))
+			throw std::runtime_error("error in boost::numeric::ublas::compressed_tensor: modes must be a permutation of 1,...,p.");
+		if(this->index_data_.size() != p || this->pointer_data_.size() != p-1 || this->index_data_.back().size() != this->value_data_.size())
+			throw std::length_error("error in boost::numeric::ublas::compressed_tensor: arrays do not match the rank or the number of elements.");
+		for(auto l = size_type(0); l+1 < p; ++l)
+			if(this->pointer_data_[l].size() != this->index_data_[l].size()+1 || this->pointer_data_[l].back() != this->index_data_[l+1].size())
+				throw std::length_error("error in boost::numeric::ublas::compressed_tensor: pointers do not match the number of nodes.");
+	}
+
+
+	size_type rank () const { return this->extents_.size(); }
+	size_type order() const { return this->extents_.size(); }
+	extents_type const& extents() const { return this->extents_; }
+
+	/** @brief Returns the number of stored elements */
+	size_type nnz() const { return this->value_data_.size(); }
+
+	/** @brief Returns the one-based modes of the levels */
+	std::vector<size_type> const& modes() const { return this->modes_; }
+
+	/** @brief Returns the number of nodes of level l, fibers of the modes of the levels 0,...,l */
+	size_type fibers(size_type l) const { return this->index_data_.at(l).size(); }
+
+	/** @brief Returns the indices of the nodes of level l */
+	index_array_type const& index_data(size_type l) const { return this->index_data_.at(l); }
+
+	/** @brief Returns the pointers to the first children of the nodes of level l, with a final end pointer */
+	pointer_array_type const& pointer_data(size_type l) const { return this->pointer_data_.at(l); }
+
+	/** @brief Returns the values of the stored elements */
+	value_array_type const& value_data() const { return this->value_data_; }
+
+	/** @brief Calls fn(idx, v) for every stored element with the zero-based indices idx of all modes */
+	template<class binary_fn>
+	void for_each(binary_fn fn) const
+	{
+		if(this->nnz() == 0u)
+			return;
+		auto idx = std::vector<size_type>(this->rank());
+		for(auto k = size_type(0); k < this->fibers(0); ++k)
+			this->visit(0u, k, idx, fn);
+	}
+
+	/** @brief Returns the dense tensor with the stored elements */
+	template<class F = first_order>
+	tensor<value_type,F> dense() const
+	{
+		auto t = tensor<value_type,F>(this->extents_, value_type{});
+		auto const& w = t.strides();
+		this->for_each([&t,&w](auto const& idx, const_reference v){
+			t[std::inner_product(idx.begin(), idx.end(), w.begin(), size_type(0))] = v;
+		});
+		return t;
+	}
+
+private:
+
+	template<class binary_fn>
+	void visit(size_type l, size_type k, std::vector<size_type>& idx, binary_fn& fn) const
+	{
+		idx[this->modes_[l]-1] = this->index_data_[l][k];
+		if(l+1 == this->rank())
+			fn(idx, this->value_data_[k]);
+		else
+			for(auto c = this->pointer_data_[l][k]; c < this->pointer_data_[l][k+1]; ++c)
+				this->visit(l+1, c, idx, fn);
+	}
+
+	extents_type extents_;
+	std::vector<size_type> modes_;
+	std::vector<index_array_type> index_data_;
+	std::vector<pointer_array_type> pointer_data_;
+	value_array_type value_data_;
+};
+
+}}} // namespaces
+
+#endif
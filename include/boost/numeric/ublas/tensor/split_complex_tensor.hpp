@@ -0,0 +1,407 @@
+//
+//  Copyright (c) 2019
+//  The Boost.uBLAS developers
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file split_complex_tensor.hpp Definition of the split_complex_tensor template class with planar complex storage
+
+
+#ifndef BOOST_UBLAS_SPLIT_COMPLEX_TENSOR_HPP
+#define BOOST_UBLAS_SPLIT_COMPLEX_TENSOR_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "extents.hpp"
+#include "strides.hpp"
+#include "storage_traits.hpp"
+#include "tensor.hpp"
+#include "tensor_view.hpp"
+#include "multiplication.hpp"
+#include "functions.hpp"
+#include "../detail/config.hpp"
+#include "../matrix.hpp"
+
+namespace boost { namespace numeric { namespace ublas {
+
+/** @brief A dense tensor of complex elements with split-complex (planar) storage
+ *
+ * The real and the imaginary parts of the elements are stored in two planes of real numbers with
+ * the extents and strides of the tensor, see split_complex_array. Functions of split-complex tensors
+ * run the real kernels of tensor<T,F> on the planes, such that contractions, norm and conj use real
+ * arithmetic on contiguous arrays which compilers and BLAS vectorize, instead of complex
+ * multiplications per element.
+ *
+ * The planes are accessed without copying through the views real() and imag().
+ *
+ * @code auto a = split_complex_tensor<float>{b}; a.imag() = 2 * a.real(); auto c = prod(a, a, {1}); @endcode
+ *
+ * @tparam T type of the real and imaginary parts
+ * @tparam F storage format of the planes, first_order or last_order
+ * @tparam A array type of a plane
+*/
+template<class T, class F = first_order, class A = std::vector<T>>
+class split_complex_tensor
+{
+	static_assert( std::is_same<F,first_order>::value ||
+	               std::is_same<F,last_order >::value, "boost::numeric::split_complex_tensor template class only supports first- or last-order storage formats.");
+
+public:
+	using value_type      = std::complex<T>;
+	using real_type       = T;
+	using layout_type     = F;
+	using array_type      = split_complex_array<A>;
+	using plane_type      = A;
+
+	using size_type       = std::size_t;
+	using const_reference = value_type;
+
+	using extents_type    = shape;
+	using strides_type    = basic_strides<std::size_t,F>;
+	using tensor_type     = tensor<value_type,F>;
+	using view_type       = tensor_view<T,F>;
+	using const_view_type = tensor_view<T const,F>;
+
+
+	split_complex_tensor() = default;
+
+	/** @brief Constructs a tensor with extents e and elements initialized to zero */
+	explicit split_complex_tensor(extents_type const& e)
+		: extents_(e)
+		, strides_(e)
+		, data_(e.product())
+	{
+	}
+
+	/** @brief Constructs a tensor with extents e and elements initialized to v */
+	split_complex_tensor(extents_type const& e, value_type const& v)
+		: extents_(e)
+		, strides_(e)
+		, data_(e.product(), v)
+	{
+	}
+
+	/** @brief Constructs a tensor from a tensor with interleaved complex elements of the same storage format */
+	template<class A2, class E>
+	explicit split_complex_tensor(tensor<value_type,F,A2,E> const& t)
+		: split_complex_tensor(shape(t.extents()))
+	{
+		auto const size = this->size();
+		auto const a = t.data();
+		auto re = this->data_.real.data();
+		auto im = this->data_.imag.data();
+
+#ifdef BOOST_UBLAS_USE_OPENMP
+		#pragma omp parallel for schedule (static) if (size >= BOOST_UBLAS_PARALLEL_THRESHOLD)
+#endif
+		for(auto i = size_type(0); i < size; ++i){
+			re[i] = a[i].real();
+			im[i] = a[i].imag();
+		}
+	}
+
+	/** @brief Constructs a tensor from its real and imaginary parts
+	 *
+	 * @note throws if the extents of both tensors differ
+	 */
+	template<class AR, class ER, class AI, class EI>
+	split_complex_tensor(tensor<T,F,AR,ER> const& re, tensor<T,F,AI,EI> const& im)
+		: split_complex_tensor(shape(re.extents()))
+	{
+		if(this->extents_ != shape(im.extents()))
+			throw std::length_error("error in boost::numeric::ublas::split_complex_tensor: real and imaginary parts must have the same extents.");
+		this->real() = re;
+		this->imag() = im;
+	}
+
+
+	size_type rank () const { return this->extents_.size(); }
+	size_type order() const { return this->extents_.size(); }
+	size_type size () const { return this->data_.size(); }
+	bool      empty() const { return this->data_.size() == 0u; }
+
+	extents_type const& extents() const { return this->extents_; }
+	strides_type const& strides() const { return this->strides_; }
+
+	/** @brief Returns the real and the imaginary plane */
+	array_type const& data() const { return this->data_; }
+
+
+	/** @brief Returns the element with the linear index i */
+	const_reference operator[](size_type i) const { return this->data_[i]; }
+
+	/** @brief Returns the element with a multi-index or single-index
+	 *
+	 * @code auto a = A.at(i,j,k); @endcode
+	 */
+	template<class ... size_types>
+	const_reference at (size_type i, size_types ... is) const {
+		if constexpr (sizeof...(is) == 0)
+			return this->data_[i];
+		else
+			return this->data_[detail::access<0ul>(size_type(0),this->strides_,i,std::forward<size_types>(is)...)];
+	}
+
+
+	/** @brief Returns a view of the real parts, writing through the view changes the elements */
+	view_type       real()       { return view_type      (this->data_.real.data(), this->extents_, this->strides_); }
+	const_view_type real() const { return const_view_type(this->data_.real.data(), this->extents_, this->strides_); }
+
+	/** @brief Returns a view of the imaginary parts, writing through the view changes the elements */
+	view_type       imag()       { return view_type      (this->data_.imag.data(), this->extents_, this->strides_); }
+	const_view_type imag() const { return const_view_type(this->data_.imag.data(), this->extents_, this->strides_); }
+
+
+	/** @brief Returns a tensor with interleaved complex elements */
+	tensor_type interleaved() const
+	{
+		auto t = tensor_type(this->extents_);
+		auto const size = this->size();
+		auto const re = this->data_.real.data();
+		auto const im = this->data_.imag.data();
+		auto c = t.data();
+
+#ifdef BOOST_UBLAS_USE_OPENMP
+		#pragma omp parallel for schedule (static) if (size >= BOOST_UBLAS_PARALLEL_THRESHOLD)
+#endif
+		for(auto i = size_type(0); i < size; ++i)
+			c[i] = value_type(re[i], im[i]);
+
+		return t;
+	}
+
+private:
+	extents_type extents_;
+	strides_type strides_;
+	array_type   data_;
+};
+
+
+
+/** @brief Returns a view of the real parts of a split-complex tensor without copying them */
+template<class T, class F, class A>
+auto real(split_complex_tensor<T,F,A>& a) { return a.real(); }
+
+template<class T, class F, class A>
+auto real(split_complex_tensor<T,F,A> const& a) { return a.real(); }
+
+/** @brief Returns a view of the imaginary parts of a split-complex tensor without copying them */
+template<class T, class F, class A>
+auto imag(split_complex_tensor<T,F,A>& a) { return a.imag(); }
+
+template<class T, class F, class A>
+auto imag(split_complex_tensor<T,F,A> const& a) { return a.imag(); }
+
+
+/** @brief Computes the complex conjugate of a split-complex tensor
+ *
+ * @note copies the real plane and negates the imaginary plane
+ *
+ * @param[in] a split-complex tensor
+ * @returns   split-complex tensor with the same extents
+*/
+template<class T, class F, class A>
+auto conj(split_complex_tensor<T,F,A> const& a)
+{
+	if( a.empty() )
+		throw std::runtime_error("error in boost::numeric::ublas::conj: tensors should not be empty.");
+
+	auto c = split_complex_tensor<T,F,A>(a.extents());
+	c.real() = a.real();
+
+	auto const size = a.size();
+	auto const im = a.data().imag.data();
+	auto ic = c.imag().data();
+
+#ifdef BOOST_UBLAS_USE_OPENMP
+	#pragma omp parallel for schedule (static) if (size >= BOOST_UBLAS_PARALLEL_THRESHOLD)
+#endif
+	for(auto i = std::size_t(0); i < size; ++i)
+		ic[i] = -im[i];
+
+	return c;
+}
+
+
+/** @brief Computes the frobenius norm of a split-complex tensor
+ *
+ * Implements k = sqrt( ||real(A)||^2 + ||imag(A)||^2 ) with the real norms of both planes.
+ *
+ * @param[in] a split-complex tensor
+ * @returns   the frobenius norm of the tensor
+*/
+template<class T, class F, class A>
+T norm(split_complex_tensor<T,F,A> const& a)
+{
+	if( a.empty() )
+		return T{};
+	return std::hypot( norm(a.real()), norm(a.imag()) );
+}
+
+
+/** @brief Computes the q-mode tensor-times-tensor product of split-complex tensors
+ *
+ * Implements C[i1,...,ir,j1,...,js] = sum( A[i1,...,ir+q] * B[j1,...,js+q] ) with real arithmetic on the planes,
+ * real(C) = real(A)*real(B) - imag(A)*imag(B) and imag(C) = real(A)*imag(B) + imag(A)*real(B).
+ *
+ * na[phia[x]] = nb[phib[x]] for 1 <= x <= q
+ *
+ * @note calls detail::split_complex::ttt
+ *
+ * @param[in]	 phia one-based permutation tuple of length q for the first input tensor a
+ * @param[in]	 phib one-based permutation tuple of length q for the second input tensor b
+ * @param[in]  a  left-hand side split-complex tensor with order r+q
+ * @param[in]  b  right-hand side split-complex tensor with order s+q
+ * @result     split-complex tensor with order r+s and the storage format of a
+*/
+template<class T, class FA, class AA, class FB, class AB>
+auto prod(split_complex_tensor<T,FA,AA> const& a, split_complex_tensor<T,FB,AB> const& b,
+          std::vector<std::size_t> const& phia, std::vector<std::size_t> const& phib)
+{
+	using tensor_type = split_complex_tensor<T,FA,AA>;
+
+	auto const pa = a.rank();
+	auto const pb = b.rank();
+	auto const q  = phia.size();
+
+	if(pa == 0ul)
+		throw std::runtime_error("error in ublas::prod: order of left-hand side tensor must be greater than 0.");
+	if(pb == 0ul)
+		throw std::runtime_error("error in ublas::prod: order of right-hand side tensor must be greater than 0.");
+	if(pa < q)
+		throw std::runtime_error("error in ublas::prod: number of contraction dimensions cannot be greater than the order of the left-hand side tensor.");
+	if(pb < q)
+		throw std::runtime_error("error in ublas::prod: number of contraction dimensions cannot be greater than the order of the right-hand side tensor.");
+	if(q != phib.size())
+		throw std::runtime_error("error in ublas::prod: permutation tuples must have the same length.");
+
+	auto const& na = a.extents();
+	auto const& nb = b.extents();
+	auto const& wa = a.strides();
+	auto const& wb = b.strides();
+
+	auto phia1 = std::vector<std::size_t>(pa), phib1 = std::vector<std::size_t>(pb);
+	std::iota(phia1.begin(), phia1.end(), 1ul);
+	std::iota(phib1.begin(), phib1.end(), 1ul);
+
+	for(auto x = 0ul; x < q; ++x){
+		if(phia.at(x) < 1ul || phia.at(x) > pa || phib.at(x) < 1ul || phib.at(x) > pb)
+			throw std::runtime_error("error in ublas::prod: permutation tuples must contain modes of the tensors.");
+		if(na.at(phia.at(x)-1) != nb.at(phib.at(x)-1))
+			throw std::runtime_error("error in ublas::prod: permutations of the extents are not correct.");
+		* std::remove(phia1.begin(), phia1.end(), phia.at(x)) = phia.at(x);
+		* std::remove(phib1.begin(), phib1.end(), phib.at(x)) = phib.at(x);
+	}
+
+	auto const r = pa - q;
+	auto const s = pb - q;
+
+	// free modes of A and B and contraction modes
+	auto nai = std::vector<std::size_t>{}, wai = std::vector<std::size_t>{}, nbj = std::vector<std::size_t>{}, wbj = std::vector<std::size_t>{};
+	auto nl = std::vector<std::size_t>{}, wal = std::vector<std::size_t>{}, wbl = std::vector<std::size_t>{};
+	for(auto x = 0ul; x < r; ++x){
+		nai.push_back(na[phia1[x]-1]);
+		wai.push_back(wa[phia1[x]-1]);
+	}
+	for(auto x = 0ul; x < s; ++x){
+		nbj.push_back(nb[phib1[x]-1]);
+		wbj.push_back(wb[phib1[x]-1]);
+	}
+	for(auto x = 0ul; x < q; ++x){
+		nl.push_back(na[phia[x]-1]);
+		wal.push_back(wa[phia[x]-1]);
+		wbl.push_back(wb[phib[x]-1]);
+	}
+
+	auto nc = std::vector<std::size_t>( std::max( r+s, std::size_t(2) ), std::size_t(1) );
+	std::copy(nai.begin(), nai.end(), nc.begin());
+	std::copy(nbj.begin(), nbj.end(), nc.begin()+r);
+
+	auto c = tensor_type(shape(nc));
+
+	auto const& wc = c.strides();
+	auto const wci = std::vector<std::size_t>(wc.begin(), wc.begin()+r);
+	auto const wcj = std::vector<std::size_t>(wc.begin()+r, wc.begin()+r+s);
+
+	auto const cr = c.real().data(), cm = c.imag().data();
+
+	detail::split_complex::ttt(detail::batched::offsets(nai, wci), detail::batched::offsets(nbj, wcj),
+	                           detail::batched::offsets(nai, wai), detail::batched::offsets(nl, wal),
+	                           detail::batched::offsets(nl, wbl),  detail::batched::offsets(nbj, wbj),
+	                           cr, cm,
+	                           a.data().real.data(), a.data().imag.data(),
+	                           b.data().real.data(), b.data().imag.data());
+
+	return c;
+}
+
+/** @brief Computes the q-mode tensor-times-tensor product of split-complex tensors
+ *
+ * na[phi[x]] = nb[phi[x]] for 1 <= x <= q
+ *
+ * @param[in]	 phi one-based permutation tuple of length q for both input tensors
+ * @param[in]  a  left-hand side split-complex tensor with order r+q
+ * @param[in]  b  right-hand side split-complex tensor with order s+q
+ * @result     split-complex tensor with order r+s
+*/
+template<class T, class FA, class AA, class FB, class AB>
+auto prod(split_complex_tensor<T,FA,AA> const& a, split_complex_tensor<T,FB,AB> const& b,
+          std::vector<std::size_t> const& phi)
+{
+	return prod(a, b, phi, phi);
+}
+
+
+/** @brief Computes the m-mode product of a split-complex tensor and a complex matrix
+ *
+ * Implements C[i1,...,im-1,j,im+1,...,ip] = sum( A[i1,...,im,...,ip] * B[j,im] ) with four real products
+ * of the planes of A with the real and the imaginary part of B.
+ *
+ * @note calls prod(ttm) of the real planes
+ *
+ * @param[in] a split-complex tensor A with order p
+ * @param[in] b matrix B with complex elements of the same real type
+ * @param[in] m contraction dimension with 1 <= m <= p
+ * @returns   split-complex tensor with order p
+*/
+template<class T, class F, class A, class E,
+         std::enable_if_t<std::is_same<typename E::value_type,std::complex<T>>::value,int> = 0>
+auto prod(split_complex_tensor<T,F,A> const& a, matrix_expression<E> const& be, const std::size_t m)
+{
+	E const& b = be();
+
+	auto br = matrix<T,F>(b.size1(), b.size2());
+	auto bi = matrix<T,F>(b.size1(), b.size2());
+	for(auto i = 0u; i < b.size1(); ++i)
+		for(auto j = 0u; j < b.size2(); ++j){
+			auto const bij = b(i,j);
+			br(i,j) = bij.real();
+			bi(i,j) = bij.imag();
+		}
+
+	auto const ar = a.real(), ai = a.imag();
+
+	auto const cr = prod(ar, br, m);
+
+	auto c = split_complex_tensor<T,F,A>(shape(cr.extents()));
+	auto re = c.real();
+	auto im = c.imag();
+	re  = cr;
+	re -= prod(ai, bi, m);
+	im  = prod(ar, bi, m);
+	im += prod(ai, br, m);
+	return c;
+}
+
+}}} // namespaces
+
+#endif
@@ -0,0 +1,353 @@
+//
+//  Copyright (c) 2019
+//  The Boost.uBLAS developers
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file static_extents.hpp Definition for the basic_static_extents and basic_fixed_rank_extents template classes
+
+
+#ifndef BOOST_UBLAS_TENSOR_STATIC_EXTENTS_HPP
+#define BOOST_UBLAS_TENSOR_STATIC_EXTENTS_HPP
+
+#include <algorithm>
+#include <array>
+#include <initializer_list>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+#include "extents.hpp"
+
+namespace boost {
+namespace numeric {
+namespace ublas {
+
+namespace detail {
+
+/** @brief Returns true if n has a scalar shape (1,1,[1,...,1]) */
+template<class array_type>
+constexpr bool is_scalar_shape(array_type const& n)
+{
+	for(auto r = 0u; r < n.size(); ++r)
+		if(n[r] != 1)
+			return false;
+	return n.size() != 0;
+}
+
+/** @brief Returns true if n has a vector shape (1,n,[1,...,1]) or (n,1,[1,...,1]) with n > 1 */
+template<class array_type>
+constexpr bool is_vector_shape(array_type const& n)
+{
+	if(n.size() == 0)
+		return false;
+	if(n.size() == 1)
+		return n[0] > 1;
+	for(auto r = 2u; r < n.size(); ++r)
+		if(n[r] != 1)
+			return false;
+	return (n[0] > 1 || n[1] > 1) && (n[0] == 1 || n[1] == 1);
+}
+
+/** @brief Returns true if n has a matrix shape (m,n,[1,...,1]) with m > 1 and n > 1 */
+template<class array_type>
+constexpr bool is_matrix_shape(array_type const& n)
+{
+	if(n.size() < 2)
+		return false;
+	for(auto r = 2u; r < n.size(); ++r)
+		if(n[r] != 1)
+			return false;
+	return n[0] > 1 && n[1] > 1;
+}
+
+/** @brief Returns true if n has more than two modes with one of them greater than one beyond the second */
+template<class array_type>
+constexpr bool is_tensor_shape(array_type const& n)
+{
+	for(auto r = 2u; r < n.size(); ++r)
+		if(n[r] > 1)
+			return true;
+	return false;
+}
+
+/** @brief Returns true if n has more than one mode and no zero extent */
+template<class array_type>
+constexpr bool is_valid_shape(array_type const& n)
+{
+	for(auto r = 0u; r < n.size(); ++r)
+		if(n[r] == 0)
+			return false;
+	return n.size() > 1;
+}
+
+} // namespace detail
+
+
+
+/** @brief Template class for storing tensor extents known at compile time
+ *
+ * Holds no data. Rank, extents, product and the strides computed from them
+ * (see static_strides.hpp) are constant expressions, so that a tensor shaped
+ * with them allocates no shape metadata.
+ *
+ * @code auto ex = basic_static_extents<std::size_t,4,2,3>{}; @endcode
+ *
+ * @tparam int_type unsigned integer type of the extents
+ * @tparam extents  extents of every mode, at least two and all greater than zero
+ */
+template<class int_type, int_type ... extents>
+class basic_static_extents
+{
+	static_assert( std::numeric_limits<int_type>::is_integer, "Static error in boost::numeric::ublas::basic_static_extents: type must be of type integer.");
+	static_assert(!std::numeric_limits<int_type>::is_signed,  "Static error in boost::numeric::ublas::basic_static_extents: type must be of type unsigned integer.");
+	static_assert( sizeof...(extents) > 1, "Static error in boost::numeric::ublas::basic_static_extents: rank must be greater than one.");
+	static_assert( ( (extents > 0) && ... ), "Static error in boost::numeric::ublas::basic_static_extents: extents must be greater than zero.");
+
+public:
+	using base_type = std::array<int_type,sizeof...(extents)>;
+	using value_type = typename base_type::value_type;
+	using const_reference = typename base_type::const_reference;
+	using size_type = typename base_type::size_type;
+	using const_pointer = typename base_type::const_pointer;
+	using const_iterator = typename base_type::const_iterator;
+
+	constexpr basic_static_extents() = default;
+
+	/** @brief Constructs basic_static_extents from an initializer list
+	 *
+	 * @note throws if the list does not equal the static extents
+	 */
+	basic_static_extents(std::initializer_list<value_type> l)
+	{
+		if(!std::equal(l.begin(), l.end(), _base.begin(), _base.end()))
+			throw std::length_error("Error in basic_static_extents::basic_static_extents() : extents do not equal the static extents.");
+	}
+
+	/** @brief Constructs basic_static_extents from extents of another type
+	 *
+	 * @note throws if the extents do not equal the static extents
+	 */
+	template<class other_extents,
+	         std::enable_if_t<detail::is_extents<other_extents>::value && !std::is_same<other_extents,basic_static_extents>::value,int> = 0>
+	explicit basic_static_extents(other_extents const& e)
+	{
+		if(*this != e)
+			throw std::length_error("Error in basic_static_extents::basic_static_extents() : extents do not equal the static extents.");
+	}
+
+	static constexpr bool is_scalar() { return detail::is_scalar_shape(_base); }
+	static constexpr bool is_vector() { return detail::is_vector_shape(_base); }
+	static constexpr bool is_matrix() { return detail::is_matrix_shape(_base); }
+	static constexpr bool is_tensor() { return detail::is_tensor_shape(_base); }
+
+	static constexpr const_pointer data() { return _base.data(); }
+
+	constexpr const_reference operator[] (size_type p) const { return _base[p]; }
+
+	const_reference at (size_type p) const { return _base.at(p); }
+
+	static constexpr bool empty() { return false; }
+
+	static constexpr size_type size() { return sizeof...(extents); }
+
+	static constexpr bool valid() { return true; }
+
+	/** @brief Returns the number of elements a tensor holds with this */
+	static constexpr size_type product() { return ( size_type(extents) * ... ); }
+
+	/** @brief Eliminates singleton dimensions when size > 2, see basic_extents::squeeze */
+	basic_extents<int_type> squeeze() const { return basic_extents<int_type>(*this).squeeze(); }
+
+	template<class other_extents,
+	         std::enable_if_t<detail::is_extents<other_extents>::value,int> = 0>
+	bool operator == (other_extents const& b) const
+	{
+		return size() == b.size() && std::equal(_base.begin(), _base.end(), b.begin());
+	}
+
+	template<class other_extents,
+	         std::enable_if_t<detail::is_extents<other_extents>::value,int> = 0>
+	bool operator != (other_extents const& b) const
+	{
+		return !( *this == b );
+	}
+
+	static constexpr const_iterator begin() { return _base.begin(); }
+	static constexpr const_iterator end() { return _base.end(); }
+
+	static constexpr base_type const& base() { return _base; }
+
+private:
+	static constexpr base_type _base = {extents...};
+};
+
+
+
+/** @brief Template class for storing tensor extents of a rank known at compile time
+ *
+ * Holds the extents in a std::array, the strides computed from them
+ * (see static_strides.hpp) as well, so that a tensor shaped with them
+ * allocates no shape metadata. Default constructed extents are zero.
+ *
+ * @code auto ex = basic_fixed_rank_extents<std::size_t,3>{4,2,3}; @endcode
+ *
+ * @tparam int_type unsigned integer type of the extents
+ * @tparam rank     number of modes, at least two
+ */
+template<class int_type, std::size_t rank>
+class basic_fixed_rank_extents
+{
+	static_assert( std::numeric_limits<int_type>::is_integer, "Static error in boost::numeric::ublas::basic_fixed_rank_extents: type must be of type integer.");
+	static_assert(!std::numeric_limits<int_type>::is_signed,  "Static error in boost::numeric::ublas::basic_fixed_rank_extents: type must be of type unsigned integer.");
+	static_assert( rank > 1, "Static error in boost::numeric::ublas::basic_fixed_rank_extents: rank must be greater than one.");
+
+public:
+	using base_type = std::array<int_type,rank>;
+	using value_type = typename base_type::value_type;
+	using const_reference = typename base_type::const_reference;
+	using reference = typename base_type::reference;
+	using size_type = typename base_type::size_type;
+	using const_pointer = typename base_type::const_pointer;
+	using const_iterator = typename base_type::const_iterator;
+
+	constexpr basic_fixed_rank_extents()
+	  : _base{}
+	{
+	}
+
+	/** @brief Constructs basic_fixed_rank_extents from a std::array
+	 *
+	 * @note checks if all elements > 0
+	 */
+	explicit basic_fixed_rank_extents(base_type const& b)
+	  : _base(b)
+	{
+		if (!this->valid()){
+			throw std::length_error("Error in basic_fixed_rank_extents::basic_fixed_rank_extents() : shape tuple is not a valid permutation: has zero elements.");
+		}
+	}
+
+	/** @brief Constructs basic_fixed_rank_extents from an initializer list
+	 *
+	 * @note checks if the list has rank elements, all of them > 0
+	 */
+	basic_fixed_rank_extents(std::initializer_list<value_type> l)
+	  : _base{}
+	{
+		if(l.size() != rank)
+			throw std::length_error("Error in basic_fixed_rank_extents::basic_fixed_rank_extents() : size of the list does not equal the rank.");
+		std::copy(l.begin(), l.end(), _base.begin());
+		if (!this->valid()){
+			throw std::length_error("Error in basic_fixed_rank_extents::basic_fixed_rank_extents() : shape tuple is not a valid permutation: has zero elements.");
+		}
+	}
+
+	/** @brief Constructs basic_fixed_rank_extents from extents of another type
+	 *
+	 * @note checks if the extents have the rank, all of them > 0
+	 */
+	template<class other_extents,
+	         std::enable_if_t<detail::is_extents<other_extents>::value && !std::is_same<other_extents,basic_fixed_rank_extents>::value,int> = 0>
+	explicit basic_fixed_rank_extents(other_extents const& e)
+	  : _base{}
+	{
+		if(e.size() != rank)
+			throw std::length_error("Error in basic_fixed_rank_extents::basic_fixed_rank_extents() : size of the extents does not equal the rank.");
+		std::copy(e.begin(), e.end(), _base.begin());
+		if (!this->valid()){
+			throw std::length_error("Error in basic_fixed_rank_extents::basic_fixed_rank_extents() : shape tuple is not a valid permutation: has zero elements.");
+		}
+	}
+
+	bool is_scalar() const { return detail::is_scalar_shape(_base); }
+	bool is_vector() const { return detail::is_vector_shape(_base); }
+	bool is_matrix() const { return detail::is_matrix_shape(_base); }
+	bool is_tensor() const { return detail::is_tensor_shape(_base); }
+
+	const_pointer data() const { return _base.data(); }
+
+	const_reference operator[] (size_type p) const { return _base[p]; }
+	reference operator[] (size_type p) { return _base[p]; }
+
+	const_reference at (size_type p) const { return _base.at(p); }
+	reference at (size_type p) { return _base.at(p); }
+
+	/** @brief Returns true if default constructed, i.e. extents are zero */
+	bool empty() const { return _base[0] == value_type(0); }
+
+	static constexpr size_type size() { return rank; }
+
+	/** @brief Returns true if all elements > 0 */
+	bool valid() const { return detail::is_valid_shape(_base); }
+
+	/** @brief Returns the number of elements a tensor holds with this */
+	size_type product() const
+	{
+		size_type p = 1u;
+		for(auto n : _base)
+			p *= n;
+		return p;
+	}
+
+	/** @brief Eliminates singleton dimensions when size > 2, see basic_extents::squeeze */
+	basic_extents<int_type> squeeze() const { return basic_extents<int_type>(*this).squeeze(); }
+
+	template<class other_extents,
+	         std::enable_if_t<detail::is_extents<other_extents>::value,int> = 0>
+	bool operator == (other_extents const& b) const
+	{
+		return size() == b.size() && std::equal(_base.begin(), _base.end(), b.begin());
+	}
+
+	template<class other_extents,
+	         std::enable_if_t<detail::is_extents<other_extents>::value,int> = 0>
+	bool operator != (other_extents const& b) const
+	{
+		return !( *this == b );
+	}
+
+	const_iterator begin() const { return _base.begin(); }
+	const_iterator end() const { return _base.end(); }
+
+	base_type const& base() const { return _base; }
+
+private:
+	base_type _base;
+};
+
+
+template<std::size_t ... extents>
+using static_extents = basic_static_extents<std::size_t, extents...>;
+
+template<std::size_t rank>
+using fixed_rank_extents = basic_fixed_rank_extents<std::size_t, rank>;
+
+
+namespace detail {
+
+template<class int_type, int_type ... extents>
+struct is_extents<basic_static_extents<int_type, extents...>> : std::true_type {};
+
+template<class int_type, std::size_t rank>
+struct is_extents<basic_fixed_rank_extents<int_type, rank>> : std::true_type {};
+
+/** @brief True for extents whose rank is a constant expression E::size() */
+template<class E>
+struct is_static_rank : std::false_type {};
+
+template<class int_type, int_type ... extents>
+struct is_static_rank<basic_static_extents<int_type, extents...>> : std::true_type {};
+
+template<class int_type, std::size_t rank>
+struct is_static_rank<basic_fixed_rank_extents<int_type, rank>> : std::true_type {};
+
+} // namespace detail
+
+} // namespace ublas
+} // namespace numeric
+} // namespace boost
+
+#endif
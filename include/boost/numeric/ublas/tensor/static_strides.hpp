@@ -0,0 +1,213 @@
+//
+//  Copyright (c) 2019
+//  The Boost.uBLAS developers
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file static_strides.hpp Definition for the basic_static_strides and basic_fixed_rank_strides template classes
+
+
+#ifndef BOOST_UBLAS_TENSOR_STATIC_STRIDES_HPP
+#define BOOST_UBLAS_TENSOR_STATIC_STRIDES_HPP
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <type_traits>
+
+#include "static_extents.hpp"
+#include "strides.hpp"
+
+namespace boost {
+namespace numeric {
+namespace ublas {
+
+namespace detail {
+
+/** @brief Computes the strides of extents n for the first- and last-order storage formats
+ *
+ * Same strides as basic_strides: all ones for scalar and vector shapes.
+ */
+template<class layout_type, class array_type>
+constexpr array_type make_strides(array_type const& n)
+{
+	auto w = array_type{};
+	for(auto r = 0u; r < w.size(); ++r)
+		w[r] = 1u;
+
+	if(is_vector_shape(n) || is_scalar_shape(n))
+		return w;
+
+	if constexpr (std::is_same<layout_type,first_order>::value){
+		for(auto k = 1u; k < w.size(); ++k)
+			w[k] = w[k-1] * n[k-1];
+	}
+	else {
+		for(auto k = w.size()-1; k > 0u; --k)
+			w[k-1] = w[k] * n[k];
+	}
+	return w;
+}
+
+} // namespace detail
+
+
+template<class __extents, class __layout>
+class basic_static_strides;
+
+/** @brief Template class for strides of static extents, computed at compile time
+ *
+ * @code auto w = basic_static_strides<static_extents<4,2,3>,first_order>{}; @endcode
+ *
+ * Holds no data, the strides are a constant expression.
+ */
+template<class __int_type, __int_type ... __extents, class __layout>
+class basic_static_strides<basic_static_extents<__int_type,__extents...>,__layout>
+{
+public:
+	using extents_type = basic_static_extents<__int_type,__extents...>;
+	using base_type = std::array<__int_type,sizeof...(__extents)>;
+
+	static_assert(std::is_same<__layout,first_order>::value || std::is_same<__layout,last_order>::value,
+	              "Static error in boost::numeric::ublas::basic_static_strides: layout type must either first or last order");
+
+	using layout_type = __layout;
+	using value_type = typename base_type::value_type;
+	using const_reference = typename base_type::const_reference;
+	using size_type = typename base_type::size_type;
+	using const_pointer = typename base_type::const_pointer;
+	using const_iterator = typename base_type::const_iterator;
+
+	constexpr basic_static_strides() = default;
+
+	constexpr basic_static_strides(extents_type const&) {}
+
+	constexpr const_reference operator[] (size_type p) const { return _base[p]; }
+
+	const_reference at (size_type p) const { return _base.at(p); }
+
+	static constexpr const_pointer data() { return _base.data(); }
+
+	static constexpr bool empty() { return false; }
+
+	static constexpr size_type size() { return sizeof...(__extents); }
+
+	template<class other_strides>
+	bool operator == (other_strides const& b) const
+	{
+		return size() == b.size() && std::equal(_base.begin(), _base.end(), b.begin());
+	}
+
+	template<class other_strides>
+	bool operator != (other_strides const& b) const
+	{
+		return !( *this == b );
+	}
+
+	static constexpr const_iterator begin() { return _base.begin(); }
+	static constexpr const_iterator end() { return _base.end(); }
+
+	static constexpr base_type const& base() { return _base; }
+
+private:
+	static constexpr base_type _base = detail::make_strides<layout_type>(extents_type::base());
+};
+
+
+
+/** @brief Template class for strides of fixed-rank extents
+ *
+ * @code auto w = basic_fixed_rank_strides<std::size_t,3,first_order>( fixed_rank_extents<3>{4,2,3} ); @endcode
+ *
+ * Holds the strides in a std::array. Default constructed strides are zero.
+ */
+template<class __int_type, std::size_t __rank, class __layout>
+class basic_fixed_rank_strides
+{
+public:
+	using extents_type = basic_fixed_rank_extents<__int_type,__rank>;
+	using base_type = std::array<__int_type,__rank>;
+
+	static_assert(std::is_same<__layout,first_order>::value || std::is_same<__layout,last_order>::value,
+	              "Static error in boost::numeric::ublas::basic_fixed_rank_strides: layout type must either first or last order");
+
+	using layout_type = __layout;
+	using value_type = typename base_type::value_type;
+	using const_reference = typename base_type::const_reference;
+	using size_type = typename base_type::size_type;
+	using const_pointer = typename base_type::const_pointer;
+	using const_iterator = typename base_type::const_iterator;
+
+	constexpr basic_fixed_rank_strides()
+	  : _base{}
+	{
+	}
+
+	/** @brief Constructs basic_fixed_rank_strides from fixed-rank extents for the first- and last-order storage formats */
+	basic_fixed_rank_strides(extents_type const& s)
+	  : _base{}
+	{
+		if(s.empty())
+			return;
+
+		if(!s.valid())
+			throw std::runtime_error("Error in boost::numeric::ublas::basic_fixed_rank_strides() : shape is not valid.");
+
+		_base = detail::make_strides<layout_type>(s.base());
+	}
+
+	const_reference operator[] (size_type p) const { return _base[p]; }
+
+	const_reference at (size_type p) const { return _base.at(p); }
+
+	const_pointer data() const { return _base.data(); }
+
+	static constexpr bool empty() { return false; }
+
+	static constexpr size_type size() { return __rank; }
+
+	template<class other_strides>
+	bool operator == (other_strides const& b) const
+	{
+		return size() == b.size() && std::equal(_base.begin(), _base.end(), b.begin());
+	}
+
+	template<class other_strides>
+	bool operator != (other_strides const& b) const
+	{
+		return !( *this == b );
+	}
+
+	const_iterator begin() const { return _base.begin(); }
+	const_iterator end() const { return _base.end(); }
+
+	base_type const& base() const { return _base; }
+
+private:
+	base_type _base;
+};
+
+
+namespace detail {
+
+template<class int_type, int_type ... extents, class layout_type>
+struct strides_traits<basic_static_extents<int_type,extents...>, layout_type>
+{
+	using type = basic_static_strides<basic_static_extents<int_type,extents...>, layout_type>;
+};
+
+template<class int_type, std::size_t rank, class layout_type>
+struct strides_traits<basic_fixed_rank_extents<int_type,rank>, layout_type>
+{
+	using type = basic_fixed_rank_strides<int_type, rank, layout_type>;
+};
+
+} // namespace detail
+
+} // namespace ublas
+} // namespace numeric
+} // namespace boost
+
+#endif
@@ -15,6 +15,7 @@
 
 #include <vector>
 #include <array>
+#include <complex>
 
 namespace boost {
 namespace numeric {
@@ -76,6 +77,57 @@ struct storage_traits<std::array<V,N>>
 	using rebind = std::array<U,N>;
 };
 
+
+/** @brief Split-complex (planar) storage of complex elements
+ *
+ * The real and the imaginary parts of the elements std::complex<V> are stored in two separate arrays, the planes,
+ * of type A with elements V. Kernels work on the planes with real arithmetic, see split_complex_tensor.
+ *
+ * @tparam A array type of the planes, e.g. std::vector<V>
+*/
+template <class A>
+struct split_complex_array
+{
+	using plane_type = A;
+	using value_type = std::complex<typename A::value_type>;
+	using size_type  = typename A::size_type;
+
+	split_complex_array() = default;
+	explicit split_complex_array(size_type n) : real(n), imag(n) {}
+	split_complex_array(size_type n, value_type const& v) : real(n, v.real()), imag(n, v.imag()) {}
+
+	size_type size() const { return real.size(); }
+
+	/** @brief Returns the i-th element, elements are not stored and cannot be referenced */
+	value_type operator[](size_type i) const { return value_type(real[i], imag[i]); }
+
+	plane_type real;
+	plane_type imag;
+};
+
+
+template <class A>
+struct storage_traits<split_complex_array<A>>
+{
+	using array_type      = split_complex_array<A>;
+	using plane_type      = A;
+
+	using size_type       = typename array_type::size_type;
+	using difference_type = typename storage_traits<A>::difference_type;
+	using value_type      = typename array_type::value_type;
+
+	// elements are assembled from both planes on access
+	using reference       = value_type;
+	using const_reference = value_type;
+
+	// pointers to the elements of one plane
+	using pointer         = typename storage_traits<A>::pointer;
+	using const_pointer   = typename storage_traits<A>::const_pointer;
+
+	template<class U>
+	using rebind = split_complex_array<typename storage_traits<A>::template rebind<U>>;
+};
+
 } // ublas
 } // numeric
 } // boost
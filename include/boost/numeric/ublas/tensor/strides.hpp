@@ -202,6 +202,16 @@ using strides = basic_strides<std::size_t, layout_type>;
 
 namespace detail {
 
+/** @brief Type of the strides computed from extents of type E
+ *
+ * Specialized for the compile-time extents in static_strides.hpp
+ */
+template<class E, class layout_type>
+struct strides_traits
+{
+	using type = basic_strides<typename E::value_type, layout_type>;
+};
+
 
 /** @brief Returns relative memory index with respect to a multi-index
  *
@@ -212,8 +222,8 @@ namespace detail {
  * @returns relative memory location depending on \c i and \c w
 */
 BOOST_UBLAS_INLINE
-template<class size_type, class layout_type>
-auto access(std::vector<size_type> const& i, basic_strides<size_type,layout_type> const& w)
+template<class size_type, class strides_type>
+auto access(std::vector<size_type> const& i, strides_type const& w)
 {
 	const auto p = i.size();
 	size_type sum = 0u;
@@ -232,8 +242,8 @@ auto access(std::vector<size_type> const& i, basic_strides<size_type,layout_type
  * @returns relative memory location depending on \c i and \c w
 */
 BOOST_UBLAS_INLINE
-template<std::size_t r, class layout_type, class ... size_types>
-auto access(std::size_t sum, basic_strides<std::size_t, layout_type> const& w, std::size_t i, size_types ... is)
+template<std::size_t r, class strides_type, class ... size_types>
+auto access(std::size_t sum, strides_type const& w, std::size_t i, size_types ... is)
 {
 	sum+=i*w[r];
 	if constexpr (sizeof...(is) == 0)
@@ -25,11 +25,14 @@
 #include "expression_evaluation.hpp"
 #include "extents.hpp"
 #include "strides.hpp"
+#include "static_extents.hpp"
+#include "static_strides.hpp"
 #include "index.hpp"
+#include "../detail/raw.hpp"
 
 namespace boost { namespace numeric { namespace ublas {
 
-template<class T, class F, class A>
+template<class T, class F, class A, class E>
 class tensor;
 
 template<class T, class F, class A>
@@ -74,16 +77,20 @@ class vector;
 		*
 		* @tparam T type of the objects stored in the tensor (like int, double, complex,...)
 		* @tparam A The type of the storage array of the tensor. Default is \c unbounded_array<T>. \c <bounded_array<T> and \c std::vector<T> can also be used
+		* @tparam E The type of the extents. Default is \c shape. \c static_extents<N...> and \c fixed_rank_extents<R> fix the extents or the rank at compile time
 		*/
-template<class T, class F = first_order, class A = std::vector<T,std::allocator<T>> >
+template<class T, class F = first_order, class A = std::vector<T,std::allocator<T>>, class E = shape >
 class tensor:
-		public detail::tensor_expression<tensor<T, F, A>,tensor<T, F, A>>
+		public detail::tensor_expression<tensor<T, F, A, E>,tensor<T, F, A, E>>
 {
 
 	static_assert( std::is_same<F,first_order>::value ||
 								 std::is_same<F,last_order >::value, "boost::numeric::tensor template class only supports first- or last-order storage formats.");
 
-	using self_type  = tensor<T, F, A>;
+	static_assert( detail::is_extents<E>::value &&
+								 std::is_same<typename E::value_type,std::size_t>::value, "boost::numeric::tensor template class only supports extents of type std::size_t.");
+
+	using self_type  = tensor<T, F, A, E>;
 public:
 
 
@@ -124,8 +131,8 @@ public:
 	using tensor_temporary_type = self_type;
 	using storage_category = dense_tag;
 
-	using strides_type = basic_strides<std::size_t,layout_type>;
-	using extents_type = shape;
+	using extents_type = E;
+	using strides_type = typename detail::strides_traits<extents_type,layout_type>::type;
 
 	using matrix_type     = matrix<value_type,layout_type,array_type>;
 	using vector_type     = vector<value_type,array_type>;
@@ -133,7 +140,7 @@ public:
 
 	/** @brief Constructs a tensor.
 	 *
-	 * @note the tensor is empty.
+	 * @note the tensor is empty unless its extents are static.
 	 * @note the tensor needs to reshaped for further use.
 	 *
 	 */
@@ -142,7 +149,7 @@ public:
 		: tensor_expression_type<self_type>() // container_type
 		, extents_()
 		, strides_()
-		, data_()
+		, data_(extents_.product())
 	{
 	}
 
@@ -325,21 +332,35 @@ public:
 	}
 
 
-	/** @brief Constructs a tensor with another tensor with a different layout
+	/** @brief Constructs a tensor with another tensor with a different layout, storage or extents type
+	 *
+	 * @code tensor<float,first_order,std::vector<float>,static_extents<4,2,3>> A{ B }; @endcode
+	 *
+	 * @note throws if static extents of this differ from those of other
+	 * @note tensors with a different layout are copied in tiles, see copy_tiled
 	 *
-	 * @param other tensor with a different layout to be copied.
+	 * @param other tensor with a different layout, storage or extents type to be copied.
 	 */
 	BOOST_UBLAS_INLINE
-	template<class other_layout>
-	tensor (const tensor<value_type, other_layout> &other)
+	template<class other_layout, class other_array, class other_extents>
+	tensor (const tensor<value_type, other_layout, other_array, other_extents> &other)
 		: tensor_expression_type<self_type> ()
 		, extents_ (other.extents())
-		, strides_ (other.extents())
-		, data_    (other.extents().product())
+		, strides_ (extents_)
+		, data_    (extents_.product())
 	{
-		copy(this->rank(), this->extents().data(),
-				 this->data(), this->strides().data(),
-				 other.data(), other.strides().data());
+		if constexpr (!std::is_same<layout_type,other_layout>::value)
+			copy_tiled(this->rank(), this->extents().data(),
+			           this->data(), this->strides().data(),
+			           other.data(), other.strides().data());
+		else if constexpr (detail::is_static_rank<extents_type>::value)
+			copy(std::integral_constant<std::size_t,extents_type::size()>{}, this->extents().data(),
+			     this->data(), this->strides().data(),
+			     other.data(), other.strides().data());
+		else
+			copy(this->rank(), this->extents().data(),
+			     this->data(), this->strides().data(),
+			     other.data(), other.strides().data());
 	}
 
 	/** @brief Constructs a tensor with an tensor expression
@@ -725,6 +746,28 @@ private:
 	array_type data_;
 };
 
+
+namespace raw {
+
+/// Tensors are strided views of their storage in either format
+template<class T, class F, class A, class E>
+struct strided_tensor_traits<tensor<T,F,A,E>>
+{
+	using tensor_type = tensor<T,F,A,E>;
+	using size_type = typename tensor_type::size_type;
+
+	static constexpr bool value = true;
+
+	static T const* data(tensor_type const& t) { return t.data(); }
+	static T* data(tensor_type& t) { return t.data(); }
+	static size_type rank(tensor_type const& t) { return t.rank(); }
+	static std::size_t const* extents(tensor_type const& t) { return t.extents().data(); }
+	static std::size_t const* strides(tensor_type const& t) { return t.strides().data(); }
+	static bool contiguous(tensor_type const&) { return true; }
+};
+
+} // namespace raw
+
 }}} // namespaces
 
 
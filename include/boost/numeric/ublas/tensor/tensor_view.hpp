@@ -0,0 +1,582 @@
+//
+//  Copyright (c) 2019
+//  The Boost.uBLAS developers
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file tensor_view.hpp Definition for the tensor_view template class
+
+
+#ifndef BOOST_UBLAS_TENSOR_VIEW_HPP
+#define BOOST_UBLAS_TENSOR_VIEW_HPP
+
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "algorithms.hpp"
+#include "expression.hpp"
+#include "expression_evaluation.hpp"
+#include "extents.hpp"
+#include "strides.hpp"
+#include "multiplication.hpp"
+#include "index.hpp"
+#include "tensor.hpp"
+#include "functions.hpp"
+#include "../storage.hpp"
+#include "../detail/raw.hpp"
+
+namespace boost { namespace numeric { namespace ublas {
+
+/** @brief A view of the elements of a dense tensor without owning them
+ *
+ * A view is given by a pointer to its first element, extents and arbitrary strides, such as
+ * subtensors with ranges and slices per mode, tensors with fixed indices dropping modes and
+ * reshaped contiguous tensors, see project and reshape. Elements are neither copied nor owned,
+ * the viewed storage must outlive the view.
+ *
+ * @code auto V = project(A, range(1,3), range::all(), 2); V = 2*V; @endcode
+ *
+ * Views take part in tensor expressions of tensor<T,F>, where the linear index of an element
+ * is that of the storage format F. Their pointer, extents and strides are passed to the
+ * functions of algorithms.hpp and multiplication.hpp like those of tensors.
+ *
+ * @tparam T type of the elements, const for read-only views
+ * @tparam F storage format of the linear index, first_order or last_order
+*/
+template<class T, class F = first_order>
+class tensor_view
+	: public detail::tensor_expression<tensor<std::remove_const_t<T>,F>, tensor_view<T,F>>
+{
+	static_assert( std::is_same<F,first_order>::value ||
+	               std::is_same<F,last_order >::value, "boost::numeric::tensor_view template class only supports first- or last-order storage formats.");
+
+	using self_type = tensor_view<T,F>;
+
+public:
+	using value_type      = std::remove_const_t<T>;
+	using layout_type     = F;
+	using array_type      = std::vector<value_type>;
+	using tensor_type     = tensor<value_type,F>;
+	using super_type      = detail::tensor_expression<tensor_type,self_type>;
+
+	using size_type       = std::size_t;
+	using difference_type = std::ptrdiff_t;
+	using pointer         = T*;
+	using const_pointer   = value_type const*;
+	using reference       = T&;
+	using const_reference = value_type const&;
+
+	using extents_type    = shape;
+	using strides_type    = basic_strides<std::size_t,F>;
+	using tensor_temporary_type = tensor_type;
+
+
+	/** @brief Constructs a view from a pointer, extents and strides
+	 *
+	 * @code auto V = tensor_view<float>(A.data(), shape{2,3}, strides_type{ std::vector<std::size_t>{2,8} }); @endcode
+	 */
+	BOOST_UBLAS_INLINE
+	tensor_view (pointer data, extents_type const& e, strides_type const& w)
+		: super_type()
+		, data_    (data)
+		, extents_ (e)
+		, strides_ (w)
+		, contiguous_ (false)
+	{
+		if(this->extents_.size() != this->strides_.size())
+			throw std::length_error("Error in boost::numeric::ublas::tensor_view: extents and strides must have the same size.");
+		this->contiguous_ = detail::flat::is_contiguous( this->rank(), this->extents_.data(), this->strides_.data(), std::is_same<F,last_order>::value );
+	}
+
+	/** @brief Constructs a view of all elements of a tensor */
+	BOOST_UBLAS_INLINE
+	template<class A, class E>
+	tensor_view (tensor<value_type,F,A,E>& t)
+		: tensor_view( t.data(), extents_type(t.extents()), strides_type(std::vector<std::size_t>(t.strides().begin(),t.strides().end())) )
+	{
+	}
+
+	/** @brief Constructs a read-only view of all elements of a tensor */
+	BOOST_UBLAS_INLINE
+	template<class A, class E, class U = T, std::enable_if_t<std::is_const<U>::value,int> = 0>
+	tensor_view (tensor<value_type,F,A,E> const& t)
+		: tensor_view( t.data(), extents_type(t.extents()), strides_type(std::vector<std::size_t>(t.strides().begin(),t.strides().end())) )
+	{
+	}
+
+	/** @brief Constructs a read-only view from a view */
+	BOOST_UBLAS_INLINE
+	template<class U = T, std::enable_if_t<std::is_const<U>::value,int> = 0>
+	tensor_view (tensor_view<value_type,F> const& v)
+		: tensor_view( v.data(), v.extents(), v.strides() )
+	{
+	}
+
+	BOOST_UBLAS_INLINE
+	tensor_view (tensor_view const& v)
+		: super_type()
+		, data_    (v.data_)
+		, extents_ (v.extents_)
+		, strides_ (v.strides_)
+		, contiguous_ (v.contiguous_)
+	{
+	}
+
+
+	/** @brief Copies the elements of a tensor or a view into the viewed elements
+	 *
+	 * @note extents must be equal
+	 */
+	BOOST_UBLAS_INLINE
+	tensor_view& operator = (tensor_view const& other)
+	{
+		this->assign(other.data(), other.extents(), other.strides().data());
+		return *this;
+	}
+
+	BOOST_UBLAS_INLINE
+	template<class U>
+	tensor_view& operator = (tensor_view<U,F> const& other)
+	{
+		this->assign(other.data(), other.extents(), other.strides().data());
+		return *this;
+	}
+
+	BOOST_UBLAS_INLINE
+	template<class L, class A, class E>
+	tensor_view& operator = (tensor<value_type,L,A,E> const& other)
+	{
+		this->assign(other.data(), other.extents(), other.strides().data());
+		return *this;
+	}
+
+	/** @brief Evaluates a tensor expression into the viewed elements
+	 *
+	 * @code project(A, range(0,2), range::all()) = B + C * 2; @endcode
+	 *
+	 * @note the expression may read the viewed elements only at the positions it writes them
+	 */
+	BOOST_UBLAS_INLINE
+	template<class D>
+	tensor_view& operator = (detail::tensor_expression<tensor_type,D> const& expr)
+	{
+		this->eval(expr, [](auto& l, auto const& r){ l = r; });
+		return *this;
+	}
+
+	BOOST_UBLAS_INLINE
+	tensor_view& operator = (const_reference v)
+	{
+		this->for_each([v](auto& l, size_type){ l = v; });
+		return *this;
+	}
+
+	BOOST_UBLAS_INLINE
+	template<class D>
+	tensor_view& operator += (detail::tensor_expression<tensor_type,D> const& expr)
+	{
+		this->eval(expr, [](auto& l, auto const& r){ l += r; });
+		return *this;
+	}
+
+	BOOST_UBLAS_INLINE
+	template<class D>
+	tensor_view& operator -= (detail::tensor_expression<tensor_type,D> const& expr)
+	{
+		this->eval(expr, [](auto& l, auto const& r){ l -= r; });
+		return *this;
+	}
+
+	BOOST_UBLAS_INLINE
+	tensor_view& operator += (const_reference v)
+	{
+		this->for_each([v](auto& l, size_type){ l += v; });
+		return *this;
+	}
+
+	BOOST_UBLAS_INLINE
+	tensor_view& operator -= (const_reference v)
+	{
+		this->for_each([v](auto& l, size_type){ l -= v; });
+		return *this;
+	}
+
+	BOOST_UBLAS_INLINE
+	tensor_view& operator *= (const_reference v)
+	{
+		this->for_each([v](auto& l, size_type){ l *= v; });
+		return *this;
+	}
+
+	BOOST_UBLAS_INLINE
+	tensor_view& operator /= (const_reference v)
+	{
+		this->for_each([v](auto& l, size_type){ l /= v; });
+		return *this;
+	}
+
+
+	/** @brief Returns true if the view is empty (\c size==0) */
+	BOOST_UBLAS_INLINE
+	bool empty () const {
+		return this->extents_.empty();
+	}
+
+	/** @brief Returns the number of viewed elements */
+	BOOST_UBLAS_INLINE
+	size_type size () const {
+		return this->extents_.product();
+	}
+
+	/** @brief Returns the extent of mode r */
+	BOOST_UBLAS_INLINE
+	size_type size (size_type r) const {
+		return this->extents_.at(r);
+	}
+
+	/** @brief Returns the number of dimensions/modes of the view */
+	BOOST_UBLAS_INLINE
+	size_type rank () const {
+		return this->extents_.size();
+	}
+
+	/** @brief Returns the number of dimensions/modes of the view */
+	BOOST_UBLAS_INLINE
+	size_type order () const {
+		return this->extents_.size();
+	}
+
+	/** @brief Returns the strides of the view */
+	BOOST_UBLAS_INLINE
+	strides_type const& strides () const {
+		return this->strides_;
+	}
+
+	/** @brief Returns the extents of the view */
+	BOOST_UBLAS_INLINE
+	extents_type const& extents () const {
+		return this->extents_;
+	}
+
+	/** @brief Returns a pointer to the first viewed element */
+	BOOST_UBLAS_INLINE
+	pointer data () const {
+		return this->data_;
+	}
+
+	/** @brief Returns true if the viewed elements are stored contiguously in the storage format F */
+	BOOST_UBLAS_INLINE
+	bool is_contiguous () const {
+		return this->contiguous_;
+	}
+
+
+	/** @brief Element access using a linear index in the storage format F
+	 *
+	 *  @param i zero-based index where 0 <= i < this->size()
+	 */
+	BOOST_UBLAS_INLINE
+	reference operator [] (size_type i) const {
+		return this->data_[this->offset(i)];
+	}
+
+	/** @brief Element access using a linear index in the storage format F
+	 *
+	 *  @param i zero-based index where 0 <= i < this->size()
+	 */
+	BOOST_UBLAS_INLINE
+	reference operator () (size_type i) const {
+		return this->data_[this->offset(i)];
+	}
+
+	/** @brief Element access using a multi-index or single-index.
+	 *
+	 *  @code V.at(i,j,k) = a; @endcode or
+	 *  @code V.at(i) = a;     @endcode
+	 *
+	 *  @param i zero-based index where 0 <= i < this->size() if sizeof...(is) == 0, else 0<= i < this->size(0)
+	 *  @param is zero-based indices where 0 <= is[r] < this->size(r) where  0 < r < this->rank()
+	 */
+	BOOST_UBLAS_INLINE
+	template<class ... size_types>
+	reference at (size_type i, size_types ... is) const {
+		if constexpr (sizeof...(is) == 0)
+			return this->data_[this->offset(i)];
+		else
+			return this->data_[detail::access<0ul>(size_type(0),this->strides_,i,std::forward<size_types>(is)...)];
+	}
+
+	/** @brief Generates a tensor index for tensor contraction
+	 *
+	 *  @code auto Vi = V(_i,_j,_k); @endcode
+	 */
+	BOOST_UBLAS_INLINE
+	template<std::size_t I, class ... index_types>
+	decltype(auto) operator() (index::index_type<I> p, index_types ... ps) const
+	{
+		constexpr auto N = sizeof...(ps)+1;
+		if( N != this->rank() )
+			throw std::runtime_error("Error in boost::numeric::ublas::tensor_view::operator(): size of provided index_types does not match with the rank.");
+
+		return std::make_pair( std::cref(*this),  std::make_tuple( p, std::forward<index_types>(ps)... ) );
+	}
+
+
+private:
+
+	/** @brief Memory offset of the element with the linear index i in the storage format F */
+	size_type offset (size_type i) const
+	{
+		if(this->contiguous_)
+			return i;
+		auto const p = this->rank();
+		auto k = size_type(0);
+		for(auto q = size_type(0); q < p; ++q){
+			auto const r = std::is_same<F,first_order>::value ? q : p-1-q;
+			k += (i % this->extents_[r]) * this->strides_[r];
+			i /= this->extents_[r];
+		}
+		return k;
+	}
+
+	/** @brief Calls fn(element, i) for all elements with linear indices i in the storage format F */
+	template<class unary_fn>
+	void for_each (unary_fn fn) const
+	{
+		auto const n = this->size();
+
+		if(this->contiguous_){
+#pragma omp parallel for
+			for(auto i = 0u; i < n; ++i)
+				fn(this->data_[i], size_type(i));
+			return;
+		}
+
+		auto const p = this->rank();
+		auto idx = std::vector<size_type>(p, 0u);
+		auto k = size_type(0);
+		for(auto i = size_type(0); i < n; ++i){
+			fn(this->data_[k], i);
+			for(auto q = size_type(0); q < p; ++q){
+				auto const r = std::is_same<F,first_order>::value ? q : p-1-q;
+				if(++idx[r] < this->extents_[r]){
+					k += this->strides_[r];
+					break;
+				}
+				k -= (this->extents_[r]-1) * this->strides_[r];
+				idx[r] = 0u;
+			}
+		}
+	}
+
+	template<class D, class binary_fn>
+	void eval (detail::tensor_expression<tensor_type,D> const& expr, binary_fn fn) const
+	{
+		static_assert(!std::is_const<T>::value, "Error in boost::numeric::ublas::tensor_view: cannot assign to a read-only view.");
+
+		if constexpr (detail::has_tensor_types<tensor_type, detail::tensor_expression<tensor_type,D>>::value)
+			if(!detail::all_extents_equal(expr, this->extents_))
+				throw std::runtime_error("Error in boost::numeric::ublas::tensor_view: expression contains tensors with different shapes.");
+
+		auto const& e = expr();
+		this->for_each([&e,fn](auto& l, size_type i){ fn(l, e(i)); });
+	}
+
+	template<class U, class E>
+	void assign (U const* other, E const& ne, std::size_t const* wo) const
+	{
+		static_assert(!std::is_const<T>::value, "Error in boost::numeric::ublas::tensor_view: cannot assign to a read-only view.");
+
+		if(this->extents_ != extents_type(ne))
+			throw std::runtime_error("Error in boost::numeric::ublas::tensor_view: extents of the assigned tensor are different.");
+
+		copy(this->rank(), this->extents_.data(), this->data_, this->strides_.data(), other, wo);
+	}
+
+	pointer data_;
+	extents_type extents_;
+	strides_type strides_;
+	bool contiguous_;
+};
+
+
+namespace detail {
+
+/** @brief Appends the mode of a projected view selected by a range */
+template<class Z, class D>
+void project_mode(std::size_t& offset, std::vector<std::size_t>& n, std::vector<std::size_t>& w,
+                  std::size_t extent, std::size_t stride, basic_range<Z,D> const& r)
+{
+	auto const rr = r.preprocess(extent);
+	if(rr.empty() || rr.start() + rr.size() > extent)
+		throw std::out_of_range("Error in boost::numeric::ublas::project: range is empty or exceeds the extent.");
+	offset += rr.start() * stride;
+	n.push_back(rr.size());
+	w.push_back(stride);
+}
+
+/** @brief Appends the mode of a projected view selected by a slice */
+template<class Z, class D>
+void project_mode(std::size_t& offset, std::vector<std::size_t>& n, std::vector<std::size_t>& w,
+                  std::size_t extent, std::size_t stride, basic_slice<Z,D> const& s)
+{
+	auto const ss = s.preprocess(extent);
+	if(ss.empty() || ss.stride() < 0 || ss.start() + (ss.size()-1) * std::size_t(ss.stride()) >= extent)
+		throw std::out_of_range("Error in boost::numeric::ublas::project: slice is empty, has a negative stride or exceeds the extent.");
+	offset += ss.start() * stride;
+	n.push_back(ss.size());
+	w.push_back(std::size_t(ss.stride()) * stride);
+}
+
+/** @brief Drops the mode of a projected view fixed to an index */
+template<class I, std::enable_if_t<std::is_integral<I>::value,int> = 0>
+void project_mode(std::size_t& offset, std::vector<std::size_t>&, std::vector<std::size_t>&,
+                  std::size_t extent, std::size_t stride, I i)
+{
+	if(i < 0 || std::size_t(i) >= extent)
+		throw std::out_of_range("Error in boost::numeric::ublas::project: index exceeds the extent.");
+	offset += std::size_t(i) * stride;
+}
+
+template<class T, class F, class ... R>
+auto project(T* data, shape const& na, std::size_t const* wa, R const& ... r)
+{
+	if(sizeof...(r) != na.size())
+		throw std::length_error("Error in boost::numeric::ublas::project: number of ranges, slices and indices must equal the rank.");
+
+	auto offset = std::size_t(0);
+	auto n = std::vector<std::size_t>{};
+	auto w = std::vector<std::size_t>{};
+	auto k = std::size_t(0);
+	((project_mode(offset, n, w, na[k], wa[k], r), ++k), ...);
+
+	// tensors have at least two modes
+	while(n.size() < 2u)
+		n.push_back(1u), w.push_back(1u);
+
+	return tensor_view<T,F>(data + offset, shape(n), basic_strides<std::size_t,F>(w));
+}
+
+template<class T, class F>
+auto reshape(T* data, shape const& na, std::size_t const* wa, std::size_t size, shape const& e)
+{
+	if(!flat::is_contiguous(na.size(), na.data(), wa, std::is_same<F,last_order>::value))
+		throw std::runtime_error("Error in boost::numeric::ublas::reshape: only contiguous tensors can be reshaped.");
+	if(e.product() != size)
+		throw std::length_error("Error in boost::numeric::ublas::reshape: number of elements must not change.");
+
+	return tensor_view<T,F>(data, e, basic_strides<std::size_t,F>(e));
+}
+
+} // namespace detail
+
+
+/** @brief Returns a view of a subtensor
+ *
+ * Each mode is selected by a range, a slice or an index. A mode with an index is dropped.
+ *
+ * @code auto V = project(A, range(1,3), slice(0,2,2), 4); @endcode
+ *
+ * @param t tensor of rank p
+ * @param r p ranges, slices or indices, range::all() selects a whole mode
+ * @returns view of rank p minus the number of indices, at least two
+*/
+template<class V, class F, class A, class E, class ... R>
+auto project(tensor<V,F,A,E>& t, R const& ... r)
+{
+	return detail::project<V,F>(t.data(), shape(t.extents()), std::vector<std::size_t>(t.strides().begin(), t.strides().end()).data(), r...);
+}
+
+template<class V, class F, class A, class E, class ... R>
+auto project(tensor<V,F,A,E> const& t, R const& ... r)
+{
+	return detail::project<V const,F>(t.data(), shape(t.extents()), std::vector<std::size_t>(t.strides().begin(), t.strides().end()).data(), r...);
+}
+
+template<class T, class F, class ... R>
+auto project(tensor_view<T,F> const& t, R const& ... r)
+{
+	return detail::project<T,F>(t.data(), t.extents(), t.strides().data(), r...);
+}
+
+
+/** @brief Returns a view of a contiguous tensor with other extents
+ *
+ * @code auto V = reshape(A, shape{6,4}); @endcode
+ *
+ * @note throws if the tensor is not contiguous or the number of elements differs
+ *
+ * @param t tensor or contiguous view
+ * @param e extents with the same product as those of t
+*/
+template<class V, class F, class A, class E>
+auto reshape(tensor<V,F,A,E>& t, shape const& e)
+{
+	return detail::reshape<V,F>(t.data(), shape(t.extents()), std::vector<std::size_t>(t.strides().begin(), t.strides().end()).data(), t.size(), e);
+}
+
+template<class V, class F, class A, class E>
+auto reshape(tensor<V,F,A,E> const& t, shape const& e)
+{
+	return detail::reshape<V const,F>(t.data(), shape(t.extents()), std::vector<std::size_t>(t.strides().begin(), t.strides().end()).data(), t.size(), e);
+}
+
+template<class T, class F>
+auto reshape(tensor_view<T,F> const& t, shape const& e)
+{
+	return detail::reshape<T,F>(t.data(), t.extents(), t.strides().data(), t.size(), e);
+}
+
+
+namespace detail {
+
+template<class T, class F>
+struct result_tensor<tensor_view<T,F>> { using type = typename tensor_view<T,F>::tensor_type; };
+
+template<class T, class V, class F>
+struct has_tensor_types<T, tensor_view<V,F>>
+{ static constexpr bool value = std::is_same<T, typename tensor_view<V,F>::tensor_type>::value; };
+
+/** @brief Retrieves extents of the view */
+template<class V, class F>
+auto retrieve_extents(tensor_view<V,F> const& v)
+{
+	return v.extents();
+}
+
+template<class V, class F, class S>
+auto all_extents_equal(tensor_view<V,F> const& v, S const& extents)
+{
+	return extents == v.extents();
+}
+
+} // namespace detail
+
+
+namespace raw {
+
+/// Views are strided by construction
+template<class T, class F>
+struct strided_tensor_traits<tensor_view<T,F>>
+{
+	using view_type = tensor_view<T,F>;
+	using size_type = typename view_type::size_type;
+
+	static constexpr bool value = true;
+
+	static T* data(view_type const& t) { return t.data(); }
+	static size_type rank(view_type const& t) { return t.rank(); }
+	static std::size_t const* extents(view_type const& t) { return t.extents().data(); }
+	static std::size_t const* strides(view_type const& t) { return t.strides().data(); }
+	static bool contiguous(view_type const& t) { return t.is_contiguous(); }
+};
+
+} // namespace raw
+
+}}} // namespaces
+
+#endif
@@ -2038,21 +2038,24 @@ namespace boost { namespace numeric { namespace ublas {
                         lower_tag, column_major_tag, dense_proxy_tag) {
         typedef typename E2::size_type size_type;
         typedef typename E2::value_type value_type;
+        typedef detail::matrix_operand_traits<E1> operand_traits;
 
         BOOST_UBLAS_CHECK (e1 ().size1 () == e1 ().size2 (), bad_size ());
         BOOST_UBLAS_CHECK (e1 ().size2 () == e2 ().size (), bad_size ());
+        // Strided matrices, their trans () and herm () read through the pointer
+        typename operand_traits::type a (operand_traits::get (e1 ()));
         size_type size = e2 ().size ();
         for (size_type n = 0; n < size; ++ n) {
 #ifndef BOOST_UBLAS_SINGULAR_CHECK
-            BOOST_UBLAS_CHECK (e1 () (n, n) != value_type/*zero*/(), singular ());
+            BOOST_UBLAS_CHECK (a (n, n) != value_type/*zero*/(), singular ());
 #else
-            if (e1 () (n, n) == value_type/*zero*/())
+            if (a (n, n) == value_type/*zero*/())
                 singular ().raise ();
 #endif
-            value_type t = e2 () (n) /= e1 () (n, n);
+            value_type t = e2 () (n) /= a (n, n);
             if (t != value_type/*zero*/()) {
                 for (size_type m = n + 1; m < size; ++ m)
-                    e2 () (m) -= e1 () (m, n) * t;
+                    e2 () (m) -= a (m, n) * t;
             }
         }
     }
@@ -2120,21 +2123,24 @@ namespace boost { namespace numeric { namespace ublas {
                         lower_tag, row_major_tag, dense_proxy_tag) {
         typedef typename E2::size_type size_type;
         typedef typename E2::value_type value_type;
+        typedef detail::matrix_operand_traits<E1> operand_traits;
 
         BOOST_UBLAS_CHECK (e1 ().size1 () == e1 ().size2 (), bad_size ());
         BOOST_UBLAS_CHECK (e1 ().size2 () == e2 ().size (), bad_size ());
+        // Strided matrices, their trans () and herm () read through the pointer
+        typename operand_traits::type a (operand_traits::get (e1 ()));
         size_type size = e2 ().size ();
         for (size_type n = 0; n < size; ++ n) {
 #ifndef BOOST_UBLAS_SINGULAR_CHECK
-            BOOST_UBLAS_CHECK (e1 () (n, n) != value_type/*zero*/(), singular ());
+            BOOST_UBLAS_CHECK (a (n, n) != value_type/*zero*/(), singular ());
 #else
-            if (e1 () (n, n) == value_type/*zero*/())
+            if (a (n, n) == value_type/*zero*/())
                 singular ().raise ();
 #endif
-            value_type t = e2 () (n) /= e1 () (n, n);
+            value_type t = e2 () (n) /= a (n, n);
             if (t != value_type/*zero*/()) {
                 for (size_type m = n + 1; m < size; ++ m)
-                    e2 () (m) -= e1 () (m, n) * t;
+                    e2 () (m) -= a (m, n) * t;
             }
         }
     }
@@ -2238,21 +2244,24 @@ namespace boost { namespace numeric { namespace ublas {
         typedef typename E2::size_type size_type;
         typedef typename E2::difference_type difference_type;
         typedef typename E2::value_type value_type;
+        typedef detail::matrix_operand_traits<E1> operand_traits;
 
         BOOST_UBLAS_CHECK (e1 ().size1 () == e1 ().size2 (), bad_size ());
         BOOST_UBLAS_CHECK (e1 ().size2 () == e2 ().size (), bad_size ());
+        // Strided matrices, their trans () and herm () read through the pointer
+        typename operand_traits::type a (operand_traits::get (e1 ()));
         size_type size = e2 ().size ();
         for (difference_type n = size - 1; n >= 0; -- n) {
 #ifndef BOOST_UBLAS_SINGULAR_CHECK
-            BOOST_UBLAS_CHECK (e1 () (n, n) != value_type/*zero*/(), singular ());
+            BOOST_UBLAS_CHECK (a (n, n) != value_type/*zero*/(), singular ());
 #else
-            if (e1 () (n, n) == value_type/*zero*/())
+            if (a (n, n) == value_type/*zero*/())
                 singular ().raise ();
 #endif
-            value_type t = e2 () (n) /= e1 () (n, n);
+            value_type t = e2 () (n) /= a (n, n);
             if (t != value_type/*zero*/()) {
                 for (difference_type m = n - 1; m >= 0; -- m)
-                    e2 () (m) -= e1 () (m, n) * t;
+                    e2 () (m) -= a (m, n) * t;
             }
         }
     }
@@ -2323,22 +2332,25 @@ namespace boost { namespace numeric { namespace ublas {
         typedef typename E2::size_type size_type;
         typedef typename E2::difference_type difference_type;
         typedef typename E2::value_type value_type;
+        typedef detail::matrix_operand_traits<E1> operand_traits;
 
         BOOST_UBLAS_CHECK (e1 ().size1 () == e1 ().size2 (), bad_size ());
         BOOST_UBLAS_CHECK (e1 ().size2 () == e2 ().size (), bad_size ());
+        // Strided matrices, their trans () and herm () read through the pointer
+        typename operand_traits::type a (operand_traits::get (e1 ()));
         size_type size = e1 ().size1 ();
         for (difference_type n = size-1; n >=0; -- n) {
 #ifndef BOOST_UBLAS_SINGULAR_CHECK
-            BOOST_UBLAS_CHECK (e1 () (n, n) != value_type/*zero*/(), singular ());
+            BOOST_UBLAS_CHECK (a (n, n) != value_type/*zero*/(), singular ());
 #else
-            if (e1 () (n, n) == value_type/*zero*/())
+            if (a (n, n) == value_type/*zero*/())
                 singular ().raise ();
 #endif
             value_type t = e2 () (n);
             for (difference_type m = n + 1; m < static_cast<difference_type>(e1 ().size2()); ++ m) {
-              t -= e1 () (n, m)  * e2 () (m);
+              t -= a (n, m)  * e2 () (m);
             }
-            e2() (n) = t / e1 () (n, n);
+            e2() (n) = t / a (n, n);
         }
     }
     // Packed (proxy) case
@@ -2548,23 +2560,26 @@ namespace boost { namespace numeric { namespace ublas {
                         lower_tag, dense_proxy_tag) {
         typedef typename E2::size_type size_type;
         typedef typename E2::value_type value_type;
+        typedef detail::matrix_operand_traits<E1> operand_traits;
 
         BOOST_UBLAS_CHECK (e1 ().size1 () == e1 ().size2 (), bad_size ());
         BOOST_UBLAS_CHECK (e1 ().size2 () == e2 ().size1 (), bad_size ());
+        // Strided matrices, their trans () and herm () read through the pointer
+        typename operand_traits::type a (operand_traits::get (e1 ()));
         size_type size1 = e2 ().size1 ();
         size_type size2 = e2 ().size2 ();
         for (size_type n = 0; n < size1; ++ n) {
 #ifndef BOOST_UBLAS_SINGULAR_CHECK
-            BOOST_UBLAS_CHECK (e1 () (n, n) != value_type/*zero*/(), singular ());
+            BOOST_UBLAS_CHECK (a (n, n) != value_type/*zero*/(), singular ());
 #else
-            if (e1 () (n, n) == value_type/*zero*/())
+            if (a (n, n) == value_type/*zero*/())
                 singular ().raise ();
 #endif
             for (size_type l = 0; l < size2; ++ l) {
-                value_type t = e2 () (n, l) /= e1 () (n, n);
+                value_type t = e2 () (n, l) /= a (n, n);
                 if (t != value_type/*zero*/()) {
                     for (size_type m = n + 1; m < size1; ++ m)
-                        e2 () (m, l) -= e1 () (m, n) * t;
+                        e2 () (m, l) -= a (m, n) * t;
                 }
             }
         }
@@ -2657,23 +2672,26 @@ namespace boost { namespace numeric { namespace ublas {
         typedef typename E2::size_type size_type;
         typedef typename E2::difference_type difference_type;
         typedef typename E2::value_type value_type;
+        typedef detail::matrix_operand_traits<E1> operand_traits;
 
         BOOST_UBLAS_CHECK (e1 ().size1 () == e1 ().size2 (), bad_size ());
         BOOST_UBLAS_CHECK (e1 ().size2 () == e2 ().size1 (), bad_size ());
+        // Strided matrices, their trans () and herm () read through the pointer
+        typename operand_traits::type a (operand_traits::get (e1 ()));
         size_type size1 = e2 ().size1 ();
         size_type size2 = e2 ().size2 ();
         for (difference_type n = size1 - 1; n >= 0; -- n) {
 #ifndef BOOST_UBLAS_SINGULAR_CHECK
-            BOOST_UBLAS_CHECK (e1 () (n, n) != value_type/*zero*/(), singular ());
+            BOOST_UBLAS_CHECK (a (n, n) != value_type/*zero*/(), singular ());
 #else
-            if (e1 () (n, n) == value_type/*zero*/())
+            if (a (n, n) == value_type/*zero*/())
                 singular ().raise ();
 #endif
             for (difference_type l = size2 - 1; l >= 0; -- l) {
-                value_type t = e2 () (n, l) /= e1 () (n, n);
+                value_type t = e2 () (n, l) /= a (n, n);
                 if (t != value_type/*zero*/()) {
                     for (difference_type m = n - 1; m >= 0; -- m)
-                        e2 () (m, l) -= e1 () (m, n) * t;
+                        e2 () (m, l) -= a (m, n) * t;
                 }
             }
         }
@@ -19,8 +19,10 @@
 
 #include <boost/config.hpp>
 #include <boost/numeric/ublas/storage.hpp>
+#include <boost/numeric/ublas/temporary_arena.hpp>
 #include <boost/numeric/ublas/vector_expression.hpp>
 #include <boost/numeric/ublas/detail/vector_assign.hpp>
+#include <boost/numeric/ublas/detail/expression_alias.hpp>
 #include <boost/serialization/collection_size_type.hpp>
 #include <boost/serialization/nvp.hpp>
 
@@ -112,6 +114,25 @@ namespace boost { namespace numeric { namespace ublas {
 	        vector_container<self_type> (),
 	        data_ (size, init) {}
 
+	/// \brief Constructor of a vector with a predefined size whose elements of trivial types are not written
+	/// \param size of the vector
+	    BOOST_UBLAS_INLINE
+	    vector (size_type size, uninitialized_tag tag):
+	        vector_container<self_type> (),
+	        data_ () {
+	        detail::resize_storage (data_, size, tag);
+	    }
+
+	/// \brief Constructor of a vector with a predefined size whose elements are value initialised in parallel
+	/// Every element is first written by the thread that works on it in the parallel kernels
+	/// \param size of the vector
+	    BOOST_UBLAS_INLINE
+	    vector (size_type size, first_touch_tag tag):
+	        vector_container<self_type> (),
+	        data_ () {
+	        detail::resize_storage (data_, size, tag);
+	    }
+
 	/// \brief Copy-constructor of a vector
 	/// \param v is the vector to be duplicated
 	    BOOST_UBLAS_INLINE
@@ -191,6 +212,20 @@ namespace boost { namespace numeric { namespace ublas {
 	             data ().resize (size);
 	     }
 
+	/// \brief Resize the vector without preserving its elements, elements of trivial types are not written
+	/// \param size new size of the vector
+	     BOOST_UBLAS_INLINE
+	     void resize (size_type size, uninitialized_tag tag) {
+	         detail::resize_storage (data (), size, tag);
+	     }
+
+	/// \brief Resize the vector without preserving its elements, elements are value initialised in parallel
+	/// \param size new size of the vector
+	     BOOST_UBLAS_INLINE
+	     void resize (size_type size, first_touch_tag tag) {
+	         detail::resize_storage (data (), size, tag);
+	     }
+
 	// ---------------
 	     // Element support
 	// ---------------
@@ -319,6 +354,17 @@ namespace boost { namespace numeric { namespace ublas {
 	         return *this;
 	     }
 
+	/// \brief Assign the result of a vector_expression evaluated into a temporary of the current temporary_arena
+	/// \tparam AE is the type of the vector_expression
+	/// \param ae is a const reference to the vector_expression
+	/// \return a reference to the resulting vector
+	     template<class AE>
+	     vector &assign_arena_temporary (const vector_expression<AE> &ae) {
+	         typename detail::temporary_vector<value_type>::type temporary (ae);
+	         resize (temporary.size (), false);
+	         return assign (temporary);
+	     }
+
 	/// \brief Assign the result of a vector_expression to the vector
 	/// Assign the result of a vector_expression to the vector. This is lazy-compiled and will be optimized out by the compiler on any type of expression.
 	/// \tparam AE is the type of the vector_expression
@@ -327,6 +373,16 @@ namespace boost { namespace numeric { namespace ublas {
 	     template<class AE>
 	     BOOST_UBLAS_INLINE
 	     vector &operator = (const vector_expression<AE> &ae) {
+	         // In place, unless the expression reads the storage written
+	         if (! detail::vector_may_alias (*this, ae)) {
+	             if (size () != ae ().size ())
+	                 resize (ae ().size (), false);
+	             return assign (ae);
+	         }
+#ifndef BOOST_UBLAS_NO_TEMPORARY_ARENA
+	         if (temporary_arena::current ())
+	             return assign_arena_temporary (ae);
+#endif
 	         self_type temporary (ae);
 	         return assign_temporary (temporary);
 	     }
@@ -349,13 +405,19 @@ namespace boost { namespace numeric { namespace ublas {
 	
 	/// \brief Assign the sum of the vector and a vector_expression to the vector
 	/// Assign the sum of the vector and a vector_expression to the vector. This is lazy-compiled and will be optimized out by the compiler on any type of expression.
-	/// A temporary is created for the computations.
+	/// A temporary is created for the computations when the vector_expression refers to the vector.
 	/// \tparam AE is the type of the vector_expression
 	/// \param ae is a const reference to the vector_expression
 	/// \return a reference to the resulting vector
 	     template<class AE>
 	     BOOST_UBLAS_INLINE
 	     vector &operator += (const vector_expression<AE> &ae) {
+	         if (! detail::vector_may_alias (*this, ae))
+	             return plus_assign (ae);
+#ifndef BOOST_UBLAS_NO_TEMPORARY_ARENA
+	         if (temporary_arena::current ())
+	             return assign_arena_temporary (*this + ae);
+#endif
 	         self_type temporary (*this + ae);
 	         return assign_temporary (temporary);
 	     }
@@ -388,12 +450,18 @@ namespace boost { namespace numeric { namespace ublas {
 	
 	/// \brief Assign the difference of the vector and a vector_expression to the vector
 	/// Assign the difference of the vector and a vector_expression to the vector. This is lazy-compiled and will be optimized out by the compiler on any type of expression.
-	/// A temporary is created for the computations.
+	/// A temporary is created for the computations when the vector_expression refers to the vector.
 	/// \tparam AE is the type of the vector_expression
 	/// \param ae is a const reference to the vector_expression
 	     template<class AE>
 	     BOOST_UBLAS_INLINE
 	     vector &operator -= (const vector_expression<AE> &ae) {
+	         if (! detail::vector_may_alias (*this, ae))
+	             return minus_assign (ae);
+#ifndef BOOST_UBLAS_NO_TEMPORARY_ARENA
+	         if (temporary_arena::current ())
+	             return assign_arena_temporary (*this - ae);
+#endif
 	         self_type temporary (*this - ae);
 	         return assign_temporary (temporary);
 	     }
@@ -1098,6 +1166,9 @@ namespace boost { namespace numeric { namespace ublas {
          template<class AE>
          BOOST_UBLAS_INLINE
          fixed_vector &operator = (const vector_expression<AE> &ae) {
+             // In place, unless the expression reads the storage written
+             if (! detail::vector_may_alias (*this, ae))
+                 return assign (ae);
              self_type temporary (ae);
              return assign_temporary (temporary);
          }
@@ -1127,6 +1198,8 @@ namespace boost { namespace numeric { namespace ublas {
          template<class AE>
          BOOST_UBLAS_INLINE
          fixed_vector &operator += (const vector_expression<AE> &ae) {
+             if (! detail::vector_may_alias (*this, ae))
+                 return plus_assign (ae);
              self_type temporary (*this + ae);
              return assign_temporary (temporary);
          }
@@ -1165,6 +1238,8 @@ namespace boost { namespace numeric { namespace ublas {
          template<class AE>
          BOOST_UBLAS_INLINE
          fixed_vector &operator -= (const vector_expression<AE> &ae) {
+             if (! detail::vector_may_alias (*this, ae))
+                 return minus_assign (ae);
              self_type temporary (*this - ae);
              return assign_temporary (temporary);
          }
@@ -2572,6 +2647,12 @@ namespace boost { namespace numeric { namespace ublas {
 	     template<class AE>
 	     BOOST_UBLAS_INLINE
 	     c_vector &operator = (const vector_expression<AE> &ae) {
+	         // In place, unless the expression reads the storage written
+	         if (! detail::vector_may_alias (*this, ae)) {
+	             if (size () != ae ().size ())
+	                 resize (ae ().size (), false);
+	             return assign (ae);
+	         }
 	         self_type temporary (ae);
 	         return assign_temporary (temporary);
 	     }
@@ -2586,6 +2667,8 @@ namespace boost { namespace numeric { namespace ublas {
 	     template<class AE>
 	     BOOST_UBLAS_INLINE
 	     c_vector &operator += (const vector_expression<AE> &ae) {
+	         if (! detail::vector_may_alias (*this, ae))
+	             return plus_assign (ae);
 	         self_type temporary (*this + ae);
 	         return assign_temporary (temporary);
 	     }
@@ -2604,6 +2687,8 @@ namespace boost { namespace numeric { namespace ublas {
 	     template<class AE>
 	     BOOST_UBLAS_INLINE
 	     c_vector &operator -= (const vector_expression<AE> &ae) {
+	         if (! detail::vector_may_alias (*this, ae))
+	             return minus_assign (ae);
 	         self_type temporary (*this - ae);
 	         return assign_temporary (temporary);
 	     }
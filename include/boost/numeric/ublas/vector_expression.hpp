@@ -581,8 +581,8 @@ namespace boost { namespace numeric { namespace ublas {
             return BOOST_UBLAS_SAME (e1_.size (), e2_.size ()); 
         }
 
-    private:
-        // Accessors
+    public:
+        // Expression accessors
         BOOST_UBLAS_INLINE
         const expression1_closure_type &expression1 () const {
             return e1_;
@@ -1036,6 +1036,17 @@ namespace boost { namespace numeric { namespace ublas {
             return e2_.size ();
         }
 
+    public:
+        // Expression accessors
+        BOOST_UBLAS_INLINE
+        expression1_closure_type expression1 () const {
+            return e1_;
+        }
+        BOOST_UBLAS_INLINE
+        const expression2_closure_type &expression2 () const {
+            return e2_;
+        }
+
     public:
         // Element access
         BOOST_UBLAS_INLINE
@@ -1279,6 +1290,17 @@ namespace boost { namespace numeric { namespace ublas {
             return e1_.size (); 
         }
 
+    public:
+        // Expression accessors
+        BOOST_UBLAS_INLINE
+        const expression1_closure_type &expression1 () const {
+            return e1_;
+        }
+        BOOST_UBLAS_INLINE
+        expression2_closure_type expression2 () const {
+            return e2_;
+        }
+
     public:
         // Element access
         BOOST_UBLAS_INLINE
@@ -1589,6 +1611,16 @@ namespace boost { namespace numeric { namespace ublas {
         return expression_type (e ());
     }
 
+    // sum v with the summation S of the dense case, one of naive_summation_tag,
+    // pairwise_summation_tag or compensated_summation_tag
+    template<class E, class S>
+    BOOST_UBLAS_INLINE
+    typename vector_scalar_unary_traits<E, vector_sum<E, S> >::result_type
+    sum (const vector_expression<E> &e, S) {
+        typedef typename vector_scalar_unary_traits<E, vector_sum<E, S> >::expression_type expression_type;
+        return expression_type (e ());
+    }
+
     // real: norm_1 v = sum (abs (v [i]))
     // complex: norm_1 v = sum (abs (real (v [i])) + abs (imag (v [i])))
     template<class E>
@@ -1609,6 +1641,14 @@ namespace boost { namespace numeric { namespace ublas {
         return expression_type (e ());
     }
 
+    template<class E, class S>
+    BOOST_UBLAS_INLINE
+    typename vector_scalar_unary_traits<E, vector_norm_2<E, S> >::result_type
+    norm_2 (const vector_expression<E> &e, S) {
+        typedef typename vector_scalar_unary_traits<E, vector_norm_2<E, S> >::expression_type expression_type;
+        return expression_type (e ());
+    }
+
     // real: norm_2_square v = sum(v [i] * v [i])
     // complex: norm_2_square v = sum(v [i] * conj (v [i]))
     template<class E>
@@ -1619,6 +1659,14 @@ namespace boost { namespace numeric { namespace ublas {
         return expression_type (e ());
     }
 
+    template<class E, class S>
+    BOOST_UBLAS_INLINE
+    typename vector_scalar_unary_traits<E, vector_norm_2_square<E, S> >::result_type
+    norm_2_square (const vector_expression<E> &e, S) {
+        typedef typename vector_scalar_unary_traits<E, vector_norm_2_square<E, S> >::expression_type expression_type;
+        return expression_type (e ());
+    }
+
     // real: norm_inf v = maximum (abs (v [i]))
     // complex: norm_inf v = maximum (maximum (abs (real (v [i])), abs (imag (v [i]))))
     template<class E>
@@ -1744,6 +1792,20 @@ namespace boost { namespace numeric { namespace ublas {
         return expression_type (e1 (), e2 ());
     }
 
+    // inner_prod (v1, v2) with the summation S of the dense case
+    template<class E1, class E2, class S>
+    BOOST_UBLAS_INLINE
+    typename vector_scalar_binary_traits<E1, E2, vector_inner_prod<E1, E2,
+                                                                   typename promote_traits<typename E1::value_type,
+                                                                                           typename E2::value_type>::promote_type, S> >::result_type
+    inner_prod (const vector_expression<E1> &e1,
+                const vector_expression<E2> &e2, S) {
+        typedef typename vector_scalar_binary_traits<E1, E2, vector_inner_prod<E1, E2,
+                                                                   typename promote_traits<typename E1::value_type,
+                                                                                           typename E2::value_type>::promote_type, S> >::expression_type expression_type;
+        return expression_type (e1 (), e2 ());
+    }
+
     template<class E1, class E2>
     BOOST_UBLAS_INLINE
     typename vector_scalar_binary_traits<E1, E2, vector_inner_prod<E1, E2,
@@ -7,8 +7,11 @@
 #ifndef _HPP_TESTHELPER_
 #define _HPP_TESTHELPER_
 
+#include <complex>
+#include <cstddef>
 #include <utility>
 #include <iostream>
+#include <boost/numeric/ublas/fwd.hpp>
 #include <boost/numeric/ublas/vector_expression.hpp>
 #include <boost/numeric/ublas/matrix_expression.hpp>
 #include <boost/mpl/if.hpp>
@@ -162,4 +165,64 @@ bool compare_distance( const boost::numeric::ublas::vector_expression<M1> & m1,
 }
 
 
+// Quarters and halves of small integers, so that sums of their products are
+// exact whatever the order of the evaluation.
+
+template < class M >
+void fill( M & m, std::size_t k ) {
+  for (std::size_t i=0; i < m.size1(); ++i) {
+    for (std::size_t j=0; j < m.size2(); ++j) {
+      m(i,j) = typename M::value_type(double((3*i + 7*j + k) % 11) - 5) / typename M::value_type(4);
+    }
+  }
+}
+
+template < class T, class L, class A >
+void fill( boost::numeric::ublas::matrix<std::complex<T>, L, A> & m, std::size_t k ) {
+  for (std::size_t i=0; i < m.size1(); ++i) {
+    for (std::size_t j=0; j < m.size2(); ++j) {
+      m(i,j) = std::complex<T>(T((3*i + 7*j + k) % 11) - 5, T((i + 2*j + k) % 5) - 2) / T(4);
+    }
+  }
+}
+
+template < class V >
+void fill_vector( V & v, std::size_t k ) {
+  for (std::size_t i=0; i < v.size(); ++i) {
+    v(i) = typename V::value_type(double((5*i + k) % 7) - 3) / typename V::value_type(2);
+  }
+}
+
+// Products one dot product at a time, to check the kernels against.
+
+template < class M, class E1, class E2 >
+M reference_prod( const E1 & a, const E2 & b ) {
+  M c(a.size1(), b.size2());
+  for (std::size_t i=0; i < c.size1(); ++i) {
+    for (std::size_t j=0; j < c.size2(); ++j) {
+      typename M::value_type t = typename M::value_type();
+      for (std::size_t k=0; k < a.size2(); ++k) {
+        t += a(i,k) * b(k,j);
+      }
+      c(i,j) = t;
+    }
+  }
+  return c;
+}
+
+template < class M, class V >
+V reference_prod( const boost::numeric::ublas::matrix_expression<M> & m,
+                  const boost::numeric::ublas::vector_expression<V> & x ) {
+  V y(m().size1());
+  for (std::size_t i=0; i < m().size1(); ++i) {
+    typename V::value_type t = typename V::value_type();
+    for (std::size_t j=0; j < m().size2(); ++j) {
+      t += m()(i,j) * x()(j);
+    }
+    y(i) = t;
+  }
+  return y;
+}
+
+
 #endif
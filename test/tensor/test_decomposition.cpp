@@ -0,0 +1,261 @@
+//  Copyright (c) 2019
+//  The Boost.uBLAS developers
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+
+
+#include <boost/test/unit_test.hpp>
+#include <boost/numeric/ublas/tensor.hpp>
+#include <boost/numeric/ublas/matrix.hpp>
+
+#include <cmath>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(test_decomposition)
+
+using test_types = std::tuple<boost::numeric::ublas::first_order, boost::numeric::ublas::last_order>;
+
+
+// factor matrices with entries of mixed signs
+template<class matrix_type>
+std::vector<matrix_type> factors(boost::numeric::ublas::shape const& n, std::vector<std::size_t> const& r)
+{
+	auto u = std::vector<matrix_type>{};
+	for(auto k = 0u; k < n.size(); ++k){
+		u.emplace_back( n[k], r[k] );
+		for(auto i = 0u; i < n[k]; ++i)
+			for(auto j = 0u; j < r[k]; ++j)
+				u[k](i,j) = std::sin( double((i+1)*(j+1)) + 0.5*k );
+	}
+	return u;
+}
+
+template<class tensor_type, class matrix_type>
+tensor_type tucker(tensor_type x, std::vector<matrix_type> const& u)
+{
+	for(auto k = 0u; k < u.size(); ++k)
+		x = boost::numeric::ublas::prod( x, u[k], k+1 );
+	return x;
+}
+
+template<class tensor_type>
+double relative_error(tensor_type const& x, tensor_type const& a)
+{
+	return boost::numeric::ublas::norm( x - a ) / boost::numeric::ublas::norm( a );
+}
+
+
+BOOST_AUTO_TEST_CASE( test_decomposition_eigh )
+{
+	using namespace boost::numeric::ublas::detail::decomposition;
+
+	auto const n = 5u;
+	auto g = std::vector<double>(n*n);
+	for(auto i = 0u; i < n; ++i)
+		for(auto j = 0u; j < n; ++j)
+			g[i*n+j] = 1.0/(i+j+1) + (i == j ? 1.0 : 0.0);
+	auto const g0 = g;
+
+	auto q = std::vector<double>{};
+	auto const w = eigh( n, g, q );
+	BOOST_CHECK( std::is_sorted( w.rbegin(), w.rend() ) );
+
+	// G = Q diag(w) Q^T and Q^T Q = I
+	for(auto i = 0u; i < n; ++i)
+		for(auto j = 0u; j < n; ++j){
+			auto gij = 0.0, qij = 0.0;
+			for(auto k = 0u; k < n; ++k){
+				gij += q[i*n+k] * w[k] * q[j*n+k];
+				qij += q[k*n+i] * q[k*n+j];
+			}
+			BOOST_CHECK_SMALL( gij - g0[i*n+j], 1e-12 );
+			BOOST_CHECK_SMALL( qij - (i == j ? 1.0 : 0.0), 1e-12 );
+		}
+
+	// pseudo-inverse of a singular matrix, H G H = H
+	auto s = std::vector<double>{ 1, 2, 2, 4 };
+	auto const h = pinv( 2, s );
+	auto const hgh = [&h,&s](auto i, auto j){
+		auto v = 0.0;
+		for(auto k = 0u; k < 2; ++k)
+			for(auto l = 0u; l < 2; ++l)
+				v += h[i*2+k] * s[k*2+l] * h[l*2+j];
+		return v;
+	};
+	for(auto i = 0u; i < 2; ++i)
+		for(auto j = 0u; j < 2; ++j)
+			BOOST_CHECK_SMALL( hgh(i,j) - h[i*2+j], 1e-12 );
+}
+
+
+BOOST_AUTO_TEST_CASE_TEMPLATE( test_decomposition_kernels, layout, test_types)
+{
+	using namespace boost::numeric;
+
+	using value_type  = double;
+	using tensor_type = ublas::tensor<value_type,layout>;
+	using matrix_type = ublas::matrix<value_type,layout>;
+
+	auto const n = ublas::shape{4,3,5};
+	auto t = tensor_type( n );
+	for(auto i = 0u; i < t.size(); ++i)
+		t[i] = value_type( (i*7) % 11 ) - 5;
+
+	auto const idx = [&n](auto x){
+		return std::vector<std::size_t>{ x % n[0], (x / n[0]) % n[1], x / (n[0]*n[1]) };
+	};
+	auto const size = n.product();
+
+	auto const R = 3u;
+	auto const u = factors<matrix_type>( n, {R,R,R} );
+	auto const nn = std::vector<std::size_t>( n.begin(), n.end() );
+
+	for(auto m = 1u; m <= n.size(); ++m){
+		auto const nm = n[m-1];
+
+		// Gram matrix of the mode-m unfolding
+		auto const g = ublas::detail::decomposition::gram<layout>( t.data(), nn, m );
+		for(auto i = 0u; i < nm; ++i)
+			for(auto j = 0u; j < nm; ++j){
+				auto e = value_type{};
+				for(auto x = 0u; x < size; ++x)
+					for(auto y = 0u; y < size; ++y){
+						auto const ix = idx(x), iy = idx(y);
+						auto same = ix[m-1] == i && iy[m-1] == j;
+						for(auto k = 0u; k < n.size(); ++k)
+							same = same && (k == m-1 || ix[k] == iy[k]);
+						if(same)
+							e += t.at(ix[0],ix[1],ix[2]) * t.at(iy[0],iy[1],iy[2]);
+					}
+				BOOST_CHECK_EQUAL( g[i*nm+j], e );
+			}
+
+		// mttkrp against the loop definition and the sparse kernel
+		auto const c = ublas::mttkrp( t, u, m );
+		BOOST_CHECK_EQUAL( c.size1(), nm );
+		BOOST_CHECK_EQUAL( c.size2(), R );
+		auto const s = ublas::mttkrp( ublas::compressed_tensor<value_type>( t ), u, m );
+		for(auto i = 0u; i < nm; ++i)
+			for(auto r = 0u; r < R; ++r){
+				auto e = value_type{};
+				for(auto x = 0u; x < size; ++x){
+					auto const ix = idx(x);
+					if(ix[m-1] != i)
+						continue;
+					auto v = t.at(ix[0],ix[1],ix[2]);
+					for(auto k = 0u; k < n.size(); ++k)
+						if(k != m-1)
+							v *= u[k](ix[k],r);
+					e += v;
+				}
+				BOOST_CHECK_SMALL( c(i,r) - e, 1e-10 );
+				BOOST_CHECK_SMALL( c(i,r) - s(i,r), 1e-10 );
+			}
+	}
+
+	BOOST_CHECK_THROW( ublas::mttkrp( t, u, 0 ), std::length_error );
+	BOOST_CHECK_THROW( ublas::mttkrp( t, std::vector<matrix_type>( u.begin(), u.end()-1 ), 1 ), std::length_error );
+	BOOST_CHECK_THROW( ublas::mttkrp( t, factors<matrix_type>( n, {R,R+1,R} ), 1 ), std::length_error );
+}
+
+
+BOOST_AUTO_TEST_CASE_TEMPLATE( test_decomposition_tucker, layout, test_types)
+{
+	using namespace boost::numeric;
+
+	using value_type  = double;
+	using tensor_type = ublas::tensor<value_type,layout>;
+	using matrix_type = ublas::matrix<value_type,layout>;
+
+	// tensor of multilinear rank (2,3,2)
+	auto const n = ublas::shape{6,5,4};
+	auto const r = std::vector<std::size_t>{2,3,2};
+	auto core = tensor_type( ublas::shape{2,3,2} );
+	for(auto i = 0u; i < core.size(); ++i)
+		core[i] = value_type(i+1) * (i % 2 ? -1 : 1);
+	auto const a = tucker( core, factors<matrix_type>( n, r ) );
+
+	auto const h = ublas::hosvd( a, r );
+	BOOST_CHECK( (h.core.extents() == ublas::shape{2,3,2}) );
+	BOOST_CHECK_EQUAL( h.fit.size(), 1 );
+	BOOST_CHECK_CLOSE( h.fit.back(), 1.0, 1e-4 );
+	BOOST_CHECK_SMALL( relative_error( ublas::reconstruct( h ), a ), 1e-10 );
+
+	// factors have orthonormal columns
+	for(auto k = 0u; k < n.size(); ++k){
+		auto const& uk = h.factors[k];
+		BOOST_CHECK_EQUAL( uk.size1(), n[k] );
+		BOOST_CHECK_EQUAL( uk.size2(), r[k] );
+		auto const q = ublas::matrix<value_type>( ublas::prod( ublas::trans( uk ), uk ) );
+		for(auto i = 0u; i < r[k]; ++i)
+			for(auto j = 0u; j < r[k]; ++j)
+				BOOST_CHECK_SMALL( q(i,j) - (i == j ? 1.0 : 0.0), 1e-12 );
+	}
+
+	// truncation below the multilinear rank improves with every iteration
+	auto const t = ublas::hooi( a, {2,2,2}, 20 );
+	BOOST_CHECK( !t.fit.empty() );
+	BOOST_CHECK( t.fit.size() <= 20 );
+	for(auto i = 1u; i < t.fit.size(); ++i)
+		BOOST_CHECK_GE( t.fit[i], t.fit[i-1] - 1e-12 );
+	BOOST_CHECK_GE( t.fit.front(), ublas::hosvd( a, {2,2,2} ).fit.back() - 1e-12 );
+	BOOST_CHECK_CLOSE( t.fit.back(), 1.0 - relative_error( ublas::reconstruct( t ), a ), 1e-6 );
+
+	auto const f = ublas::hooi( a, r );
+	BOOST_CHECK_CLOSE( f.fit.back(), 1.0, 1e-4 );
+	BOOST_CHECK_SMALL( relative_error( ublas::reconstruct( f ), a ), 1e-10 );
+
+	BOOST_CHECK_THROW( ublas::hosvd( a, {2,3} ), std::length_error );
+	BOOST_CHECK_THROW( ublas::hosvd( a, {2,0,2} ), std::length_error );
+	BOOST_CHECK_THROW( ublas::hooi( a, {7,3,2} ), std::length_error );
+}
+
+
+BOOST_AUTO_TEST_CASE_TEMPLATE( test_decomposition_cp, layout, test_types)
+{
+	using namespace boost::numeric;
+
+	using value_type  = double;
+	using tensor_type = ublas::tensor<value_type,layout>;
+	using matrix_type = ublas::matrix<value_type,layout>;
+
+	// sum of two outer products
+	auto const n = ublas::shape{5,4,3};
+	auto const u = factors<matrix_type>( n, {2,2,2} );
+	auto core = tensor_type( ublas::shape{2,2,2}, value_type{} );
+	core.at(0,0,0) = 3;
+	core.at(1,1,1) = 1;
+	auto const a = tucker( core, u );
+
+	auto const c = ublas::cp_als( a, 2, 500, 1e-12 );
+	BOOST_CHECK_EQUAL( c.lambda.size(), 2 );
+	BOOST_CHECK_EQUAL( c.factors.size(), 3 );
+	BOOST_CHECK( !c.fit.empty() );
+	BOOST_CHECK_GT( c.fit.back(), 0.999 );
+	BOOST_CHECK_SMALL( relative_error( ublas::reconstruct( c ), a ), 1e-3 );
+	BOOST_CHECK_CLOSE( c.fit.back(), 1.0 - relative_error( ublas::reconstruct( c ), a ), 1e-3 );
+
+	for(auto k = 0u; k < n.size(); ++k)
+		for(auto r = 0u; r < 2; ++r){
+			auto l = value_type{};
+			for(auto i = 0u; i < n[k]; ++i)
+				l += c.factors[k](i,r) * c.factors[k](i,r);
+			BOOST_CHECK_CLOSE( l, 1.0, 1e-8 );
+		}
+
+	// more components than some extents
+	auto const d = ublas::cp_als( a, 4, 10 );
+	BOOST_CHECK_EQUAL( d.lambda.size(), 4 );
+	BOOST_CHECK( d.fit.size() <= 10 );
+	BOOST_CHECK_CLOSE( d.fit.back(), 1.0 - relative_error( ublas::reconstruct( d ), a ), 1e-3 );
+
+	BOOST_CHECK_THROW( ublas::cp_als( a, 0 ), std::length_error );
+	BOOST_CHECK_THROW( ublas::cp_als( tensor_type{}, 2 ), std::length_error );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
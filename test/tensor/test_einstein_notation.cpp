@@ -118,5 +118,143 @@ BOOST_AUTO_TEST_CASE_TEMPLATE( test_einstein_multiplication, value,  test_types
 	}
 }
 
-BOOST_AUTO_TEST_SUITE_END()
 
+BOOST_AUTO_TEST_CASE_TEMPLATE( test_einstein_einsum, value,  test_types )
+{
+	using namespace boost::numeric::ublas;
+	using value_type   = typename value::first_type;
+	using layout_type  = typename value::second_type;
+	using tensor_type  = tensor<value_type,layout_type>;
+	using namespace boost::numeric::ublas::index;
+
+	auto fill = [](tensor_type& t, int offset){
+		for(auto i = 0u; i < t.size(); ++i)
+			t[i] = value_type( int(i % 7) + offset );
+	};
+
+	auto A  = tensor_type{4,3,2};
+	auto B  = tensor_type{4,5};
+	auto C  = tensor_type{5,3};
+	auto v1 = tensor_type{4,1};
+	auto v2 = tensor_type{3,1};
+	auto v3 = tensor_type{2,1};
+	fill(A,1); fill(B,2); fill(C,-1); fill(v1,1); fill(v2,3); fill(v3,2);
+
+	{
+		// contracts all modes of A with three vectors
+		tensor_type c = einsum( A(_i,_j,_k), v1(_i,_), v2(_j,_), v3(_k,_) );
+
+		auto const r = prod( prod( prod( A, v1, std::vector<std::size_t>{1}, std::vector<std::size_t>{1} ),
+		                           v2, std::vector<std::size_t>{1}, std::vector<std::size_t>{1} ),
+		                     v3, std::vector<std::size_t>{1}, std::vector<std::size_t>{1} );
+
+		BOOST_CHECK_EQUAL( c.rank(), 3 );
+		BOOST_CHECK_EQUAL( c.size(), 1 );
+		BOOST_CHECK_EQUAL( c[0], r[0] );
+	}
+
+	{
+		// matrix chain with the free indices of B and C in reverse order
+		auto const a = tensor_type{3,4};
+		auto const d = tensor_type{5,2};
+		auto a_ = a; auto d_ = d;
+		fill(a_,1); fill(d_,2);
+
+		tensor_type c = einsum( a_(_i,_j), B(_j,_k), d_(_k,_l) );
+		tensor_type r = prod( prod( a_, B, std::vector<std::size_t>{2}, std::vector<std::size_t>{1} ), d_, std::vector<std::size_t>{2}, std::vector<std::size_t>{1} );
+
+		BOOST_CHECK( c.extents() == (shape{3,2}) );
+		BOOST_CHECK( c == r );
+	}
+
+	{
+		// free indices are ordered from left to right
+		auto const AB = einsum( A(_,_j,_), B(_,_k), C(_k,_j) );
+		BOOST_CHECK( AB.extents() == (shape{4,2,4}) );
+
+		auto const BC = prod( B, C, std::vector<std::size_t>{2}, std::vector<std::size_t>{1} ); // 4x3
+		for(auto l = 0u; l < 4; ++l)
+			for(auto k = 0u; k < 2; ++k)
+				for(auto i = 0u; i < 4; ++i){
+					auto sum = value_type{};
+					for(auto j = 0u; j < 3; ++j)
+						sum += A.at(i,j,k) * BC.at(l,j);
+					BOOST_CHECK_EQUAL( AB.at(i,k,l), sum );
+				}
+	}
+
+	{
+		// contractions of temporaries and within expressions
+		auto const AB = tensor_type( A(_i,_j,_) * v1(_i,_) );
+		auto const AC = tensor_type( AB(_j,_k,_) * v2(_j,_) );
+
+		tensor_type c1 = einsum( tensor_type( A(_i,_j,_) * v1(_i,_) )(_j,_,_), v2(_j,_), v1(_,_) );
+		tensor_type c3 = AC + einsum( A(_i,_j,_k), v1(_i,_), v2(_j,_) ) + AC;
+
+		// free indices with extent one are kept as for prod
+		BOOST_CHECK( AC.extents() == (shape{2,1,1}) );
+		BOOST_CHECK( c1.extents() == (shape{2,1,1,4,1}) );
+		for(auto j = 0u; j < 4; ++j)
+			for(auto i = 0u; i < 2; ++i)
+				BOOST_CHECK_EQUAL( c1.at(i,0,0,j,0), AC[i]*v1[j] );
+
+		BOOST_CHECK( c3.extents() == AC.extents() );
+		for(auto i = 0u; i < c3.size(); ++i)
+			BOOST_CHECK_EQUAL( c3[i], value_type(3)*AC[i] );
+	}
+
+	{
+		// the product of two tensors is evaluated at once and can be written
+		auto a = tensor_type{2,3}, b = tensor_type{3,2};
+		fill(a,1); fill(b,1);
+		auto c = a(_i,_j) * b(_j,_k);
+		auto const c00 = c.at(0,0);
+		a.at(0,0) = value_type(100);
+		BOOST_CHECK_EQUAL( c.at(0,0), c00 );
+		c.at(0,0) = value_type(3);
+		BOOST_CHECK_EQUAL( c.at(0,0), value_type(3) );
+	}
+
+	{
+		BOOST_CHECK_THROW( einsum( A(_i,_j,_k), B(_j,_), C(_,_k) ), std::runtime_error );
+		BOOST_CHECK_THROW( einsum( A(_i,_i,_k), v3(_k,_) ), std::runtime_error );
+		BOOST_CHECK_THROW( einsum( A(_i,_j,_k), v1(_i,_), v1(_i,_) ), std::runtime_error );
+	}
+}
+
+
+BOOST_AUTO_TEST_CASE( test_einstein_contraction_path )
+{
+	using namespace boost::numeric::ublas;
+
+	// (A*B)*v costs 2*50*50*50+50*50 multiply-adds, A*(B*v) only 2*50*50
+	auto const labels  = std::vector<std::vector<std::size_t>>{ {0,1}, {1,2}, {2} };
+	auto const extents = std::vector<std::size_t>{50,50,50};
+
+	auto const path = detail::contraction_path( labels, extents );
+	BOOST_REQUIRE_EQUAL( path.size(), 2 );
+	BOOST_CHECK_EQUAL( path[0].left, 1 );
+	BOOST_CHECK_EQUAL( path[0].right, 2 );
+	BOOST_CHECK_EQUAL( path[1].left, 0 );
+	BOOST_CHECK_EQUAL( path[1].right, 3 );
+
+	// a chain of matrices and vectors exceeding the exhaustive search
+	auto const n = detail::contraction_path_exhaustive + 2;
+	auto chain_labels  = std::vector<std::vector<std::size_t>>{};
+	auto chain_extents = std::vector<std::size_t>(n+1, 8);
+	for(auto i = 0u; i < n; ++i)
+		chain_labels.push_back( {i,i+1} );
+	chain_labels.back() = {n-1};
+
+	// the vector is multiplied from the right through the chain
+	auto const greedy = detail::contraction_path( chain_labels, chain_extents );
+	BOOST_REQUIRE_EQUAL( greedy.size(), n-1 );
+	BOOST_CHECK_EQUAL( greedy[0].left, n-2 );
+	BOOST_CHECK_EQUAL( greedy[0].right, n-1 );
+	for(auto k = 1u; k < n-1; ++k){
+		BOOST_CHECK_EQUAL( greedy[k].left, n-2-k );
+		BOOST_CHECK_EQUAL( greedy[k].right, n+k-1 );
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
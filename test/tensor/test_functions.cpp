@@ -13,9 +13,12 @@
 
 #include <iostream>
 #include <algorithm>
+#include <numeric>
 #include <boost/numeric/ublas/tensor.hpp>
 #include <boost/numeric/ublas/matrix.hpp>
 #include <boost/numeric/ublas/vector.hpp>
+#include <boost/numeric/ublas/matrix_proxy.hpp>
+#include <boost/numeric/ublas/vector_proxy.hpp>
 
 #include <boost/test/unit_test.hpp>
 
@@ -108,6 +111,64 @@ BOOST_FIXTURE_TEST_CASE_TEMPLATE( test_tensor_prod_matrix, value,  test_types, f
 
 
 
+BOOST_FIXTURE_TEST_CASE_TEMPLATE( test_tensor_prod_strided, value,  test_types, fixture )
+{
+	using namespace boost::numeric;
+	using value_type   = typename value::first_type;
+	using layout_type  = typename value::second_type;
+	using tensor_type  = ublas::tensor<value_type,layout_type>;
+	using vector_type  = typename tensor_type::vector_type;
+	using matrix_type  = typename tensor_type::matrix_type;
+	using other_layout = std::conditional_t<std::is_same<layout_type,ublas::first_order>::value, ublas::last_order, ublas::first_order>;
+	using other_matrix_type = ublas::matrix<value_type,other_layout>;
+
+
+	for(auto const& n : extents){
+
+		auto a = tensor_type(n);
+		for(auto i = 0u; i < a.size(); ++i)
+			a[i] = value_type(i % 7);
+
+		for(auto m = 0u; m < n.size(); ++m){
+
+			// proxies of larger operands are read in place
+			auto v = vector_type(2*n[m]+3);
+			for(auto i = 0u; i < v.size(); ++i)
+				v[i] = value_type(i % 5);
+			auto vr = ublas::vector_range<vector_type>(v, ublas::range(3, 3+n[m]));
+			auto vs = ublas::vector_slice<vector_type>(v, ublas::slice(1, 2, n[m]));
+			auto vn = ublas::vector_slice<vector_type>(v, ublas::slice(2*n[m], -2, n[m]));
+
+			BOOST_CHECK( ublas::prod(a, vr, m+1) == ublas::prod(a, vector_type(vr), m+1) );
+			BOOST_CHECK( ublas::prod(a, vs, m+1) == ublas::prod(a, vector_type(vs), m+1) );
+			BOOST_CHECK( ublas::prod(a, vn, m+1) == ublas::prod(a, vector_type(vn), m+1) );
+
+			auto q = 3u;
+			auto b = matrix_type(q+2, 2*n[m]+1);
+			auto bo = other_matrix_type(q, n[m]);
+			for(auto i = 0u; i < b.size1(); ++i)
+				for(auto j = 0u; j < b.size2(); ++j)
+					b(i,j) = value_type((i + 3*j) % 4);
+			for(auto i = 0u; i < q; ++i)
+				for(auto j = 0u; j < n[m]; ++j)
+					bo(i,j) = b(i,j);
+			auto bs = ublas::matrix_slice<matrix_type>(b, ublas::slice(1, 1, q), ublas::slice(1, 2, n[m]));
+
+			BOOST_CHECK( ublas::prod(a, bs, m+1) == ublas::prod(a, matrix_type(bs), m+1) );
+			BOOST_CHECK( ublas::prod(a, bo, m+1) == ublas::prod(a, matrix_type(bo), m+1) );
+
+			auto bt = matrix_type(n[m], 3);
+			for(auto i = 0u; i < bt.size1(); ++i)
+				for(auto j = 0u; j < bt.size2(); ++j)
+					bt(i,j) = value_type((2*i + j) % 3);
+			BOOST_CHECK( ublas::prod(a, ublas::column(bt, 1), m+1) == ublas::prod(a, vector_type(ublas::column(bt, 1)), m+1) );
+		}
+	}
+}
+
+
+
+
 BOOST_FIXTURE_TEST_CASE_TEMPLATE( test_tensor_prod_tensor_1, value,  test_types, fixture )
 {
 	using namespace boost::numeric;
@@ -218,6 +279,61 @@ BOOST_FIXTURE_TEST_CASE_TEMPLATE( test_tensor_prod_tensor_2, value,  test_types,
 
 
 
+BOOST_AUTO_TEST_CASE_TEMPLATE( test_tensor_batched_prod, value,  test_types )
+{
+	using namespace boost::numeric;
+	using value_type   = typename value::first_type;
+	using layout_type  = typename value::second_type;
+	using tensor_type  = ublas::tensor<value_type,layout_type>;
+	using other_layout = std::conditional_t<std::is_same<layout_type,ublas::first_order>::value, ublas::last_order, ublas::first_order>;
+	using other_tensor_type = ublas::tensor<value_type,other_layout>;
+
+	auto const first = std::is_same<layout_type,ublas::first_order>::value;
+	auto const batch = 5ul;
+
+	// the batch mode is the slowest one, slices are contiguous
+	auto const batched = [first,batch](ublas::shape const& n){
+		auto nk = std::vector<std::size_t>(n.begin(), n.end());
+		nk.insert(first ? nk.end() : nk.begin(), batch);
+		auto t = tensor_type(ublas::shape(nk));
+		for(auto i = 0u; i < t.size(); ++i)
+			t[i] = value_type( (i*3) % 7 ) - value_type(3);
+		return t;
+	};
+	auto const slice = [](tensor_type const& t, ublas::shape const& n, std::size_t k){
+		auto s = tensor_type(n);
+		std::copy(t.begin() + k*s.size(), t.begin() + (k+1)*s.size(), s.begin());
+		return s;
+	};
+
+	auto const check = [&](ublas::shape const& na, ublas::shape const& nb, std::vector<std::size_t> const& phia, std::vector<std::size_t> const& phib){
+		auto const a = batched(na);
+		auto const b = batched(nb);
+		auto const c = ublas::batched_prod(a, b, phia, phib);
+		BOOST_CHECK_EQUAL( c.extents().at(first ? c.rank()-1 : 0), batch );
+		for(auto k = 0ul; k < batch; ++k){
+			auto const ck = ublas::prod(slice(a, na, k), slice(b, nb, k), phia, phib);
+			BOOST_CHECK_EQUAL( c.size(), batch*ck.size() );
+			BOOST_CHECK( std::equal(ck.begin(), ck.end(), c.begin() + k*ck.size()) );
+		}
+		BOOST_CHECK( ublas::batched_prod(a, other_tensor_type(b), phia, phib) == c );
+	};
+
+	check( ublas::shape{3,4}, ublas::shape{4,2}, {2}, {1} );
+	check( ublas::shape{3,4}, ublas::shape{2,3}, {1}, {2} );
+	check( ublas::shape{2,3,4}, ublas::shape{4,3,2}, {2,3}, {2,1} );
+	check( ublas::shape{3,1,4}, ublas::shape{3,4}, {1,3}, {1,2} );
+	check( ublas::shape{2,3}, ublas::shape{3,2}, {}, {} );
+
+	auto const a = batched( ublas::shape{3,4} );
+	BOOST_CHECK( ublas::batched_prod(a, a, {1,2}) == ublas::batched_prod(a, a, {1,2}, {1,2}) );
+	BOOST_CHECK_THROW( ublas::batched_prod(a, tensor_type( first ? ublas::shape{4,2,3} : ublas::shape{3,4,2} ), {2}, {1}), std::runtime_error );
+	BOOST_CHECK_THROW( ublas::batched_prod(a, batched( ublas::shape{3,2} ), {2}, {1}), std::runtime_error );
+	BOOST_CHECK_THROW( ublas::batched_prod(a, a, {2}, {1,2}), std::runtime_error );
+	BOOST_CHECK_THROW( ublas::batched_prod(a, a, {3}, {1}), std::runtime_error );
+}
+
+
 BOOST_FIXTURE_TEST_CASE_TEMPLATE( test_tensor_inner_prod, value,  test_types, fixture )
 {
 	using namespace boost::numeric;
@@ -240,6 +356,43 @@ BOOST_FIXTURE_TEST_CASE_TEMPLATE( test_tensor_inner_prod, value,  test_types, fi
 }
 
 
+BOOST_FIXTURE_TEST_CASE_TEMPLATE( test_tensor_prod_mixed_layout, value,  test_types, fixture )
+{
+	using namespace boost::numeric;
+	using value_type   = typename value::first_type;
+	using layout_type  = typename value::second_type;
+	using tensor_type  = ublas::tensor<value_type,layout_type>;
+	using other_layout = std::conditional_t<std::is_same<layout_type,ublas::first_order>::value, ublas::last_order, ublas::first_order>;
+	using other_tensor_type = ublas::tensor<value_type,other_layout>;
+
+	auto shapes = extents;
+	shapes.push_back( fixture::extents_type{40,3,35} );
+
+	for(auto const& n : shapes) {
+
+		auto a = tensor_type(n);
+		auto b = other_tensor_type(n);
+		for(auto i = 0u; i < a.size(); ++i){
+			a[i] = value_type(i % 7);
+			b[i] = value_type(i % 5);
+		}
+		auto const bc = tensor_type(b);
+
+		BOOST_CHECK_EQUAL( ublas::inner_prod(a, b), ublas::inner_prod(a, bc) );
+
+		auto phi = std::vector<std::size_t>(n.size());
+		std::iota(phi.begin(), phi.end(), 1ul);
+		for(auto q = 1ul; q <= n.size(); ++q){
+			auto const phiq = std::vector<std::size_t>(phi.begin(), phi.begin()+q);
+			BOOST_CHECK( ublas::prod(a, b, phiq) == ublas::prod(a, bc, phiq) );
+		}
+
+		if(a.size() < 1000u)
+			BOOST_CHECK( ublas::outer_prod(a, b) == ublas::outer_prod(a, bc) );
+	}
+}
+
+
 BOOST_FIXTURE_TEST_CASE_TEMPLATE( test_tensor_norm, value,  test_types, fixture )
 {
 	using namespace boost::numeric;
@@ -270,6 +423,71 @@ BOOST_FIXTURE_TEST_CASE_TEMPLATE( test_tensor_norm, value,  test_types, fixture
 }
 
 
+using reduction_types = zip<int,double>::with_t<boost::numeric::ublas::first_order, boost::numeric::ublas::last_order>;
+
+BOOST_FIXTURE_TEST_CASE_TEMPLATE( test_tensor_reductions, value,  reduction_types, fixture )
+{
+	using namespace boost::numeric;
+	using value_type   = typename value::first_type;
+	using layout_type  = typename value::second_type;
+	using tensor_type  = ublas::tensor<value_type,layout_type>;
+
+	// the last extents span several chunks of the reductions
+	auto all_extents = extents;
+	all_extents.push_back( ublas::shape{40,30,20} );
+
+	for(auto const& n : all_extents) {
+
+		auto a  = tensor_type(n);
+		auto b  = tensor_type(n);
+		for(auto i = 0u; i < a.size(); ++i){
+			a[i] = value_type( int(i*7u % 13u) - 6 );
+			b[i] = value_type( int(i*3u % 5u) - 2 );
+		}
+
+		// references from evaluated expressions
+		auto const c = tensor_type( a - b );
+		auto const d = tensor_type( a * b );
+		auto const s = std::accumulate( c.begin(), c.end(), value_type{} );
+		auto const q = std::accumulate( c.begin(), c.end(), value_type{}, [](auto l, auto r){ return l + r*r; } );
+
+		BOOST_CHECK_EQUAL( ublas::sum( a - b ), s );
+		BOOST_CHECK_EQUAL( ublas::sum( c ), s );
+		BOOST_CHECK_EQUAL( ublas::norm( a - b ), std::sqrt( q ) );
+		BOOST_CHECK_EQUAL( ublas::inner_prod( a - b, a - b ), q );
+		BOOST_CHECK_EQUAL( ublas::inner_prod( a - b, c ), q );
+		BOOST_CHECK_EQUAL( ublas::inner_prod( c, c ), q );
+		BOOST_CHECK_EQUAL( (ublas::max)( a * b ), *std::max_element( d.begin(), d.end() ) );
+		BOOST_CHECK_EQUAL( (ublas::min)( a * b ), *std::min_element( d.begin(), d.end() ) );
+		BOOST_CHECK_EQUAL( (ublas::max)( -c ), -*std::min_element( c.begin(), c.end() ) );
+
+		BOOST_CHECK( a - b == c );
+		BOOST_CHECK( a - b <= a - b + value_type(1) );
+		BOOST_CHECK( !( a - b < c ) );
+	}
+
+	// views are evaluated through their strides
+	auto t = tensor_type( ublas::shape{30,20,10} );
+	for(auto i = 0u; i < t.size(); ++i)
+		t[i] = value_type( int(i % 17u) - 8 );
+	auto const v = ublas::project( t, ublas::range(1,29), ublas::slice(0,2,10), ublas::range::all() );
+	auto const w = tensor_type( v );
+	BOOST_CHECK_EQUAL( ublas::sum( v + v ), ublas::sum( w + w ) );
+	BOOST_CHECK_EQUAL( ublas::norm( v - w + v ), ublas::norm( w ) );
+	BOOST_CHECK_EQUAL( ublas::inner_prod( v * v, w ), ublas::inner_prod( w * w, w ) );
+	BOOST_CHECK_EQUAL( (ublas::max)( v ), (ublas::max)( w ) );
+	BOOST_CHECK( v == w );
+
+	auto const e = tensor_type( ublas::shape{2,3}, value_type{1} );
+	BOOST_CHECK_EQUAL( ublas::sum( e - e ), value_type{} );
+	BOOST_CHECK_THROW( ublas::sum( t + tensor_type( ublas::shape{10,20,30} ) ), std::runtime_error );
+	BOOST_CHECK_THROW( ublas::norm( t + tensor_type( ublas::shape{10,20,30} ) ), std::runtime_error );
+	BOOST_CHECK_THROW( ublas::inner_prod( t + t, e + e ), std::length_error );
+	BOOST_CHECK_THROW( (ublas::max)( tensor_type{} ), std::runtime_error );
+	BOOST_CHECK_THROW( ( t + tensor_type( ublas::shape{10,20,30} ) == t ), std::runtime_error );
+}
+
+
 BOOST_FIXTURE_TEST_CASE( test_tensor_real_imag_conj, fixture )
 {
 	using namespace boost::numeric;
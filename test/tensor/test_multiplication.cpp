@@ -227,6 +227,90 @@ BOOST_FIXTURE_TEST_CASE_TEMPLATE( test_tensor_ttm, value,  test_types, fixture )
 
 
 
+BOOST_FIXTURE_TEST_CASE_TEMPLATE( test_tensor_ttv_ttm_contiguous, value,  test_types, fixture )
+{
+	using namespace boost::numeric;
+	using value_type   = typename value::first_type;
+	using layout_type  = typename value::second_type;
+	using strides_type = ublas::strides<layout_type>;
+	using vector_type  = std::vector<value_type>;
+	using extents_type = ublas::shape;
+	using size_type = typename extents_type::value_type;
+
+	// results for contiguous tensors must equal those for tensors with doubled strides
+	auto spread = [](vector_type const& x){
+		auto y = vector_type(2*x.size(), value_type{});
+		for(auto i = 0u; i < x.size(); ++i)
+			y[2*i] = x[i];
+		return y;
+	};
+	auto twice = [](strides_type const& w){
+		auto v = w.base();
+		for(auto& x : v) x *= 2;
+		return v;
+	};
+
+	for(auto const& na : extents) {
+
+		auto a = vector_type(na.product());
+		for(auto i = 0u; i < a.size(); ++i)
+			a[i] = value_type( int(i%5)+1 );
+		auto wa = strides_type(na);
+		auto a2 = spread(a);
+		auto wa2 = twice(wa);
+
+		BOOST_CHECK( ublas::detail::flat::is_contiguous(na.size(), na.data(), wa.data(), std::is_same<layout_type,ublas::last_order>::value) );
+
+		for(auto m = 0u; m < na.size(); ++m){
+
+			// matrix with 5 rows in both layouts
+			auto nb = extents_type {5, na[m]};
+			auto b  = vector_type (nb.product());
+			for(auto i = 0u; i < b.size(); ++i)
+				b[i] = value_type( int(i%3)+1 );
+
+			for(auto const& wb : {ublas::strides<ublas::first_order>(nb).base(), ublas::strides<ublas::last_order>(nb).base()}){
+
+				auto nc = na;
+				nc[m] = nb[0];
+				auto wc = strides_type (nc);
+				auto c  = vector_type  (nc.product(), value_type{0});
+				auto c2 = spread(c);
+				auto wc2 = twice(wc);
+
+				ublas::ttm(size_type(m+1), na.size(), c .data(), nc.data(), wc .data(), a .data(), na.data(), wa .data(), b.data(), nb.data(), wb.data());
+				ublas::ttm(size_type(m+1), na.size(), c2.data(), nc.data(), wc2.data(), a2.data(), na.data(), wa2.data(), b.data(), nb.data(), wb.data());
+
+				for(auto i = 0u; i < c.size(); ++i)
+					BOOST_CHECK_EQUAL( c[i] , c2[2*i] );
+			}
+
+			auto nv = extents_type {na[m], 1};
+			auto v  = vector_type  (2*na[m]);
+			for(auto i = 0u; i < v.size(); ++i)
+				v[i] = value_type( int(i%4)+1 );
+			auto wv = std::vector<size_type>{2,2};
+
+			auto nc_ = std::vector<size_type>(std::max(na.size()-1, std::size_t(2)), 1);
+			for(auto i = 0u, j = 0u; i < na.size(); ++i)
+				if(i != m)
+					nc_[j++] = na[i];
+			auto nc = extents_type(nc_);
+			auto wc = strides_type (nc);
+			auto c  = vector_type  (nc.product(), value_type{0});
+			auto c2 = spread(c);
+			auto wc2 = twice(wc);
+
+			ublas::ttv(size_type(m+1), na.size(), c .data(), nc.data(), wc .data(), a .data(), na.data(), wa .data(), v.data(), nv.data(), wv.data());
+			ublas::ttv(size_type(m+1), na.size(), c2.data(), nc.data(), wc2.data(), a2.data(), na.data(), wa2.data(), v.data(), nv.data(), wv.data());
+
+			for(auto i = 0u; i < c.size(); ++i)
+				BOOST_CHECK_EQUAL( c[i] , c2[2*i] );
+		}
+	}
+}
+
+
 BOOST_FIXTURE_TEST_CASE_TEMPLATE( test_tensor_ttt_permutation, value,  test_types, fixture )
 {
 	using namespace boost::numeric;
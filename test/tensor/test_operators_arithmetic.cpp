@@ -264,4 +264,70 @@ BOOST_FIXTURE_TEST_CASE_TEMPLATE( test_tensor_assign_arithmetic_operations, valu
 }
 
 
+BOOST_FIXTURE_TEST_CASE_TEMPLATE( test_tensor_mixed_layout_arithmetic_operations, value,  test_types, fixture)
+{
+	using namespace boost::numeric;
+	using value_type  = typename value::first_type;
+	using layout_type = typename value::second_type;
+	using other_layout_type = std::conditional_t<std::is_same<layout_type,ublas::first_order>::value, ublas::last_order, ublas::first_order>;
+	using tensor_type = ublas::tensor<value_type, layout_type>;
+	using other_tensor_type = ublas::tensor<value_type, other_layout_type>;
+
+
+	auto check = [](auto const& e)
+	{
+		auto t  = tensor_type (e);
+		auto o  = other_tensor_type (e);
+		auto v  = value_type  {};
+
+		std::iota(t.begin(), t.end(), v);
+		std::iota(o.begin(), o.end(), v+2);
+
+		// o in the layout of t and t in the layout of o, copied element by element
+		auto t2 = tensor_type (e);
+		auto o2 = other_tensor_type (e);
+		if(!e.empty()){
+			ublas::copy(t2.rank(), t2.extents().data(), t2.data(), t2.strides().data(), o.data(), o.strides().data());
+			ublas::copy(o2.rank(), o2.extents().data(), o2.data(), o2.strides().data(), t.data(), t.strides().data());
+		}
+
+		auto c = other_tensor_type(t2);
+		BOOST_CHECK( std::equal(c.begin(), c.end(), o.begin()) );
+		auto d = tensor_type(c);
+		BOOST_CHECK( std::equal(d.begin(), d.end(), t2.begin()) );
+
+		tensor_type r = t + o;
+		for(auto i = 0ul; i < t.size(); ++i)
+			BOOST_CHECK_EQUAL ( r(i), t(i) + t2(i) );
+
+		r = t * o - o / 2;
+		for(auto i = 0ul; i < t.size(); ++i)
+			BOOST_CHECK_EQUAL ( r(i), t(i) * t2(i) - t2(i) / 2 );
+
+		r = (t + o) * 2;
+		for(auto i = 0ul; i < t.size(); ++i)
+			BOOST_CHECK_EQUAL ( r(i), (t(i) + t2(i)) * 2 );
+
+		other_tensor_type q = o - t;
+		for(auto i = 0ul; i < t.size(); ++i)
+			BOOST_CHECK_EQUAL ( q(i), o(i) - o2(i) );
+
+		r  = t;
+		r += o;
+		r *= o;
+		r -= o;
+		for(auto i = 0ul; i < t.size(); ++i)
+			BOOST_CHECK_EQUAL ( r(i), (t(i) + t2(i)) * t2(i) - t2(i) );
+	};
+
+	for(auto const& e : extents)
+		check(e);
+	check(typename fixture::extents_type{33,5,40});
+
+	auto r  = tensor_type (extents.at(4));
+	BOOST_CHECK_THROW ( r = tensor_type(extents.at(4)) + other_tensor_type(extents.at(5)), std::runtime_error );
+	BOOST_CHECK_THROW ( r += other_tensor_type(extents.at(8)), std::runtime_error );
+}
+
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,225 @@
+//  Copyright (c) 2019
+//  The Boost.uBLAS developers
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+
+
+#include <boost/test/unit_test.hpp>
+#include <boost/numeric/ublas/tensor.hpp>
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+
+#include <cstdint>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(test_sparse_tensor)
+
+using test_types = std::tuple<boost::numeric::ublas::first_order, boost::numeric::ublas::last_order>;
+
+
+// dense tensor with about every third element nonzero
+template<class tensor_type>
+tensor_type sparse_dense(boost::numeric::ublas::shape const& e)
+{
+	auto t = tensor_type(e, typename tensor_type::value_type{});
+	for(auto i = 0u; i < t.size(); ++i)
+		if((i*7u) % 3u == 1u)
+			t[i] = typename tensor_type::value_type((i*5u) % 11u + 1u);
+	return t;
+}
+
+
+BOOST_AUTO_TEST_CASE( test_coordinate_tensor )
+{
+	using namespace boost::numeric;
+
+	using value_type  = float;
+	using sparse_type = ublas::coordinate_tensor<value_type,std::uint32_t>;
+
+	auto a = sparse_type{ ublas::shape{4,3,2} };
+	a.append_element( {3,2,1}, 1.f );
+	a.append_element( {0,1,0}, 2.f );
+	a.append_element( {3,2,1}, 3.f );
+	a.append_element( {1,0,1}, 4.f );
+	BOOST_CHECK_EQUAL( a.nnz(), 4 );
+
+	a.sort();
+	BOOST_CHECK_EQUAL( a.nnz(), 3 );
+	BOOST_CHECK( (a.index_data(0) == std::vector<std::uint32_t>{0,1,3}) );
+	BOOST_CHECK( (a.index_data(1) == std::vector<std::uint32_t>{1,0,2}) );
+	BOOST_CHECK( (a.index_data(2) == std::vector<std::uint32_t>{0,1,1}) );
+	BOOST_CHECK( (a.value_data()  == std::vector<value_type>{2.f,4.f,4.f}) );
+
+	a.sort( {3,1,2} );
+	BOOST_CHECK( (a.index_data(2) == std::vector<std::uint32_t>{0,1,1}) );
+	BOOST_CHECK( (a.index_data(0) == std::vector<std::uint32_t>{0,1,3}) );
+
+	auto const d = a.dense();
+	BOOST_CHECK_EQUAL( d.at(3,2,1), 4.f );
+	BOOST_CHECK_EQUAL( d.at(1,0,1), 4.f );
+	BOOST_CHECK_EQUAL( d.at(0,1,0), 2.f );
+	BOOST_CHECK_EQUAL( d.at(0,0,0), 0.f );
+
+	BOOST_CHECK_THROW( a.append_element( {4,0,0}, 1.f ), std::out_of_range );
+	BOOST_CHECK_THROW( a.append_element( {0,0}, 1.f ), std::length_error );
+	BOOST_CHECK_THROW( a.sort( {1,1,2} ), std::runtime_error );
+}
+
+
+BOOST_AUTO_TEST_CASE_TEMPLATE( test_compressed_tensor, layout, test_types)
+{
+	using namespace boost::numeric;
+
+	using value_type  = double;
+	using tensor_type = ublas::tensor<value_type,layout>;
+	using sparse_type = ublas::compressed_tensor<value_type>;
+
+	// two top-level fibers i = 0,2 with fibers (0,1), (2,0), (2,1)
+	auto t = tensor_type( ublas::shape{3,2,4}, value_type{} );
+	t.at(0,1,0) = 1;
+	t.at(0,1,3) = 2;
+	t.at(2,0,2) = 3;
+	t.at(2,1,1) = 4;
+	t.at(2,1,2) = 5;
+
+	auto const a = sparse_type( t );
+	BOOST_CHECK_EQUAL( a.nnz(), 5 );
+	BOOST_CHECK_EQUAL( a.fibers(0), 2 );
+	BOOST_CHECK_EQUAL( a.fibers(1), 3 );
+	BOOST_CHECK( (a.index_data(0) == std::vector<std::size_t>{0,2}) );
+	BOOST_CHECK( (a.pointer_data(0) == std::vector<std::size_t>{0,1,3}) );
+	BOOST_CHECK( (a.index_data(1) == std::vector<std::size_t>{1,0,1}) );
+	BOOST_CHECK( (a.pointer_data(1) == std::vector<std::size_t>{0,2,3,5}) );
+	BOOST_CHECK( (a.index_data(2) == std::vector<std::size_t>{0,3,2,1,2}) );
+	BOOST_CHECK( (a.value_data() == std::vector<value_type>{1,2,3,4,5}) );
+	BOOST_CHECK( a.template dense<layout>() == t );
+
+	auto const b = sparse_type( t, {3,1,2} );
+	BOOST_CHECK_EQUAL( b.fibers(0), 4 );
+	BOOST_CHECK( (b.modes() == std::vector<std::size_t>{3,1,2}) );
+	BOOST_CHECK( b.template dense<layout>() == t );
+	BOOST_CHECK( ublas::coordinate_tensor<value_type>( b ).template dense<layout>() == t );
+
+	auto const s = sparse_dense<tensor_type>( ublas::shape{5,4,3,2} );
+	for(auto const& modes : std::vector<std::vector<std::size_t>>{ {1,2,3,4}, {4,3,2,1}, {2,4,1,3} })
+		BOOST_CHECK( sparse_type( s, modes ).template dense<layout>() == s );
+
+	auto const z = sparse_type( tensor_type( ublas::shape{3,2}, value_type{} ) );
+	BOOST_CHECK_EQUAL( z.nnz(), 0 );
+	BOOST_CHECK( z.template dense<layout>() == tensor_type( ublas::shape{3,2}, value_type{} ) );
+
+	BOOST_CHECK_THROW( sparse_type( t, {1,2} ), std::runtime_error );
+	BOOST_CHECK_THROW( sparse_type( ublas::shape{2,2}, {1,2}, {{0},{1}}, {{0,2}}, {1.0} ), std::length_error );
+}
+
+
+BOOST_AUTO_TEST_CASE_TEMPLATE( test_sparse_prod, layout, test_types)
+{
+	using namespace boost::numeric;
+
+	using value_type  = double;
+	using tensor_type = ublas::tensor<value_type,layout>;
+	using sparse_type = ublas::compressed_tensor<value_type,std::uint32_t>;
+
+	for(auto const& n : std::vector<ublas::shape>{ {4,3}, {5,4,3}, {3,5,2,4} }){
+		auto const t = sparse_dense<tensor_type>( n );
+		auto const p = n.size();
+
+		for(auto m = 1u; m <= p; ++m){
+			auto b = ublas::vector<value_type>( n[m-1] );
+			auto B = ublas::matrix<value_type,layout>( 3, n[m-1] );
+			for(auto i = 0u; i < b.size(); ++i){
+				b(i) = value_type(i+1);
+				for(auto j = 0u; j < B.size1(); ++j)
+					B(j,i) = value_type(i+2*j+1);
+			}
+
+			// with mode m at the last level and elsewhere
+			for(auto const& modes : std::vector<std::vector<std::size_t>>{ {}, { m } }){
+				auto pi = modes;
+				for(auto r = 1u; r <= p && !pi.empty(); ++r)
+					if(r != m)
+						pi.push_back(r);
+				auto const a = sparse_type( t, pi );
+
+				auto const c = ublas::prod( a, b, m );
+				BOOST_CHECK_EQUAL( c.rank(), std::max(p-1, std::size_t(2)) );
+				BOOST_CHECK( c.template dense<layout>() == ublas::prod( t, b, m ) );
+
+				auto const d = ublas::prod( a, B, m );
+				BOOST_CHECK( (d.extents() == ublas::prod( t, B, m ).extents()) );
+				BOOST_CHECK( d.template dense<layout>() == ublas::prod( t, B, m ) );
+			}
+		}
+	}
+
+	auto const a = sparse_type( sparse_dense<tensor_type>( ublas::shape{4,3,2} ) );
+	BOOST_CHECK_THROW( ublas::prod( a, ublas::vector<value_type>(3), 1 ), std::length_error );
+	BOOST_CHECK_THROW( ublas::prod( a, ublas::vector<value_type>(4), 4 ), std::length_error );
+	BOOST_CHECK_THROW( ublas::prod( a, ublas::matrix<value_type>(2,3), 1 ), std::length_error );
+	BOOST_CHECK_THROW( ublas::prod( a, ublas::matrix<value_type>(2,4), 0 ), std::length_error );
+}
+
+
+BOOST_AUTO_TEST_CASE_TEMPLATE( test_sparse_mttkrp, layout, test_types)
+{
+	using namespace boost::numeric;
+
+	using value_type  = double;
+	using tensor_type = ublas::tensor<value_type,layout>;
+	using matrix_type = ublas::matrix<value_type,layout>;
+	using sparse_type = ublas::compressed_tensor<value_type>;
+
+	auto const n = ublas::shape{5,4,3};
+	auto const t = sparse_dense<tensor_type>( n );
+	auto const R = 3u;
+
+	auto u = std::vector<matrix_type>{};
+	for(auto r = 0u; r < n.size(); ++r){
+		u.emplace_back( n[r], R );
+		for(auto i = 0u; i < n[r]; ++i)
+			for(auto j = 0u; j < R; ++j)
+				u[r](i,j) = value_type( (i+1)*(j+r+1) % 7 ) - 3;
+	}
+
+	for(auto m = 1u; m <= n.size(); ++m){
+		auto e = matrix_type( n[m-1], R );
+		for(auto i = 0u; i < e.size1(); ++i)
+			for(auto j = 0u; j < R; ++j)
+				e(i,j) = 0;
+		for(auto k = 0u; k < n[2]; ++k)
+			for(auto j = 0u; j < n[1]; ++j)
+				for(auto i = 0u; i < n[0]; ++i){
+					auto const idx = std::vector<std::size_t>{i,j,k};
+					for(auto r = 0u; r < R; ++r){
+						auto v = t.at(i,j,k);
+						for(auto q = 0u; q < n.size(); ++q)
+							if(q != m-1)
+								v *= u[q](idx[q],r);
+						e(idx[m-1],r) += v;
+					}
+				}
+
+		for(auto const& modes : std::vector<std::vector<std::size_t>>{ {1,2,3}, {3,2,1}, {2,3,1} }){
+			auto const c = ublas::mttkrp( sparse_type( t, modes ), u, m );
+			BOOST_CHECK_EQUAL( c.size1(), n[m-1] );
+			BOOST_CHECK_EQUAL( c.size2(), R );
+			for(auto i = 0u; i < c.size1(); ++i)
+				for(auto j = 0u; j < R; ++j)
+					BOOST_CHECK_EQUAL( c(i,j), e(i,j) );
+		}
+	}
+
+	auto const a = sparse_type( t );
+	BOOST_CHECK_THROW( ublas::mttkrp( a, u, 4 ), std::length_error );
+	BOOST_CHECK_THROW( ublas::mttkrp( a, std::vector<matrix_type>( u.begin(), u.end()-1 ), 1 ), std::length_error );
+	u[1] = matrix_type( n[1], R+1 );
+	BOOST_CHECK_THROW( ublas::mttkrp( a, u, 1 ), std::length_error );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
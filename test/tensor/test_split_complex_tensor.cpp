@@ -0,0 +1,192 @@
+//  Copyright (c) 2019
+//  The Boost.uBLAS developers
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+
+
+#include <boost/test/unit_test.hpp>
+#include <boost/numeric/ublas/tensor.hpp>
+#include <boost/numeric/ublas/matrix.hpp>
+
+#include <cmath>
+#include <complex>
+
+BOOST_AUTO_TEST_SUITE(test_split_complex_tensor)
+
+using test_types = std::tuple<boost::numeric::ublas::first_order, boost::numeric::ublas::last_order>;
+
+
+template<class tensor_type>
+tensor_type make_complex(boost::numeric::ublas::shape const& n, double offset)
+{
+	auto t = tensor_type( n );
+	for(auto i = 0u; i < t.size(); ++i)
+		t[i] = typename tensor_type::value_type( std::sin( i + offset ), std::cos( 2.0*i - offset ) );
+	return t;
+}
+
+template<class split_type, class tensor_type>
+void check_close(split_type const& s, tensor_type const& t)
+{
+	BOOST_REQUIRE( s.extents() == t.extents() );
+	for(auto i = 0u; i < t.size(); ++i){
+		BOOST_CHECK_SMALL( s[i].real() - t[i].real(), 1e-12 );
+		BOOST_CHECK_SMALL( s[i].imag() - t[i].imag(), 1e-12 );
+	}
+}
+
+
+BOOST_AUTO_TEST_CASE( test_split_complex_array )
+{
+	using array_type  = boost::numeric::ublas::split_complex_array<std::vector<float>>;
+	using traits_type = boost::numeric::ublas::storage_traits<array_type>;
+
+	BOOST_CHECK( (std::is_same<traits_type::value_type, std::complex<float>>::value) );
+	BOOST_CHECK( (std::is_same<traits_type::plane_type, std::vector<float>>::value) );
+	BOOST_CHECK( (std::is_same<traits_type::rebind<double>, boost::numeric::ublas::split_complex_array<std::vector<double>>>::value) );
+
+	auto a = array_type( 3, std::complex<float>(1,-2) );
+	BOOST_CHECK_EQUAL( a.size(), 3 );
+	a.imag[1] = 4;
+	BOOST_CHECK_EQUAL( a[0], std::complex<float>(1,-2) );
+	BOOST_CHECK_EQUAL( a[1], std::complex<float>(1, 4) );
+}
+
+
+BOOST_AUTO_TEST_CASE_TEMPLATE( test_split_complex_tensor_ctor, layout, test_types)
+{
+	using namespace boost::numeric;
+	using value_type  = std::complex<double>;
+	using tensor_type = ublas::tensor<value_type,layout>;
+	using split_type  = ublas::split_complex_tensor<double,layout>;
+
+	auto const n = ublas::shape{3,4,2};
+	auto const t = make_complex<tensor_type>( n, 0.5 );
+
+	auto const s = split_type( t );
+	BOOST_CHECK_EQUAL( s.rank(), 3 );
+	BOOST_CHECK_EQUAL( s.size(), t.size() );
+	BOOST_CHECK( s.strides() == t.strides() );
+	BOOST_CHECK( s.interleaved() == t );
+	for(auto i = 0u; i < n[0]; ++i)
+		for(auto j = 0u; j < n[1]; ++j)
+			for(auto k = 0u; k < n[2]; ++k)
+				BOOST_CHECK_EQUAL( s.at(i,j,k), t.at(i,j,k) );
+
+	auto const z = split_type( n, value_type(2,-1) );
+	for(auto i = 0u; i < z.size(); ++i)
+		BOOST_CHECK_EQUAL( z[i], value_type(2,-1) );
+
+	BOOST_CHECK( split_type{}.empty() );
+	BOOST_CHECK( split_type( n )[5] == value_type{} );
+
+	auto const re = ublas::tensor<double,layout>( n, 1.0 );
+	auto const im = ublas::tensor<double,layout>( n, 3.0 );
+	auto const c = split_type( re, im );
+	for(auto i = 0u; i < c.size(); ++i)
+		BOOST_CHECK_EQUAL( c[i], value_type(1,3) );
+
+	BOOST_CHECK_THROW( split_type( re, ublas::tensor<double,layout>( ublas::shape{3,4} ) ), std::length_error );
+}
+
+
+BOOST_AUTO_TEST_CASE_TEMPLATE( test_split_complex_tensor_views, layout, test_types)
+{
+	using namespace boost::numeric;
+	using value_type  = std::complex<double>;
+	using tensor_type = ublas::tensor<value_type,layout>;
+	using split_type  = ublas::split_complex_tensor<double,layout>;
+
+	auto const n = ublas::shape{3,4,2};
+	auto t = make_complex<tensor_type>( n, 1.5 );
+	auto s = split_type( t );
+
+	// views share the planes
+	auto r = ublas::real( s );
+	auto i = ublas::imag( s );
+	BOOST_CHECK_EQUAL( r.data(), s.data().real.data() );
+	BOOST_CHECK_EQUAL( i.data(), s.data().imag.data() );
+	BOOST_CHECK( r.extents() == n );
+	BOOST_CHECK( ublas::real( std::as_const( s ) ) == ublas::real( t ) );
+	BOOST_CHECK( ublas::imag( std::as_const( s ) ) == ublas::imag( t ) );
+
+	r = 2.0 * r;
+	i += 1.0;
+	ublas::project( i, 1, ublas::range::all(), ublas::range::all() ) = 0.0;
+	for(auto a = 0u; a < n[0]; ++a)
+		for(auto b = 0u; b < n[1]; ++b)
+			for(auto c = 0u; c < n[2]; ++c){
+				auto const e = t.at(a,b,c);
+				auto const im = a == 1 ? 0.0 : e.imag() + 1.0;
+				BOOST_CHECK_EQUAL( s.at(a,b,c), value_type( 2.0*e.real(), im ) );
+			}
+}
+
+
+BOOST_AUTO_TEST_CASE_TEMPLATE( test_split_complex_tensor_conj_norm, layout, test_types)
+{
+	using namespace boost::numeric;
+	using tensor_type = ublas::tensor<std::complex<double>,layout>;
+	using split_type  = ublas::split_complex_tensor<double,layout>;
+
+	auto const t = make_complex<tensor_type>( ublas::shape{5,3,4}, 0.25 );
+	auto const s = split_type( t );
+
+	auto const c = ublas::conj( s );
+	auto const e = tensor_type( ublas::conj( t ) );
+	check_close( c, e );
+
+	auto n = 0.0;
+	for(auto const& x : t)
+		n += std::norm( x );
+	BOOST_CHECK_CLOSE( ublas::norm( s ), std::sqrt( n ), 1e-10 );
+	BOOST_CHECK_EQUAL( ublas::norm( split_type{} ), 0.0 );
+
+	BOOST_CHECK_THROW( ublas::conj( split_type{} ), std::runtime_error );
+}
+
+
+BOOST_AUTO_TEST_CASE_TEMPLATE( test_split_complex_tensor_prod, layout, test_types)
+{
+	using namespace boost::numeric;
+	using value_type  = std::complex<double>;
+	using tensor_type = ublas::tensor<value_type,layout>;
+	using split_type  = ublas::split_complex_tensor<double,layout>;
+
+	auto const a = make_complex<tensor_type>( ublas::shape{3,4,2}, 0.5 );
+	auto const b = make_complex<tensor_type>( ublas::shape{4,5,3}, 2.5 );
+	auto const sa = split_type( a );
+	auto const sb = split_type( b );
+
+	// against the contraction of interleaved complex tensors
+	check_close( ublas::prod( sa, sb, {1,2}, {3,1} ), ublas::prod( a, b, {1,2}, {3,1} ) );
+	check_close( ublas::prod( sa, sb, {2}, {1} ), ublas::prod( a, b, {2}, {1} ) );
+	check_close( ublas::prod( sa, sa, {1,2,3} ), ublas::prod( a, a, {1,2,3} ) );
+
+	// the other storage format for the right-hand side
+	using other_layout = std::conditional_t<std::is_same<layout,ublas::first_order>::value, ublas::last_order, ublas::first_order>;
+	auto const bo = ublas::split_complex_tensor<double,other_layout>( ublas::tensor<value_type,other_layout>( b ) );
+	check_close( ublas::prod( sa, bo, {2}, {1} ), ublas::prod( a, b, {2}, {1} ) );
+
+	// tensor-times-matrix
+	auto m = ublas::matrix<value_type>( 6, 4 );
+	for(auto i = 0u; i < m.size1(); ++i)
+		for(auto j = 0u; j < m.size2(); ++j)
+			m(i,j) = value_type( double(i) - double(j), 0.5*(i+j) );
+	auto mc = ublas::matrix<value_type,ublas::column_major>( 5, 3 );
+	for(auto i = 0u; i < mc.size1(); ++i)
+		for(auto j = 0u; j < mc.size2(); ++j)
+			mc(i,j) = m(i,j+1);
+	check_close( ublas::prod( sa, m, 2 ), ublas::prod( a, m, 2 ) );
+	check_close( ublas::prod( sa, mc, 1 ), ublas::prod( a, mc, 1 ) );
+
+	BOOST_CHECK_THROW( ublas::prod( sa, sb, {1}, {1} ), std::runtime_error );
+	BOOST_CHECK_THROW( ublas::prod( sa, m, 0 ), std::length_error );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,241 @@
+//  Copyright (c) 2019
+//  The Boost.uBLAS developers
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+
+
+#include <boost/test/unit_test.hpp>
+#include <boost/numeric/ublas/tensor.hpp>
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+
+#include <numeric>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(test_static_extents)
+
+using test_types = std::tuple<boost::numeric::ublas::first_order, boost::numeric::ublas::last_order>;
+
+BOOST_AUTO_TEST_CASE( test_static_extents_ctor )
+{
+	using namespace boost::numeric;
+
+	using extents_type = ublas::static_extents<4,2,3>;
+
+	static_assert( extents_type::size() == 3, "rank is a constant expression" );
+	static_assert( extents_type::product() == 24, "product is a constant expression" );
+	static_assert( extents_type{}[1] == 2, "extents are constant expressions" );
+	static_assert( ublas::static_extents<1,1,1>::is_scalar(), "" );
+	static_assert( ublas::static_extents<1,4>::is_vector(), "" );
+	static_assert( ublas::static_extents<4,2,1>::is_matrix(), "" );
+	static_assert( extents_type::is_tensor(), "" );
+	static_assert( std::is_empty<extents_type>::value, "static extents hold no data" );
+
+	auto e = extents_type{};
+	BOOST_CHECK( !e.empty() );
+	BOOST_CHECK( e.valid() );
+	BOOST_CHECK( (e == ublas::shape{4,2,3}) );
+	BOOST_CHECK( (ublas::shape{4,2,3} == e) );
+	BOOST_CHECK( (e != ublas::shape{4,2}) );
+	BOOST_CHECK( (e == extents_type{4,2,3}) );
+	BOOST_CHECK( (ublas::static_extents<1,2,1>{}.squeeze() == ublas::shape{1,2,1}.squeeze()) );
+
+	BOOST_CHECK_THROW( (extents_type{4,2,4}), std::length_error );
+	BOOST_CHECK_THROW( extents_type(ublas::shape{4,2}), std::length_error );
+	BOOST_CHECK_NO_THROW( extents_type(ublas::shape{4,2,3}) );
+}
+
+
+BOOST_AUTO_TEST_CASE( test_fixed_rank_extents_ctor )
+{
+	using namespace boost::numeric;
+
+	using extents_type = ublas::fixed_rank_extents<3>;
+
+	static_assert( extents_type::size() == 3, "rank is a constant expression" );
+
+	auto e0 = extents_type{};
+	BOOST_CHECK( e0.empty() );
+
+	auto e1 = extents_type{4,2,3};
+	BOOST_CHECK( !e1.empty() );
+	BOOST_CHECK_EQUAL( e1.product(), 24 );
+	BOOST_CHECK( e1.is_tensor() );
+	BOOST_CHECK( (e1 == ublas::shape{4,2,3}) );
+	BOOST_CHECK( (e1 == ublas::static_extents<4,2,3>{}) );
+	BOOST_CHECK( (extents_type{1,3,1}.is_vector()) );
+	BOOST_CHECK( (extents_type{1,3,1}.squeeze() == ublas::shape{1,3,1}.squeeze()) );
+
+	BOOST_CHECK_THROW( (extents_type{4,2}), std::length_error );
+	BOOST_CHECK_THROW( (extents_type{4,0,3}), std::length_error );
+	BOOST_CHECK_THROW( extents_type(ublas::shape{4,2,3,1}), std::length_error );
+	BOOST_CHECK( (extents_type(ublas::static_extents<4,2,3>{}) == e1) );
+	BOOST_CHECK( ublas::shape(e1) == e1 );
+}
+
+
+template<class layout, std::size_t ... n>
+void check_strides()
+{
+	using namespace boost::numeric;
+
+	using static_strides_type = typename ublas::detail::strides_traits<ublas::static_extents<n...>,layout>::type;
+	using fixed_strides_type  = typename ublas::detail::strides_traits<ublas::fixed_rank_extents<sizeof...(n)>,layout>::type;
+
+	auto const w  = ublas::strides<layout>( ublas::shape{n...} );
+	auto const ws = static_strides_type{};
+	auto const wf = fixed_strides_type( ublas::fixed_rank_extents<sizeof...(n)>{n...} );
+
+	static_assert( static_strides_type::size() == sizeof...(n) && static_strides_type{}[0] > 0, "strides are constant expressions" );
+
+	BOOST_CHECK( ws == w );
+	BOOST_CHECK( wf == w );
+	BOOST_CHECK( std::equal( w.begin(), w.end(), ws.begin() ) );
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE( test_static_strides, layout, test_types)
+{
+	check_strides<layout,1,1>();
+	check_strides<layout,1,2>();
+	check_strides<layout,2,1>();
+	check_strides<layout,2,3>();
+	check_strides<layout,2,3,1>();
+	check_strides<layout,1,2,3>();
+	check_strides<layout,4,2,3>();
+	check_strides<layout,4,2,3,5>();
+	check_strides<layout,1,1,2,1>();
+}
+
+
+BOOST_AUTO_TEST_CASE_TEMPLATE( test_static_tensor_access, layout, test_types)
+{
+	using namespace boost::numeric;
+
+	using value_type    = float;
+	using static_tensor = ublas::tensor<value_type,layout,std::vector<value_type>,ublas::static_extents<4,2,3>>;
+	using fixed_tensor  = ublas::tensor<value_type,layout,std::vector<value_type>,ublas::fixed_rank_extents<3>>;
+	using tensor_type   = ublas::tensor<value_type,layout>;
+
+	auto a = static_tensor{};
+	BOOST_CHECK_EQUAL( a.size(), 24 );
+	BOOST_CHECK_EQUAL( a.rank(), 3 );
+	BOOST_CHECK( (a.strides() == ublas::strides<layout>( ublas::shape{4,2,3} )) );
+
+	auto f = fixed_tensor{4,2,3};
+	BOOST_CHECK_EQUAL( f.size(), 24 );
+
+	auto t = tensor_type{4,2,3};
+	std::iota( t.begin(), t.end(), value_type{1} );
+
+	for(auto k = 0u; k < 3; ++k)
+		for(auto j = 0u; j < 2; ++j)
+			for(auto i = 0u; i < 4; ++i){
+				a.at(i,j,k) = t.at(i,j,k);
+				f.at(i,j,k) = t.at(i,j,k);
+			}
+
+	BOOST_CHECK( std::equal( a.begin(), a.end(), t.begin() ) );
+	BOOST_CHECK( std::equal( f.begin(), f.end(), t.begin() ) );
+
+	auto b = static_tensor( ublas::static_extents<4,2,3>{}, value_type{2} );
+	BOOST_CHECK_THROW( (static_tensor{4,2,4}), std::length_error );
+	BOOST_CHECK_THROW( static_tensor( ublas::static_extents<4,2,3>{}, std::vector<value_type>(23) ), std::runtime_error );
+
+	static_tensor c = a + b * value_type{3} - a;
+	for(auto i = 0u; i < c.size(); ++i)
+		BOOST_CHECK_EQUAL( c[i], value_type{6} );
+
+	c += value_type{1};
+	BOOST_CHECK( (c == static_tensor( ublas::static_extents<4,2,3>{}, value_type{7} )) );
+	BOOST_CHECK( c == value_type{7} );
+}
+
+
+BOOST_AUTO_TEST_CASE_TEMPLATE( test_static_tensor_functions, layout, test_types)
+{
+	using namespace boost::numeric;
+
+	using value_type    = double;
+	using static_tensor = ublas::tensor<value_type,layout,std::vector<value_type>,ublas::static_extents<4,2,3>>;
+	using fixed_tensor  = ublas::tensor<value_type,layout,std::vector<value_type>,ublas::fixed_rank_extents<3>>;
+	using tensor_type   = ublas::tensor<value_type,layout>;
+
+	auto t = tensor_type{4,2,3};
+	std::iota( t.begin(), t.end(), value_type{1} );
+
+	auto a = static_tensor( t );
+	auto f = fixed_tensor( t );
+	BOOST_CHECK( std::equal( a.begin(), a.end(), t.begin() ) );
+	BOOST_CHECK( tensor_type( a ) == t );
+	BOOST_CHECK( tensor_type( f ) == t );
+	BOOST_CHECK_THROW( static_tensor( tensor_type{4,3,2} ), std::length_error );
+
+	// with a different layout, elements are copied at the same multi-index
+	using other_layout = std::conditional_t<std::is_same<layout,ublas::first_order>::value,ublas::last_order,ublas::first_order>;
+	auto o = ublas::tensor<value_type,other_layout,std::vector<value_type>,ublas::static_extents<4,2,3>>( a );
+	for(auto k = 0u; k < 3; ++k)
+		for(auto j = 0u; j < 2; ++j)
+			for(auto i = 0u; i < 4; ++i)
+				BOOST_CHECK_EQUAL( o.at(i,j,k), t.at(i,j,k) );
+
+	auto v = ublas::vector<value_type>(2);
+	v(0) = 1; v(1) = 2;
+	auto m = ublas::matrix<value_type,layout>(5,3);
+	for(auto i = 0u; i < m.size1(); ++i)
+		for(auto j = 0u; j < m.size2(); ++j)
+			m(i,j) = value_type(i+j+1);
+
+	BOOST_CHECK( ublas::prod( a, v, 2 ) == ublas::prod( t, v, 2 ) );
+	BOOST_CHECK( ublas::prod( f, m, 3 ) == ublas::prod( t, m, 3 ) );
+	BOOST_CHECK( (ublas::prod( a, f, std::vector<std::size_t>{1,3} ) == ublas::prod( t, t, std::vector<std::size_t>{1,3} )) );
+	BOOST_CHECK( ublas::outer_prod( a, f ) == ublas::outer_prod( t, t ) );
+	BOOST_CHECK_EQUAL( ublas::inner_prod( a, f ), ublas::inner_prod( t, t ) );
+
+	auto const tau = std::vector<std::size_t>{3,1,2};
+	BOOST_CHECK( ublas::trans( a, tau ) == ublas::trans( t, tau ) );
+	BOOST_CHECK( ublas::trans( f, tau ) == ublas::trans( t, tau ) );
+
+	BOOST_CHECK_CLOSE( ublas::norm( a ), ublas::norm( t ), 1e-10 );
+	BOOST_CHECK_CLOSE( ublas::norm( f + f ), ublas::norm( t + t ), 1e-10 );
+}
+
+
+BOOST_AUTO_TEST_CASE( test_static_rank_algorithms )
+{
+	using namespace boost::numeric;
+
+	auto const n  = std::vector<std::size_t>{4,2,3};
+	auto const wa = std::vector<std::size_t>{1,4,8};
+	auto const wc = std::vector<std::size_t>{6,3,1};
+	auto const rank = std::integral_constant<std::size_t,3>{};
+
+	auto a = std::vector<int>(24);
+	auto c = std::vector<int>(24);
+	auto d = std::vector<int>(24);
+	std::iota( a.begin(), a.end(), 1 );
+
+	ublas::copy( rank, n.data(), c.data(), wc.data(), a.data(), wa.data() );
+	ublas::copy( n.size(), n.data(), d.data(), wc.data(), a.data(), wa.data() );
+	BOOST_CHECK( c == d );
+
+	ublas::transform( rank, n.data(), c.data(), wc.data(), a.data(), wa.data(), [](int x){ return 2*x; } );
+	ublas::transform( n.size(), n.data(), d.data(), wc.data(), a.data(), wa.data(), [](int x){ return 2*x; } );
+	BOOST_CHECK( c == d );
+
+	BOOST_CHECK_EQUAL( ublas::accumulate( rank, n.data(), a.data(), wa.data(), 0 ), 300 );
+	BOOST_CHECK_EQUAL( ublas::accumulate( rank, n.data(), a.data(), wa.data(), 0, [](int k, int x){ return k + x*x; } ),
+	                   ublas::accumulate( n.size(), n.data(), a.data(), wa.data(), 0, [](int k, int x){ return k + x*x; } ) );
+
+	auto const pi = std::vector<std::size_t>{2,3,1};
+	auto const wt = std::vector<std::size_t>{1,3,6};
+	ublas::trans( rank, n.data(), pi.data(), c.data(), wt.data(), a.data(), wa.data() );
+	ublas::trans( n.size(), n.data(), pi.data(), d.data(), wt.data(), const_cast<int const*>(a.data()), wa.data() );
+	BOOST_CHECK( c == d );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
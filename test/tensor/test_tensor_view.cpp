@@ -0,0 +1,236 @@
+//  Copyright (c) 2019
+//  The Boost.uBLAS developers
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+
+
+#include <boost/test/unit_test.hpp>
+#include <boost/numeric/ublas/tensor.hpp>
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+
+#include <numeric>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(test_tensor_view)
+
+using test_types = std::tuple<boost::numeric::ublas::first_order, boost::numeric::ublas::last_order>;
+
+
+BOOST_AUTO_TEST_CASE_TEMPLATE( test_tensor_view_project, layout, test_types)
+{
+	using namespace boost::numeric;
+
+	using value_type  = float;
+	using tensor_type = ublas::tensor<value_type,layout>;
+
+	auto t = tensor_type{4,3,5};
+	std::iota( t.begin(), t.end(), value_type{1} );
+
+	auto v = ublas::project( t, ublas::range(1,3), ublas::range::all(), ublas::slice(0,2,3) );
+	BOOST_CHECK( (v.extents() == ublas::shape{2,3,3}) );
+	BOOST_CHECK_EQUAL( v.size(), 18 );
+	BOOST_CHECK( !v.is_contiguous() );
+
+	for(auto k = 0u; k < 3; ++k)
+		for(auto j = 0u; j < 3; ++j)
+			for(auto i = 0u; i < 2; ++i)
+				BOOST_CHECK_EQUAL( v.at(i,j,k), t.at(i+1,j,2*k) );
+
+	// fixing an index drops the mode
+	auto m = ublas::project( t, 2, ublas::range::all(), ublas::range(1,4) );
+	BOOST_CHECK( (m.extents() == ublas::shape{3,3}) );
+	for(auto j = 0u; j < 3; ++j)
+		for(auto i = 0u; i < 3; ++i)
+			BOOST_CHECK_EQUAL( m.at(i,j), t.at(2,i,j+1) );
+
+	// vectors and scalars are padded to rank two
+	auto x = ublas::project( t, 1, ublas::range::all(), 4 );
+	BOOST_CHECK( (x.extents() == ublas::shape{3,1}) );
+	BOOST_CHECK_EQUAL( x.at(2,0), t.at(1,2,4) );
+	auto s = ublas::project( t, 3, 2, 1 );
+	BOOST_CHECK( (s.extents() == ublas::shape{1,1}) );
+	BOOST_CHECK_EQUAL( s.at(0,0), t.at(3,2,1) );
+
+	// views of views
+	auto vw = ublas::project( v, 1, ublas::range(1,3), ublas::range::all() );
+	BOOST_CHECK( (vw.extents() == ublas::shape{2,3}) );
+	for(auto j = 0u; j < 3; ++j)
+		for(auto i = 0u; i < 2; ++i)
+			BOOST_CHECK_EQUAL( vw.at(i,j), t.at(2,i+1,2*j) );
+
+	// the linear index is that of the storage format
+	auto c = tensor_type( v );
+	BOOST_CHECK( (c.extents() == v.extents()) );
+	for(auto i = 0u; i < c.size(); ++i){
+		BOOST_CHECK_EQUAL( c[i], v[i] );
+		BOOST_CHECK_EQUAL( c(i), v(i) );
+	}
+	for(auto k = 0u; k < 3; ++k)
+		for(auto j = 0u; j < 3; ++j)
+			for(auto i = 0u; i < 2; ++i)
+				BOOST_CHECK_EQUAL( c.at(i,j,k), v.at(i,j,k) );
+
+	auto const& ct = t;
+	auto cv = ublas::project( ct, ublas::range::all(), 1, ublas::range::all() );
+	static_assert( std::is_same<decltype(cv), ublas::tensor_view<value_type const,layout>>::value, "views of constant tensors are read-only" );
+	BOOST_CHECK_EQUAL( cv.at(3,4), t.at(3,1,4) );
+
+	BOOST_CHECK_THROW( ublas::project( t, ublas::range(2,5), ublas::range::all(), ublas::range::all() ), std::out_of_range );
+	BOOST_CHECK_THROW( ublas::project( t, ublas::range(2,2), ublas::range::all(), ublas::range::all() ), std::out_of_range );
+	BOOST_CHECK_THROW( ublas::project( t, ublas::slice(0,2,3), ublas::range::all(), ublas::range::all() ), std::out_of_range );
+	BOOST_CHECK_THROW( ublas::project( t, 4, ublas::range::all(), ublas::range::all() ), std::out_of_range );
+	BOOST_CHECK_THROW( ublas::project( t, ublas::slice(3,-1,2), ublas::range::all(), ublas::range::all() ), std::out_of_range );
+	BOOST_CHECK_THROW( ublas::project( t, ublas::range::all(), ublas::range::all() ), std::length_error );
+}
+
+
+BOOST_AUTO_TEST_CASE_TEMPLATE( test_tensor_view_assign, layout, test_types)
+{
+	using namespace boost::numeric;
+
+	using value_type  = double;
+	using tensor_type = ublas::tensor<value_type,layout>;
+
+	auto t = tensor_type{4,3,5};
+	std::iota( t.begin(), t.end(), value_type{1} );
+	auto const r = t;
+
+	auto v = ublas::project( t, ublas::range(1,3), ublas::range::all(), ublas::slice(1,2,2) );
+	auto const u = tensor_type( v );
+
+	// expressions of views and tensors are written through the view
+	v = v * value_type{2} + u;
+	for(auto k = 0u; k < 5; ++k)
+		for(auto j = 0u; j < 3; ++j)
+			for(auto i = 0u; i < 4; ++i){
+				auto const inside = i >= 1 && i < 3 && k % 2 == 1;
+				BOOST_CHECK_EQUAL( t.at(i,j,k), inside ? 3*r.at(i,j,k) : r.at(i,j,k) );
+			}
+
+	v -= u;
+	v /= value_type{2};
+	BOOST_CHECK( t == r );
+
+	v = value_type{0};
+	v += value_type{1};
+	for(auto i = 0u; i < v.size(); ++i)
+		BOOST_CHECK_EQUAL( v[i], value_type{1} );
+
+	// tensors and views of the same extents are copied
+	v = u;
+	BOOST_CHECK( t == r );
+	auto w = ublas::project( t, ublas::range(0,2), ublas::range::all(), ublas::range(0,2) );
+	w = v;
+	BOOST_CHECK( tensor_type( w ) == u );
+
+	// a view is rebound only by construction
+	auto x = w;
+	x = value_type{7};
+	BOOST_CHECK_EQUAL( t.at(1,2,1), value_type{7} );
+	BOOST_CHECK_EQUAL( x.data(), w.data() );
+
+	auto a = ublas::tensor_view<value_type,layout>( t );
+	BOOST_CHECK( a.is_contiguous() );
+	a = r;
+	BOOST_CHECK( t == r );
+	a *= value_type{2};
+	BOOST_CHECK( t == r * value_type{2} );
+
+	BOOST_CHECK_THROW( v = r, std::runtime_error );
+	BOOST_CHECK_THROW( v = r + r, std::runtime_error );
+	BOOST_CHECK_THROW( (ublas::tensor_view<value_type,layout>( t.data(), ublas::shape{2,3}, typename tensor_type::strides_type( ublas::shape{2,3,1,1} ) )), std::length_error );
+}
+
+
+BOOST_AUTO_TEST_CASE_TEMPLATE( test_tensor_view_reshape, layout, test_types)
+{
+	using namespace boost::numeric;
+
+	using value_type  = float;
+	using tensor_type = ublas::tensor<value_type,layout>;
+
+	auto t = tensor_type{4,3,2};
+	std::iota( t.begin(), t.end(), value_type{1} );
+
+	auto v = ublas::reshape( t, ublas::shape{6,4} );
+	BOOST_CHECK( v.is_contiguous() );
+	BOOST_CHECK_EQUAL( v.data(), t.data() );
+	for(auto i = 0u; i < t.size(); ++i)
+		BOOST_CHECK_EQUAL( v[i], t[i] );
+
+	v.at(5,3) = value_type{0};
+	BOOST_CHECK_EQUAL( t[23], value_type{0} );
+
+	// contiguous views can be reshaped further
+	auto const s = std::is_same<layout,ublas::first_order>::value ?
+	                 ublas::project( t, ublas::range::all(), ublas::range::all(), 1 ) :
+	                 ublas::project( t, 1, ublas::range::all(), ublas::range::all() );
+	BOOST_CHECK( s.is_contiguous() );
+	auto const m = ublas::reshape( s, ublas::shape{s.size(),1} );
+	BOOST_CHECK_EQUAL( m.data(), s.data() );
+	BOOST_CHECK_EQUAL( m[1], s[1] );
+
+	BOOST_CHECK_THROW( ublas::reshape( t, ublas::shape{5,5} ), std::length_error );
+	BOOST_CHECK_THROW( ublas::reshape( ublas::project( t, ublas::range::all(), ublas::range(0,2), ublas::range::all() ), ublas::shape{16,1} ), std::runtime_error );
+}
+
+
+BOOST_AUTO_TEST_CASE_TEMPLATE( test_tensor_view_functions, layout, test_types)
+{
+	using namespace boost::numeric;
+
+	using value_type  = double;
+	using tensor_type = ublas::tensor<value_type,layout>;
+
+	auto t = tensor_type{5,4,6};
+	std::iota( t.begin(), t.end(), value_type{1} );
+
+	auto const v = ublas::project( t, ublas::range(1,4), ublas::slice(0,2,2), ublas::range(1,6) );
+	auto const c = tensor_type( v );
+
+	auto b = ublas::vector<value_type>(2);
+	b(0) = 1; b(1) = 2;
+	auto m = ublas::matrix<value_type,layout>(4,5);
+	for(auto i = 0u; i < m.size1(); ++i)
+		for(auto j = 0u; j < m.size2(); ++j)
+			m(i,j) = value_type(i+2*j+1);
+
+	BOOST_CHECK( ublas::prod( v, b, 2 ) == ublas::prod( c, b, 2 ) );
+	BOOST_CHECK( ublas::prod( v, m, 3 ) == ublas::prod( c, m, 3 ) );
+	BOOST_CHECK( (ublas::prod( v, c, std::vector<std::size_t>{1,3} ) == ublas::prod( c, c, std::vector<std::size_t>{1,3} )) );
+	BOOST_CHECK( (ublas::prod( c, v, std::vector<std::size_t>{2}, std::vector<std::size_t>{2} ) == ublas::prod( c, c, std::vector<std::size_t>{2} )) );
+	BOOST_CHECK( ublas::outer_prod( v, v ) == ublas::outer_prod( c, c ) );
+	BOOST_CHECK_EQUAL( ublas::inner_prod( v, c ), ublas::inner_prod( c, c ) );
+
+	auto const tau = std::vector<std::size_t>{3,1,2};
+	BOOST_CHECK( ublas::trans( v, tau ) == ublas::trans( c, tau ) );
+
+	BOOST_CHECK_CLOSE( ublas::norm( v ), ublas::norm( c ), 1e-10 );
+	BOOST_CHECK_CLOSE( ublas::norm( v - c + v ), ublas::norm( c ), 1e-10 );
+
+	// contiguous views are multiplied with the flattened kernels
+	auto const r = ublas::reshape( t, ublas::shape{20,6} );
+	auto const ones = ublas::vector<value_type>(6, 1);
+	BOOST_CHECK( ublas::prod( r, ones, 2 ) == ublas::prod( tensor_type( r ), ones, 2 ) );
+
+	// the kernels take the pointer, extents and strides of views
+	auto d = tensor_type{3,2};
+	auto const x = ublas::project( t, 2, ublas::range(1,4), ublas::slice(0,5,2) );
+	auto const y = tensor_type( x );
+	ublas::copy( d.rank(), x.extents().data(), d.data(), d.strides().data(), x.data(), x.strides().data() );
+	BOOST_CHECK( d == y );
+	BOOST_CHECK_EQUAL( ublas::accumulate( x.rank(), x.extents().data(), x.data(), x.strides().data(), value_type{} ),
+	                   std::accumulate( y.begin(), y.end(), value_type{} ) );
+
+	using namespace boost::numeric::ublas::index;
+	auto const e = v(_i,_j,_k) * c(_i,_,_k);
+	BOOST_CHECK( tensor_type( e ) == ublas::prod( c, c, std::vector<std::size_t>{1,3} ) );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,210 @@
+//  Copyright (c) 2019
+//  The Boost.uBLAS developers
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+// Container assignments evaluate in place when the expression does not
+// read the container, through a temporary when it does, both have to give
+// the results of an assignment to another container
+
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/matrix_proxy.hpp>
+#include <boost/numeric/ublas/matrix_sparse.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+#include <boost/numeric/ublas/vector_proxy.hpp>
+#include <complex>
+#include "common/testhelper.hpp"
+#include "utils.hpp"
+
+using namespace boost::numeric::ublas;
+
+template<class T, class L>
+bool check_may_alias (std::size_t size) {
+    typedef matrix<T, L> matrix_type;
+    bool pass = true;
+
+    matrix_type m (size, size), a (size, size), b (size + 1, size);
+    vector<T> v (size), w (size);
+    matrix_range<matrix_type> mr (m, range (1, size), range (0, size));
+    compressed_matrix<T> s (size, size);
+
+    // Elementwise reads of the target itself, other containers and scalars
+    pass &= ! detail::matrix_may_alias (m, a);
+    pass &= ! detail::matrix_may_alias (m, m + a);
+    pass &= ! detail::matrix_may_alias (m, T (2) * m - a / T (3));
+    pass &= ! detail::matrix_may_alias (m, -conj (m) + s);
+    pass &= ! detail::matrix_may_alias (m, prod (a, a) + zero_matrix<T> (size, size));
+    pass &= ! detail::matrix_may_alias (m, outer_prod (v, row (a, 1)));
+    pass &= ! detail::vector_may_alias (v, prod (m, w) + v);
+    pass &= ! detail::vector_may_alias (v, row (m, 0) * w (0));
+
+    // Reads of other elements of the target
+    pass &= detail::matrix_may_alias (m, prod (m, a));
+    pass &= detail::matrix_may_alias (m, a + prod (a, m));
+    pass &= detail::matrix_may_alias (m, trans (m));
+    pass &= detail::matrix_may_alias (m, herm (m) - a);
+    pass &= detail::matrix_may_alias (m, m (0, 0) * a);
+    pass &= detail::matrix_may_alias (m, a * m (1, 0));
+    pass &= detail::matrix_may_alias (m, project (b, range (0, size), range (0, size)) + mr (0, 0) * a);
+    pass &= detail::matrix_may_alias (m, outer_prod (column (m, 0), v));
+    pass &= detail::vector_may_alias (v, prod (m, v));
+    pass &= detail::vector_may_alias (v, prod (v, m));
+    pass &= detail::vector_may_alias (v, w * v (2));
+    pass &= detail::vector_may_alias (v, subrange (v, 0, size));
+
+    // Scalars held by reference, in the target or not
+    T t (2);
+    pass &= ! detail::matrix_may_alias (b, b + t * b);
+    pass &= detail::matrix_may_alias (b, b + b (1, 1) * b);
+    return pass;
+}
+
+BOOST_UBLAS_TEST_DEF( test_may_alias )
+{
+    BOOST_UBLAS_TEST_CHECK( (check_may_alias<double, row_major> (7)) );
+    BOOST_UBLAS_TEST_CHECK( (check_may_alias<double, column_major> (7)) );
+    BOOST_UBLAS_TEST_CHECK( (check_may_alias<std::complex<double>, row_major> (5)) );
+}
+
+template<class T, class L>
+bool check_matrix (std::size_t size) {
+    typedef matrix<T, L> matrix_type;
+    bool pass = true;
+
+    matrix_type m0 (size, size), a (size, size);
+    fill (m0, 1);
+    fill (a, 2);
+    matrix_type m (m0), r (size, size);
+
+    // Aliased, through a temporary
+    noalias (r) = prod (m0, a);
+    m = prod (m, a);
+    pass &= compare (m, r);
+    m = m0;
+    noalias (r) = prod (a, m0);
+    m = prod (a, m);
+    pass &= compare (m, r);
+    m = m0;
+    noalias (r) = trans (m0);
+    m = trans (m);
+    pass &= compare (m, r);
+    m = m0;
+    noalias (r) = m0 (0, 0) * m0 - m0 / m0 (size - 1, 0);
+    m = m (0, 0) * m - m / m (size - 1, 0);
+    pass &= compare (m, r);
+    m = m0;
+    noalias (r) = m0 + prod (herm (m0), a);
+    m += prod (herm (m), a);
+    pass &= compare (m, r);
+    m = m0;
+    noalias (r) = m0 - trans (m0);
+    m -= trans (m);
+    pass &= compare (m, r);
+    m = m0;
+    matrix_type p (project (m0, range (1, size), range (0, size - 2)));
+    m = project (m, range (1, size), range (0, size - 2));
+    pass &= compare (m, p);
+
+    // In place, resized when needed
+    m = m0;
+    noalias (r) = T (2) * m0 - a;
+    m = T (2) * m - a;
+    pass &= compare (m, r);
+    matrix_type c (size + 1, size - 1), ca (size + 1, size);
+    fill (ca, 3);
+    matrix_type cr (prod (ca, a));
+    c = prod (ca, a);
+    pass &= compare (c, cr);
+    c += prod (ca, a);
+    pass &= compare (c, T (2) * cr);
+
+    // Containers of fixed storage
+    c_matrix<T, 8, 8> cm (size, size);
+    cm = m0;
+    noalias (r) = prod (m0, m0);
+    cm = prod (cm, cm);
+    pass &= compare (cm, r);
+    bounded_matrix<T, 8, 8, L> bm (m0);
+    bm = prod (a, bm);
+    noalias (r) = prod (a, m0);
+    pass &= compare (bm, r);
+    return pass;
+}
+
+BOOST_UBLAS_TEST_DEF( test_matrix )
+{
+    BOOST_UBLAS_TEST_CHECK( (check_matrix<double, row_major> (7)) );
+    BOOST_UBLAS_TEST_CHECK( (check_matrix<double, column_major> (8)) );
+    BOOST_UBLAS_TEST_CHECK( (check_matrix<std::complex<double>, row_major> (5)) );
+}
+
+template<class T>
+bool check_vector (std::size_t size) {
+    typedef vector<T> vector_type;
+    bool pass = true;
+
+    matrix<T> a (size, size);
+    fill (a, 1);
+    vector_type v0 (size), w (size), r (size);
+    fill_vector (v0, 2);
+    fill_vector (w, 3);
+    vector_type v (v0);
+
+    // Aliased, through a temporary
+    noalias (r) = prod (a, v0);
+    v = prod (a, v);
+    pass &= compare (v, r);
+    v = v0;
+    noalias (r) = v0 + prod (v0, a);
+    v += prod (v, a);
+    pass &= compare (v, r);
+    v = v0;
+    noalias (r) = v0 (0) * v0 - w;
+    v = v (0) * v - w;
+    pass &= compare (v, r);
+    v = v0;
+    vector_type s (subrange (v0, 1, size));
+    v = subrange (v, 1, size);
+    pass &= compare (v, s);
+
+    // In place, resized when needed
+    v = v0;
+    noalias (r) = v0 - T (3) * w;
+    v -= T (3) * w;
+    pass &= compare (v, r);
+    vector_type u (size + 2);
+    u = prod (a, v0);
+    noalias (r) = prod (a, v0);
+    pass &= compare (u, r);
+
+    // Containers of fixed storage
+    c_vector<T, 8> cv (size);
+    cv = v0;
+    noalias (r) = prod (a, v0);
+    cv = prod (a, cv);
+    pass &= compare (cv, r);
+    bounded_vector<T, 8> bv (v0);
+    bv -= bv (1) * w;
+    noalias (r) = v0 - v0 (1) * w;
+    pass &= compare (bv, r);
+    return pass;
+}
+
+BOOST_UBLAS_TEST_DEF( test_vector )
+{
+    BOOST_UBLAS_TEST_CHECK( check_vector<double> (7) );
+    BOOST_UBLAS_TEST_CHECK( check_vector<std::complex<double> > (5) );
+}
+
+int main()
+{
+    BOOST_UBLAS_TEST_BEGIN();
+
+    BOOST_UBLAS_TEST_DO( test_may_alias );
+    BOOST_UBLAS_TEST_DO( test_matrix );
+    BOOST_UBLAS_TEST_DO( test_vector );
+
+    BOOST_UBLAS_TEST_END();
+}
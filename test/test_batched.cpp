@@ -0,0 +1,201 @@
+//  Copyright (c) 2019
+//  The Boost.uBLAS developers
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#undef BOOST_UBLAS_NO_EXCEPTIONS
+#include <boost/numeric/ublas/batched.hpp>
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+#include <boost/numeric/ublas/lu.hpp>
+#include <complex>
+#include "utils.hpp"
+
+using namespace boost::numeric::ublas;
+
+// Matrix b of the batch, different for every b
+template<class BM>
+void fill (BM &a, std::size_t k) {
+    typedef typename BM::value_type value_type;
+    for (std::size_t b = 0; b < a.batch (); ++ b)
+        for (std::size_t i = 0; i < a.size1 (); ++ i)
+            for (std::size_t j = 0; j < a.size2 (); ++ j)
+                a (b, i, j) = value_type (double ((3 * i + 7 * j + 5 * b + k) % 11) - 5);
+}
+
+// Regular, with the largest elements off the diagonal for rows to be swapped
+template<class BM>
+void fill_regular (BM &a) {
+    typedef typename BM::value_type value_type;
+    fill (a, 4);
+    for (std::size_t b = 0; b < a.batch (); ++ b)
+        for (std::size_t i = 0; i < a.size1 (); ++ i)
+            a (b, i, (i + 1 + b) % a.size1 ()) += value_type (20);
+}
+
+template<class BV>
+void fill_vector (BV &x, std::size_t k) {
+    typedef typename BV::value_type value_type;
+    for (std::size_t b = 0; b < x.batch (); ++ b)
+        for (std::size_t i = 0; i < x.size (); ++ i)
+            x (b, i) = value_type (double ((i + 3 * b + k) % 5) - 2);
+}
+
+template<class T, class BM>
+matrix<T> get (const BM &a, std::size_t b) {
+    matrix<T> m (a.size1 (), a.size2 ());
+    for (std::size_t i = 0; i < m.size1 (); ++ i)
+        for (std::size_t j = 0; j < m.size2 (); ++ j)
+            m (i, j) = a (b, i, j);
+    return m;
+}
+
+template<class T, class BV>
+vector<T> get_vector (const BV &x, std::size_t b) {
+    vector<T> v (x.size ());
+    for (std::size_t i = 0; i < v.size (); ++ i)
+        v (i) = x (b, i);
+    return v;
+}
+
+// Every matrix of the batch against the generic evaluation
+template<class T, std::size_t M, std::size_t K, std::size_t N>
+bool check_prod (std::size_t batch) {
+    bool pass = true;
+    batched_matrix<T, M, K> a (batch);
+    batched_matrix<T, K, N> b (batch);
+    batched_vector<T, K> x (batch);
+    fill (a, 1);
+    fill (b, 2);
+    fill_vector (x, 3);
+    batched_matrix<T, M, N> c;
+    batched_vector<T, M> y;
+    batched_prod (a, b, c);
+    batched_prod (a, x, y);
+    pass &= c.batch () == batch && y.batch () == batch;
+    for (std::size_t l = 0; l < batch; ++ l) {
+        matrix<T> ml (prod (get<T> (a, l), get<T> (b, l)));
+        vector<T> vl (prod (get<T> (a, l), get_vector<T> (x, l)));
+        pass &= norm_inf (get<T> (c, l) - ml) == 0;
+        pass &= norm_inf (get_vector<T> (y, l) - vl) == 0;
+    }
+    return pass;
+}
+
+BOOST_UBLAS_TEST_DEF( test_prod )
+{
+    BOOST_UBLAS_TEST_CHECK( (check_prod<double, 4, 4, 4> (1000)) );
+    BOOST_UBLAS_TEST_CHECK( (check_prod<double, 3, 5, 2> (129)) );
+    BOOST_UBLAS_TEST_CHECK( (check_prod<float, 2, 2, 2> (7)) );
+    BOOST_UBLAS_TEST_CHECK( (check_prod<std::complex<double>, 3, 3, 3> (300)) );
+    BOOST_UBLAS_TEST_CHECK( (check_prod<double, 4, 4, 4> (0)) );
+}
+
+template<class T, std::size_t N>
+bool check_lu (std::size_t batch) {
+    bool pass = true;
+    batched_matrix<T, N, N> a (batch);
+    fill_regular (a);
+    batched_matrix<T, N, N> lu (a);
+    batched_permutation<N> pm (batch);
+    pass &= batched_lu_factorize (lu, pm) == 0;
+
+    batched_vector<T, N> x (batch);
+    fill_vector (x, 1);
+    batched_vector<T, N> r (x);
+    batched_lu_substitute (lu, pm, r);
+    batched_matrix<T, N, N> ai;
+    batched_inverse (a, ai);
+    for (std::size_t l = 0; l < batch; ++ l) {
+        // The same factors and interchanges as lu_factorize
+        matrix<T> ml (get<T> (a, l));
+        permutation_matrix<std::size_t> pml (N);
+        lu_factorize (ml, pml);
+        pass &= norm_inf (get<T> (lu, l) - ml) == 0;
+        for (std::size_t k = 0; k < N; ++ k)
+            pass &= pm (l, k) == pml (k);
+
+        vector<T> rl (prod (get<T> (a, l), get_vector<T> (r, l)));
+        pass &= norm_inf (rl - get_vector<T> (x, l)) < 1e-10;
+        matrix<T> il (prod (get<T> (a, l), get<T> (ai, l)));
+        pass &= norm_inf (il - identity_matrix<T> (N)) < 1e-10;
+    }
+    return pass;
+}
+
+BOOST_UBLAS_TEST_DEF( test_lu )
+{
+    BOOST_UBLAS_TEST_CHECK( (check_lu<double, 3> (500)) );
+    BOOST_UBLAS_TEST_CHECK( (check_lu<double, 4> (129)) );
+    BOOST_UBLAS_TEST_CHECK( (check_lu<double, 6> (40)) );
+    BOOST_UBLAS_TEST_CHECK( (check_lu<std::complex<double>, 4> (200)) );
+
+    // A singular matrix in the batch is reported, the others still factorized
+    batched_matrix<double, 3, 3> a (300);
+    fill_regular (a);
+    for (std::size_t j = 0; j < 3; ++ j)
+        a (200, 1, j) = 2 * a (200, 0, j);
+    batched_matrix<double, 3, 3> lu (a);
+    batched_permutation<3> pm (300);
+    BOOST_UBLAS_TEST_CHECK( batched_lu_factorize (lu, pm) == 201 );
+    matrix<double> m (get<double> (a, 17));
+    permutation_matrix<std::size_t> pml (3);
+    lu_factorize (m, pml);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (get<double> (lu, 17) - m) == 0 );
+    bool thrown = false;
+    try {
+        batched_inverse (a, lu);
+    } catch (const singular &) {
+        thrown = true;
+    }
+    BOOST_UBLAS_TEST_CHECK( thrown );
+}
+
+#ifdef BOOST_UBLAS_CPP_GE_2011
+BOOST_UBLAS_TEST_DEF( test_fixed )
+{
+    typedef fixed_matrix<double, 4, 4> fixed_type;
+    typedef fixed_matrix<double, 4, 4, column_major> fixed_column_type;
+    std::vector<fixed_type> as (333), bs (333);
+    std::vector<fixed_vector<double, 4> > xs (333);
+    for (std::size_t l = 0; l < as.size (); ++ l)
+        for (std::size_t i = 0; i < 4; ++ i) {
+            xs [l] (i) = double ((i + l) % 7);
+            for (std::size_t j = 0; j < 4; ++ j) {
+                as [l] (i, j) = double ((i + 2 * j + l) % 9) - 4;
+                bs [l] (i, j) = double ((3 * i + j + l) % 5) - 2;
+            }
+        }
+    batched_matrix<double, 4, 4> a (as), b (bs), c;
+    batched_vector<double, 4> x (xs), y;
+    batched_prod (a, b, c);
+    batched_prod (a, x, y);
+    std::vector<fixed_column_type> cs;
+    std::vector<fixed_vector<double, 4> > ys;
+    c.copy_to (cs);
+    y.copy_to (ys);
+    BOOST_UBLAS_TEST_CHECK( cs.size () == as.size () && ys.size () == as.size () );
+    bool pass = true;
+    for (std::size_t l = 0; l < as.size (); ++ l) {
+        pass &= norm_inf (cs [l] - fixed_type (prod (as [l], bs [l]))) == 0;
+        pass &= norm_inf (ys [l] - fixed_vector<double, 4> (prod (as [l], xs [l]))) == 0;
+        pass &= a (l, 1, 2) == as [l] (1, 2);
+    }
+    BOOST_UBLAS_TEST_CHECK( pass );
+}
+#endif
+
+int main()
+{
+    BOOST_UBLAS_TEST_BEGIN();
+
+    BOOST_UBLAS_TEST_DO( test_prod );
+    BOOST_UBLAS_TEST_DO( test_lu );
+#ifdef BOOST_UBLAS_CPP_GE_2011
+    BOOST_UBLAS_TEST_DO( test_fixed );
+#endif
+
+    BOOST_UBLAS_TEST_END();
+}
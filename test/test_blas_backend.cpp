@@ -0,0 +1,199 @@
+//  Copyright (c) 2019
+//  The Boost.uBLAS developers
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+// Built as is and with BOOST_UBLAS_USE_CBLAS and BOOST_UBLAS_USE_LAPACK,
+// both have to give the results of the generic evaluation
+
+#include <boost/numeric/ublas/blas.hpp>
+#include <boost/numeric/ublas/lu.hpp>
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/matrix_proxy.hpp>
+#include <boost/numeric/ublas/operation.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+#include <boost/numeric/ublas/vector_proxy.hpp>
+#include <complex>
+#include "common/testhelper.hpp"
+#include "utils.hpp"
+
+using namespace boost::numeric::ublas;
+
+template<class E1, class E2>
+bool close (const E1 &e1, const E2 &e2) {
+    return norm_inf (e1 - e2) <= 1e-4 * (1 + norm_inf (e2));
+}
+
+template<class T, class L>
+bool check_prod (std::size_t size1, std::size_t size, std::size_t size2) {
+    typedef matrix<T, L> matrix_type;
+    typedef matrix<T> result_type;
+    bool pass = true;
+
+    matrix_type a (size1 + 3, size + 2), b (size, size2), bt (size2, size);
+    fill (a, 1);
+    fill (b, 2);
+    fill (bt, 3);
+    matrix_range<matrix_type> ar (a, range (1, 1 + size1), range (2, 2 + size));
+    result_type ab (reference_prod<result_type> (ar, b));
+    result_type abt (reference_prod<result_type> (ar, result_type (trans (bt))));
+    result_type abh (reference_prod<result_type> (ar, result_type (herm (bt))));
+
+    // Ranges, transposes and conjugate transposes of both layouts
+    matrix_type c (size1, size2), c0 (size1, size2);
+    fill (c0, 4);
+    noalias (c) = prod (ar, b);
+    pass &= close (c, ab);
+    noalias (c) = prod (ar, trans (bt));
+    pass &= close (c, abt);
+    noalias (c) = prod (ar, herm (bt));
+    pass &= close (c, abh);
+    c = c0;
+    noalias (c) += prod (ar, b);
+    pass &= close (c, c0 + ab);
+    c = c0;
+    noalias (c) -= prod (ar, trans (bt));
+    pass &= close (c, c0 - abt);
+    matrix<T, column_major> ct (size2, size1);
+    noalias (ct) = prod (trans (b), trans (ar));
+    pass &= close (ct, trans (ab));
+
+    // Slices of the target, every other column
+    matrix_type t (size1, 2 * size2);
+    fill (t, 5);
+    matrix_type t0 (t);
+    matrix_slice<matrix_type> ts (t, slice (0, 1, size1), slice (1, 2, size2));
+    noalias (ts) = prod (ar, b);
+    pass &= close (ts, ab);
+    pass &= close (column (t, 0), column (t0, 0));
+
+    // axpy_prod, gmm with the target as an operand
+    matrix_type d (size1, size2);
+    axpy_prod (ar, b, d, true);
+    pass &= close (d, ab);
+    axpy_prod (ar, b, d, false);
+    pass &= close (d, ab + ab);
+    matrix_type s (size, size);
+    fill (s, 6);
+    result_type ss (reference_prod<result_type> (s, s));
+    result_type s2 (T (2) * s - ss);
+    blas_3::gmm (s, T (2), T (-1), s, s);
+    pass &= close (s, s2);
+    return pass;
+}
+
+BOOST_UBLAS_TEST_DEF( test_prod )
+{
+    BOOST_UBLAS_TEST_CHECK( (check_prod<double, row_major> (67, 45, 39)) );
+    BOOST_UBLAS_TEST_CHECK( (check_prod<double, column_major> (61, 47, 53)) );
+    BOOST_UBLAS_TEST_CHECK( (check_prod<float, row_major> (64, 64, 64)) );
+    BOOST_UBLAS_TEST_CHECK( (check_prod<std::complex<double>, row_major> (35, 41, 29)) );
+    BOOST_UBLAS_TEST_CHECK( (check_prod<std::complex<float>, column_major> (35, 41, 29)) );
+    BOOST_UBLAS_TEST_CHECK( (check_prod<double, row_major> (1, 1, 1)) );
+}
+
+template<class T, class L>
+bool check_prod_vector (std::size_t size1, std::size_t size2) {
+    typedef matrix<T, L> matrix_type;
+    typedef vector<T> vector_type;
+    bool pass = true;
+
+    matrix_type a (size1, size2);
+    fill (a, 1);
+    vector_type x (2 * size2), y (size1), y0 (size1), z (size2);
+    fill_vector (x, 2);
+    fill_vector (y0, 3);
+    vector_slice<vector_type> xs (x, slice (1, 2, size2));
+    vector_type ax (size1, T ()), ay (size2, T ());
+    for (std::size_t i = 0; i < size1; ++ i)
+        for (std::size_t j = 0; j < size2; ++ j) {
+            ax (i) += a (i, j) * xs (j);
+            ay (j) += y0 (i) * a (i, j);
+        }
+
+    noalias (y) = prod (a, xs);
+    pass &= close (y, ax);
+    y = y0;
+    noalias (y) -= prod (a, xs);
+    pass &= close (y, y0 - ax);
+    noalias (z) = prod (y0, a);
+    pass &= close (z, ay);
+    noalias (z) = prod (trans (a), y0);
+    pass &= close (z, ay);
+    axpy_prod (a, xs, y, true);
+    pass &= close (y, ax);
+    axpy_prod (y0, a, z, true);
+    pass &= close (z, ay);
+    y = y0;
+    blas_2::gmv (y, T (3), T (2), a, xs);
+    pass &= close (y, T (3) * y0 + T (2) * ax);
+    return pass;
+}
+
+BOOST_UBLAS_TEST_DEF( test_prod_vector )
+{
+    BOOST_UBLAS_TEST_CHECK( (check_prod_vector<double, row_major> (67, 45)) );
+    BOOST_UBLAS_TEST_CHECK( (check_prod_vector<double, column_major> (67, 45)) );
+    BOOST_UBLAS_TEST_CHECK( (check_prod_vector<std::complex<double>, row_major> (31, 40)) );
+    BOOST_UBLAS_TEST_CHECK( (check_prod_vector<float, column_major> (31, 40)) );
+}
+
+template<class T, class L>
+bool check_lu (std::size_t size) {
+    typedef matrix<T, L> matrix_type;
+    bool pass = true;
+
+    // Regular, with the largest elements off the diagonal for rows to be swapped
+    matrix_type a (size, size);
+    fill (a, 1);
+    for (std::size_t i = 0; i < size; ++ i)
+        a (i, (i + 1) % size) += T (20);
+    matrix_type lu (a);
+    permutation_matrix<std::size_t> pm (size);
+    pass &= lu_factorize (lu, pm) == 0;
+
+    // P A = L U
+    matrix_type pa (a);
+    swap_rows (pm, pa);
+    pass &= close (prod (triangular_adaptor<matrix_type, unit_lower> (lu),
+                         triangular_adaptor<matrix_type, upper> (lu)), pa);
+
+    matrix_type b (size, 3), x (size, 3);
+    fill (b, 2);
+    x = b;
+    lu_substitute (lu, pm, x);
+    pass &= close (prod (a, x), b);
+    vector<T> v (size), w (size);
+    fill_vector (v, 3);
+    w = v;
+    lu_substitute (lu, pm, w);
+    pass &= close (prod (a, w), v);
+
+    // A singular matrix reports its first zero pivot
+    matrix_type s (a);
+    column (s, 3).assign (zero_vector<T> (size));
+    permutation_matrix<std::size_t> ps (size);
+    pass &= lu_factorize (s, ps) == 4;
+    return pass;
+}
+
+BOOST_UBLAS_TEST_DEF( test_lu )
+{
+    BOOST_UBLAS_TEST_CHECK( (check_lu<double, row_major> (40)) );
+    BOOST_UBLAS_TEST_CHECK( (check_lu<double, column_major> (40)) );
+    BOOST_UBLAS_TEST_CHECK( (check_lu<float, column_major> (17)) );
+    BOOST_UBLAS_TEST_CHECK( (check_lu<std::complex<double>, row_major> (25)) );
+}
+
+int main()
+{
+    BOOST_UBLAS_TEST_BEGIN();
+
+    BOOST_UBLAS_TEST_DO( test_prod );
+    BOOST_UBLAS_TEST_DO( test_prod_vector );
+    BOOST_UBLAS_TEST_DO( test_lu );
+
+    BOOST_UBLAS_TEST_END();
+}
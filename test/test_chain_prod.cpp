@@ -0,0 +1,109 @@
+//  Copyright (c) 2019
+//  The Boost.uBLAS developers
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/numeric/ublas/operation_chain.hpp>
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/matrix_proxy.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+#include <boost/numeric/ublas/vector_proxy.hpp>
+#include <complex>
+#include "common/testhelper.hpp"
+#include "utils.hpp"
+
+using namespace boost::numeric::ublas;
+
+template<class T, class L>
+bool check_chain (std::size_t p0, std::size_t p1, std::size_t p2, std::size_t p3, std::size_t p4) {
+    typedef matrix<T, L> matrix_type;
+    typedef matrix<T> result_type;
+    bool pass = true;
+
+    matrix_type a (p0, p1), b (p1, p2), c (p2, p3), d (p3, p4), e (p0, p4);
+    fill (a, 1);
+    fill (b, 2);
+    fill (c, 3);
+    fill (d, 4);
+    fill (e, 5);
+    result_type ab (prod (a, b)), abc (prod (ab, c)), abcd (prod (abc, d));
+    pass &= compare (chain_prod (a, b, c), abc);
+    pass &= compare (chain_prod (a, b, c, d), abcd);
+    pass &= compare (chain_prod (a, b, c, d, trans (e)), result_type (prod (abcd, trans (e))));
+
+    // Proxies, transposes and expressions as factors
+    matrix_type t (p1 + 2, 2 * p2);
+    fill (t, 6);
+    matrix_slice<matrix_type> bs (t, slice (1, 1, p1), slice (0, 2, p2));
+    result_type abs (prod (a, bs));
+    pass &= compare (chain_prod (a, bs, c), result_type (prod (abs, c)));
+    pass &= compare (chain_prod (trans (trans (a)), b, c + c), result_type (prod (ab, result_type (c + c))));
+
+    // A vector at the end, also a slice of one
+    vector<T> x (2 * p3), y (p3);
+    fill_vector (x, 7);
+    vector_slice<vector<T> > xs (x, slice (1, 2, p3));
+    y = xs;
+    vector<T> abcy (prod (abc, y));
+    pass &= compare (chain_prod (a, b, c, xs), abcy);
+    pass &= compare (chain_prod (a, b, c, y), abcy);
+    vector<T> z (p0);
+    fill_vector (z, 8);
+    pass &= compare (chain_prod (a, b, c, d, trans (e), z), vector<T> (prod (result_type (prod (abcd, trans (e))), z)));
+    pass &= compare (chain_prod (a, result_type (prod (b, c)), y + y), vector<T> (abcy + abcy));
+    return pass;
+}
+
+BOOST_UBLAS_TEST_DEF( test_chain )
+{
+    BOOST_UBLAS_TEST_CHECK( (check_chain<double, row_major> (1, 1, 1, 1, 1)) );
+    BOOST_UBLAS_TEST_CHECK( (check_chain<double, row_major> (300, 5, 200, 3, 40)) );
+    BOOST_UBLAS_TEST_CHECK( (check_chain<double, column_major> (7, 90, 4, 80, 6)) );
+    BOOST_UBLAS_TEST_CHECK( (check_chain<float, row_major> (6, 4, 5, 3, 4)) );
+    BOOST_UBLAS_TEST_CHECK( (check_chain<std::complex<double>, column_major> (30, 2, 25, 40, 3)) );
+}
+
+BOOST_UBLAS_TEST_DEF( test_order )
+{
+    // 10 x 100, 100 x 5, 5 x 50: (A B) C takes 7500 multiplications, A (B C) 75000
+    matrix<double> a (10, 100), b (100, 5), c (5, 50);
+    detail::matrix_chain<double> abc;
+    abc.push_back (a);
+    abc.push_back (b);
+    abc.push_back (c);
+    abc.order ();
+    BOOST_UBLAS_TEST_CHECK( abc.multiplications () == 7500 );
+
+    // A tall factor then a vector is taken from the right
+    matrix<double> p (1000, 10), q (10, 1000);
+    vector<double> v (1000);
+    detail::matrix_chain<double> pqv;
+    pqv.push_back (p);
+    pqv.push_back (q);
+    pqv.push_back (v);
+    pqv.order ();
+    BOOST_UBLAS_TEST_CHECK( pqv.multiplications () == 20000 );
+
+    // The classic six: 30 x 35, 35 x 15, 15 x 5, 5 x 10, 10 x 20, 20 x 25
+    const std::size_t sizes [7] = { 30, 35, 15, 5, 10, 20, 25 };
+    matrix<double> m [6];
+    detail::matrix_chain<double> chain;
+    for (std::size_t i = 0; i < 6; ++ i) {
+        m [i].resize (sizes [i], sizes [i + 1], false);
+        chain.push_back (m [i]);
+    }
+    chain.order ();
+    BOOST_UBLAS_TEST_CHECK( chain.multiplications () == 15125 );
+}
+
+int main()
+{
+    BOOST_UBLAS_TEST_BEGIN();
+
+    BOOST_UBLAS_TEST_DO( test_chain );
+    BOOST_UBLAS_TEST_DO( test_order );
+
+    BOOST_UBLAS_TEST_END();
+}
@@ -0,0 +1,82 @@
+//  Copyright (c) 2019
+//  The Boost.uBLAS developers
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "utils.hpp"
+
+using namespace boost::numeric::ublas;
+
+BOOST_UBLAS_TEST_DEF( test_unbounded_array )
+{
+    std::size_t n = 100000;
+    unbounded_array<double> a (n, first_touch_tag ());
+    BOOST_UBLAS_TEST_CHECK( a.size () == n );
+    BOOST_UBLAS_TEST_CHECK( *std::max_element (a.begin (), a.end ()) == 0 );
+    BOOST_UBLAS_TEST_CHECK( *std::min_element (a.begin (), a.end ()) == 0 );
+
+    unbounded_array<double> u (n, uninitialized_tag ());
+    BOOST_UBLAS_TEST_CHECK( u.size () == n );
+    u.resize (10, uninitialized_tag ());
+    BOOST_UBLAS_TEST_CHECK( u.size () == 10 );
+
+    // Same size, the elements are cleared in place
+    std::fill (a.begin (), a.end (), 1.0);
+    const double *data = &a [0];
+    a.resize (n, first_touch_tag ());
+    BOOST_UBLAS_TEST_CHECK( &a [0] == data );
+    BOOST_UBLAS_TEST_CHECK( *std::max_element (a.begin (), a.end ()) == 0 );
+    a.resize (0, first_touch_tag ());
+    BOOST_UBLAS_TEST_CHECK( a.size () == 0 );
+
+    // Non trivial elements are constructed
+    unbounded_array<std::string> s (n, first_touch_tag ());
+    BOOST_UBLAS_TEST_CHECK( s [n - 1].empty () );
+    s [0] = "touched";
+    s.resize (3, first_touch_tag ());
+    BOOST_UBLAS_TEST_CHECK( s.size () == 3 && s [0].empty () );
+    unbounded_array<std::string> t (4, uninitialized_tag ());
+    BOOST_UBLAS_TEST_CHECK( t [3].empty () );
+}
+
+BOOST_UBLAS_TEST_DEF( test_containers )
+{
+    vector<double> v (1000, first_touch_tag ());
+    BOOST_UBLAS_TEST_CHECK( v.size () == 1000 && norm_inf (v) == 0 );
+    v.resize (50000, uninitialized_tag ());
+    BOOST_UBLAS_TEST_CHECK( v.size () == 50000 );
+    v.resize (70000, first_touch_tag ());
+    BOOST_UBLAS_TEST_CHECK( v.size () == 70000 && norm_inf (v) == 0 );
+
+    matrix<double> m (300, 200, first_touch_tag ());
+    BOOST_UBLAS_TEST_CHECK( m.size1 () == 300 && m.size2 () == 200 && norm_inf (m) == 0 );
+    m.resize (20, 30, uninitialized_tag ());
+    BOOST_UBLAS_TEST_CHECK( m.size1 () == 20 && m.size2 () == 30 && m.data ().size () == 600 );
+    matrix<double, column_major> c (7, 9, uninitialized_tag ());
+    BOOST_UBLAS_TEST_CHECK( c.data ().size () == 63 );
+    c.resize (400, 100, first_touch_tag ());
+    BOOST_UBLAS_TEST_CHECK( c.size1 () == 400 && norm_inf (c) == 0 );
+
+    // Other storage is resized as usual
+    vector<double, std::vector<double> > w (100, first_touch_tag ());
+    BOOST_UBLAS_TEST_CHECK( w.size () == 100 && norm_inf (w) == 0 );
+    matrix<double, row_major, bounded_array<double, 16> > b (4, 4, uninitialized_tag ());
+    BOOST_UBLAS_TEST_CHECK( b.size1 () == 4 );
+}
+
+int main()
+{
+    BOOST_UBLAS_TEST_BEGIN();
+
+    BOOST_UBLAS_TEST_DO( test_unbounded_array );
+    BOOST_UBLAS_TEST_DO( test_containers );
+
+    BOOST_UBLAS_TEST_END();
+}
@@ -0,0 +1,140 @@
+//  Copyright (c) 2019
+//  The Boost.uBLAS developers
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#undef BOOST_UBLAS_NO_EXCEPTIONS
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+#include <boost/numeric/ublas/operation_fixed.hpp>
+#include <complex>
+#include "common/testhelper.hpp"
+#include "utils.hpp"
+
+#ifdef BOOST_UBLAS_CPP_GE_2011
+
+using namespace boost::numeric::ublas;
+
+// The unrolled kernels against the generic evaluation of the same product
+template<class T, std::size_t M, std::size_t K, std::size_t N, class L1, class L2>
+bool check_prod () {
+    bool pass = true;
+    fixed_matrix<T, M, K, L1> a;
+    fixed_matrix<T, K, N, L2> b;
+    fixed_vector<T, K> x;
+    fixed_vector<T, M> z;
+    fill (a, 1);
+    fill (b, 2);
+    fill_vector (x, 3);
+    fill_vector (z, 4);
+    matrix<T> ga (a), gb (b);
+    vector<T> gx (x), gz (z);
+
+    fixed_vector<T, M> y;
+    noalias (y) = prod (a, x);
+    pass &= compare (y, vector<T> (prod (ga, gx)));
+    y = prod (a, x);
+    pass &= compare (y, vector<T> (prod (ga, gx)));
+    noalias (y) += prod (a, x);
+    pass &= compare (y, vector<T> (T (2) * prod (ga, gx)));
+    noalias (y) -= prod (a, x);
+    pass &= compare (y, vector<T> (prod (ga, gx)));
+
+    fixed_vector<T, K> w (prod (z, a));
+    pass &= compare (w, vector<T> (prod (gz, ga)));
+
+    fixed_matrix<T, M, N, L1> c (prod (a, b));
+    pass &= compare (c, matrix<T> (prod (ga, gb)));
+    fixed_matrix<T, M, N, L2> d;
+    noalias (d) = prod (a, b);
+    pass &= compare (d, matrix<T> (prod (ga, gb)));
+    noalias (d) -= prod (a, b);
+    pass &= norm_inf (d) == 0;
+
+    fixed_matrix<T, K, M, L2> t (trans (a));
+    pass &= compare (t, matrix<T> (trans (ga)));
+    const fixed_matrix<T, M, K, L1> &ca (a);
+    t = trans (ca);
+    pass &= compare (t, matrix<T> (trans (ga)));
+
+    pass &= inner_prod (x, x) == inner_prod (gx, gx);
+    return pass;
+}
+
+BOOST_UBLAS_TEST_DEF( test_prod )
+{
+    BOOST_UBLAS_TEST_CHECK( (check_prod<double, 3, 3, 3, row_major, row_major> ()) );
+    BOOST_UBLAS_TEST_CHECK( (check_prod<double, 4, 4, 4, row_major, column_major> ()) );
+    BOOST_UBLAS_TEST_CHECK( (check_prod<double, 6, 6, 6, column_major, row_major> ()) );
+    BOOST_UBLAS_TEST_CHECK( (check_prod<float, 2, 5, 3, column_major, column_major> ()) );
+    BOOST_UBLAS_TEST_CHECK( (check_prod<int, 1, 7, 2, row_major, row_major> ()) );
+    BOOST_UBLAS_TEST_CHECK( (check_prod<std::complex<double>, 3, 4, 2, row_major, column_major> ()) );
+}
+
+template<class T, std::size_t N, class L>
+bool check_inverse () {
+    fixed_matrix<T, N, N, L> a;
+    fill (a, 5);
+    for (std::size_t i = 0; i < N; ++ i)
+        a (i, i) += T (10);
+    fixed_matrix<T, N, N, L> ai (inverse (a));
+    fixed_matrix<T, N, N, L> p (prod (a, ai));
+    bool pass = norm_inf (p - identity_matrix<T> (N)) < 1e-12;
+
+    // The determinant is the product of the pivots of the LU factorization
+    matrix<T> lu (a);
+    T pivots (1);
+    for (std::size_t k = 0; k < N; ++ k) {
+        pivots *= lu (k, k);
+        for (std::size_t i = k + 1; i < N; ++ i) {
+            T l (lu (i, k) / lu (k, k));
+            for (std::size_t j = k; j < N; ++ j)
+                lu (i, j) -= l * lu (k, j);
+        }
+    }
+    pass &= std::abs (determinant (a) - pivots) < 1e-9 * std::abs (pivots);
+    return pass;
+}
+
+BOOST_UBLAS_TEST_DEF( test_inverse )
+{
+    BOOST_UBLAS_TEST_CHECK( (check_inverse<double, 1, row_major> ()) );
+    BOOST_UBLAS_TEST_CHECK( (check_inverse<double, 2, row_major> ()) );
+    BOOST_UBLAS_TEST_CHECK( (check_inverse<double, 3, column_major> ()) );
+    BOOST_UBLAS_TEST_CHECK( (check_inverse<double, 4, row_major> ()) );
+    BOOST_UBLAS_TEST_CHECK( (check_inverse<double, 4, column_major> ()) );
+    BOOST_UBLAS_TEST_CHECK( (check_inverse<std::complex<double>, 4, row_major> ()) );
+
+    fixed_matrix<double, 3, 3> r (1., 2., 3., 4., 5., 6., 7., 8., 10.);
+    BOOST_UBLAS_TEST_CHECK( determinant (r) == -3 );
+    fixed_matrix<double, 4, 4> s (0.);
+    BOOST_UBLAS_TEST_CHECK( determinant (s) == 0 );
+    bool thrown = false;
+    try {
+        inverse (s);
+    } catch (const singular &) {
+        thrown = true;
+    }
+    BOOST_UBLAS_TEST_CHECK( thrown );
+}
+
+int main()
+{
+    BOOST_UBLAS_TEST_BEGIN();
+
+    BOOST_UBLAS_TEST_DO( test_prod );
+    BOOST_UBLAS_TEST_DO( test_inverse );
+
+    BOOST_UBLAS_TEST_END();
+}
+
+#else
+
+int main()
+{
+    BOOST_UBLAS_TEST_BEGIN();
+    BOOST_UBLAS_TEST_END();
+}
+#endif // BOOST_UBLAS_CPP_GE_2011
@@ -0,0 +1,145 @@
+//  Copyright (c) 2019
+//  The Boost.uBLAS developers
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/numeric/ublas/ilu.hpp>
+#include <boost/numeric/ublas/iterative.hpp>
+#include <boost/numeric/ublas/matrix_sparse.hpp>
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+#include "utils.hpp"
+
+using namespace boost::numeric::ublas;
+
+typedef compressed_matrix<double, row_major> sparse_type;
+
+// Five point stencil on an n x n grid, convection c makes it non symmetric
+sparse_type laplace_2d (std::size_t n, double c = 0) {
+    std::size_t size = n * n;
+    sparse_type a (size, size, 5 * size);
+    for (std::size_t i = 0; i < size; ++ i) {
+        std::size_t x = i % n, y = i / n;
+        if (y > 0) a.push_back (i, i - n, -1);
+        if (x > 0) a.push_back (i, i - 1, -1 - c);
+        a.push_back (i, i, 4);
+        if (x + 1 < n) a.push_back (i, i + 1, -1 + c);
+        if (y + 1 < n) a.push_back (i, i + n, -1);
+    }
+    return a;
+}
+
+// Dense L U product of the factors stored in lu
+matrix<double> multiply_factors (const sparse_type &lu) {
+    std::size_t n = lu.size1 ();
+    matrix<double> l (n, n), u (n, n);
+    l = identity_matrix<double> (n);
+    u.clear ();
+    for (std::size_t i = 0; i < n; ++ i)
+        for (std::size_t k = lu.index1_data () [i]; k < lu.index1_data () [i + 1]; ++ k) {
+            std::size_t j = lu.index2_data () [k];
+            if (j < i)
+                l (i, j) = lu.value_data () [k];
+            else
+                u (i, j) = lu.value_data () [k];
+        }
+    return prod (l, u);
+}
+
+BOOST_UBLAS_TEST_DEF( test_ilu0 )
+{
+    // No fill in for a tridiagonal matrix, ILU(0) is the exact LU
+    std::size_t n = 40;
+    sparse_type t (n, n, 3 * n);
+    for (std::size_t i = 0; i < n; ++ i) {
+        if (i > 0) t.push_back (i, i - 1, -1);
+        t.push_back (i, i, 3);
+        if (i + 1 < n) t.push_back (i, i + 1, -2);
+    }
+    matrix<double> dense (t);
+    BOOST_UBLAS_TEST_CHECK( ilu0_factorize (t) == 0 );
+    BOOST_UBLAS_TEST_CHECK( t.nnz () == 3 * n - 2 );
+    BOOST_UBLAS_TEST_CHECK( norm_inf (multiply_factors (t) - dense) < 1e-12 );
+
+    ilu_level_schedule<sparse_type> s (t);
+    BOOST_UBLAS_TEST_CHECK( s.lower_levels () == n );
+    BOOST_UBLAS_TEST_CHECK( s.upper_levels () == n );
+    vector<double> b (n), x (n);
+    for (std::size_t i = 0; i < n; ++ i)
+        b (i) = double (i % 4);
+    x = b;
+    ilu_substitute (t, s, x);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (prod (dense, x) - b) < 1e-10 );
+
+    // On a 2D grid L U matches A on the pattern of A
+    sparse_type a (laplace_2d (8, 0.3)), lu (a);
+    BOOST_UBLAS_TEST_CHECK( ilu0_factorize (lu) == 0 );
+    BOOST_UBLAS_TEST_CHECK( lu.nnz () == a.nnz () );
+    matrix<double> p (multiply_factors (lu));
+    double error = 0;
+    for (std::size_t i = 0; i < a.size1 (); ++ i)
+        for (std::size_t k = a.index1_data () [i]; k < a.index1_data () [i + 1]; ++ k)
+            error = (std::max) (error, std::abs (p (i, a.index2_data () [k]) - a.value_data () [k]));
+    BOOST_UBLAS_TEST_CHECK( error < 1e-12 );
+
+    // Wavefronts of the grid
+    ilu_level_schedule<sparse_type> w (lu);
+    BOOST_UBLAS_TEST_CHECK( w.lower_levels () == 2 * 8 - 1 );
+    BOOST_UBLAS_TEST_CHECK( w.upper_levels () == 2 * 8 - 1 );
+    BOOST_UBLAS_TEST_CHECK( w.lower_begin ().back () == a.size1 () );
+
+    // Missing diagonal
+    sparse_type m (2, 2, 2);
+    m.push_back (0, 1, 1);
+    m.push_back (1, 0, 1);
+    BOOST_UBLAS_TEST_CHECK( ilu0_factorize (m) == 1 );
+}
+
+BOOST_UBLAS_TEST_DEF( test_ilut )
+{
+    sparse_type a (laplace_2d (8, 0.3));
+    matrix<double> dense (a);
+
+    // Without dropping ILUT is the exact LU
+    sparse_type lu (a);
+    BOOST_UBLAS_TEST_CHECK( ilut_factorize (lu, 0.0, a.size1 ()) == 0 );
+    BOOST_UBLAS_TEST_CHECK( lu.nnz () > a.nnz () );
+    BOOST_UBLAS_TEST_CHECK( norm_inf (multiply_factors (lu) - dense) < 1e-10 );
+    ilu_level_schedule<sparse_type> s (lu);
+    vector<double> b (a.size1 ()), x (a.size1 ());
+    for (std::size_t i = 0; i < b.size (); ++ i)
+        b (i) = 1.0 + (i % 3);
+    x = b;
+    ilu_substitute (lu, s, x);
+    BOOST_UBLAS_TEST_CHECK( norm_inf (prod (dense, x) - b) < 1e-10 );
+
+    // Fill is bounded per row
+    sparse_type small (a);
+    BOOST_UBLAS_TEST_CHECK( ilut_factorize (small, 1e-3, 3) == 0 );
+    BOOST_UBLAS_TEST_CHECK( small.nnz () <= 7 * a.size1 () );
+
+    // As a preconditioner ILUT beats ILU(0)
+    sparse_type big (laplace_2d (24, 0.3));
+    vector<double> c (big.size1 (), 1.0), y (big.size1 ());
+    iteration_control<> control (1000, 1e-10);
+    y.clear ();
+    std::size_t ilu0 = bicgstab (big, y, c, ilu0_preconditioner<sparse_type> (big), control);
+    BOOST_UBLAS_TEST_CHECK( control.converged () );
+    y.clear ();
+    std::size_t ilut = bicgstab (big, y, c, ilut_preconditioner<sparse_type> (big, 1e-4, 10), control);
+    BOOST_UBLAS_TEST_CHECK( control.converged () );
+    BOOST_UBLAS_TEST_CHECK( ilut < ilu0 );
+    BOOST_UBLAS_TEST_CHECK( norm_2 (c - prod (big, y)) / norm_2 (c) < 1e-9 );
+}
+
+int main()
+{
+    BOOST_UBLAS_TEST_BEGIN();
+
+    BOOST_UBLAS_TEST_DO( test_ilu0 );
+    BOOST_UBLAS_TEST_DO( test_ilut );
+
+    BOOST_UBLAS_TEST_END();
+}
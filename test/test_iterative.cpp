@@ -0,0 +1,230 @@
+//  Copyright (c) 2019
+//  The Boost.uBLAS developers
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/numeric/ublas/iterative.hpp>
+#include <boost/numeric/ublas/matrix_sparse.hpp>
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+#include <complex>
+#include "utils.hpp"
+
+using namespace boost::numeric::ublas;
+
+typedef compressed_matrix<double, row_major> sparse_type;
+
+// Five point stencil on an n x n grid, convection c makes it non symmetric
+template<class T>
+compressed_matrix<T, row_major> laplace_2d (std::size_t n, double c = 0) {
+    std::size_t size = n * n;
+    compressed_matrix<T, row_major> a (size, size, 5 * size);
+    for (std::size_t i = 0; i < size; ++ i) {
+        std::size_t x = i % n, y = i / n;
+        if (y > 0) a.push_back (i, i - n, T (-1));
+        if (x > 0) a.push_back (i, i - 1, T (-1 - c));
+        a.push_back (i, i, T (4));
+        if (x + 1 < n) a.push_back (i, i + 1, T (-1 + c));
+        if (y + 1 < n) a.push_back (i, i + n, T (-1));
+    }
+    return a;
+}
+
+template<class M, class V>
+double residual (const M &a, const V &x, const V &b) {
+    return norm_2 (b - prod (a, x)) / norm_2 (b);
+}
+
+struct count_monitor {
+    count_monitor (std::size_t &calls): calls_ (calls) {}
+    void operator () (std::size_t, double) const { ++ calls_; }
+    std::size_t &calls_;
+};
+
+// Matrix free operator y = A x for the tridiagonal [-1 2 -1]
+struct tridiagonal_operator {
+    template<class V1, class V2>
+    void apply (const V1 &x, V2 &y) const {
+        std::size_t n = x.size ();
+        for (std::size_t i = 0; i < n; ++ i)
+            y (i) = 2 * x (i) - (i > 0 ? x (i - 1) : 0) - (i + 1 < n ? x (i + 1) : 0);
+    }
+};
+
+BOOST_UBLAS_TEST_DEF( test_cg )
+{
+    sparse_type a (laplace_2d<double> (16));
+    vector<double> b (a.size1 ()), x (a.size1 ());
+    for (std::size_t i = 0; i < b.size (); ++ i)
+        b (i) = 1.0 + (i % 7);
+
+    iteration_control<> control (1000, 1e-10);
+
+    std::size_t calls = 0;
+    x.clear ();
+    std::size_t plain = cg (a, x, b, identity_preconditioner (), control, count_monitor (calls));
+    BOOST_UBLAS_TEST_CHECK( control.converged () );
+    BOOST_UBLAS_TEST_CHECK( calls == plain );
+    BOOST_UBLAS_TEST_CHECK( residual (a, x, b) < 1e-9 );
+
+    x.clear ();
+    cg (a, x, b, jacobi_preconditioner<double> (a), control);
+    BOOST_UBLAS_TEST_CHECK( control.converged () );
+    BOOST_UBLAS_TEST_CHECK( residual (a, x, b) < 1e-9 );
+
+    x.clear ();
+    std::size_t ic = cg (a, x, b, ichol0_preconditioner<sparse_type> (a), control);
+    BOOST_UBLAS_TEST_CHECK( control.converged () );
+    BOOST_UBLAS_TEST_CHECK( ic < plain );
+    BOOST_UBLAS_TEST_CHECK( residual (a, x, b) < 1e-9 );
+
+    x.clear ();
+    std::size_t ilu = cg (a, x, b, ilu0_preconditioner<sparse_type> (a), control);
+    BOOST_UBLAS_TEST_CHECK( control.converged () );
+    BOOST_UBLAS_TEST_CHECK( ilu < plain );
+    BOOST_UBLAS_TEST_CHECK( residual (a, x, b) < 1e-9 );
+
+    // Matrix free operator and a dense matrix give the same answer
+    std::size_t n = 50;
+    matrix<double> d (n, n);
+    d.clear ();
+    for (std::size_t i = 0; i < n; ++ i) {
+        d (i, i) = 2;
+        if (i > 0) d (i, i - 1) = -1;
+        if (i + 1 < n) d (i, i + 1) = -1;
+    }
+    vector<double> c (n, 1.0), y1 (n), y2 (n);
+    y1.clear (); y2.clear ();
+    cg (tridiagonal_operator (), y1, c, identity_preconditioner (), control);
+    BOOST_UBLAS_TEST_CHECK( control.converged () );
+    cg (d, y2, c, identity_preconditioner (), control);
+    BOOST_UBLAS_TEST_CHECK( control.converged () );
+    BOOST_UBLAS_TEST_CHECK( norm_inf (y1 - y2) < 1e-8 );
+
+    // Stopping on max_iterations
+    iteration_control<> few (3, 1e-12);
+    x.clear ();
+    BOOST_UBLAS_TEST_CHECK( cg (a, x, b, identity_preconditioner (), few) == 3 );
+    BOOST_UBLAS_TEST_CHECK( ! few.converged () );
+}
+
+BOOST_UBLAS_TEST_DEF( test_cg_complex )
+{
+    typedef std::complex<double> value_type;
+    typedef compressed_matrix<value_type, row_major> complex_sparse_type;
+
+    complex_sparse_type a (laplace_2d<value_type> (10));
+    vector<value_type> b (a.size1 ()), x (a.size1 ());
+    for (std::size_t i = 0; i < b.size (); ++ i)
+        b (i) = value_type (1.0, double (i % 3));
+
+    iteration_control<> control (1000, 1e-10);
+    x.clear ();
+    cg (a, x, b, ichol0_preconditioner<complex_sparse_type> (a), control);
+    BOOST_UBLAS_TEST_CHECK( control.converged () );
+    BOOST_UBLAS_TEST_CHECK( residual (a, x, b) < 1e-9 );
+}
+
+BOOST_UBLAS_TEST_DEF( test_bicgstab )
+{
+    sparse_type a (laplace_2d<double> (16, 0.4));
+    vector<double> b (a.size1 ()), x (a.size1 ());
+    for (std::size_t i = 0; i < b.size (); ++ i)
+        b (i) = 1.0 + (i % 5);
+
+    iteration_control<> control (1000, 1e-10);
+    krylov_workspace<double> ws;
+
+    x.clear ();
+    std::size_t plain = bicgstab (a, x, b, identity_preconditioner (), control, null_monitor (), ws);
+    BOOST_UBLAS_TEST_CHECK( control.converged () );
+    BOOST_UBLAS_TEST_CHECK( residual (a, x, b) < 1e-9 );
+
+    // Reusing the workspace
+    x.clear ();
+    std::size_t ilu = bicgstab (a, x, b, ilu0_preconditioner<sparse_type> (a), control, null_monitor (), ws);
+    BOOST_UBLAS_TEST_CHECK( control.converged () );
+    BOOST_UBLAS_TEST_CHECK( ilu < plain );
+    BOOST_UBLAS_TEST_CHECK( residual (a, x, b) < 1e-9 );
+}
+
+BOOST_UBLAS_TEST_DEF( test_gmres )
+{
+    sparse_type a (laplace_2d<double> (16, 0.4));
+    vector<double> b (a.size1 ()), x (a.size1 ());
+    for (std::size_t i = 0; i < b.size (); ++ i)
+        b (i) = 1.0 + (i % 5);
+
+    iteration_control<> control (2000, 1e-10);
+
+    std::size_t calls = 0;
+    x.clear ();
+    std::size_t plain = gmres (a, x, b, identity_preconditioner (), 30, control, count_monitor (calls));
+    BOOST_UBLAS_TEST_CHECK( control.converged () );
+    BOOST_UBLAS_TEST_CHECK( calls == plain );
+    BOOST_UBLAS_TEST_CHECK( residual (a, x, b) < 1e-9 );
+
+    x.clear ();
+    std::size_t ilu = gmres (a, x, b, ilu0_preconditioner<sparse_type> (a), 30, control);
+    BOOST_UBLAS_TEST_CHECK( control.converged () );
+    BOOST_UBLAS_TEST_CHECK( ilu < plain );
+    BOOST_UBLAS_TEST_CHECK( residual (a, x, b) < 1e-9 );
+
+    // Complex, dense and unrestarted
+    typedef std::complex<double> value_type;
+    std::size_t n = 20;
+    matrix<value_type> d (n, n);
+    for (std::size_t i = 0; i < n; ++ i)
+        for (std::size_t j = 0; j < n; ++ j)
+            d (i, j) = i == j ? value_type (n, 1) : value_type (1.0 / (1 + i + j), double (i) - double (j));
+    vector<value_type> c (n), y (n);
+    for (std::size_t i = 0; i < n; ++ i)
+        c (i) = value_type (double (i), 1);
+    y.clear ();
+    gmres (d, y, c, identity_preconditioner (), n, control);
+    BOOST_UBLAS_TEST_CHECK( control.converged () );
+    BOOST_UBLAS_TEST_CHECK( residual (d, y, c) < 1e-9 );
+
+    // Singular on the Krylov subspace, the minimum residual step stays
+    // finite and the iteration stops without converging
+    matrix<double> e (2, 2), f (3, 3);
+    e.clear ();
+    e (0, 1) = 1;
+    vector<double> g (2), z (2);
+    g (0) = 1;
+    g (1) = 0;
+    z.clear ();
+    iteration_control<double> singular (20, 1e-10);
+    std::size_t it = gmres (e, z, g, identity_preconditioner (), 2, singular);
+    BOOST_UBLAS_TEST_CHECK( it < 20 );
+    BOOST_UBLAS_TEST_CHECK( ! singular.converged () );
+    BOOST_UBLAS_TEST_CHECK( norm_inf (z) == 0 );
+    BOOST_UBLAS_TEST_CHECK( singular.residual_norm () == 1 );
+
+    // Only after a first column with a nonzero pivot
+    f.clear ();
+    f (0, 1) = 1;
+    f (1, 2) = 1;
+    vector<double> h (3), u (3);
+    h.clear ();
+    h (1) = 1;
+    u.clear ();
+    it = gmres (f, u, h, identity_preconditioner (), 3, singular);
+    BOOST_UBLAS_TEST_CHECK( it == 2 );
+    BOOST_UBLAS_TEST_CHECK( ! singular.converged () );
+    BOOST_UBLAS_TEST_CHECK( norm_inf (u) == 0 );
+}
+
+int main()
+{
+    BOOST_UBLAS_TEST_BEGIN();
+
+    BOOST_UBLAS_TEST_DO( test_cg );
+    BOOST_UBLAS_TEST_DO( test_cg_complex );
+    BOOST_UBLAS_TEST_DO( test_bicgstab );
+    BOOST_UBLAS_TEST_DO( test_gmres );
+
+    BOOST_UBLAS_TEST_END();
+}
@@ -0,0 +1,155 @@
+//  Copyright (c) 2019
+//  The Boost.uBLAS developers
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/matrix_proxy.hpp>
+#include <complex>
+#include "common/testhelper.hpp"
+#include "utils.hpp"
+
+using namespace boost::numeric::ublas;
+
+template<class M1, class M2>
+bool check_prod (std::size_t size1, std::size_t size, std::size_t size2) {
+    typedef typename M1::value_type value_type;
+    typedef matrix<value_type> result_type;
+    bool pass = true;
+
+    M1 a (size1, size);
+    M2 b (size, size2);
+    fill (a, 1);
+    fill (b, 2);
+    result_type ab (reference_prod<result_type> (a, b));
+    M1 c (size1, size2), c0 (size1, size2);
+    fill (c0, 3);
+
+    noalias (c) = prod (a, b);
+    pass &= compare (c, ab);
+    c = prod (a, b);
+    pass &= compare (c, ab);
+    c = c0;
+    noalias (c) += prod (a, b);
+    pass &= compare (c, c0 + ab);
+    c = c0;
+    noalias (c) -= prod (a, b);
+    pass &= compare (c, c0 - ab);
+    return pass;
+}
+
+template<class M>
+bool check_proxies (std::size_t size1, std::size_t size, std::size_t size2) {
+    typedef typename M::value_type value_type;
+    typedef matrix<value_type> result_type;
+    bool pass = true;
+
+    // Operands inside larger matrices, every other row and column of a slice
+    M a (size1 + 5, size + 3), b (2 * size + 1, 2 * size2 + 2);
+    fill (a, 1);
+    fill (b, 2);
+    matrix_range<M> ar (a, range (2, 2 + size1), range (3, 3 + size));
+    matrix_slice<M> bs (b, slice (1, 2, size), slice (2, 2, size2));
+    indirect_array<> ia (size1), ja (size);
+    for (std::size_t i = 0; i < size1; ++ i)
+        ia (i) = (7 * i + 1) % size1;
+    for (std::size_t k = 0; k < size; ++ k)
+        ja (k) = size - 1 - k;
+    matrix_indirect<M> ai (a, ia, ja);
+    result_type arbs (reference_prod<result_type> (ar, bs));
+    result_type aibs (reference_prod<result_type> (ai, bs));
+
+    result_type c (size1, size2);
+    noalias (c) = prod (ar, bs);
+    pass &= compare (c, arbs);
+    noalias (c) = prod (ai, bs);
+    pass &= compare (c, aibs);
+    result_type ct (size2, size1);
+    noalias (ct) = prod (trans (bs), trans (ar));
+    pass &= compare (ct, trans (arbs));
+
+    // Targets: a range, a slice and a permutation of a larger matrix
+    M t (size1 + 4, 2 * size2 + 1);
+    fill (t, 3);
+    M t0 (t);
+    matrix_range<M> tr (t, range (4, 4 + size1), range (1, 1 + size2));
+    noalias (tr) = prod (ar, bs);
+    pass &= compare (tr, arbs);
+    pass &= compare (subrange (t, 0, 4, 0, 2 * size2 + 1), subrange (t0, 0, 4, 0, 2 * size2 + 1));
+    t = t0;
+    matrix_slice<M> ts (t, slice (1, 1, size1), slice (0, 2, size2));
+    noalias (ts) += prod (ai, bs);
+    pass &= compare (ts, result_type (project (t0, slice (1, 1, size1), slice (0, 2, size2))) + aibs);
+    t = t0;
+    indirect_array<> ti (size1), tj (size2);
+    for (std::size_t i = 0; i < size1; ++ i)
+        ti (i) = size1 + 3 - i;
+    for (std::size_t j = 0; j < size2; ++ j)
+        tj (j) = 2 * j + 1;
+    matrix_indirect<M> tx (t, ti, tj);
+    noalias (tx) -= prod (ar, bs);
+    pass &= compare (tx, result_type (project (t0, ti, tj)) - arbs);
+    tx = prod (ai, bs);
+    pass &= compare (tx, aibs);
+    return pass;
+}
+
+typedef matrix<double, column_major> column_major_matrix;
+
+BOOST_UBLAS_TEST_DEF( test_prod )
+{
+    BOOST_UBLAS_TEST_CHECK( (check_prod<matrix<double>, matrix<double> > (1, 1, 1)) );
+    BOOST_UBLAS_TEST_CHECK( (check_prod<matrix<double>, matrix<double> > (7, 5, 3)) );
+    BOOST_UBLAS_TEST_CHECK( (check_prod<matrix<double>, matrix<double> > (67, 45, 39)) );
+    BOOST_UBLAS_TEST_CHECK( (check_prod<matrix<double>, matrix<double> > (301, 527, 263)) );
+    BOOST_UBLAS_TEST_CHECK( (check_prod<column_major_matrix, column_major_matrix> (67, 45, 39)) );
+    BOOST_UBLAS_TEST_CHECK( (check_prod<column_major_matrix, matrix<double> > (131, 300, 270)) );
+    BOOST_UBLAS_TEST_CHECK( (check_prod<matrix<float>, matrix<float> > (64, 64, 64)) );
+    BOOST_UBLAS_TEST_CHECK( (check_prod<matrix<std::complex<double> >, matrix<std::complex<double> > > (35, 41, 29)) );
+}
+
+BOOST_UBLAS_TEST_DEF( test_proxies )
+{
+    BOOST_UBLAS_TEST_CHECK( check_proxies<matrix<double> > (3, 2, 4) );
+    BOOST_UBLAS_TEST_CHECK( check_proxies<matrix<double> > (61, 47, 53) );
+    BOOST_UBLAS_TEST_CHECK( check_proxies<column_major_matrix> (61, 47, 53) );
+    BOOST_UBLAS_TEST_CHECK( check_proxies<matrix<std::complex<double> > > (33, 40, 29) );
+}
+
+BOOST_UBLAS_TEST_DEF( test_prod_mixed )
+{
+    // Transposes are gathered, expressions and other value types go element by element
+    matrix<double> a (50, 60), b (60, 70);
+    fill (a, 1);
+    fill (b, 2);
+    matrix<double> ab (reference_prod<matrix<double> > (a, b));
+    matrix<double> c (70, 50);
+    noalias (c) = prod (trans (b), trans (a));
+    BOOST_UBLAS_TEST_CHECK( compare (c, trans (ab)) );
+    matrix<double> d (50, 70);
+    noalias (d) = prod (a + a, b);
+    BOOST_UBLAS_TEST_CHECK( compare (d, reference_prod<matrix<double> > (matrix<double> (a + a), b)) );
+    matrix<float> f (50, 70);
+    noalias (f) = prod (a, b);
+    BOOST_UBLAS_TEST_CHECK( compare (matrix<double> (f), matrix<double> (matrix<float> (ab))) );
+
+    // Aliased operands are evaluated into a temporary first
+    matrix<double> s (60, 60);
+    fill (s, 4);
+    matrix<double> ss (reference_prod<matrix<double> > (s, s));
+    s = prod (s, s);
+    BOOST_UBLAS_TEST_CHECK( compare (s, ss) );
+}
+
+int main()
+{
+    BOOST_UBLAS_TEST_BEGIN();
+
+    BOOST_UBLAS_TEST_DO( test_prod );
+    BOOST_UBLAS_TEST_DO( test_proxies );
+    BOOST_UBLAS_TEST_DO( test_prod_mixed );
+
+    BOOST_UBLAS_TEST_END();
+}
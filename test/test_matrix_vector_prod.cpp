@@ -0,0 +1,122 @@
+//  Copyright (c) 2019
+//  The Boost.uBLAS developers
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/matrix_proxy.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+#include <boost/numeric/ublas/vector_proxy.hpp>
+#include <complex>
+#include "common/testhelper.hpp"
+#include "utils.hpp"
+
+using namespace boost::numeric::ublas;
+
+template<class M>
+bool check_prod (std::size_t size1, std::size_t size2) {
+    typedef typename M::value_type value_type;
+    typedef vector<value_type> vector_type;
+    bool pass = true;
+
+    M m (size1, size2);
+    fill (m, 0);
+    vector_type x (size2), z (size1), y (size1), y0 (size1);
+    fill_vector (x, 1);
+    fill_vector (z, 2);
+    fill_vector (y0, 3);
+    vector_type ax (reference_prod (m, x));
+    vector_type za (reference_prod (matrix<value_type> (trans (m)), z));
+
+    noalias (y) = prod (m, x);
+    pass &= compare (y, ax);
+    y = prod (m, x);
+    pass &= compare (y, ax);
+    y = y0;
+    noalias (y) += prod (m, x);
+    pass &= compare (y, y0 + ax);
+    y = y0;
+    noalias (y) -= prod (m, x);
+    pass &= compare (y, y0 - ax);
+
+    vector_type w (size2);
+    noalias (w) = prod (z, m);
+    pass &= compare (w, za);
+    w.clear ();
+    noalias (w) -= prod (z, m);
+    pass &= compare (w, - za);
+
+    // Proxies as operands and target
+    if (size1 > 2 && size2 > 2) {
+        vector_type r (size1 + 3);
+        r.clear ();
+        noalias (subrange (r, 3, 3 + size1)) = prod (m, x);
+        pass &= compare (subrange (r, 3, 3 + size1), ax);
+        vector_type s (size1 - 2);
+        noalias (s) = prod (subrange (m, 1, size1 - 1, 0, size2), x);
+        pass &= compare (s, subrange (ax, 1, size1 - 1));
+        noalias (s) = prod (project (m, range (1, size1 - 1), range (0, size2)), x);
+        pass &= compare (s, subrange (ax, 1, size1 - 1));
+    }
+
+    // Products of expressions still go element by element
+    noalias (y) = prod (m, x + x);
+    pass &= compare (y, value_type (2) * ax);
+    return pass;
+}
+
+BOOST_UBLAS_TEST_DEF( test_prod_row_major )
+{
+    BOOST_UBLAS_TEST_CHECK( check_prod<matrix<double> > (1, 1) );
+    BOOST_UBLAS_TEST_CHECK( check_prod<matrix<double> > (7, 5) );
+    BOOST_UBLAS_TEST_CHECK( check_prod<matrix<double> > (13, 17) );
+    BOOST_UBLAS_TEST_CHECK( check_prod<matrix<double> > (301, 259) );
+    BOOST_UBLAS_TEST_CHECK( check_prod<matrix<std::complex<double> > > (9, 6) );
+}
+
+typedef matrix<double, column_major> column_major_matrix;
+typedef matrix<std::complex<double>, column_major> complex_column_major_matrix;
+
+BOOST_UBLAS_TEST_DEF( test_prod_column_major )
+{
+    BOOST_UBLAS_TEST_CHECK( check_prod<column_major_matrix> (1, 1) );
+    BOOST_UBLAS_TEST_CHECK( check_prod<column_major_matrix> (7, 5) );
+    BOOST_UBLAS_TEST_CHECK( check_prod<column_major_matrix> (13, 17) );
+    BOOST_UBLAS_TEST_CHECK( check_prod<column_major_matrix> (301, 259) );
+    BOOST_UBLAS_TEST_CHECK( check_prod<complex_column_major_matrix> (9, 6) );
+}
+
+BOOST_UBLAS_TEST_DEF( test_prod_mixed )
+{
+    // Target of another value type than the product
+    matrix<float> m (6, 6);
+    fill (m, 0);
+    vector<double> x (6), y (6);
+    fill_vector (x, 1);
+    noalias (y) = prod (m, x);
+    BOOST_UBLAS_TEST_CHECK( compare (y, reference_prod (matrix<double> (m), x)) );
+    vector<float> f (6);
+    noalias (f) = prod (m, x);
+    BOOST_UBLAS_TEST_CHECK( compare (vector<double> (f), y) );
+
+    // Rows of a transposed column major matrix are contiguous
+    matrix<double, column_major> c (5, 9);
+    fill (c, 0);
+    vector<double> z (5), w (9);
+    fill_vector (z, 2);
+    noalias (w) = prod (trans (c), z);
+    BOOST_UBLAS_TEST_CHECK( compare (w, reference_prod (matrix<double> (trans (c)), z)) );
+}
+
+int main()
+{
+    BOOST_UBLAS_TEST_BEGIN();
+
+    BOOST_UBLAS_TEST_DO( test_prod_row_major );
+    BOOST_UBLAS_TEST_DO( test_prod_column_major );
+    BOOST_UBLAS_TEST_DO( test_prod_mixed );
+
+    BOOST_UBLAS_TEST_END();
+}
@@ -0,0 +1,172 @@
+//  Copyright (c) 2019
+//  The Boost.uBLAS developers
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/numeric/ublas/operation_fused.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+#include <boost/numeric/ublas/vector_proxy.hpp>
+#include <boost/numeric/ublas/vector_sparse.hpp>
+#include <cmath>
+#include <complex>
+#include <limits>
+#include "utils.hpp"
+
+using namespace boost::numeric::ublas;
+
+static const double TOL (1.0e-12);
+
+BOOST_UBLAS_TEST_DEF( test_fused_norm )
+{
+    std::size_t n = 37;
+    vector<double> x (n), y (n), z (n);
+    for (std::size_t i = 0; i < n; ++ i) {
+        x (i) = 1.0 + i;
+        y (i) = 0.5 * i - 3.0;
+        z (i) = (i % 3) - 1.0;
+    }
+
+    vector<double> expected (y + 2.0 * x);
+    vector<double> v (y);
+    double r = plus_assign_norm_2 (v, 2.0 * x);
+    BOOST_UBLAS_TEST_CHECK_VECTOR_CLOSE( v, expected, n, TOL );
+    BOOST_UBLAS_TEST_CHECK_CLOSE( r, norm_2 (expected), TOL );
+
+    expected = y - 0.5 * x + 3.0 * z;
+    v = y;
+    r = minus_assign_norm_2 (v, 0.5 * x - 3.0 * z);
+    BOOST_UBLAS_TEST_CHECK_VECTOR_CLOSE( v, expected, n, TOL );
+    BOOST_UBLAS_TEST_CHECK_CLOSE( r, norm_2 (expected), TOL );
+
+    // The target may appear at the same index on the right hand side
+    expected = 2.0 * x + 3.0 * y - z;
+    v = y;
+    r = assign_norm_2 (v, 2.0 * x + 3.0 * v - z);
+    BOOST_UBLAS_TEST_CHECK_VECTOR_CLOSE( v, expected, n, TOL );
+    BOOST_UBLAS_TEST_CHECK_CLOSE( r, norm_2 (expected), TOL );
+
+    // Other accumulators
+    v = y;
+    fused_norm_1<double> r1;
+    fused_vector_assign<scalar_plus_assign> (v, x, r1);
+    BOOST_UBLAS_TEST_CHECK_CLOSE( r1.result (), norm_1 (y + x), TOL );
+    fused_norm_inf<double> ri;
+    fused_vector_assign<scalar_assign> (v, z - x, ri);
+    BOOST_UBLAS_TEST_CHECK_CLOSE( ri.result (), norm_inf (z - x), TOL );
+    fused_sum<double> rs;
+    fused_vector_assign<scalar_assign> (v, x, rs);
+    BOOST_UBLAS_TEST_CHECK_CLOSE( rs.result (), sum (x), TOL );
+}
+
+BOOST_UBLAS_TEST_DEF( test_fused_norm_extreme )
+{
+    // The squares overflow or underflow, the norms do not
+    std::size_t n = 3;
+    vector<double> x (n), v (n);
+    double r;
+    for (std::size_t i = 0; i < n; ++ i)
+        x (i) = 1e200;
+    r = assign_norm_2 (v, x);
+    BOOST_UBLAS_TEST_CHECK_REL_CLOSE( r, std::sqrt (3.0) * 1e200, TOL );
+    BOOST_UBLAS_TEST_CHECK_REL_CLOSE( r, norm_2 (x), TOL );
+    v.clear ();
+    r = minus_assign_norm_2 (v, x);
+    BOOST_UBLAS_TEST_CHECK_REL_CLOSE( r, std::sqrt (3.0) * 1e200, TOL );
+
+    for (std::size_t i = 0; i < n; ++ i)
+        x (i) = 1e-200;
+    v.clear ();
+    r = plus_assign_norm_2 (v, x);
+    BOOST_UBLAS_TEST_CHECK_REL_CLOSE( r, std::sqrt (3.0) * 1e-200, TOL );
+    BOOST_UBLAS_TEST_CHECK_REL_CLOSE( r, norm_2 (x), TOL );
+
+    // Subnormal elements
+    x (0) = 3e-310;
+    x (1) = 4e-310;
+    x (2) = 0.0;
+    r = assign_norm_2 (v, x);
+    BOOST_UBLAS_TEST_CHECK_REL_CLOSE( r, 5e-310, 1e-6 );
+
+    typedef std::complex<double> complex_type;
+    vector<complex_type> c (n), w (n);
+    for (std::size_t i = 0; i < n; ++ i)
+        c (i) = complex_type (3e250, -4e250);
+    r = assign_norm_2 (w, c);
+    BOOST_UBLAS_TEST_CHECK_REL_CLOSE( r, std::sqrt (3.0) * 5e250, TOL );
+
+    // Zero and infinite norms stay so
+    x.clear ();
+    BOOST_UBLAS_TEST_CHECK( assign_norm_2 (v, x) == 0.0 );
+    x (1) = std::numeric_limits<double>::infinity ();
+    BOOST_UBLAS_TEST_CHECK( assign_norm_2 (v, x) == std::numeric_limits<double>::infinity () );
+}
+
+BOOST_UBLAS_TEST_DEF( test_fused_inner_prod )
+{
+    std::size_t n = 25;
+    vector<double> x (n), y (n), z (n);
+    for (std::size_t i = 0; i < n; ++ i) {
+        x (i) = 1.0 + i;
+        y (i) = 0.5 * i - 3.0;
+        z (i) = (i % 3) - 1.0;
+    }
+
+    vector<double> v (n);
+    double d = assign_inner_prod (v, 1.5 * y + z, x);
+    BOOST_UBLAS_TEST_CHECK_VECTOR_CLOSE( v, 1.5 * y + z, n, TOL );
+    BOOST_UBLAS_TEST_CHECK_CLOSE( d, inner_prod (x, 1.5 * y + z), TOL );
+
+    v = z;
+    d = plus_assign_inner_prod (v, y, x);
+    BOOST_UBLAS_TEST_CHECK_CLOSE( d, inner_prod (x, z + y), TOL );
+
+    // Complex values are not conjugated, like inner_prod
+    typedef std::complex<double> complex_type;
+    vector<complex_type> a (n), b (n), c (n);
+    for (std::size_t i = 0; i < n; ++ i) {
+        a (i) = complex_type (i, 1);
+        b (i) = complex_type (1, - double (i));
+    }
+    c = a;
+    complex_type e = minus_assign_inner_prod (c, complex_type (0, 2) * b, a);
+    BOOST_UBLAS_TEST_CHECK_CLOSE( e, inner_prod (a, a - complex_type (0, 2) * b), TOL );
+}
+
+BOOST_UBLAS_TEST_DEF( test_fused_proxies )
+{
+    std::size_t n = 20;
+    vector<double> x (n), y (n);
+    for (std::size_t i = 0; i < n; ++ i) {
+        x (i) = 1.0 + i;
+        y (i) = 2.0 - i;
+    }
+
+    // Dense proxies run the fused loop
+    vector<double> v (y);
+    vector_range<vector<double> > vr (v, range (5, 15));
+    double r = plus_assign_norm_2 (vr, project (x, range (5, 15)));
+    BOOST_UBLAS_TEST_CHECK_CLOSE( r, norm_2 (project (y + x, range (5, 15))), TOL );
+    BOOST_UBLAS_TEST_CHECK_CLOSE( v (4), y (4), TOL );
+    BOOST_UBLAS_TEST_CHECK_CLOSE( v (5), y (5) + x (5), TOL );
+
+    // Sparse targets assign first and reduce over the stored elements
+    mapped_vector<double> s (n);
+    s (3) = 1.0;
+    r = plus_assign_norm_2 (s, unit_vector<double> (n, 7) * 2.0);
+    BOOST_UBLAS_TEST_CHECK_CLOSE( r, std::sqrt (5.0), TOL );
+    BOOST_UBLAS_TEST_CHECK_CLOSE( s (7), 2.0, TOL );
+}
+
+int main()
+{
+    BOOST_UBLAS_TEST_BEGIN();
+
+    BOOST_UBLAS_TEST_DO( test_fused_norm );
+    BOOST_UBLAS_TEST_DO( test_fused_norm_extreme );
+    BOOST_UBLAS_TEST_DO( test_fused_inner_prod );
+    BOOST_UBLAS_TEST_DO( test_fused_proxies );
+
+    BOOST_UBLAS_TEST_END();
+}
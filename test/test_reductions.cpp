@@ -0,0 +1,152 @@
+//  Copyright (c) 2019
+//  The Boost.uBLAS developers
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/numeric/ublas/vector.hpp>
+#include <boost/numeric/ublas/vector_proxy.hpp>
+#include <cmath>
+#include <complex>
+#include <limits>
+#ifdef BOOST_UBLAS_USE_OPENMP
+#include <omp.h>
+#endif
+#include "utils.hpp"
+
+using namespace boost::numeric::ublas;
+
+BOOST_UBLAS_TEST_DEF( test_sum )
+{
+    // Cancellation only the compensated summation survives
+    vector<double> c (4);
+    c (0) = 1; c (1) = 1e100; c (2) = 1; c (3) = -1e100;
+    BOOST_UBLAS_TEST_CHECK( sum (c, naive_summation_tag ()) == 0 );
+    BOOST_UBLAS_TEST_CHECK( sum (c, compensated_summation_tag ()) == 2 );
+
+    // Many small terms, more than one chunk
+    std::size_t n = 1000003;
+    vector<float> v (n, 0.1f);
+    double exact = 0.1f * double (n);
+    double naive = sum (v, naive_summation_tag ());
+    double pairwise = sum (v, pairwise_summation_tag ());
+    double compensated = sum (v, compensated_summation_tag ());
+    BOOST_UBLAS_TEST_CHECK( std::abs (pairwise - exact) < std::abs (naive - exact) );
+    BOOST_UBLAS_TEST_CHECK( std::abs (pairwise - exact) / exact < 1e-6 );
+    BOOST_UBLAS_TEST_CHECK( std::abs (compensated - exact) / exact < 1e-7 );
+    BOOST_UBLAS_TEST_CHECK( sum (v) == sum (v, BOOST_UBLAS_DEFAULT_SUMMATION ()) );
+
+    // Expressions and proxies
+    vector<double> a (n), b (n);
+    for (std::size_t i = 0; i < n; ++ i) {
+        a (i) = double (i % 17);
+        b (i) = double (i % 5);
+    }
+    double ab = 0;
+    for (std::size_t i = 0; i < n; ++ i)
+        ab += a (i) + 2 * b (i);
+    BOOST_UBLAS_TEST_CHECK( sum (a + 2 * b) == ab );
+    BOOST_UBLAS_TEST_CHECK( sum (subrange (a, 0, 17)) == 136 );
+    BOOST_UBLAS_TEST_CHECK( sum (vector<int> (10000, 3)) == 30000 );
+    BOOST_UBLAS_TEST_CHECK( sum (vector<double> (0)) == 0 );
+}
+
+BOOST_UBLAS_TEST_DEF( test_inner_prod )
+{
+    std::size_t n = 100000;
+    vector<double> a (n), b (n);
+    for (std::size_t i = 0; i < n; ++ i) {
+        a (i) = double (i % 7) - 3;
+        b (i) = double (i % 3);
+    }
+    double exact = 0;
+    for (std::size_t i = 0; i < n; ++ i)
+        exact += a (i) * b (i);
+    BOOST_UBLAS_TEST_CHECK( inner_prod (a, b) == exact );
+    BOOST_UBLAS_TEST_CHECK( inner_prod (a, b, naive_summation_tag ()) == exact );
+    BOOST_UBLAS_TEST_CHECK( inner_prod (a, b, compensated_summation_tag ()) == exact );
+
+    vector<double> c (3);
+    c (0) = 1e100; c (1) = 1; c (2) = -1e100;
+    vector<double> d (3, 1.0);
+    BOOST_UBLAS_TEST_CHECK( inner_prod (c, d, compensated_summation_tag ()) == 1 );
+
+    typedef std::complex<double> complex_type;
+    vector<complex_type> z (n, complex_type (1, 2)), w (n, complex_type (0, 1));
+    BOOST_UBLAS_TEST_CHECK( inner_prod (z, w) == complex_type (-2.0 * n, double (n)) );
+    BOOST_UBLAS_TEST_CHECK( inner_prod (z, w, compensated_summation_tag ()) == complex_type (-2.0 * n, double (n)) );
+}
+
+BOOST_UBLAS_TEST_DEF( test_norm_2 )
+{
+    vector<double> v (2);
+    v (0) = 3; v (1) = 4;
+    BOOST_UBLAS_TEST_CHECK( norm_2 (v) == 5 );
+    BOOST_UBLAS_TEST_CHECK( norm_2_square (v) == 25 );
+
+    // The squares overflow, the rescaled sum does not
+    vector<double> big (v * 1e300);
+    BOOST_UBLAS_TEST_CHECK( std::abs (norm_2 (big) / 5e300 - 1) < 1e-15 );
+    BOOST_UBLAS_TEST_CHECK( norm_2_square (big) == std::numeric_limits<double>::infinity () );
+
+    // The squares underflow, also for subnormal elements
+    vector<double> small (v * 1e-300);
+    BOOST_UBLAS_TEST_CHECK( std::abs (norm_2 (small) / 5e-300 - 1) < 1e-15 );
+    vector<double> tiny (v * 1e-320);
+    BOOST_UBLAS_TEST_CHECK( std::abs (norm_2 (tiny) / 5e-320 - 1) < 1e-3 );
+
+    BOOST_UBLAS_TEST_CHECK( norm_2 (vector<double> (10, 0.0)) == 0 );
+    vector<double> inf (v);
+    inf (1) = std::numeric_limits<double>::infinity ();
+    BOOST_UBLAS_TEST_CHECK( norm_2 (inf) == std::numeric_limits<double>::infinity () );
+    vector<double> nan (v);
+    nan (0) = std::numeric_limits<double>::quiet_NaN ();
+    BOOST_UBLAS_TEST_CHECK( norm_2 (nan) != norm_2 (nan) );
+
+    typedef std::complex<double> complex_type;
+    vector<complex_type> z (2);
+    z (0) = complex_type (3e200, 0); z (1) = complex_type (0, 4e200);
+    BOOST_UBLAS_TEST_CHECK( std::abs (norm_2 (z) / 5e200 - 1) < 1e-15 );
+
+    std::size_t n = 100000;
+    vector<float> f (n, 1e30f);
+    BOOST_UBLAS_TEST_CHECK( std::abs (norm_2 (f) / (1e30 * std::sqrt (double (n))) - 1) < 1e-5 );
+    BOOST_UBLAS_TEST_CHECK( std::abs (norm_2 (f, compensated_summation_tag ()) / (1e30 * std::sqrt (double (n))) - 1) < 1e-6 );
+}
+
+BOOST_UBLAS_TEST_DEF( test_reproducible )
+{
+    // The result does not depend on the number of threads
+    std::size_t n = 300007;
+    vector<double> v (n);
+    for (std::size_t i = 0; i < n; ++ i)
+        v (i) = std::sin (double (i)) * (1 + double (i % 1000));
+
+    double s1 = sum (v), c1 = sum (v, compensated_summation_tag ()), n1 = norm_2 (v), i1 = inner_prod (v, v);
+#ifdef BOOST_UBLAS_USE_OPENMP
+    int threads = omp_get_max_threads ();
+    for (int t = 1; t <= 5; ++ t) {
+        omp_set_num_threads (t);
+        BOOST_UBLAS_TEST_CHECK( sum (v) == s1 );
+        BOOST_UBLAS_TEST_CHECK( sum (v, compensated_summation_tag ()) == c1 );
+        BOOST_UBLAS_TEST_CHECK( norm_2 (v) == n1 );
+        BOOST_UBLAS_TEST_CHECK( inner_prod (v, v) == i1 );
+    }
+    omp_set_num_threads (threads);
+#endif
+    BOOST_UBLAS_TEST_CHECK( std::abs (s1 - c1) < 1e-9 * norm_1 (v) );
+    BOOST_UBLAS_TEST_CHECK( std::abs (n1 * n1 - i1) < 1e-12 * i1 );
+}
+
+int main()
+{
+    BOOST_UBLAS_TEST_BEGIN();
+
+    BOOST_UBLAS_TEST_DO( test_sum );
+    BOOST_UBLAS_TEST_DO( test_inner_prod );
+    BOOST_UBLAS_TEST_DO( test_norm_2 );
+    BOOST_UBLAS_TEST_DO( test_reproducible );
+
+    BOOST_UBLAS_TEST_END();
+}
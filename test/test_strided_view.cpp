@@ -0,0 +1,132 @@
+//  Copyright (c) 2019
+//  The Boost.uBLAS developers
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/matrix_proxy.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+#include <boost/numeric/ublas/vector_proxy.hpp>
+#include <boost/numeric/ublas/detail/raw.hpp>
+#include "utils.hpp"
+
+using namespace boost::numeric::ublas;
+
+template<class M>
+void fill (M &m) {
+    for (std::size_t i = 0; i < m.size1 (); ++ i)
+        for (std::size_t j = 0; j < m.size2 (); ++ j)
+            m (i, j) = typename M::value_type (10 * i + j);
+}
+
+// Every element seen through the pointer and the strides is the element itself
+template<class V>
+bool same_vector (V &v) {
+    if (! raw::strided_vector_traits<V>::value)
+        return false;
+    raw::strided_vector_view<typename V::value_type> w (raw::strided_vector (v));
+    bool pass = true;
+    for (std::size_t i = 0; i < v.size (); ++ i)
+        pass &= &w (i) == &v (i);
+    return pass;
+}
+
+template<class M>
+bool same_matrix (M &m) {
+    if (! raw::strided_matrix_traits<M>::value)
+        return false;
+    raw::strided_matrix_view<typename M::value_type> w (raw::strided_matrix (m));
+    const M &cm (m);
+    raw::strided_matrix_view<const typename M::value_type> cw (raw::strided_matrix (cm));
+    bool pass = true;
+    for (std::size_t i = 0; i < m.size1 (); ++ i)
+        for (std::size_t j = 0; j < m.size2 (); ++ j)
+            pass &= &w (i, j) == &m (i, j) && &cw (i, j) == &cm (i, j);
+    return pass;
+}
+
+// trans () of a strided matrix is the matrix with its strides swapped
+template<class M>
+bool same_transpose (M &m) {
+    typedef matrix_unary2<M, scalar_identity<typename M::value_type> > transpose_type;
+    if (! raw::strided_matrix_traits<transpose_type>::value)
+        return false;
+    const transpose_type t (m);
+    raw::strided_matrix_view<const typename M::value_type> w (raw::strided_matrix (t));
+    bool pass = true;
+    for (std::size_t i = 0; i < t.size1 (); ++ i)
+        for (std::size_t j = 0; j < t.size2 (); ++ j)
+            pass &= &w (i, j) == &m (j, i);
+    return pass;
+}
+
+template<class M>
+bool check_matrix () {
+    bool pass = true;
+    M m (7, 9);
+    fill (m);
+    pass &= same_matrix (m);
+    matrix_range<M> mr (m, range (2, 6), range (1, 8));
+    pass &= same_matrix (mr);
+    matrix_slice<M> ms (m, slice (1, 2, 3), slice (8, -3, 3));
+    pass &= same_matrix (ms);
+    // Proxies of proxies
+    matrix_range<matrix_slice<M> > mrs (ms, range (1, 3), range (0, 2));
+    pass &= same_matrix (mrs);
+    matrix_reference<M> mref (m);
+    pass &= same_matrix (mref);
+    pass &= same_transpose (m);
+    pass &= same_transpose (ms);
+    pass &= same_transpose (mrs);
+
+    matrix_row<M> r (m, 3);
+    pass &= same_vector (r);
+    matrix_column<matrix_range<M> > c (mr, 2);
+    pass &= same_vector (c);
+    return pass;
+}
+
+BOOST_UBLAS_TEST_DEF( test_matrices )
+{
+    BOOST_UBLAS_TEST_CHECK( check_matrix<matrix<double> > () );
+    BOOST_UBLAS_TEST_CHECK( (check_matrix<matrix<double, column_major> > ()) );
+    BOOST_UBLAS_TEST_CHECK( (check_matrix<matrix<float, row_major, std::vector<float> > > ()) );
+    BOOST_UBLAS_TEST_CHECK( (check_matrix<bounded_matrix<double, 7, 9, column_major> > ()) );
+    BOOST_UBLAS_TEST_CHECK( (check_matrix<c_matrix<double, 7, 9> > ()) );
+}
+
+BOOST_UBLAS_TEST_DEF( test_vectors )
+{
+    vector<double> v (20);
+    BOOST_UBLAS_TEST_CHECK( same_vector (v) );
+    vector_range<vector<double> > vr (v, range (3, 17));
+    BOOST_UBLAS_TEST_CHECK( same_vector (vr) );
+    vector_slice<vector<double> > vs (v, slice (18, -3, 6));
+    BOOST_UBLAS_TEST_CHECK( same_vector (vs) );
+    vector_slice<vector_range<vector<double> > > vsr (vr, slice (1, 4, 3));
+    BOOST_UBLAS_TEST_CHECK( same_vector (vsr) );
+    c_vector<double, 5> cv (5);
+    BOOST_UBLAS_TEST_CHECK( same_vector (cv) );
+    bounded_vector<double, 5> bv (5);
+    BOOST_UBLAS_TEST_CHECK( same_vector (bv) );
+
+    // Neither indirect proxies nor packed bits have strides
+    BOOST_UBLAS_TEST_CHECK( ! (raw::strided_vector_traits<vector_indirect<vector<double> > >::value) );
+    BOOST_UBLAS_TEST_CHECK( ! (raw::strided_vector_traits<vector<bool, std::vector<bool> > >::value) );
+    BOOST_UBLAS_TEST_CHECK( ! (raw::strided_matrix_traits<matrix_indirect<matrix<double> > >::value) );
+    BOOST_UBLAS_TEST_CHECK( ! (raw::strided_matrix_traits<matrix_vector_range<matrix<double> > >::value) );
+    // Conjugate transposes are read through the pointer of what they refer to
+    BOOST_UBLAS_TEST_CHECK( ! (raw::strided_matrix_traits<matrix_unary2<matrix<double>, scalar_conj<double> > >::value) );
+}
+
+int main()
+{
+    BOOST_UBLAS_TEST_BEGIN();
+
+    BOOST_UBLAS_TEST_DO( test_matrices );
+    BOOST_UBLAS_TEST_DO( test_vectors );
+
+    BOOST_UBLAS_TEST_END();
+}
@@ -0,0 +1,151 @@
+//  Copyright (c) 2019
+//  The Boost.uBLAS developers
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/numeric/ublas/temporary_arena.hpp>
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+#include <boost/numeric/ublas/matrix_proxy.hpp>
+#include <boost/numeric/ublas/vector_proxy.hpp>
+#include <boost/numeric/ublas/operation_blocked.hpp>
+#include "utils.hpp"
+
+using namespace boost::numeric::ublas;
+
+template<class M>
+void fill (M &m) {
+    for (std::size_t i = 0; i < m.size1 (); ++ i)
+        for (std::size_t j = 0; j < m.size2 (); ++ j)
+            m (i, j) = double ((3 * i + 7 * j) % 11) - 5;
+}
+
+template<class V1, class V2>
+bool same (const V1 &v1, const V2 &v2) {
+    return norm_inf (v1 - v2) == 0;
+}
+
+BOOST_UBLAS_TEST_DEF( test_arena )
+{
+    temporary_arena arena (1024);
+    BOOST_UBLAS_TEST_CHECK( arena.capacity () == 0 && arena.used () == 0 );
+
+    char *p = static_cast<char *> (arena.allocate (10));
+    char *q = static_cast<char *> (arena.allocate (100));
+    BOOST_UBLAS_TEST_CHECK( std::size_t (p) % temporary_arena::alignment == 0 );
+    BOOST_UBLAS_TEST_CHECK( std::size_t (q) % temporary_arena::alignment == 0 );
+    BOOST_UBLAS_TEST_CHECK( q >= p + 10 && arena.owns (p) && arena.owns (q) );
+    BOOST_UBLAS_TEST_CHECK( arena.capacity () == 1024 );
+
+    // Only the last allocation is given back on its own
+    std::size_t used = arena.used ();
+    arena.deallocate (p, 10);
+    BOOST_UBLAS_TEST_CHECK( arena.used () == used );
+    arena.deallocate (q, 100);
+    BOOST_UBLAS_TEST_CHECK( arena.used () < used );
+    BOOST_UBLAS_TEST_CHECK( arena.allocate (100) == q );
+
+    // Large requests get blocks of their own, kept over a reset
+    temporary_arena::marker m (arena.mark ());
+    char *r = static_cast<char *> (arena.allocate (5000));
+    BOOST_UBLAS_TEST_CHECK( arena.owns (r + 4999) && arena.capacity () > 5000 );
+    arena.release (m);
+    BOOST_UBLAS_TEST_CHECK( arena.allocate (100) != r );
+    std::size_t capacity = arena.capacity ();
+    arena.reset ();
+    BOOST_UBLAS_TEST_CHECK( arena.used () == 0 && arena.allocate (10) == p );
+    BOOST_UBLAS_TEST_CHECK( arena.allocate (4000) == r && arena.capacity () == capacity );
+    int i = 0;
+    BOOST_UBLAS_TEST_CHECK( ! arena.owns (&i) );
+}
+
+BOOST_UBLAS_TEST_DEF( test_guard )
+{
+    temporary_arena outer, inner;
+    BOOST_UBLAS_TEST_CHECK( temporary_arena::current () == 0 );
+    BOOST_UBLAS_TEST_CHECK( temporary_allocator<double> ().arena () == 0 );
+    {
+        temporary_arena_guard g (outer);
+        outer.allocate (10);
+#ifndef BOOST_UBLAS_NO_TEMPORARY_ARENA
+        BOOST_UBLAS_TEST_CHECK( temporary_arena::current () == &outer );
+        BOOST_UBLAS_TEST_CHECK( temporary_allocator<double> ().arena () == &outer );
+#endif
+        {
+            temporary_arena_guard h (inner);
+#ifndef BOOST_UBLAS_NO_TEMPORARY_ARENA
+            BOOST_UBLAS_TEST_CHECK( temporary_arena::current () == &inner );
+            BOOST_UBLAS_TEST_CHECK( temporary_allocator<int> () == temporary_allocator<double> () );
+#endif
+        }
+#ifndef BOOST_UBLAS_NO_TEMPORARY_ARENA
+        BOOST_UBLAS_TEST_CHECK( temporary_arena::current () == &outer );
+#endif
+        BOOST_UBLAS_TEST_CHECK( outer.used () > 0 );
+    }
+    BOOST_UBLAS_TEST_CHECK( temporary_arena::current () == 0 && outer.used () == 0 );
+}
+
+BOOST_UBLAS_TEST_DEF( test_temporaries )
+{
+    std::size_t n = 67;
+    matrix<double> a (n, n);
+    matrix<double, column_major> c (n, n);
+    fill (a);
+    fill (c);
+    vector<double> x (n);
+    for (std::size_t i = 0; i < n; ++ i)
+        x (i) = double (i % 5) - 2;
+
+    vector<double> y (prod (a, x));
+    matrix<double> ac (prod (a, c));
+    vector<double> yb (block_prod<vector<double>, 16> (a, x));
+    matrix<double> ab (block_prod<matrix<double>, 16> (a, c));
+
+    temporary_arena arena;
+    {
+        temporary_arena_guard g (arena);
+        vector<double> z (n);
+        z = prod (a, x);
+        BOOST_UBLAS_TEST_CHECK( same (z, y) );
+        z += prod (a, x);
+        BOOST_UBLAS_TEST_CHECK( same (z, 2.0 * y) );
+        z -= prod (a, x);
+        BOOST_UBLAS_TEST_CHECK( same (z, y) );
+        vector<double> w;
+        w = prod (a, x);
+        BOOST_UBLAS_TEST_CHECK( same (w, y) );
+
+        matrix<double> m;
+        m = prod (a, c);
+        BOOST_UBLAS_TEST_CHECK( same (m, ac) );
+        matrix<double, column_major> mc (n, n);
+        mc.clear ();
+        mc += prod (a, c);
+        mc -= a;
+        BOOST_UBLAS_TEST_CHECK( same (mc, ac - a) );
+
+        BOOST_UBLAS_TEST_CHECK( same (block_prod<vector<double>, 16> (a, x), yb) );
+        BOOST_UBLAS_TEST_CHECK( same (block_prod<matrix<double>, 16> (a, c), ab) );
+
+#ifndef BOOST_UBLAS_NO_TEMPORARY_ARENA
+        // Every temporary went through the arena and was given back,
+        // all but the alignment of the first
+        BOOST_UBLAS_TEST_CHECK( arena.capacity () > 0 );
+#endif
+        BOOST_UBLAS_TEST_CHECK( arena.used () < temporary_arena::alignment );
+    }
+}
+
+int main()
+{
+    BOOST_UBLAS_TEST_BEGIN();
+
+    BOOST_UBLAS_TEST_DO( test_arena );
+    BOOST_UBLAS_TEST_DO( test_guard );
+    BOOST_UBLAS_TEST_DO( test_temporaries );
+
+    BOOST_UBLAS_TEST_END();
+}
@@ -0,0 +1,185 @@
+//  Copyright (c) 2019
+//  The Boost.uBLAS developers
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+// trans () and herm () of dense matrices go the way of the matrices
+// themselves, their products, solves and assignments have to give the
+// results of the generic evaluation
+
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/matrix_proxy.hpp>
+#include <boost/numeric/ublas/triangular.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+#include <complex>
+#include "common/testhelper.hpp"
+#include "utils.hpp"
+
+using namespace boost::numeric::ublas;
+
+template<class T, class L>
+bool check_prod (std::size_t size1, std::size_t size, std::size_t size2) {
+    typedef matrix<T, L> matrix_type;
+    typedef matrix<T> result_type;
+    bool pass = true;
+
+    // Operands stored transposed, the first one inside a larger matrix
+    matrix_type a (size + 2, size1 + 3), b (size2, size);
+    fill (a, 1);
+    fill (b, 2);
+    matrix_range<matrix_type> ar (a, range (2, 2 + size), range (1, 1 + size1));
+    result_type at (trans (ar)), ah (herm (ar)), bt (trans (b)), bh (herm (b));
+
+    result_type c (size1, size2);
+    noalias (c) = prod (trans (ar), trans (b));
+    pass &= compare (c, reference_prod<result_type> (at, bt));
+    noalias (c) = prod (herm (ar), herm (b));
+    pass &= compare (c, reference_prod<result_type> (ah, bh));
+    noalias (c) = prod (at, herm (b));
+    pass &= compare (c, reference_prod<result_type> (at, bh));
+    result_type c0 (size1, size2);
+    fill (c0, 3);
+    c = c0;
+    noalias (c) -= prod (herm (ar), trans (b));
+    pass &= compare (c, c0 - reference_prod<result_type> (ah, bt));
+
+    // prod (A, x) and prod (x, A) of the same
+    vector<T> x (size), y (size1), z (size2), ax (size1), za (size2);
+    fill_vector (x, 4);
+    noalias (y) = prod (trans (ar), x);
+    noalias (ax) = prod (at, x);
+    pass &= compare (y, ax);
+    noalias (y) = prod (herm (ar), x);
+    noalias (ax) = prod (ah, x);
+    pass &= compare (y, ax);
+    noalias (z) = prod (x, herm (b));
+    noalias (za) = prod (x, bh);
+    pass &= compare (z, za);
+    return pass;
+}
+
+BOOST_UBLAS_TEST_DEF( test_prod )
+{
+    BOOST_UBLAS_TEST_CHECK( (check_prod<double, row_major> (1, 1, 1)) );
+    BOOST_UBLAS_TEST_CHECK( (check_prod<double, row_major> (67, 45, 39)) );
+    BOOST_UBLAS_TEST_CHECK( (check_prod<double, column_major> (61, 47, 53)) );
+    BOOST_UBLAS_TEST_CHECK( (check_prod<std::complex<double>, row_major> (35, 41, 29)) );
+    BOOST_UBLAS_TEST_CHECK( (check_prod<std::complex<double>, column_major> (35, 41, 29)) );
+}
+
+template<class T, class L>
+bool check_solve (std::size_t size) {
+    typedef matrix<T, L> matrix_type;
+    bool pass = true;
+
+    // Upper triangular, so that its transpose is lower triangular
+    matrix_type u (size, size);
+    fill (u, 1);
+    for (std::size_t i = 0; i < size; ++ i) {
+        for (std::size_t j = 0; j < i; ++ j)
+            u (i, j) = T ();
+        u (i, i) += T (8);
+    }
+    matrix_type ut (trans (u)), uh (herm (u));
+    vector<T> v (size), w (size);
+    fill_vector (v, 2);
+    w = v;
+    inplace_solve (trans (u), v, lower_tag ());
+    inplace_solve (ut, w, lower_tag ());
+    pass &= compare (v, w);
+    inplace_solve (herm (u), v, lower_tag ());
+    inplace_solve (uh, w, lower_tag ());
+    pass &= compare (v, w);
+    inplace_solve (v, trans (u), upper_tag ());
+    inplace_solve (w, ut, upper_tag ());
+    pass &= compare (v, w);
+
+    matrix_type b (size, 5), bb (size, 5);
+    fill (b, 3);
+    bb = b;
+    inplace_solve (herm (u), b, lower_tag ());
+    inplace_solve (uh, bb, lower_tag ());
+    pass &= compare (b, bb);
+    return pass;
+}
+
+BOOST_UBLAS_TEST_DEF( test_solve )
+{
+    BOOST_UBLAS_TEST_CHECK( (check_solve<double, row_major> (37)) );
+    BOOST_UBLAS_TEST_CHECK( (check_solve<double, column_major> (37)) );
+    BOOST_UBLAS_TEST_CHECK( (check_solve<std::complex<double>, row_major> (29)) );
+}
+
+template<class T, class L>
+bool check_assign (std::size_t size1, std::size_t size2) {
+    typedef matrix<T, L> matrix_type;
+    typedef matrix<T, row_major> row_major_matrix;
+    typedef matrix<T, column_major> column_major_matrix;
+    bool pass = true;
+
+    matrix_type a (size2 + 3, size1 + 1);
+    fill (a, 1);
+    matrix_range<matrix_type> ar (a, range (1, 1 + size2), range (0, size1));
+    row_major_matrix at (size1, size2), ah (size1, size2);
+    for (std::size_t i = 0; i < size1; ++ i)
+        for (std::size_t j = 0; j < size2; ++ j) {
+            at (i, j) = ar (j, i);
+            ah (i, j) = type_traits<T>::conj (ar (j, i));
+        }
+
+    // Targets of both layouts, a slice of a larger one
+    row_major_matrix r (size1, size2);
+    noalias (r) = trans (ar);
+    pass &= compare (r, at);
+    r = herm (ar);
+    pass &= compare (r, ah);
+    noalias (r) += herm (ar);
+    pass &= compare (r, ah + ah);
+    column_major_matrix c (size1, size2);
+    noalias (c) = herm (ar);
+    pass &= compare (c, ah);
+    noalias (c) -= trans (ar);
+    pass &= compare (c, ah - at);
+    matrix_type t (size1 + 2, 2 * size2), t0 (size1 + 2, 2 * size2);
+    fill (t0, 2);
+    t = t0;
+    matrix_slice<matrix_type> ts (t, slice (1, 1, size1), slice (1, 2, size2));
+    noalias (ts) = trans (ar);
+    pass &= compare (ts, at);
+    pass &= compare (row (t, 0), row (t0, 0));
+
+    // Permutations of the target are assigned element by element
+    t = t0;
+    indirect_array<> ti (size1), tj (size2);
+    for (std::size_t i = 0; i < size1; ++ i)
+        ti (i) = size1 - 1 - i;
+    for (std::size_t j = 0; j < size2; ++ j)
+        tj (j) = 2 * j;
+    matrix_indirect<matrix_type> tx (t, ti, tj);
+    noalias (tx) = herm (ar);
+    pass &= compare (tx, ah);
+    return pass;
+}
+
+BOOST_UBLAS_TEST_DEF( test_assign )
+{
+    BOOST_UBLAS_TEST_CHECK( (check_assign<double, row_major> (1, 1)) );
+    BOOST_UBLAS_TEST_CHECK( (check_assign<double, row_major> (67, 45)) );
+    BOOST_UBLAS_TEST_CHECK( (check_assign<double, column_major> (61, 97)) );
+    BOOST_UBLAS_TEST_CHECK( (check_assign<float, row_major> (64, 64)) );
+    BOOST_UBLAS_TEST_CHECK( (check_assign<std::complex<double>, row_major> (35, 41)) );
+    BOOST_UBLAS_TEST_CHECK( (check_assign<std::complex<double>, column_major> (35, 41)) );
+}
+
+int main()
+{
+    BOOST_UBLAS_TEST_BEGIN();
+
+    BOOST_UBLAS_TEST_DO( test_prod );
+    BOOST_UBLAS_TEST_DO( test_solve );
+    BOOST_UBLAS_TEST_DO( test_assign );
+
+    BOOST_UBLAS_TEST_END();
+}